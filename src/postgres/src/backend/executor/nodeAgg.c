@@ -241,6 +241,8 @@
 #include "utils/tuplesort.h"
 #include "utils/datum.h"
 
+#include "pg_yb_utils.h"
+
 
 static void select_current_set(AggState *aggstate, int setno, bool is_hash);
 static void initialize_phase(AggState *aggstate, int newphase);
@@ -297,7 +299,11 @@ static int find_compatible_pertrans(AggState *aggstate, Aggref *newagg,
 						 Datum initValue, bool initValueIsNull,
 						 List *transnos);
 static void yb_agg_pushdown_supported(AggState *aggstate);
+static bool yb_agg_group_pushdown_supported(AggState *aggstate);
 static void yb_agg_pushdown(AggState *aggstate);
+static void yb_agg_merge_pushdown_results(AggState *aggstate,
+										  AggStatePerGroup pergroup,
+										  TupleTableSlot *outerslot);
 
 
 /*
@@ -1460,13 +1466,22 @@ lookup_hash_entry(AggState *aggstate)
 	bool		isnew;
 	int			i;
 
-	/* transfer just the needed columns into hashslot */
-	slot_getsomeattrs(inputslot, perhash->largestGrpColIdx);
+	/*
+	 * transfer just the needed columns into hashslot
+	 *
+	 * YB: tuples produced by pushed down grouped aggregates contain partial
+	 * aggregate values followed by the grouping column values.
+	 */
+	if (aggstate->yb_pushdown_supported)
+		slot_getsomeattrs(inputslot, aggstate->numaggs + perhash->numhashGrpCols);
+	else
+		slot_getsomeattrs(inputslot, perhash->largestGrpColIdx);
 	ExecClearTuple(hashslot);
 
 	for (i = 0; i < perhash->numhashGrpCols; i++)
 	{
-		int			varNumber = perhash->hashGrpColIdxInput[i] - 1;
+		int			varNumber = aggstate->yb_pushdown_supported ?
+			aggstate->numaggs + i : perhash->hashGrpColIdxInput[i] - 1;
 
 		hashslot->tts_values[i] = inputslot->tts_values[varNumber];
 		hashslot->tts_isnull[i] = inputslot->tts_isnull[varNumber];
@@ -1537,17 +1552,26 @@ yb_agg_pushdown_supported(AggState *aggstate)
 	/* Initially set pushdown supported to false. */
 	aggstate->yb_pushdown_supported = false;
 
-	/* Phase 0 is a dummy phase, so there should be two phases. */
-	if (aggstate->numphases != 2)
-		return;
+	if (aggstate->aggstrategy == AGG_HASHED)
+	{
+		/* GROUP BY is only pushed down for hashed aggregates. */
+		if (!yb_agg_group_pushdown_supported(aggstate))
+			return;
+	}
+	else
+	{
+		/* Phase 0 is a dummy phase, so there should be two phases. */
+		if (aggstate->numphases != 2)
+			return;
 
-	/* Plain agg strategy. */
-	if (aggstate->phase->aggstrategy != AGG_PLAIN)
-		return;
+		/* Plain agg strategy. */
+		if (aggstate->phase->aggstrategy != AGG_PLAIN)
+			return;
 
-	/* No GROUP BY. */
-	if (aggstate->phase->numsets != 0)
-		return;
+		/* No GROUP BY. */
+		if (aggstate->phase->numsets != 0)
+			return;
+	}
 
 	/* Foreign scan outer plan. */
 	if (!IsA(outerPlanState(aggstate), ForeignScanState))
@@ -1563,7 +1587,8 @@ yb_agg_pushdown_supported(AggState *aggstate)
 	if (scan_state->ss.ps.qual)
 		return;
 
-	check_outer_plan = false;
+	/* Grouping columns are checked to be simple column references of the outer plan. */
+	check_outer_plan = aggstate->aggstrategy == AGG_HASHED;
 
 	foreach(lc_agg, aggstate->aggs)
 	{
@@ -1693,6 +1718,57 @@ yb_agg_pushdown_supported(AggState *aggstate)
 	aggstate->yb_pushdown_supported = true;
 }
 
+/*
+ * Evaluates whether GROUP BY of a hashed aggregate could be pushed down to
+ * DocDB. DocDB returns partial aggregates per group, that are merged into the
+ * hash table the same way as partial aggregates of the plain pushdown are
+ * merged across responses.
+ */
+static bool
+yb_agg_group_pushdown_supported(AggState *aggstate)
+{
+	Agg		   *node = (Agg *) aggstate->ss.ps.plan;
+	List	   *outerTlist = outerPlanState(aggstate)->plan->targetlist;
+	Bitmapset  *colnos;
+	int			i;
+
+	if (!yb_enable_group_by_pushdown || aggstate->numaggs == 0)
+		return false;
+
+	/* Single hashed phase without grouping sets. */
+	if (aggstate->numphases != 1 || aggstate->num_hashes != 1 || node->groupingSets != NIL)
+		return false;
+
+	/*
+	 * Rows returned by DocDB contain only aggregates and grouping columns, so
+	 * other columns could not be referenced by the target list or qual.
+	 */
+	colnos = find_unaggregated_cols(aggstate);
+	for (i = 0; i < node->numCols; i++)
+		colnos = bms_del_member(colnos, node->grpColIdx[i]);
+	if (!bms_is_empty(colnos))
+		return false;
+
+	for (i = 0; i < node->numCols; i++)
+	{
+		TargetEntry *tle = list_nth(outerTlist, node->grpColIdx[i] - 1);
+		Var		   *var;
+
+		if (!IsA(tle->expr, Var))
+			return false;
+		var = castNode(Var, tle->expr);
+
+		/*
+		 * DocDB groups rows by encoded values, so only types that are allowed
+		 * to be YB keys are supported.
+		 */
+		if (var->varoattno <= 0 || !YbDataTypeIsValidForKey(var->vartype))
+			return false;
+	}
+
+	return true;
+}
+
 /*
  * Populates aggregate pushdown information in the YB foreign scan state.
  */
@@ -1701,6 +1777,7 @@ yb_agg_pushdown(AggState *aggstate)
 {
 	ForeignScanState *scan_state = castNode(ForeignScanState, outerPlanState(aggstate));
 	List *pushdown_aggs = NIL;
+	List *group_cols = NIL;
 	int aggno;
 
 	for (aggno = 0; aggno < aggstate->numaggs; aggno++)
@@ -1710,10 +1787,71 @@ yb_agg_pushdown(AggState *aggstate)
 		pushdown_aggs = lappend(pushdown_aggs, aggref);
 	}
 	scan_state->yb_fdw_aggs = pushdown_aggs;
+
+	if (aggstate->aggstrategy == AGG_HASHED)
+	{
+		Agg *node = (Agg *) aggstate->ss.ps.plan;
+		List *outerTlist = outerPlanState(aggstate)->plan->targetlist;
+		int i;
+
+		for (i = 0; i < node->numCols; i++)
+		{
+			TargetEntry *tle = list_nth(outerTlist, node->grpColIdx[i] - 1);
+
+			group_cols = lappend(group_cols, castNode(Var, tle->expr));
+		}
+	}
+	scan_state->yb_fdw_group_cols = group_cols;
 	/* Disable projection for tuples produced by pushed down aggregate operators. */
 	scan_state->ss.ps.ps_ProjInfo = NULL;
 }
 
+/*
+ * Merges partial aggregate values returned by DocDB in outerslot into the
+ * transition values of the group.
+ *
+ * We special case COUNT, so it returns the count summed across all responses.
+ */
+static void
+yb_agg_merge_pushdown_results(AggState *aggstate,
+							  AggStatePerGroup pergroup,
+							  TupleTableSlot *outerslot)
+{
+	int aggno;
+
+	for (aggno = 0; aggno < aggstate->numaggs; aggno++)
+	{
+		MemoryContext oldContext;
+		int transno = aggstate->peragg[aggno].transno;
+		Aggref *aggref = aggstate->peragg[aggno].aggref;
+		char *func_name = get_func_name(aggref->aggfnoid);
+		AggStatePerGroup pergroupstate = &pergroup[transno];
+		AggStatePerTrans pertrans = &aggstate->pertrans[transno];
+		FunctionCallInfo fcinfo = &pertrans->transfn_fcinfo;
+		Datum value = outerslot->tts_values[aggno];
+		bool isnull = outerslot->tts_isnull[aggno];
+
+		if (strcmp(func_name, "count") == 0)
+		{
+			/*
+			 * Sum results from each response for COUNT. It is safe to do this
+			 * directly on the datum as it is guaranteed to be an int64.
+			 */
+			oldContext = MemoryContextSwitchTo(
+				aggstate->curaggcontext->ecxt_per_tuple_memory);
+			pergroupstate->transValue += value;
+			MemoryContextSwitchTo(oldContext);
+		}
+		else
+		{
+			/* Set slot result as argument, then advance the transition function. */
+			fcinfo->arg[1] = value;
+			fcinfo->argnull[1] = isnull;
+			advance_transition_function(aggstate, pertrans, pergroupstate);
+		}
+	}
+}
+
 /*
  * ExecAgg -
  *
@@ -1792,7 +1930,6 @@ agg_retrieve_direct(AggState *aggstate)
 	int			nextSetSize;
 	int			numReset;
 	int			i;
-	int			aggno;
 
 	/*
 	 * get state info from node
@@ -1960,38 +2097,7 @@ agg_retrieve_direct(AggState *aggstate)
 
 				Assert(aggstate->numaggs == outerslot->tts_nvalid);
 
-				for (aggno = 0; aggno < aggstate->numaggs; aggno++)
-				{
-					MemoryContext oldContext;
-					int transno = peragg[aggno].transno;
-					Aggref *aggref = aggstate->peragg[aggno].aggref;
-					char *func_name = get_func_name(aggref->aggfnoid);
-					AggStatePerGroup pergroup = pergroups[currentSet];
-					AggStatePerGroup pergroupstate = &pergroup[transno];
-					AggStatePerTrans pertrans = &aggstate->pertrans[transno];
-					FunctionCallInfo fcinfo = &pertrans->transfn_fcinfo;
-					Datum value = outerslot->tts_values[aggno];
-					bool isnull = outerslot->tts_isnull[aggno];
-
-					if (strcmp(func_name, "count") == 0)
-					{
-						/*
-						 * Sum results from each response for COUNT. It is safe to do this
-						 * directly on the datum as it is guaranteed to be an int64.
-						 */
-						oldContext = MemoryContextSwitchTo(
-							aggstate->curaggcontext->ecxt_per_tuple_memory);
-						pergroupstate->transValue += value;
-						MemoryContextSwitchTo(oldContext);
-					}
-					else
-					{
-						/* Set slot result as argument, then advance the transition function. */
-						fcinfo->arg[1] = value;
-						fcinfo->argnull[1] = isnull;
-						advance_transition_function(aggstate, pertrans, pergroupstate);
-					}
-				}
+				yb_agg_merge_pushdown_results(aggstate, pergroups[currentSet], outerslot);
 
 				/* Reset per-input-tuple context after each tuple */
 				ResetExprContext(tmpcontext);
@@ -2204,8 +2310,16 @@ agg_fill_hash_table(AggState *aggstate)
 		/* Find or build hashtable entries */
 		lookup_hash_entries(aggstate);
 
-		/* Advance the aggregates (or combine functions) */
-		advance_aggregates(aggstate);
+		/*
+		 * Advance the aggregates (or combine functions)
+		 *
+		 * YB: if aggregates were pushed down, the tuple contains partial
+		 * aggregates of the group, returned by DocDB.
+		 */
+		if (aggstate->yb_pushdown_supported)
+			yb_agg_merge_pushdown_results(aggstate, aggstate->hash_pergroup[0], outerslot);
+		else
+			advance_aggregates(aggstate);
 
 		/*
 		 * Reset per-input-tuple context after each tuple, but note that the
@@ -519,12 +519,33 @@ ybcSetupScanTargets(ForeignScanState *node)
 			HandleYBStatus(YBCPgDmlAppendTarget(ybc_state->handle, op_handle));
 		}
 
+		/*
+		 * For pushed down GROUP BY, DocDB returns partial aggregates per group, followed by the
+		 * grouping column values.
+		 */
+		foreach(lc, node->yb_fdw_group_cols)
+		{
+			/* Use original attribute number, as for aggregate arguments above. */
+			int attno = lfirst_node(Var, lc)->varoattno;
+			Form_pg_attribute attr = TupleDescAttr(tupdesc, attno - 1);
+			YBCPgTypeAttrs type_attrs = {attr->atttypmod};
+
+			YBCPgExpr expr = YBCNewColumnRef(ybc_state->handle,
+											 attno,
+											 attr->atttypid,
+											 attr->attcollation,
+											 &type_attrs);
+			HandleYBStatus(YBCPgDmlAppendTarget(ybc_state->handle, expr));
+			HandleYBStatus(YbPgDmlAppendGroupingColumn(ybc_state->handle, expr));
+		}
+
 		/*
 		 * Setup the scan slot based on new tuple descriptor for the given targets. This is a dummy
 		 * tupledesc that only includes the number of attributes.
 		 */
-		TupleDesc target_tupdesc = CreateTemplateTupleDesc(list_length(node->yb_fdw_aggs),
-														   false /* hasoid */);
+		TupleDesc target_tupdesc = CreateTemplateTupleDesc(
+			list_length(node->yb_fdw_aggs) + list_length(node->yb_fdw_group_cols),
+			false /* hasoid */);
 		ExecInitScanTupleSlot(estate, &node->ss, target_tupdesc);
 
 		/*
@@ -2088,6 +2088,16 @@ static struct config_bool ConfigureNamesBool[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"yb_enable_group_by_pushdown", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Push GROUP BY of hashed aggregates down to DocDB, so "
+						 "tablets return partial aggregates per group."),
+			NULL
+		},
+		&yb_enable_group_by_pushdown,
+		false,
+		NULL, NULL, NULL
+	},
 
 
     {
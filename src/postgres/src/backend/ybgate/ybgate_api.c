@@ -14,6 +14,8 @@
 
 #include "postgres.h"
 
+#include <math.h>
+
 #include "ybgate/ybgate_api.h"
 
 #include "access/htup_details.h"
@@ -28,6 +30,7 @@
 #include "nodes/makefuncs.h"
 #include "nodes/nodeFuncs.h"
 #include "nodes/primnodes.h"
+#include "utils/fmgroids.h"
 #include "utils/memutils.h"
 #include "utils/numeric.h"
 #include "utils/rowtypes.h"
@@ -418,6 +421,165 @@ YbgStatus YbgEvalExpr(YbgPreparedExpr expr, YbgExprContext expr_ctx, uint64_t *d
 	return PG_STATUS_OK;
 }
 
+/*
+ * Cases for the integer (including bool and timestamp) comparison functions
+ * with the specified operator suffix.
+ */
+#define YBG_INT_COMPARISON_CASES(op) \
+	case F_INT2##op: \
+	case F_INT4##op: \
+	case F_INT8##op: \
+	case F_INT24##op: \
+	case F_INT42##op: \
+	case F_INT28##op: \
+	case F_INT82##op: \
+	case F_INT48##op: \
+	case F_INT84##op: \
+	case F_BOOL##op: \
+	case F_TIMESTAMP_##op: \
+	case F_TIMESTAMPTZ_##op
+
+#define YBG_REAL_COMPARISON_CASES(op) \
+	case F_FLOAT4##op: \
+	case F_FLOAT8##op
+
+static bool getComparisonOp(Oid funcid, YbgCompareOp *op, bool *is_real)
+{
+	*is_real = false;
+	switch (funcid)
+	{
+		YBG_REAL_COMPARISON_CASES(EQ):
+			*is_real = true;
+			switch_fallthrough();
+		YBG_INT_COMPARISON_CASES(EQ):
+			*op = YBG_CMP_EQ;
+			return true;
+		YBG_REAL_COMPARISON_CASES(NE):
+			*is_real = true;
+			switch_fallthrough();
+		YBG_INT_COMPARISON_CASES(NE):
+			*op = YBG_CMP_NE;
+			return true;
+		YBG_REAL_COMPARISON_CASES(LT):
+			*is_real = true;
+			switch_fallthrough();
+		YBG_INT_COMPARISON_CASES(LT):
+			*op = YBG_CMP_LT;
+			return true;
+		YBG_REAL_COMPARISON_CASES(LE):
+			*is_real = true;
+			switch_fallthrough();
+		YBG_INT_COMPARISON_CASES(LE):
+			*op = YBG_CMP_LE;
+			return true;
+		YBG_REAL_COMPARISON_CASES(GT):
+			*is_real = true;
+			switch_fallthrough();
+		YBG_INT_COMPARISON_CASES(GT):
+			*op = YBG_CMP_GT;
+			return true;
+		YBG_REAL_COMPARISON_CASES(GE):
+			*is_real = true;
+			switch_fallthrough();
+		YBG_INT_COMPARISON_CASES(GE):
+			*op = YBG_CMP_GE;
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Extract the constant value, return false if constant type is unexpected.
+ */
+static bool getComparisonConst(Const *const_expr, YbgColumnComparison *cmp)
+{
+	Datum value = const_expr->constvalue;
+	switch (const_expr->consttype)
+	{
+		case BOOLOID:
+			cmp->int_value = DatumGetBool(value) ? 1 : 0;
+			return !cmp->is_real;
+		case INT2OID:
+			cmp->int_value = DatumGetInt16(value);
+			return !cmp->is_real;
+		case INT4OID:
+			cmp->int_value = DatumGetInt32(value);
+			return !cmp->is_real;
+		case INT8OID:
+		case TIMESTAMPOID:
+		case TIMESTAMPTZOID:
+			cmp->int_value = DatumGetInt64(value);
+			return !cmp->is_real;
+		case FLOAT4OID:
+			cmp->real_value = DatumGetFloat4(value);
+			/* NaN ordering differs from IEEE comparisons, leave it to evalExpr */
+			return cmp->is_real && !isnan(cmp->real_value);
+		case FLOAT8OID:
+			cmp->real_value = DatumGetFloat8(value);
+			return cmp->is_real && !isnan(cmp->real_value);
+		default:
+			return false;
+	}
+}
+
+YbgStatus YbgExprGetColumnComparison(const YbgPreparedExpr expr,
+									 YbgColumnComparison *cmp,
+									 bool *is_comparison)
+{
+	OpExpr	   *op_expr;
+	Expr	   *left;
+	Expr	   *right;
+	Var		   *var_expr;
+	Const	   *const_expr;
+	bool		swapped = false;
+
+	PG_SETUP_ERROR_REPORTING();
+
+	*is_comparison = false;
+	if (!IsA(expr, OpExpr))
+		return PG_STATUS_OK;
+
+	op_expr = castNode(OpExpr, expr);
+	if (list_length(op_expr->args) != 2 ||
+		!getComparisonOp(op_expr->opfuncid, &cmp->op, &cmp->is_real))
+		return PG_STATUS_OK;
+
+	left = (Expr *) linitial(op_expr->args);
+	right = (Expr *) lsecond(op_expr->args);
+	if (IsA(left, Const) && IsA(right, Var))
+	{
+		Expr *tmp = left;
+		left = right;
+		right = tmp;
+		swapped = true;
+	}
+	if (!IsA(left, Var) || !IsA(right, Const))
+		return PG_STATUS_OK;
+
+	var_expr = castNode(Var, left);
+	const_expr = castNode(Const, right);
+	if (var_expr->varattno <= 0 || const_expr->constisnull ||
+		!getComparisonConst(const_expr, cmp))
+		return PG_STATUS_OK;
+
+	cmp->attno = var_expr->varattno;
+	if (swapped)
+	{
+		/* const < var is the same as var > const */
+		switch (cmp->op)
+		{
+			case YBG_CMP_LT: cmp->op = YBG_CMP_GT; break;
+			case YBG_CMP_LE: cmp->op = YBG_CMP_GE; break;
+			case YBG_CMP_GT: cmp->op = YBG_CMP_LT; break;
+			case YBG_CMP_GE: cmp->op = YBG_CMP_LE; break;
+			default: break;
+		}
+	}
+	*is_comparison = true;
+	return PG_STATUS_OK;
+}
+
 YbgStatus YbgSplitArrayDatum(uint64_t datum,
 			     const int type,
 			     uint64_t **result_datum_array,
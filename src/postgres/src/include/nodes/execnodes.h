@@ -1741,6 +1741,7 @@ typedef struct ForeignScanState
 
 	/* YB specific attributes. */
 	List	   *yb_fdw_aggs;	/* aggregate pushdown information */
+	List	   *yb_fdw_group_cols;	/* Vars of pushed down GROUP BY columns */
 } ForeignScanState;
 
 /* ----------------
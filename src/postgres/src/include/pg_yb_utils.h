@@ -439,6 +439,13 @@ extern int yb_index_state_flags_update_delay;
  */
 extern bool yb_enable_expression_pushdown;
 
+/*
+ * Enables pushdown of GROUP BY for hashed aggregates.
+ * If true, DocDB computes partial aggregates per group, that are merged by the
+ * HashAggregate node.
+ */
+extern bool yb_enable_group_by_pushdown;
+
 /*
  * YSQL guc variable that is used to enable the use of Postgres's selectivity
  * functions and YSQL table statistics.
@@ -196,6 +196,47 @@ YbgStatus YbgExprCollation(const YbgPreparedExpr expr, int32_t *collid);
  */
 YbgStatus YbgEvalExpr(YbgPreparedExpr expr, YbgExprContext expr_ctx, uint64_t *datum, bool *is_null);
 
+/*
+ * Comparison operators recognized by YbgExprGetColumnComparison.
+ */
+typedef enum YbgCompareOp
+{
+	YBG_CMP_EQ,
+	YBG_CMP_NE,
+	YBG_CMP_LT,
+	YBG_CMP_LE,
+	YBG_CMP_GT,
+	YBG_CMP_GE
+} YbgCompareOp;
+
+/*
+ * Comparison of a column with a constant, normalized to have the column on
+ * the left side.
+ */
+struct YbgColumnComparison
+{
+	int32_t attno;			/* attribute number of the column */
+	YbgCompareOp op;		/* comparison operator */
+	bool is_real;			/* whether constant is in real_value or int_value */
+	int64_t int_value;		/* integer, bool or timestamp constant */
+	double real_value;		/* float4 or float8 constant, never NaN */
+};
+
+#ifndef __cplusplus
+typedef struct YbgColumnComparison YbgColumnComparison;
+#endif
+
+/*
+ * Check if the expression is a comparison of a fixed width column with a
+ * non-null constant of the same kind (integer, bool, timestamp or float).
+ * Such expressions could be evaluated by DocDB directly over column values,
+ * without converting them to datums. If so, set is_comparison to true and
+ * fill in cmp.
+ */
+YbgStatus YbgExprGetColumnComparison(const YbgPreparedExpr expr,
+									 YbgColumnComparison *cmp,
+									 bool *is_comparison);
+
 /*
  * Given a 'datum' of array type, split datum into individual elements of type 'type' and store
  * the result in 'result_datum_array', with number of elements in 'nelems'. This will error out
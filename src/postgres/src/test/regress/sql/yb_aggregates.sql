@@ -129,3 +129,22 @@ EXPLAIN (COSTS OFF) SELECT COUNT(*), SUM(int_4) FROM ybaggtest;
 EXPLAIN (COSTS OFF) SELECT int_2, COUNT(*), SUM(int_4) FROM ybaggtest GROUP BY int_2;
 EXPLAIN (COSTS OFF) SELECT DISTINCT int_4 FROM ybaggtest;
 EXPLAIN (COSTS OFF) SELECT COUNT(distinct int_4), SUM(int_4) FROM ybaggtest;
+
+-- Test GROUP BY pushdown
+CREATE TABLE ybgrouptest(k INT PRIMARY KEY, g1 INT, g2 TEXT, v INT, d FLOAT8);
+INSERT INTO ybgrouptest VALUES
+  (1, 1, 'a', 10, 1.5), (2, 2, 'b', 20, NULL), (3, 1, NULL, NULL, 2.5), (4, 2, 'a', 40, 4),
+  (5, NULL, 'b', 50, 5), (6, 1, 'a', 60, NULL), (7, 2, NULL, 70, 7.5), (8, NULL, 'b', NULL, 8),
+  (9, 1, 'b', 90, 9), (10, 3, 'a', 100, 10);
+SET yb_enable_group_by_pushdown = on;
+EXPLAIN (COSTS OFF) SELECT g1, COUNT(*), COUNT(v), SUM(v), MIN(v), MAX(d) FROM ybgrouptest GROUP BY g1;
+SELECT g1, COUNT(*), COUNT(v), SUM(v), MIN(v), MAX(d) FROM ybgrouptest GROUP BY g1 ORDER BY g1;
+SELECT g2, COUNT(*), SUM(v) FROM ybgrouptest GROUP BY g2 HAVING COUNT(*) > 1 ORDER BY g2;
+SELECT g1, g2, COUNT(*) FROM ybgrouptest GROUP BY g1, g2 ORDER BY g1, g2;
+EXPLAIN (COSTS OFF) SELECT g1, COUNT(*) FROM ybgrouptest WHERE v > 10 GROUP BY g1;
+SELECT g1, COUNT(*) FROM ybgrouptest WHERE v > 10 GROUP BY g1 ORDER BY g1;
+-- Negative tests - GROUP BY pushdown not supported
+EXPLAIN (COSTS OFF) SELECT DISTINCT g1 FROM ybgrouptest;
+EXPLAIN (COSTS OFF) SELECT g1 + 1, COUNT(*) FROM ybgrouptest GROUP BY g1 + 1;
+RESET yb_enable_group_by_pushdown;
+DROP TABLE ybgrouptest;
@@ -158,6 +158,15 @@ Result<DocHybridTime> DocHybridTime::DecodeFromEnd(Slice encoded_key_with_ht_at_
   return DecodeFromEnd(&encoded_key_with_ht_at_end);
 }
 
+size_t DocHybridTime::EncodedSizeOrZero(Slice encoded_key) {
+  if (encoded_key.empty()) {
+    return 0;
+  }
+  const size_t result = static_cast<uint8_t>(encoded_key.end()[-1]) & kHybridTimeSizeMask;
+  return result >= 1 && result <= kMaxBytesPerEncodedHybridTime && result < encoded_key.size()
+      ? result : 0;
+}
+
 string DocHybridTime::ToString() const {
   if (write_id_ == 0) {
     return hybrid_time_.ToDebugString();
@@ -154,6 +154,10 @@ class DocHybridTime {
   // Returns failure in case of corruption.
   static Result<size_t> GetEncodedSize(const Slice& encoded_key);
 
+  // Same as GetEncodedSize, but returns 0 instead of failure. Does not allocate, so could be used
+  // in performance critical parts of the code for keys that might not contain DocHybridTime.
+  static size_t EncodedSizeOrZero(Slice encoded_key);
+
   bool is_valid() const { return hybrid_time_.is_valid(); }
 
   static std::string DebugSliceToString(Slice input);
@@ -32,7 +32,9 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -44,6 +46,7 @@
 #include "yb/common/partition.h"
 #include "yb/common/schema.h"
 
+#include "yb/util/format.h"
 #include "yb/util/monotime.h"
 #include "yb/util/test_macros.h"
 
@@ -120,4 +123,86 @@ TEST(PartitionTest, TestRedisEncoding) {
   ASSERT_EQ(pk1, pk2);
 }
 
+namespace {
+
+uint32_t DecodeRangeStart(const string& key) {
+  return key.empty() ? 0 : PartitionSchema::DecodeMultiColumnHashValue(key);
+}
+
+uint32_t DecodeRangeEnd(const string& key) {
+  return key.empty() ? PartitionSchema::kMaxPartitionKey + 1
+                     : PartitionSchema::DecodeMultiColumnHashValue(key);
+}
+
+// Checks that ranges cover the whole hash range without gaps and overlaps, every partition is
+// split into min(num_splits, partition width) ranges, and range widths inside of a partition
+// differ by at most one.
+void CheckSplitHashPartitionRanges(const vector<uint32_t>& partition_starts, size_t num_splits) {
+  vector<string> partition_keys;
+  for (auto start : partition_starts) {
+    partition_keys.push_back(
+        start == 0 ? string() : PartitionSchema::EncodeMultiColumnHashValue(start));
+  }
+  auto ranges = PartitionSchema::SplitHashPartitionRanges(partition_keys, num_splits);
+  ASSERT_FALSE(ranges.empty());
+  ASSERT_EQ(ranges.front().first, "");
+  ASSERT_EQ(ranges.back().second, "");
+
+  size_t range_idx = 0;
+  for (size_t partition = 0; partition != partition_starts.size(); ++partition) {
+    const uint32_t start = partition_starts[partition];
+    const uint32_t end = partition + 1 < partition_starts.size()
+        ? partition_starts[partition + 1] : PartitionSchema::kMaxPartitionKey + 1;
+    const auto expected_splits = std::max<size_t>(std::min<size_t>(num_splits, end - start), 1);
+    ASSERT_LE(range_idx + expected_splits, ranges.size());
+    ASSERT_EQ(DecodeRangeStart(ranges[range_idx].first), start);
+    uint32_t min_width = std::numeric_limits<uint32_t>::max();
+    uint32_t max_width = 0;
+    for (size_t i = 0; i != expected_splits; ++i, ++range_idx) {
+      const auto& range = ranges[range_idx];
+      const auto range_start = DecodeRangeStart(range.first);
+      const auto range_end = DecodeRangeEnd(range.second);
+      ASSERT_LT(range_start, range_end) << "Range: " << range_idx;
+      if (range_idx + 1 != ranges.size()) {
+        ASSERT_EQ(range.second, ranges[range_idx + 1].first) << "Range: " << range_idx;
+      }
+      min_width = std::min(min_width, range_end - range_start);
+      max_width = std::max(max_width, range_end - range_start);
+    }
+    ASSERT_EQ(DecodeRangeEnd(ranges[range_idx - 1].second), end);
+    ASSERT_LE(max_width - min_width, 1);
+  }
+  ASSERT_EQ(range_idx, ranges.size());
+}
+
+} // namespace
+
+TEST(PartitionTest, SplitHashPartitionRanges) {
+  for (size_t num_splits : {1, 2, 3, 7, 16}) {
+    SCOPED_TRACE(Format("Splits: $0", num_splits));
+    // Single tablet.
+    ASSERT_NO_FATALS(CheckSplitHashPartitionRanges({0}, num_splits));
+    // Evenly split table.
+    ASSERT_NO_FATALS(CheckSplitHashPartitionRanges({0, 0x5555, 0xAAAA}, num_splits));
+    // Uneven tablets, as produced by tablet splitting, including tablets narrower than the
+    // number of splits, and the last tablet that consists of the single hash value.
+    ASSERT_NO_FATALS(CheckSplitHashPartitionRanges(
+        {0, 1, 3, 100, 0x8000, 0x8005, 0xC000, 0xFFFF}, num_splits));
+  }
+
+  // Width of the hash range is not divisible by the number of splits.
+  auto ranges = PartitionSchema::SplitHashPartitionRanges({""}, 3);
+  ASSERT_EQ(ranges.size(), 3);
+  ASSERT_EQ(DecodeRangeEnd(ranges[0].second), 0x5555);
+  ASSERT_EQ(DecodeRangeEnd(ranges[1].second), 0xAAAA);
+  ASSERT_EQ(ranges[2].second, "");
+
+  // Partition that consists of the single hash value is not split.
+  ranges = PartitionSchema::SplitHashPartitionRanges(
+      {"", PartitionSchema::EncodeMultiColumnHashValue(0xFFFF)}, 4);
+  ASSERT_EQ(ranges.size(), 5);
+  ASSERT_EQ(DecodeRangeStart(ranges[4].first), 0xFFFF);
+  ASSERT_EQ(ranges[4].second, "");
+}
+
 } // namespace yb
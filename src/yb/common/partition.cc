@@ -568,6 +568,30 @@ boost::optional<std::pair<Partition, Partition>> PartitionSchema::SplitHashParti
   return std::make_pair(left, right);
 }
 
+std::vector<std::pair<std::string, std::string>> PartitionSchema::SplitHashPartitionRanges(
+    const std::vector<std::string>& partition_keys, size_t num_splits) {
+  constexpr uint32_t kHashRangeEnd = kMaxPartitionKey + 1;
+  std::vector<std::pair<std::string, std::string>> result;
+  result.reserve(partition_keys.size() * num_splits);
+  for (size_t partition = 0; partition != partition_keys.size(); ++partition) {
+    const uint32_t start = partition_keys[partition].empty()
+        ? 0 : DecodeMultiColumnHashValue(partition_keys[partition]);
+    const uint32_t end = partition + 1 < partition_keys.size()
+        ? DecodeMultiColumnHashValue(partition_keys[partition + 1])
+        : kHashRangeEnd;
+    const auto width = end - start;
+    const auto splits = std::max<uint32_t>(std::min<size_t>(num_splits, width), 1);
+    for (uint32_t split = 0; split != splits; ++split) {
+      const auto split_start = start + width * split / splits;
+      const auto split_end = start + width * (split + 1) / splits;
+      result.emplace_back(
+          split_start == 0 ? std::string() : EncodeMultiColumnHashValue(split_start),
+          split_end == kHashRangeEnd ? std::string() : EncodeMultiColumnHashValue(split_end));
+    }
+  }
+  return result;
+}
+
 Status PartitionSchema::CreateHashPartitions(int32_t num_tablets,
                                              vector<Partition> *partitions,
                                              int32_t max_partition_key) const {
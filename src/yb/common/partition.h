@@ -371,6 +371,14 @@ class PartitionSchema {
   static boost::optional<std::pair<Partition, Partition>> SplitHashPartitionForStatusTablet(
       const Partition& partition);
 
+  // Splits hash range of each partition of hash partitioned table, given by the sorted start
+  // partition keys, into up to num_splits sub-ranges of the same width. Rows are distributed over
+  // the hash range uniformly, so sub-ranges contain roughly the same number of rows.
+  // Returns lower (inclusive) and upper (exclusive) partition keys of the sub-ranges, empty key
+  // means the beginning or the end of the hash range respectively.
+  static std::vector<std::pair<std::string, std::string>> SplitHashPartitionRanges(
+      const std::vector<std::string>& partition_keys, size_t num_splits);
+
  private:
 
   struct HashBucketSchema {
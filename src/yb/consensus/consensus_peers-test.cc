@@ -59,6 +59,8 @@ using namespace std::chrono_literals;
 
 METRIC_DECLARE_entity(tablet);
 
+DECLARE_int32(consensus_max_in_flight_requests_per_peer);
+
 namespace yb {
 namespace consensus {
 
@@ -76,6 +78,96 @@ const char* kTabletId = "test-peers-tablet";
 const char* kLeaderUuid = "peer-0";
 const char* kFollowerUuid = "peer-1";
 
+// Simulates a follower that holds update requests until they are explicitly answered, so several
+// requests could be in flight at the same time.
+class HeldUpdatesPeerProxy : public PeerProxy {
+ public:
+  explicit HeldUpdatesPeerProxy(ThreadPool* pool) : pool_(pool) {}
+
+  void UpdateAsync(const LWConsensusRequestPB* request,
+                   RequestTriggerMode trigger_mode,
+                   LWConsensusResponsePB* response,
+                   rpc::RpcController* controller,
+                   const rpc::ResponseCallback& callback) override {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    held_updates_.push_back(HeldUpdate {
+      .request = request,
+      .response = response,
+      .callback = callback,
+    });
+  }
+
+  void RequestConsensusVoteAsync(const VoteRequestPB* request,
+                                 VoteResponsePB* response,
+                                 rpc::RpcController* controller,
+                                 const rpc::ResponseCallback& callback) override {
+    LOG(DFATAL) << "Not implemented";
+  }
+
+  size_t num_held_updates() const {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    return held_updates_.size();
+  }
+
+  // Returns the number of held requests that were marked as pipelined by the leader.
+  size_t num_held_pipelined_updates() const {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    return std::count_if(held_updates_.begin(), held_updates_.end(), [](const auto& update) {
+      return update.request->pipelined();
+    });
+  }
+
+  OpId last_received() const {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    return last_received_;
+  }
+
+  // Processes held requests in order they were sent, and answers them in reverse order.
+  void RespondToAll() {
+    std::vector<rpc::ResponseCallback> callbacks;
+    {
+      std::lock_guard<simple_spinlock> lock(lock_);
+      for (const auto& update : held_updates_) {
+        ProcessUpdateUnlocked(*update.request, update.response);
+        callbacks.push_back(update.callback);
+      }
+      held_updates_.clear();
+    }
+    for (auto it = callbacks.rbegin(); it != callbacks.rend(); ++it) {
+      WARN_NOT_OK(pool_->SubmitFunc(*it), "Submit failed");
+    }
+  }
+
+ private:
+  struct HeldUpdate {
+    const LWConsensusRequestPB* request;
+    LWConsensusResponsePB* response;
+    rpc::ResponseCallback callback;
+  };
+
+  void ProcessUpdateUnlocked(
+      const LWConsensusRequestPB& request, LWConsensusResponsePB* response) REQUIRES(lock_) {
+    response->Clear();
+    if (last_received_ < OpId::FromPB(request.preceding_id())) {
+      auto* error = response->mutable_status()->mutable_error();
+      error->set_code(ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH);
+      StatusToPB(STATUS(IllegalState, ""), error->mutable_status());
+    } else if (!request.ops().empty()) {
+      last_received_ = std::max(last_received_, OpId::FromPB(request.ops().back().id()));
+    }
+    response->ref_responder_uuid(kFollowerUuid);
+    response->set_responder_term(request.caller_term());
+    last_received_.ToPB(response->mutable_status()->mutable_last_received());
+    last_received_.ToPB(response->mutable_status()->mutable_last_received_current_leader());
+    response->mutable_status()->set_last_committed_idx(last_received_.index);
+  }
+
+  ThreadPool* const pool_;
+  mutable simple_spinlock lock_;
+  std::vector<HeldUpdate> held_updates_ GUARDED_BY(lock_);
+  OpId last_received_ GUARDED_BY(lock_);
+};
+
 class ConsensusPeersTest : public YBTest {
  public:
   ConsensusPeersTest()
@@ -414,5 +506,61 @@ TEST_F(ConsensusPeersTest, TestDontSendOneRpcPerWriteWhenPeerIsDown) {
   ASSERT_LT(mock_proxy->update_count() - initial_update_count, 5);
 }
 
+// Tests that several requests are sent to the same peer without waiting for responses, when
+// pipelining is enabled.
+TEST_F(ConsensusPeersTest, TestPipelinedRequests) {
+  constexpr size_t kNumInFlight = 3;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_consensus_max_in_flight_requests_per_peer) = kNumInFlight;
+
+  auto proxy = new HeldUpdatesPeerProxy(raft_pool_.get());
+  auto peer = ASSERT_RESULT(Peer::NewRemotePeer(
+      FakeRaftPeerPB(kFollowerUuid), kTabletId, kLeaderUuid, PeerProxyPtr(proxy),
+      message_queue_.get(), nullptr /* multi raft batcher */, raft_pool_token_.get(),
+      nullptr /* consensus */, messenger_.get()));
+
+  auto se = ScopeExit([&peer, proxy] {
+    peer->Close();
+    // Release requests that are still held, so they don't keep the peer alive.
+    proxy->RespondToAll();
+  });
+
+  // The first exchange negotiates the peer's position in the log, pipelining starts after it.
+  AppendReplicateMessagesToQueue(message_queue_.get(), clock_, 1, 1);
+  ASSERT_OK(peer->SignalRequest(RequestTriggerMode::kAlwaysSend));
+  ASSERT_OK(WaitFor([proxy] {
+    proxy->RespondToAll();
+    return proxy->last_received().index == 1;
+  }, 10s, "Replicate first operation"));
+  consensus_->WaitForMajorityReplicatedIndex(1);
+  ASSERT_OK(WaitFor([proxy] {
+    proxy->RespondToAll();
+    return proxy->num_held_updates() == 0;
+  }, 10s, "Complete first exchange"));
+
+  // Each new operation is sent in its own request, while previous requests are not answered yet.
+  int64_t last_index = 1;
+  for (size_t i = 1; i <= kNumInFlight; ++i) {
+    AppendReplicateMessagesToQueue(message_queue_.get(), clock_, ++last_index, 1);
+    ASSERT_OK(WaitFor([&peer, proxy, i]() -> Result<bool> {
+      RETURN_NOT_OK(peer->SignalRequest(RequestTriggerMode::kNonEmptyOnly));
+      return proxy->num_held_updates() >= i;
+    }, 10s, Format("Send request $0", i)));
+  }
+  ASSERT_EQ(proxy->num_held_updates(), kNumInFlight);
+  ASSERT_EQ(proxy->num_held_pipelined_updates(), kNumInFlight - 1);
+
+  // No more requests are sent, when the limit is reached.
+  AppendReplicateMessagesToQueue(message_queue_.get(), clock_, ++last_index, 1);
+  ASSERT_OK(peer->SignalRequest(RequestTriggerMode::kNonEmptyOnly));
+  std::this_thread::sleep_for(100ms);
+  ASSERT_EQ(proxy->num_held_updates(), kNumInFlight);
+
+  ASSERT_OK(WaitFor([proxy, last_index] {
+    proxy->RespondToAll();
+    return proxy->last_received().index == last_index;
+  }, 10s, "Replicate all operations"));
+  consensus_->WaitForMajorityReplicatedIndex(last_index);
+}
+
 }  // namespace consensus
 }  // namespace yb
@@ -67,6 +67,7 @@
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_callback.h"
 #include "yb/util/status_format.h"
+#include "yb/util/status_log.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/tsan_util.h"
 
@@ -84,6 +85,7 @@ DEFINE_UNKNOWN_int32(max_wait_for_processresponse_before_closing_ms,
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
 DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_int32(consensus_max_in_flight_requests_per_peer);
 
 DECLARE_bool(enable_multi_raft_heartbeat_batcher);
 
@@ -116,6 +118,16 @@ using rpc::PeriodicTimer;
 using rpc::RpcController;
 using strings::Substitute;
 
+// State of a pipelined request, it is kept alive until its response is processed. Several such
+// requests could be in flight at the same time, in addition to the regular one.
+struct Peer::PipelinedRequest {
+  ThreadSafeArena arena;
+  LWConsensusRequestPB* request = arena.NewObject<LWConsensusRequestPB>(&arena);
+  LWConsensusResponsePB* response = arena.NewObject<LWConsensusResponsePB>(&arena);
+  LWReplicateMsgsHolder msgs_holder;
+  rpc::RpcController controller;
+};
+
 Peer::Peer(
     const RaftPeerPB& peer_pb, string tablet_id, string leader_uuid, PeerProxyPtr proxy,
     PeerMessageQueue* queue, MultiRaftHeartbeatBatcherPtr multi_raft_batcher,
@@ -159,6 +171,9 @@ Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
   // If there are new requests in the queue we'll get them on ProcessResponse().
   auto performing_update_lock = LockPerformingUpdate(std::try_to_lock);
   if (!performing_update_lock.owns_lock()) {
+    if (trigger_mode == RequestTriggerMode::kNonEmptyOnly) {
+      return MaybeSendPipelinedRequest();
+    }
     return Status::OK();
   }
 
@@ -358,6 +373,93 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
                       std::bind(&Peer::ProcessResponse, retain_self));
 }
 
+Status Peer::MaybeSendPipelinedRequest() {
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock()) {
+      return STATUS(IllegalState, "Peer was closed.");
+    }
+
+    // The regular request is also in flight, so it is counted against the limit too.
+    // After an error, requests are sent one by one until the exchange with the peer succeeds.
+    if (state_ != kPeerRunning || failed_attempts_ > 0 ||
+        num_pipelined_requests_ + 1 >= FLAGS_consensus_max_in_flight_requests_per_peer) {
+      return Status::OK();
+    }
+
+    ++num_pipelined_requests_;
+    using_thread_pool_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  auto status = raft_pool_token_->SubmitFunc(
+      std::bind(&Peer::SendPipelinedRequest, shared_from_this()));
+  using_thread_pool_.fetch_sub(1, std::memory_order_acq_rel);
+  if (!status.ok()) {
+    std::lock_guard<simple_spinlock> lock(peer_lock_);
+    --num_pipelined_requests_;
+  }
+  return status;
+}
+
+void Peer::SendPipelinedRequest() {
+  auto retain_self = shared_from_this();
+
+  auto processing_lock = StartProcessingUnlocked();
+  if (!processing_lock.owns_lock()) {
+    return;
+  }
+
+  auto data = std::make_shared<PipelinedRequest>();
+  auto sent = queue_->PipelinedRequestForPeer(
+      peer_pb_.permanent_uuid(), data->request, &data->msgs_holder);
+  if (!sent.ok() || !*sent) {
+    LOG_IF_WITH_PREFIX(INFO, !sent.ok())
+        << "Could not obtain pipelined request from queue for peer: " << sent.status();
+    --num_pipelined_requests_;
+    return;
+  }
+
+  data->request->ref_tablet_id(tablet_id_);
+  data->request->ref_caller_uuid(leader_uuid_);
+  data->request->ref_dest_uuid(peer_pb_.permanent_uuid());
+
+  heartbeater_->Snooze();
+
+  MAYBE_FAULT(FLAGS_TEST_fault_crash_on_leader_request_fraction);
+
+  // See comment in SendNextRequest.
+  minimum_viable_heartbeat_ = cur_heartbeat_id_ + 1;
+  processing_lock.unlock();
+  data->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  proxy_->UpdateAsync(
+      data->request, RequestTriggerMode::kNonEmptyOnly, data->response, &data->controller,
+      [retain_self, data] {
+    retain_self->ProcessPipelinedResponse(data.get());
+  });
+}
+
+void Peer::ProcessPipelinedResponse(PipelinedRequest* request) {
+  auto status = request->controller.status();
+  if (status.ok()) {
+    status = request->controller.thread_pool_failure();
+  }
+  request->controller.Reset();
+
+  bool more_pending;
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock()) {
+      return;
+    }
+    --num_pipelined_requests_;
+    more_pending = ProcessResponseWithStatus(status, request->response, /* pipelined= */ true);
+  }
+
+  if (more_pending) {
+    WARN_NOT_OK(SignalRequest(RequestTriggerMode::kNonEmptyOnly),
+                "Failed to send request after pipelined response");
+  }
+}
+
 std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
   std::unique_lock<simple_spinlock> lock(peer_lock_);
 
@@ -369,7 +471,8 @@ std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
 }
 
 bool Peer::ProcessResponseWithStatus(const Status& status,
-                                     LWConsensusResponsePB* response) {
+                                     LWConsensusResponsePB* response,
+                                     bool pipelined) {
   if (!status.ok()) {
     if (status.IsRemoteError()) {
       // Most controller errors are caused by network issues or corner cases like shutdown and
@@ -379,7 +482,7 @@ bool Peer::ProcessResponseWithStatus(const Status& status,
       // remote is responsive.
       queue_->NotifyPeerIsResponsiveDespiteError(peer_pb_.permanent_uuid());
     }
-    ProcessResponseError(status);
+    ProcessResponseError(status, pipelined);
     return false;
   }
 
@@ -395,7 +498,7 @@ bool Peer::ProcessResponseWithStatus(const Status& status,
         Substitute("Leader communication with peer $0 received error $1, will try to "
                    "evict peer", peer_pb_.permanent_uuid(),
                    response->error().ShortDebugString()));
-    ProcessResponseError(StatusFromPB(response->error().status()));
+    ProcessResponseError(StatusFromPB(response->error().status()), pipelined);
     return false;
   }
 
@@ -412,7 +515,7 @@ bool Peer::ProcessResponseWithStatus(const Status& status,
         peer_pb_.permanent_uuid(),
         Format("Tablet in peer $0 is in FAILED state, will try to evict peer",
                peer_pb_.permanent_uuid()));
-    ProcessResponseError(StatusFromPB(response->error().status()));
+    ProcessResponseError(StatusFromPB(response->error().status()), pipelined);
   }
 
   // Response should be either error or status.
@@ -428,12 +531,12 @@ bool Peer::ProcessResponseWithStatus(const Status& status,
     // Again, let the queue know that the remote is still responsive, since we will not be sending
     // this error response through to the queue.
     queue_->NotifyPeerIsResponsiveDespiteError(peer_pb_.permanent_uuid());
-    ProcessResponseError(StatusFromPB(response->error().status()));
+    ProcessResponseError(StatusFromPB(response->error().status()), pipelined);
     return false;
   }
 
   failed_attempts_ = 0;
-  return queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), *response);
+  return queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), *response, pipelined);
 }
 
 void Peer::ProcessResponse() {
@@ -532,8 +635,12 @@ void Peer::ProcessRemoteBootstrapResponse() {
   }
 }
 
-void Peer::ProcessResponseError(const Status& status) {
-  DCHECK(performing_update_mutex_.is_locked() || performing_heartbeat_mutex_.is_locked());
+void Peer::ProcessResponseError(const Status& status, bool pipelined) {
+  DCHECK(pipelined || performing_update_mutex_.is_locked() ||
+         performing_heartbeat_mutex_.is_locked());
+  if (pipelined) {
+    queue_->PipelinedRequestFailed(peer_pb_.permanent_uuid());
+  }
   failed_attempts_++;
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(WARNING, 5) << "Couldn't send request. "
       << " Status: " << status.ToString() << ". Retrying in the next heartbeat period."
@@ -125,6 +125,11 @@ namespace consensus {
 //        v                               v
 //  SignalRequest()                    return
 //
+// When consensus_max_in_flight_requests_per_peer is greater than 1, SignalRequest() for a
+// non-empty queue while a request is being processed sends a pipelined request with operations
+// following the ones that are already in flight, up to the configured number of outstanding
+// requests. Responses to pipelined requests are processed by ProcessPipelinedResponse().
+//
 class Peer;
 typedef std::shared_ptr<Peer> PeerPtr;
 
@@ -180,8 +185,17 @@ class Peer : public std::enable_shared_from_this<Peer> {
   }
 
  private:
+  struct PipelinedRequest;
+
   void SendNextRequest(RequestTriggerMode trigger_mode);
 
+  // Schedules sending of a pipelined request if the number of outstanding requests allows it.
+  Status MaybeSendPipelinedRequest();
+
+  void SendPipelinedRequest();
+
+  void ProcessPipelinedResponse(PipelinedRequest* request);
+
   // Signals that a response was received from the peer. This method does response handling that
   // requires IO or may block.
   void ProcessResponse();
@@ -191,7 +205,8 @@ class Peer : public std::enable_shared_from_this<Peer> {
 
   // Returns true if there are more pending ops to process, false otherwise.
   bool ProcessResponseWithStatus(const Status& status,
-                                 LWConsensusResponsePB* response);
+                                 LWConsensusResponsePB* response,
+                                 bool pipelined = false);
 
   // Fetch the desired remote bootstrap request from the queue and send it to the peer. The callback
   // goes to ProcessRemoteBootstrapResponse().
@@ -204,7 +219,7 @@ class Peer : public std::enable_shared_from_this<Peer> {
   void ProcessRemoteBootstrapResponse();
 
   // Signals there was an error sending the request to the peer.
-  void ProcessResponseError(const Status& status);
+  void ProcessResponseError(const Status& status, bool pipelined = false);
 
   // Returns true if the peer is closed and the calling function should return.
   std::unique_lock<simple_spinlock> StartProcessingUnlocked();
@@ -291,6 +306,10 @@ class Peer : public std::enable_shared_from_this<Peer> {
   Consensus* consensus_ = nullptr;
   rpc::Messenger* messenger_ = nullptr;
   std::atomic<int> using_thread_pool_{0};
+
+  // Number of pipelined requests that are being assembled or are in flight. Protected by
+  // peer_lock_.
+  int num_pipelined_requests_ = 0;
 };
 
 // A proxy to another peer. Usually a thin wrapper around an rpc proxy but can be replaced for
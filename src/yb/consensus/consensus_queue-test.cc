@@ -57,6 +57,7 @@ using std::string;
 
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_uint64(consensus_max_batch_size_bytes);
+DECLARE_int32(consensus_max_in_flight_requests_per_peer);
 
 METRIC_DECLARE_entity(tablet);
 
@@ -361,6 +362,85 @@ TEST_F(ConsensusQueueTest, TestGetPagedMessages) {
   ASSERT_FALSE(queue_->ResponseFromPeer(response.responder_uuid().ToBuffer(), response));
 }
 
+// Tests that pipelined requests continue after the operations that are already in flight, and
+// that responses received out of order don't move the peer's watermark back.
+TEST_F(ConsensusQueueTest, TestPipelinedRequests) {
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+
+  google::FlagSaver saver;
+  FLAGS_consensus_max_in_flight_requests_per_peer = 3;
+
+  ThreadSafeArena arena;
+  {
+    auto& request = *arena.NewObject<LWConsensusRequestPB>(&arena);
+    auto& response = *arena.NewObject<LWConsensusResponsePB>(&arena);
+    response.ref_responder_uuid(kPeerUuid);
+    ASSERT_TRUE(UpdatePeerWatermarkToOp(&request, &response, OpId::Min(), OpId::Min()));
+  }
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 100);
+
+  auto new_request = [&arena] {
+    return arena.NewObject<LWConsensusRequestPB>(&arena);
+  };
+  auto respond = [this, &arena](const LWConsensusRequestPB& request, bool pipelined) {
+    auto& response = *arena.NewObject<LWConsensusResponsePB>(&arena);
+    response.ref_responder_uuid(kPeerUuid);
+    SetLastReceivedAndLastCommitted(&response, OpId::FromPB(request.ops().back().id()));
+    return queue_->ResponseFromPeer(kPeerUuid, response, pipelined);
+  };
+
+  bool needs_remote_bootstrap;
+  LWReplicateMsgsHolder refs[4];
+
+  // Nothing is pipelined until the first successful exchange with the peer.
+  auto* first = new_request();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, first, &refs[0], &needs_remote_bootstrap));
+  ASSERT_EQ(100, first->ops().size());
+  ASSERT_FALSE(ASSERT_RESULT(queue_->PipelinedRequestForPeer(kPeerUuid, new_request(), &refs[1])));
+  ASSERT_FALSE(respond(*first, /* pipelined= */ false));
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 101, 30);
+
+  // Limit each request to about 10 operations.
+  FLAGS_consensus_max_batch_size_bytes = first->SerializedSize() / 10;
+
+  auto* regular = new_request();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, regular, &refs[0], &needs_remote_bootstrap));
+  ASSERT_EQ(101, regular->ops().front().id().index());
+  auto last_index = regular->ops().back().id().index();
+
+  auto* pipelined1 = new_request();
+  ASSERT_TRUE(ASSERT_RESULT(queue_->PipelinedRequestForPeer(kPeerUuid, pipelined1, &refs[1])));
+  ASSERT_EQ(last_index + 1, pipelined1->ops().front().id().index());
+  ASSERT_EQ(last_index, pipelined1->preceding_id().index());
+  ASSERT_FALSE(pipelined1->has_ht_lease_expiration());
+  last_index = pipelined1->ops().back().id().index();
+
+  auto* pipelined2 = new_request();
+  ASSERT_TRUE(ASSERT_RESULT(queue_->PipelinedRequestForPeer(kPeerUuid, pipelined2, &refs[2])));
+  ASSERT_EQ(last_index + 1, pipelined2->ops().front().id().index());
+  last_index = pipelined2->ops().back().id().index();
+
+  // Responses are received in reverse order.
+  ASSERT_EQ(last_index < 130, respond(*pipelined2, /* pipelined= */ true));
+  ASSERT_FALSE(respond(*pipelined1, /* pipelined= */ true));
+  respond(*regular, /* pipelined= */ false);
+  ASSERT_EQ(last_index, queue_->GetTrackedPeerForTests(kPeerUuid).last_received.index);
+
+  // The next regular request continues after the last acked operation.
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 131, 10);
+  auto* next = new_request();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, next, &refs[3], &needs_remote_bootstrap));
+  ASSERT_EQ(last_index + 1, next->ops().front().id().index());
+
+  // After a failure, operations are resent starting from the last acked one.
+  queue_->PipelinedRequestFailed(kPeerUuid);
+  ASSERT_FALSE(ASSERT_RESULT(queue_->PipelinedRequestForPeer(kPeerUuid, new_request(), &refs[1])));
+}
+
 TEST_F(ConsensusQueueTest, TestPeersDontAckBeyondWatermarks) {
   queue_->Init(OpId::Min());
   queue_->SetLeaderMode(
@@ -107,6 +107,12 @@ DEFINE_RUNTIME_bool(enable_consensus_exponential_backoff, true,
     "for number of entries to replicate to lagging follower is enabled.");
 TAG_FLAG(enable_consensus_exponential_backoff, advanced);
 
+DEFINE_RUNTIME_int32(consensus_max_in_flight_requests_per_peer, 1,
+    "Maximal number of UpdateConsensus requests with operations that the leader could have in "
+    "flight to a single peer. When greater than 1, new operations are sent to a follower without "
+    "waiting for the response to the previous request. 1 disables pipelining.");
+TAG_FLAG(consensus_max_in_flight_requests_per_peer, advanced);
+
 DEFINE_RUNTIME_int32(consensus_lagging_follower_threshold, 10,
     "Number of retransmissions at tablet leader to mark a follower as lagging. "
     "-1 disables the feature.");
@@ -186,10 +192,10 @@ std::string PeerMessageQueue::TrackedPeer::ToString() const {
   return Format(
       "{ peer: $0 is_new: $1 last_received: $2 next_index: $3 last_known_committed_idx: $4 "
       "is_last_exchange_successful: $5 needs_remote_bootstrap: $6 member_type: $7 "
-      "num_sst_files: $8 last_applied: $9 }",
+      "num_sst_files: $8 last_applied: $9 last_sent_index: $10 }",
       uuid, is_new, last_received, next_index, last_known_committed_idx,
       is_last_exchange_successful, needs_remote_bootstrap, PeerMemberType_Name(member_type),
-      num_sst_files, last_applied);
+      num_sst_files, last_applied, last_sent_index);
 }
 
 void PeerMessageQueue::TrackedPeer::ResetLeaderLeases() {
@@ -476,6 +482,10 @@ uint64_t GetNumMessagesToSendWithBackoff(int64_t last_num_messages_sent) {
   return std::max<int64_t>((last_num_messages_sent >> 1) - 1, 0);
 }
 
+bool PipeliningEnabled() {
+  return FLAGS_consensus_max_in_flight_requests_per_peer > 1;
+}
+
 Status PeerMessageQueue::RequestForPeer(const string& uuid,
                                         LWConsensusRequestPB* request,
                                         LWReplicateMsgsHolder* msgs_holder,
@@ -583,6 +593,14 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     *needs_remote_bootstrap = peer->needs_remote_bootstrap;
 
     previously_sent_index = peer->next_index - 1;
+    if (peer->last_num_messages_sent >= 0 || is_new) {
+      // Previous request was not acked, so pipelined requests sent after it are also lost.
+      peer->last_sent_index = kInvalidOpIdIndex;
+    } else if (PipeliningEnabled() && peer->last_sent_index > previously_sent_index) {
+      // Operations up to last_sent_index are already in flight, continue after them.
+      previously_sent_index = peer->last_sent_index;
+      request->set_pipelined(true);
+    }
     if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
       // Previous request to peer has not been acked. Reduce number of entries to be sent
       // in this attempt using exponential backoff. Note that to_index is inclusive.
@@ -662,6 +680,8 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       }
 
       peer->last_num_messages_sent = result->messages.size();
+      peer->last_sent_index = result->messages.empty()
+          ? previously_sent_index : result->messages.back()->id().index();
     }
 
     ScopedTrackedConsumption consumption;
@@ -715,6 +735,97 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   return Status::OK();
 }
 
+Result<bool> PeerMessageQueue::PipelinedRequestForPeer(
+    const std::string& uuid, LWConsensusRequestPB* request, LWReplicateMsgsHolder* msgs_holder) {
+  DCHECK(request->ops().empty()) << request->ShortDebugString();
+
+  int64_t previously_sent_index;
+  {
+    LockGuard lock(queue_lock_);
+    auto peer = FindPtrOrNull(peers_map_, uuid);
+    if (PREDICT_FALSE(peer == nullptr || queue_state_.mode == Mode::NON_LEADER)) {
+      return STATUS(NotFound, "Peer not tracked or queue not in leader mode.");
+    }
+    if (!PipeliningEnabled() || peer->is_new || !peer->is_last_exchange_successful ||
+        peer->needs_remote_bootstrap || peer->last_sent_index < peer->next_index - 1 ||
+        !log_cache_.HasOpBeenWritten(peer->last_sent_index + 1)) {
+      return false;
+    }
+    previously_sent_index = peer->last_sent_index;
+  }
+
+  auto max_batch_size = FLAGS_consensus_max_batch_size_bytes - request->SerializedSize();
+  auto result = VERIFY_RESULT(ReadFromLogCache(
+      previously_sent_index, /* to_index= */ 0, max_batch_size, uuid));
+  if (result.messages.empty()) {
+    return false;
+  }
+
+  {
+    LockGuard lock(queue_lock_);
+    auto peer = FindPtrOrNull(peers_map_, uuid);
+    if (PREDICT_FALSE(peer == nullptr)) {
+      return STATUS(NotFound, "Peer not tracked.");
+    }
+    // Another request was assembled for this peer or the peer's state was reset meanwhile.
+    if (peer->last_sent_index != previously_sent_index || !peer->is_last_exchange_successful) {
+      return false;
+    }
+    peer->last_sent_index = result.messages.back()->id().index();
+
+    request->set_propagated_hybrid_time(clock_->Now().ToUint64());
+    // Same as in RequestForPeer, see comments there.
+    if (queue_state_.majority_replicated_op_id.index > queue_state_.committed_op_id.index &&
+        queue_state_.majority_replicated_op_id.term == queue_state_.current_term) {
+      queue_state_.majority_replicated_op_id.ToPB(request->mutable_committed_op_id());
+    } else {
+      queue_state_.committed_op_id.ToPB(request->mutable_committed_op_id());
+    }
+    request->set_caller_term(queue_state_.current_term);
+  }
+
+  request->set_pipelined(true);
+  // Pipelined requests don't carry leader leases, since lease expiration is tracked only for the
+  // last regular request sent to the peer.
+  request->clear_leader_lease_duration_ms();
+  request->clear_ht_lease_expiration();
+  request->clear_propagated_safe_time();
+
+  result.preceding_op.ToPB(request->mutable_preceding_id());
+  for (const auto& msg : result.messages) {
+    request->mutable_ops()->push_back_ref(msg.get());
+  }
+
+  const auto last_sent_op_id = OpId::FromPB(request->ops().rbegin()->id());
+  if (last_sent_op_id.index < request->committed_op_id().index()) {
+    last_sent_op_id.ToPB(request->mutable_committed_op_id());
+  }
+
+  ScopedTrackedConsumption consumption;
+  if (result.read_from_disk_size) {
+    consumption = ScopedTrackedConsumption(operations_mem_tracker_, result.read_from_disk_size);
+  }
+  *msgs_holder = LWReplicateMsgsHolder(std::move(result.messages), std::move(consumption));
+
+  VLOG_WITH_PREFIX(2) << "Sending pipelined request with operations to Peer: " << uuid
+      << ". Size: " << request->ops().size()
+      << ". From: " << request->ops().front().id().ShortDebugString() << ". To: "
+      << request->ops().back().id().ShortDebugString();
+
+  return true;
+}
+
+void PeerMessageQueue::PipelinedRequestFailed(const std::string& peer_uuid) {
+  LockGuard scoped_lock(queue_lock_);
+  TrackedPeer* peer = FindPtrOrNull(peers_map_, peer_uuid);
+  if (peer == nullptr) {
+    return;
+  }
+
+  // Operations after the last acked one should be sent again by the next regular request.
+  peer->last_sent_index = kInvalidOpIdIndex;
+}
+
 Result<ReadOpsResult> PeerMessageQueue::ReadFromLogCache(
     int64_t after_index, int64_t to_index, size_t max_batch_size, const std::string& peer_uuid,
     const CoarseTimePoint deadline, const bool fetch_single_entry) {
@@ -1208,7 +1319,8 @@ void PeerMessageQueue::RequestWasNotSent(const std::string& peer_uuid) {
 
 
 bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
-                                        const LWConsensusResponsePB& response) {
+                                        const LWConsensusResponsePB& response,
+                                        bool pipelined) {
   MajorityReplicatedData majority_replicated;
   Mode mode_copy;
   bool result = false;
@@ -1231,6 +1343,7 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
           << response.ShortDebugString();
 
       peer->needs_remote_bootstrap = true;
+      peer->last_sent_index = kInvalidOpIdIndex;
       // Since we received a response from the peer, we know it is alive. So we need to update
       // peer->last_successful_communication_time, otherwise, we will remove this peer from the
       // configuration if the remote bootstrap is not completed within
@@ -1261,7 +1374,10 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
     peer->is_new = false;
     peer->last_successful_communication_time = MonoTime::Now();
 
-    peer->ResetLastRequest();
+    // Retransmission tracking is related to the regular request only.
+    if (!pipelined) {
+      peer->ResetLastRequest();
+    }
 
     if (response.has_status()) {
       const auto& status = response.status();
@@ -1270,8 +1386,22 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       DCHECK(status.has_last_received_current_leader());
       DCHECK(status.has_last_committed_idx());
 
-      peer->last_known_committed_idx = status.last_committed_idx();
-      peer->last_applied = OpId::FromPB(status.last_applied());
+      // With pipelining, responses could be received out of order. The response to the earlier
+      // request does not contain anything new, and should not move peer's state back.
+      const bool stale = PipeliningEnabled() && !status.has_error() && !previous.is_new &&
+          std::max(status.last_received().index(),
+                   status.last_received_current_leader().index()) < peer->last_received.index;
+      if (stale) {
+        VLOG_WITH_PREFIX_UNLOCKED(2)
+            << "Stale response from peer: " << peer->ToString()
+            << ", response: " << response.ShortDebugString();
+        if (pipelined) {
+          return false;
+        }
+      } else {
+        peer->last_known_committed_idx = status.last_committed_idx();
+        peer->last_applied = OpId::FromPB(status.last_applied());
+      }
 
       // If the reported last-received op for the replica is in our local log, then resume sending
       // entries from that point onward. Otherwise, resume after the last op they received from us.
@@ -1279,7 +1409,9 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       // log, which is guaranteed by the Raft protocol to be a valid op.
 
       bool peer_has_prefix_of_log = IsOpInLog(OpId::FromPB(status.last_received()));
-      if (peer_has_prefix_of_log) {
+      if (stale) {
+        // Keep the state from the newer response.
+      } else if (peer_has_prefix_of_log) {
         // If the latest thing in their log is in our log, we are in sync.
         peer->last_received = OpId::FromPB(status.last_received());
         peer->next_index = peer->last_received.index + 1;
@@ -1302,6 +1434,7 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
       if (PREDICT_FALSE(status.has_error())) {
         peer->is_last_exchange_successful = false;
+        peer->last_sent_index = kInvalidOpIdIndex;
         switch (status.error().code()) {
           case ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH: {
             DCHECK(status.has_last_received());
@@ -1351,7 +1484,8 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
     // If our log has the next request for the peer or if the peer's committed index is lower than
     // our own, set 'more_pending' to true.
-    result = log_cache_.HasOpBeenWritten(peer->next_index) ||
+    // Operations that are already in flight to the peer are not considered pending.
+    result = log_cache_.HasOpBeenWritten(std::max(peer->next_index, peer->last_sent_index + 1)) ||
         (peer->last_known_committed_idx < queue_state_.committed_op_id.index);
 
     mode_copy = queue_state_.mode;
@@ -1365,8 +1499,11 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
         }
       }
 
-      peer->leader_lease_expiration.OnReplyFromFollower();
-      peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      // Leases are sent only in regular requests, so pipelined responses should not extend them.
+      if (!pipelined) {
+        peer->leader_lease_expiration.OnReplyFromFollower();
+        peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      }
 
       majority_replicated.op_id = queue_state_.majority_replicated_op_id;
       majority_replicated.leader_lease_expiration = LeaderLeaseExpirationWatermark();
@@ -157,6 +157,11 @@ class PeerMessageQueue {
     // Number of retransmissions from same next_index_.
     int64_t current_retransmissions = -1;
 
+    // Index of the last operation sent to the peer, that could be not acked yet. Pipelined
+    // requests continue sending operations after it. kInvalidOpIdIndex when unknown, e.g. after
+    // a failed request, in which case sending restarts from next_index.
+    int64_t last_sent_index = kInvalidOpIdIndex;
+
     // The last operation that we've sent to this peer and that it acked. Used for watermark
     // movement.
     OpId last_received = yb::OpId::Min();
@@ -299,6 +304,17 @@ class PeerMessageQueue {
       PeerMemberType* member_type = nullptr,
       bool* last_exchange_successful = nullptr);
 
+  // Assembles a request with operations following the ones that were already sent to the peer,
+  // while the previous requests are still in flight. See
+  // consensus_max_in_flight_requests_per_peer.
+  //
+  // Returns false if there is nothing to send or the peer's state does not allow pipelining, e.g.
+  // the last exchange with it failed. Pipelined requests do not extend leader leases.
+  Result<bool> PipelinedRequestForPeer(
+      const std::string& uuid,
+      LWConsensusRequestPB* request,
+      LWReplicateMsgsHolder* msgs_holder);
+
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
   // peer->needs_remote_bootstrap to false.
@@ -317,12 +333,18 @@ class PeerMessageQueue {
   void NotifyPeerIsResponsiveDespiteError(const std::string& peer_uuid);
 
   // Updates the request queue with the latest response of a peer, returns whether this peer has
-  // more requests pending.
+  // more requests pending. pipelined should be true for responses to requests assembled by
+  // PipelinedRequestForPeer().
   virtual bool ResponseFromPeer(const std::string& peer_uuid,
-                                const LWConsensusResponsePB& response);
+                                const LWConsensusResponsePB& response,
+                                bool pipelined = false);
 
   void RequestWasNotSent(const std::string& peer_uuid);
 
+  // Notifies the queue that a pipelined request to the peer failed, so operations sent after the
+  // last acked one should be sent again.
+  void PipelinedRequestFailed(const std::string& peer_uuid);
+
   // Closes the queue, peers are still allowed to call UntrackPeer() and ResponseFromPeer() but no
   // additional peers can be tracked or messages queued.
   virtual void Close();
@@ -63,6 +63,9 @@ DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
 DECLARE_int32(o_direct_block_size_bytes);
+DECLARE_int32(log_entry_batch_compression_algo);
+DECLARE_bool(log_entry_batch_compression_supported);
+DECLARE_uint64(log_entry_batch_compression_min_size);
 
 namespace yb {
 namespace log {
@@ -906,6 +909,36 @@ TEST_F(LogTest, TestWriteManyBatches) {
   }
 }
 
+// Writes batches compressed with every supported codec into the same segment and reads them back.
+TEST_F(LogTest, CompressedEntryBatches) {
+  constexpr int kNumBatches = 30;
+  constexpr int kEntriesPerBatch = 10;
+  FLAGS_log_entry_batch_compression_min_size = 0;
+  FLAGS_log_entry_batch_compression_supported = true;
+  BuildLog();
+
+  OpIdPB op_id = MakeOpId(1, 1);
+  for (int i = 0; i != kNumBatches; ++i) {
+    FLAGS_log_entry_batch_compression_algo = i % kLogEntryBatchCodecMapSize;
+    ASSERT_OK(AppendNoOpsToLogSync(clock_, log_.get(), &op_id, kEntriesPerBatch));
+  }
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  int64_t expected_index = 1;
+  for (const auto& segment : segments) {
+    auto read_entries = segment->ReadEntries();
+    ASSERT_OK(read_entries.status);
+    for (const auto& entry : read_entries.entries) {
+      ASSERT_TRUE(entry->has_replicate());
+      ASSERT_EQ(entry->replicate().id().index(), expected_index);
+      ++expected_index;
+    }
+  }
+  ASSERT_EQ(expected_index, kNumBatches * kEntriesPerBatch + 1);
+}
+
 // This tests that querying LogReader works.
 // This sets up a reader with some segments to query which amount to the
 // following:
@@ -49,6 +49,7 @@
 
 #include "yb/consensus/consensus_util.h"
 #include "yb/consensus/log.messages.h"
+#include "yb/consensus/log_group_commit.h"
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
@@ -169,6 +170,16 @@ TAG_FLAG(log_inject_latency_ms_stddev, unsafe);
 DEFINE_UNKNOWN_int32(log_inject_append_latency_ms_max, 0,
              "The maximum latency to inject before the log append operation.");
 
+DEFINE_NON_RUNTIME_uint64(log_group_commit_window_us, 0,
+    "When durable_wal_write is on and this is non-zero, WAL syncs of all tablets whose WALs "
+    "reside on the same file system are coalesced into a single file system sync, waiting up "
+    "to this number of microseconds for other tablets to join the group. WAL segments are "
+    "written with buffered IO in this mode. The file system sync flushes all dirty data of the "
+    "file system, including SST files and WALs of idle tablets, so it is only intended for "
+    "dedicated WAL drives. Requires Linux 5.8+, where syncfs reports writeback errors; on older "
+    "kernels group commit is not turned on and each WAL segment is synced separately. "
+    "0 disables group commit.");
+
 DEFINE_test_flag(bool, log_consider_all_ops_safe, false,
             "If true, we consider all operations to be safe and will not wait"
             "for the opId to apply to the local log. i.e. WaitForSafeOpIdToApply "
@@ -667,6 +678,18 @@ Status Log::Init() {
 
   if (durable_wal_write_) {
     YB_LOG_FIRST_N(INFO, 1) << "durable_wal_write is turned on.";
+    if (FLAGS_log_group_commit_window_us > 0) {
+      auto committer = LogGroupCommitter::ForDirectory(
+          wal_dir_, MonoDelta::FromMicroseconds(FLAGS_log_group_commit_window_us));
+      if (committer.ok()) {
+        group_committer_ = std::move(*committer);
+        YB_LOG_FIRST_N(INFO, 1) << "WAL group commit is turned on, window: "
+                                << FLAGS_log_group_commit_window_us << " us.";
+      } else {
+        YB_LOG_FIRST_N(WARNING, 1) << "Failed to turn on WAL group commit: "
+                                   << committer.status();
+      }
+    }
   } else if (interval_durable_wal_write_) {
     YB_LOG_FIRST_N(INFO, 1) << "interval_durable_wal_write_ms is turned on to sync every "
                             << interval_durable_wal_write_.ToMilliseconds() << " ms.";
@@ -1000,7 +1023,8 @@ Status Log::DoSync() {
   LOG_SLOW_EXECUTION_EVERY_N_SECS(INFO, /* log at most one slow execution every 1 sec */ 1,
                                   50, "Fsync log took a long time") {
     SCOPED_LATENCY_METRIC(metrics_, sync_latency);
-    status = active_segment_->Sync();
+    // Data of buffered segment is already in the OS, so it is enough to sync the file system.
+    status = group_committer_ ? group_committer_->Sync() : active_segment_->Sync();
   }
 
   return status;
@@ -1677,7 +1701,8 @@ WritableFileOptions Log::GetNewSegmentWritableFileOptions() {
   WritableFileOptions opts;
   // We always want to sync on close: https://github.com/yugabyte/yugabyte-db/issues/3490
   opts.sync_on_close = true;
-  opts.o_direct = durable_wal_write_;
+  // Group commit relies on file system sync, so it could not be combined with direct IO.
+  opts.o_direct = durable_wal_write_ && !group_committer_;
   return opts;
 }
 
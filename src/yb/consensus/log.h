@@ -567,6 +567,10 @@ class Log : public RefCountedThreadSafe<Log> {
   // If true, sync on all appends.
   bool durable_wal_write_;
 
+  // If set, syncs on durable_wal_write_ are coalesced with WALs of other tablets on the same
+  // file system.
+  std::shared_ptr<LogGroupCommitter> group_committer_;
+
   // If non-zero, sync every interval of time.
   MonoDelta interval_durable_wal_write_;
 
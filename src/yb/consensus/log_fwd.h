@@ -27,6 +27,7 @@ class LogAnchorRegistry;
 using LogPtr = scoped_refptr<Log>;
 class LogEntryBatchPB;
 class LogEntryPB;
+class LogGroupCommitter;
 class LogIndex;
 class LogReader;
 class LogSegmentFooterPB;
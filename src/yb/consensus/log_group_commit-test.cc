@@ -0,0 +1,178 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/log_group_commit.h"
+
+#include "yb/util/countdown_latch.h"
+#include "yb/util/path_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_thread_holder.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace log {
+
+class LogGroupCommitTest : public YBTest {
+};
+
+// Checks that each Sync call is covered by a sync that was started after the call, and that
+// concurrent calls are coalesced.
+TEST_F(LogGroupCommitTest, Coalesce) {
+  constexpr int kThreads = 16;
+  constexpr int kSyncsPerThread = 50;
+
+  // Number of writes performed, and number of writes that were made durable.
+  std::atomic<uint64_t> written{0};
+  std::atomic<uint64_t> durable{0};
+  LogGroupCommitter committer("test", MonoDelta::FromMicroseconds(200), [&]() -> Status {
+    auto snapshot = written.load();
+    SleepFor(MonoDelta::FromMilliseconds(1));
+    durable = snapshot;
+    return Status::OK();
+  });
+
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kThreads; ++i) {
+    thread_holder.AddThreadFunctor([&] {
+      for (int j = 0; j != kSyncsPerThread; ++j) {
+        auto write = ++written;
+        ASSERT_OK(committer.Sync());
+        ASSERT_GE(durable.load(), write);
+      }
+    });
+  }
+  thread_holder.JoinAll();
+
+  LOG(INFO) << "Syncs: " << committer.num_syncs() << ", calls: " << kThreads * kSyncsPerThread;
+  ASSERT_LT(committer.num_syncs(), kThreads * kSyncsPerThread);
+}
+
+TEST_F(LogGroupCommitTest, Failure) {
+  bool fail = true;
+  LogGroupCommitter committer("test", MonoDelta(), [&]() -> Status {
+    if (fail) {
+      return STATUS(IOError, "Injected failure");
+    }
+    return Status::OK();
+  });
+  ASSERT_NOK(committer.Sync());
+  fail = false;
+  ASSERT_OK(committer.Sync());
+  ASSERT_EQ(committer.num_syncs(), 2);
+}
+
+// Checks that each caller gets status of the sync that covered it, even when the next sync
+// fails before the caller observes the result.
+TEST_F(LogGroupCommitTest, FailureAttributedToGroup) {
+  CountDownLatch first_sync_started(1);
+  CountDownLatch first_sync_allowed(1);
+  std::atomic<int> syncs{0};
+  LogGroupCommitter committer("test", MonoDelta(), [&]() -> Status {
+    switch (++syncs) {
+      case 1:
+        first_sync_started.CountDown();
+        first_sync_allowed.Wait();
+        return Status::OK();
+      case 2:
+        return STATUS(IOError, "Injected failure");
+      default:
+        return Status::OK();
+    }
+  });
+
+  TestThreadHolder thread_holder;
+  thread_holder.AddThreadFunctor([&committer] {
+    ASSERT_OK(committer.Sync());
+  });
+  first_sync_started.Wait();
+  // Callers that arrived while the first sync is in progress are covered by the second one.
+  constexpr int kWaiters = 4;
+  for (int i = 0; i != kWaiters; ++i) {
+    thread_holder.AddThreadFunctor([&committer] {
+      ASSERT_NOK(committer.Sync());
+    });
+  }
+  SleepFor(MonoDelta::FromMilliseconds(100));
+  first_sync_allowed.CountDown();
+  thread_holder.JoinAll();
+
+  ASSERT_OK(committer.Sync());
+  ASSERT_EQ(committer.num_syncs(), 3);
+}
+
+// Checks that callers that got success are not affected by concurrent failed syncs.
+TEST_F(LogGroupCommitTest, InterleavedFailures) {
+  constexpr int kThreads = 8;
+  constexpr int kSyncsPerThread = 50;
+
+  std::atomic<uint64_t> written{0};
+  std::atomic<uint64_t> durable{0};
+  std::atomic<int> syncs{0};
+  LogGroupCommitter committer("test", MonoDelta::FromMicroseconds(100), [&]() -> Status {
+    auto snapshot = written.load();
+    // Every other sync fails, so only successful syncs make data durable.
+    if (++syncs % 2 == 0) {
+      return STATUS(IOError, "Injected failure");
+    }
+    durable = snapshot;
+    return Status::OK();
+  });
+
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kThreads; ++i) {
+    thread_holder.AddThreadFunctor([&] {
+      for (int j = 0; j != kSyncsPerThread; ++j) {
+        auto write = ++written;
+        if (committer.Sync().ok()) {
+          ASSERT_GE(durable.load(), write);
+        }
+      }
+    });
+  }
+  thread_holder.JoinAll();
+}
+
+TEST_F(LogGroupCommitTest, SyncfsReportsWritebackErrors) {
+  ASSERT_FALSE(SyncfsReportsWritebackErrors("3.10.0-1160.el7.x86_64"));
+  ASSERT_FALSE(SyncfsReportsWritebackErrors("4.18.0-348.el8.x86_64"));
+  ASSERT_FALSE(SyncfsReportsWritebackErrors("5.4.0-150-generic"));
+  ASSERT_FALSE(SyncfsReportsWritebackErrors("5.7.19"));
+  ASSERT_TRUE(SyncfsReportsWritebackErrors("5.8.0"));
+  ASSERT_TRUE(SyncfsReportsWritebackErrors("5.15.0-91-generic"));
+  ASSERT_TRUE(SyncfsReportsWritebackErrors("6.1.0"));
+  ASSERT_FALSE(SyncfsReportsWritebackErrors(""));
+  ASSERT_FALSE(SyncfsReportsWritebackErrors("unknown"));
+}
+
+#if defined(__linux__)
+TEST_F(LogGroupCommitTest, ForDirectory) {
+  auto dir = GetTestDataDirectory();
+  auto committer_result = LogGroupCommitter::ForDirectory(dir, MonoDelta());
+  if (!committer_result.ok() && committer_result.status().IsNotSupported()) {
+    GTEST_SKIP() << committer_result.status();
+  }
+  auto committer = ASSERT_RESULT(std::move(committer_result));
+  // Directories on the same file system share committer.
+  auto other = ASSERT_RESULT(LogGroupCommitter::ForDirectory(DirName(dir), MonoDelta()));
+  ASSERT_EQ(committer, other);
+  ASSERT_OK(committer->Sync());
+  ASSERT_EQ(committer->num_syncs(), 1);
+}
+#endif
+
+}  // namespace log
+}  // namespace yb
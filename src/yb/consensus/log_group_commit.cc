@@ -0,0 +1,142 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_group_commit.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include <sstream>
+#include <unordered_map>
+
+#include "yb/util/errno.h"
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/status_format.h"
+#include "yb/util/thread_restrictions.h"
+
+DECLARE_bool(never_fsync);
+
+namespace yb {
+namespace log {
+
+LogGroupCommitter::LogGroupCommitter(
+    std::string name, MonoDelta window, SyncFunctor sync_functor)
+    : name_(std::move(name)), window_(window), sync_functor_(std::move(sync_functor)) {
+}
+
+Result<std::shared_ptr<LogGroupCommitter>> LogGroupCommitter::ForDirectory(
+    const std::string& dir, MonoDelta window) {
+#if defined(__linux__)
+  struct utsname uts_name;
+  if (uname(&uts_name) != 0) {
+    return STATUS_IO_ERROR("uname", errno);
+  }
+  if (!SyncfsReportsWritebackErrors(uts_name.release)) {
+    return STATUS_FORMAT(
+        NotSupported, "syncfs does not report writeback errors on kernel $0, 5.8+ is required",
+        uts_name.release);
+  }
+
+  struct stat st;
+  if (stat(dir.c_str(), &st) != 0) {
+    return STATUS_IO_ERROR(dir, errno);
+  }
+
+  static std::mutex mutex;
+  static std::unordered_map<dev_t, std::shared_ptr<LogGroupCommitter>> committers;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& result = committers[st.st_dev];
+  if (!result) {
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+      return STATUS_IO_ERROR(dir, errno);
+    }
+    // Committers live until process exit, so the descriptor is never closed.
+    result = std::make_shared<LogGroupCommitter>(
+        Format("$0 (device $1:$2)", dir, major(st.st_dev), minor(st.st_dev)), window,
+        [fd, dir]() -> Status {
+          ThreadRestrictions::AssertIOAllowed();
+          if (FLAGS_never_fsync) {
+            return Status::OK();
+          }
+          if (syncfs(fd) != 0) {
+            return STATUS_IO_ERROR(dir, errno);
+          }
+          return Status::OK();
+        });
+  }
+  return result;
+#else
+  return STATUS(NotSupported, "WAL group commit requires syncfs");
+#endif
+}
+
+Status LogGroupCommitter::Sync() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Sync that was not started yet covers all data written before this call, so its status is the
+  // result of this call. Status of later syncs is not relevant, even if they fail before this
+  // caller wakes up.
+  const auto group = pending_group_;
+  while (!group->finished) {
+    if (leader_active_) {
+      cond_.wait(lock);
+      continue;
+    }
+
+    // When there is no active leader, no sync is in progress, so our group is still pending.
+    leader_active_ = true;
+    if (window_) {
+      // Let other tablets join the group.
+      lock.unlock();
+      SleepFor(window_);
+      lock.lock();
+    }
+    auto sync_group = std::move(pending_group_);
+    pending_group_ = std::make_shared<SyncGroup>();
+    lock.unlock();
+    auto status = sync_functor_();
+    lock.lock();
+    sync_group->finished = true;
+    sync_group->status = std::move(status);
+    ++finished_syncs_;
+    leader_active_ = false;
+    cond_.notify_all();
+  }
+
+  return group->status;
+}
+
+uint64_t LogGroupCommitter::num_syncs() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return finished_syncs_;
+}
+
+bool SyncfsReportsWritebackErrors(const std::string& kernel_release) {
+  int major_version = 0;
+  int minor_version = 0;
+  char separator = 0;
+  std::istringstream version_stream(kernel_release);
+  version_stream >> major_version >> separator >> minor_version;
+  if (!version_stream || separator != '.') {
+    return false;
+  }
+  return major_version * 1000 + minor_version >= 5008;
+}
+
+}  // namespace log
+}  // namespace yb
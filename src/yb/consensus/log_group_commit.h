@@ -0,0 +1,89 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "yb/util/monotime.h"
+#include "yb/util/result.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace log {
+
+// Coalesces WAL syncs of many tablets, whose WAL segments reside on the same file system, into a
+// single file system sync.
+//
+// File system sync flushes all dirty data of the file system, including SST files and WALs of
+// tablets that did not ask for sync. So it is only worth using when WALs are placed on a dedicated
+// file system.
+//
+// Caller of Sync() should have already written its data to the OS, i.e. WAL segments should not
+// use O_DIRECT. The first caller, that does not find sync being prepared, becomes a leader. It
+// waits for the group commit window, so other tablets could join, and then performs sync.
+// All callers that arrived before the leader started sync are satisfied by it, and get its status.
+// Callers that arrived while sync is in progress wait for the next one.
+class LogGroupCommitter {
+ public:
+  using SyncFunctor = std::function<Status()>;
+
+  LogGroupCommitter(std::string name, MonoDelta window, SyncFunctor sync_functor);
+
+  // Returns committer shared by all WALs on the file system containing the specified directory.
+  // Returns NotSupported if file system sync is not available on this platform, or does not
+  // report writeback errors, see SyncfsReportsWritebackErrors.
+  static Result<std::shared_ptr<LogGroupCommitter>> ForDirectory(
+      const std::string& dir, MonoDelta window);
+
+  // Blocks until all data written to the file system before this call is durable.
+  Status Sync();
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  // Number of syncs performed, i.e. number of calls to sync functor.
+  uint64_t num_syncs() const;
+
+ private:
+  const std::string name_;
+  const MonoDelta window_;
+  const SyncFunctor sync_functor_;
+
+  // Callers that are satisfied by the same sync.
+  struct SyncGroup {
+    bool finished = false;
+    Status status;
+  };
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  // Whether some caller is collecting the group or executing sync.
+  bool leader_active_ = false;
+  // Group that will be satisfied by the next sync, i.e. sync that was not started yet.
+  std::shared_ptr<SyncGroup> pending_group_ = std::make_shared<SyncGroup>();
+  // Number of syncs finished.
+  uint64_t finished_syncs_ = 0;
+};
+
+// Returns true if syncfs of the kernel with the specified release reports writeback errors. Before
+// Linux 5.8 syncfs returns success even when some data failed to reach the disk.
+bool SyncfsReportsWritebackErrors(const std::string& kernel_release);
+
+}  // namespace log
+}  // namespace yb
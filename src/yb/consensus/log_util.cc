@@ -38,6 +38,8 @@
 #include <utility>
 
 #include <glog/logging.h>
+#include <lz4.h>
+#include <snappy.h>
 
 #include "yb/common/hybrid_time.h"
 
@@ -122,6 +124,38 @@ DEFINE_UNKNOWN_bool(
 TAG_FLAG(save_index_into_wal_segments, hidden);
 TAG_FLAG(save_index_into_wal_segments, advanced);
 
+// Using class kLocalPersisted as nodes that don't support compressed entry batches won't be able
+// to read WAL segments written with compression enabled, and WAL segments are sent to other
+// tablet servers during remote bootstrap.
+DEFINE_RUNTIME_AUTO_bool(log_entry_batch_compression_supported, kLocalPersisted, false, true,
+    "Whether all servers are able to read compressed WAL entry batches. Entry batches are "
+    "compressed only when this flag is set and log_entry_batch_compression_algo is not 0.");
+
+DEFINE_RUNTIME_int32(log_entry_batch_compression_algo, 0,
+    "Algorithm used to compress WAL entry batches. 0 - no compression, 1 - snappy, 2 - lz4. "
+    "Has effect only after log_entry_batch_compression_supported is promoted. Versions without "
+    "compression support could not read such WAL segments, so before downgrade turn this flag "
+    "off and wait until all WAL segments written with compression are garbage collected.");
+TAG_FLAG(log_entry_batch_compression_algo, advanced);
+
+DEFINE_RUNTIME_uint64(log_entry_batch_compression_min_size, 4_KB,
+    "WAL entry batches smaller than this size are written without compression.");
+TAG_FLAG(log_entry_batch_compression_min_size, advanced);
+
+namespace {
+
+bool ValidateLogEntryBatchCompressionAlgo(const char* flag_name, int32_t value) {
+  if (value >= 0 && implicit_cast<size_t>(value) < yb::log::kLogEntryBatchCodecMapSize) {
+    return true;
+  }
+  LOG(ERROR) << "Invalid value for " << flag_name << ": " << value;
+  return false;
+}
+
+} // namespace
+
+DEFINE_validator(log_entry_batch_compression_algo, &ValidateLogEntryBatchCompressionAlgo);
+
 namespace yb {
 namespace log {
 
@@ -149,6 +183,81 @@ const size_t kLogSegmentFooterMagicAndFooterLength  = 12;
 
 const size_t kEntryHeaderSize = 12;
 
+namespace {
+
+// The codec of the entry batch is stored in the high bits of the length field of the entry
+// header. Batches are much smaller than 256MB, so those bits were always zero before.
+constexpr int kEntryCodecShift = 28;
+constexpr uint32_t kEntryLengthMask = (1U << kEntryCodecShift) - 1;
+
+// Compresses data with the specified codec. The result is prefixed with the varint encoded size
+// of the uncompressed data. Returns false if compression did not reduce the size.
+bool CompressEntryBatch(LogEntryBatchCodec codec, const Slice& data, faststring* out) {
+  out->clear();
+  PutVarint64(out, data.size());
+  const auto prefix_size = out->size();
+  size_t compressed_size = 0;
+  switch (codec) {
+    case LogEntryBatchCodec::kSnappy:
+      out->resize(prefix_size + snappy::MaxCompressedLength(data.size()));
+      snappy::RawCompress(
+          data.cdata(), data.size(), pointer_cast<char*>(out->data() + prefix_size),
+          &compressed_size);
+      break;
+    case LogEntryBatchCodec::kLz4: {
+      const auto bound = LZ4_compressBound(narrow_cast<int>(data.size()));
+      out->resize(prefix_size + bound);
+      auto result = LZ4_compress_default(
+          data.cdata(), pointer_cast<char*>(out->data() + prefix_size),
+          narrow_cast<int>(data.size()), bound);
+      if (result <= 0) {
+        return false;
+      }
+      compressed_size = result;
+      break;
+    }
+    case LogEntryBatchCodec::kNone:
+      return false;
+  }
+  out->resize(prefix_size + compressed_size);
+  return out->size() < data.size();
+}
+
+Result<RefCntBuffer> DecompressEntryBatch(LogEntryBatchCodec codec, Slice data) {
+  uint64_t uncompressed_size;
+  SCHECK(GetVarint64(&data, &uncompressed_size), Corruption,
+         "Failed to decode uncompressed size of log entry batch");
+  SCHECK_LE(uncompressed_size, implicit_cast<uint64_t>(std::numeric_limits<int32_t>::max()),
+            Corruption, "Uncompressed log entry batch is too big");
+  RefCntBuffer result(uncompressed_size);
+  switch (codec) {
+    case LogEntryBatchCodec::kSnappy: {
+      size_t expected_size;
+      if (!snappy::GetUncompressedLength(data.cdata(), data.size(), &expected_size) ||
+          expected_size != uncompressed_size ||
+          !snappy::RawUncompress(data.cdata(), data.size(), result.data())) {
+        return STATUS(Corruption, "Failed to decompress snappy log entry batch");
+      }
+      return result;
+    }
+    case LogEntryBatchCodec::kLz4: {
+      auto decompressed_size = LZ4_decompress_safe(
+          data.cdata(), result.data(), narrow_cast<int>(data.size()),
+          narrow_cast<int>(uncompressed_size));
+      if (decompressed_size < 0 || implicit_cast<size_t>(decompressed_size) != uncompressed_size) {
+        return STATUS_FORMAT(
+            Corruption, "Failed to decompress lz4 log entry batch: $0", decompressed_size);
+      }
+      return result;
+    }
+    case LogEntryBatchCodec::kNone:
+      break;
+  }
+  return STATUS_FORMAT(Corruption, "Unexpected log entry batch codec: $0", codec);
+}
+
+} // namespace
+
 const int kLogMajorVersion = 1;
 const int kLogMinorVersion = 0;
 
@@ -867,7 +976,9 @@ Status ReadableLogSegment::ReadEntryHeader(int64_t *offset, EntryHeader* header)
 
 Status ReadableLogSegment::DecodeEntryHeader(const Slice& data, EntryHeader* header) {
   DCHECK_EQ(kEntryHeaderSize, data.size());
-  header->msg_length = DecodeFixed32(data.data());
+  const auto length_and_codec = DecodeFixed32(data.data());
+  header->msg_length = length_and_codec & kEntryLengthMask;
+  const auto codec = length_and_codec >> kEntryCodecShift;
   header->msg_crc = DecodeFixed32(data.data() + 4);
   header->header_crc = DecodeFixed32(data.data() + 8);
 
@@ -878,6 +989,10 @@ Status ReadableLogSegment::DecodeEntryHeader(const Slice& data, EntryHeader* hea
         Corruption, "Invalid checksum in log entry head header: found=$0, computed=$1",
         header->header_crc, computed_crc);
   }
+  if (codec >= kLogEntryBatchCodecMapSize) {
+    return STATUS_FORMAT(Corruption, "Unknown log entry batch codec: $0", codec);
+  }
+  header->codec = static_cast<LogEntryBatchCodec>(codec);
   return Status::OK();
 }
 
@@ -921,6 +1036,18 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
                                          header.msg_crc, read_crc));
   }
 
+  auto batch_data = entry_batch_slice.Prefix(header.msg_length);
+  if (header.codec != LogEntryBatchCodec::kNone) {
+    auto decompressed = DecompressEntryBatch(header.codec, batch_data);
+    if (!decompressed.ok()) {
+      return decompressed.status().CloneAndPrepend(
+          Format("Failed to decompress entry at offset: $0, length: $1", *offset,
+                 header.msg_length));
+    }
+    buffer = std::move(*decompressed);
+    batch_data = buffer.AsSlice();
+  }
+
   // TODO(lw_uc) embed buffer and first arena block into holder itself.
   struct DataHolder {
     RefCntBuffer buffer;
@@ -931,7 +1058,7 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
 
   auto holder = std::make_shared<DataHolder>(buffer);
   auto batch = holder->arena.NewArenaObject<LWLogEntryBatchPB>();
-  s = batch->ParseFromSlice(entry_batch_slice.Prefix(header.msg_length));
+  s = batch->ParseFromSlice(batch_data);
 
   if (!s.ok()) {
     return STATUS_FORMAT(
@@ -1070,14 +1197,32 @@ Status WritableLogSegment::WriteIndexWithFooterAndClose(
   return Status::OK();
 }
 
-Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
+Status WritableLogSegment::WriteEntryBatch(const Slice& entry_batch_data) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
   uint8_t header_buf[kEntryHeaderSize];
 
-  // First encode the length of the message.
+  auto codec = GetAtomicFlag(&FLAGS_log_entry_batch_compression_supported)
+      ? static_cast<LogEntryBatchCodec>(GetAtomicFlag(&FLAGS_log_entry_batch_compression_algo))
+      : LogEntryBatchCodec::kNone;
+  Slice data = entry_batch_data;
+  if (codec != LogEntryBatchCodec::kNone &&
+      data.size() >= GetAtomicFlag(&FLAGS_log_entry_batch_compression_min_size)) {
+    if (CompressEntryBatch(codec, data, &compression_buffer_)) {
+      data = Slice(compression_buffer_);
+    } else {
+      codec = LogEntryBatchCodec::kNone;
+    }
+  } else {
+    codec = LogEntryBatchCodec::kNone;
+  }
+
+  // First encode the length of the message, together with the codec used to compress it.
   auto len = data.size();
-  InlineEncodeFixed32(&header_buf[0], narrow_cast<uint32_t>(len));
+  SCHECK_LE(len, kEntryLengthMask, InvalidArgument, "Log entry batch is too big");
+  InlineEncodeFixed32(
+      &header_buf[0],
+      narrow_cast<uint32_t>(len) | (static_cast<uint32_t>(codec) << kEntryCodecShift));
 
   // Then the CRC of the message.
   uint32_t msg_crc = crc::Crc32c(data.data(), data.size());
@@ -157,6 +157,9 @@ struct FirstEntryMetadata {
 
 YB_DEFINE_ENUM(EntriesToRead, (kAll)(kReplicate));
 
+// Codec used to compress a log entry batch, stored in the entry header. Values are persisted.
+YB_DEFINE_ENUM(LogEntryBatchCodec, (kNone)(kSnappy)(kLz4));
+
 // A segment of the log can either be a ReadableLogSegment (for replay and
 // consensus catch-up) or a WritableLogSegment (where the Log actually stores
 // state). LogSegments have a maximum size defined in LogOptions (set from the
@@ -296,6 +299,9 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
 
     // The CRC32C of this EntryHeader.
     uint32_t header_crc;
+
+    // The codec used to compress the batch data.
+    LogEntryBatchCodec codec;
   };
 
   ~ReadableLogSegment() {}
@@ -483,6 +489,9 @@ class WritableLogSegment {
 
   faststring index_block_header_buffer_;
 
+  // Buffer used to compress entry batches.
+  faststring compression_buffer_;
+
   DISALLOW_COPY_AND_ASSIGN(WritableLogSegment);
 };
 
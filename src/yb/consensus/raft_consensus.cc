@@ -241,6 +241,13 @@ DEFINE_UNKNOWN_int64(protege_synchronization_timeout_ms, 1000,
 DEFINE_test_flag(bool, skip_election_when_fail_detected, false,
                  "Inside RaftConsensus::ReportFailureDetectedTask, skip normal election.");
 
+DEFINE_RUNTIME_int32(consensus_pipelined_request_reorder_wait_ms, 100,
+                     "How long a replica waits for preceding operations to be received when a "
+                     "pipelined request from the leader arrives out of order. The request is "
+                     "processed, and rejected because of log matching property mismatch, when "
+                     "operations were not received in time.");
+TAG_FLAG(consensus_pipelined_request_reorder_wait_ms, advanced);
+
 namespace yb {
 namespace consensus {
 
@@ -1546,8 +1553,13 @@ Status RaftConsensus::Update(
       return STATUS_FORMAT(TimedOut, "Unable to lock update mutex for $0", wait_duration);
     }
 
+    if (request.pipelined() && !request.ops().empty()) {
+      WaitForPrecedingOps(request, deadline, &lock);
+    }
+
     LongOperationTracker operation_tracker("UpdateReplica", 1s);
     result = VERIFY_RESULT(UpdateReplica(request_ptr, response));
+    update_cond_.notify_all();
 
     auto delay = TEST_delay_update_.load(std::memory_order_acquire);
     if (delay != MonoDelta::kZero) {
@@ -1579,6 +1591,24 @@ Status RaftConsensus::Update(
   return Status::OK();
 }
 
+void RaftConsensus::WaitForPrecedingOps(
+    const LWConsensusRequestPB& request, CoarseTimePoint deadline,
+    std::unique_lock<std::timed_mutex>* update_lock) {
+  auto wait_deadline = std::min(
+      deadline,
+      CoarseMonoClock::now() +
+          GetAtomicFlag(&FLAGS_consensus_pipelined_request_reorder_wait_ms) * 1ms);
+  const auto preceding_index = request.preceding_id().index();
+  auto received = update_cond_.wait_until(*update_lock, wait_deadline, [this, preceding_index] {
+    auto lock = state_->LockForRead();
+    return state_->GetLastReceivedOpIdUnlocked().index >= preceding_index;
+  });
+  if (!received) {
+    VLOG_WITH_PREFIX(1) << "Operations preceding pipelined request were not received in time: "
+                        << request.preceding_id().ShortDebugString();
+  }
+}
+
 Status RaftConsensus::StartReplicaOperationUnlocked(
     const ReplicateMsgPtr& msg, HybridTime propagated_safe_time) {
   if (IsConsensusOnlyOperation(msg->op_type())) {
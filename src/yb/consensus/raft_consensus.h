@@ -33,6 +33,7 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -413,6 +414,12 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
       const std::shared_ptr<LWConsensusRequestPB>& request,
       LWConsensusResponsePB* response);
 
+  // Pipelined requests could arrive out of order. Waits, releasing update_lock, until operations
+  // preceding request are received, for at most consensus_pipelined_request_reorder_wait_ms.
+  void WaitForPrecedingOps(
+      const LWConsensusRequestPB& request, CoarseTimePoint deadline,
+      std::unique_lock<std::timed_mutex>* update_lock);
+
   // Deduplicates an RPC request making sure that we get only messages that we
   // haven't appended to our log yet.
   // On return 'deduplicated_req' is instantiated with only the new messages
@@ -717,6 +724,10 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   // taken, this lock must be taken first.
   mutable std::timed_mutex update_mutex_;
 
+  // Notified after each processed update, used by pipelined requests that arrived out of order to
+  // wait for preceding operations. Used with update_mutex_.
+  std::condition_variable_any update_cond_;
+
   std::atomic<bool> outstanding_report_failure_task_{false};
 
   AtomicBool shutdown_;
@@ -0,0 +1,182 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <math.h>
+
+#include <gtest/gtest.h>
+
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/columnar_predicate.h"
+#include "yb/docdb/columnar_row_batch.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const ColumnId kIntColumn(10);
+const ColumnId kRealColumn(11);
+
+// Reference implementation that follows Postgres semantics.
+bool Matches(ColumnarCompareOp op, int cmp) {
+  switch (op) {
+    case ColumnarCompareOp::kEq: return cmp == 0;
+    case ColumnarCompareOp::kNe: return cmp != 0;
+    case ColumnarCompareOp::kLt: return cmp < 0;
+    case ColumnarCompareOp::kLe: return cmp <= 0;
+    case ColumnarCompareOp::kGt: return cmp > 0;
+    case ColumnarCompareOp::kGe: return cmp >= 0;
+  }
+  FATAL_INVALID_ENUM_VALUE(ColumnarCompareOp, op);
+}
+
+int CompareReal(double lhs, double rhs) {
+  if (isnan(lhs)) {
+    return isnan(rhs) ? 0 : 1;
+  }
+  if (isnan(rhs)) {
+    return -1;
+  }
+  return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+bool ReferenceMatches(const ColumnarPredicate& predicate, const QLValuePB& value) {
+  if (IsNull(value)) {
+    return false;
+  }
+  if (predicate.is_real) {
+    return Matches(predicate.op, CompareReal(value.double_value(), predicate.real_value));
+  }
+  const auto v = value.int64_value();
+  return Matches(predicate.op, v < predicate.int_value ? -1 : (v > predicate.int_value ? 1 : 0));
+}
+
+void FillBatch(size_t num_rows, ColumnarRowBatch* batch) {
+  batch->AddColumn(kIntColumn, DataType::INT64);
+  batch->AddColumn(kRealColumn, DataType::DOUBLE);
+  for (size_t row = 0; row != num_rows; ++row) {
+    QLValuePB value;
+    if (row % 7 != 0) {
+      value.set_int64_value(RandomUniformInt<int64_t>(-16, 16));
+      batch->column(0).Append(value);
+    }
+    if (row % 5 != 0) {
+      value.set_double_value(
+          row % 11 == 0 ? NAN : RandomUniformInt<int64_t>(-16, 16) / 2.0);
+      batch->column(1).Append(value);
+    }
+    batch->FinishRow();
+  }
+}
+
+std::vector<ColumnarPredicate> AllPredicates() {
+  std::vector<ColumnarPredicate> result;
+  for (auto op : ColumnarCompareOpList()) {
+    ColumnarPredicate int_predicate;
+    int_predicate.column_id = kIntColumn;
+    int_predicate.op = op;
+    int_predicate.int_value = 3;
+    result.push_back(int_predicate);
+
+    ColumnarPredicate real_predicate;
+    real_predicate.column_id = kRealColumn;
+    real_predicate.op = op;
+    real_predicate.is_real = true;
+    real_predicate.real_value = 1.5;
+    result.push_back(real_predicate);
+  }
+  return result;
+}
+
+} // namespace
+
+class ColumnarPredicateTest : public YBTest {
+};
+
+TEST_F(ColumnarPredicateTest, Correctness) {
+  // Odd number of rows, to check tail processing of vectorized kernels.
+  constexpr size_t kNumRows = 1003;
+  ColumnarRowBatch batch;
+  FillBatch(kNumRows, &batch);
+
+  for (const auto& predicate : AllPredicates()) {
+    const auto& column = *batch.FindColumn(predicate.column_id);
+    for (auto kernel : PredicateKernelList()) {
+      std::vector<uint8_t> selection(kNumRows, 1);
+      // Unselected rows should remain unselected.
+      selection[5] = 0;
+      ASSERT_TRUE(ApplyColumnarPredicate(predicate, column, kNumRows, selection.data(), kernel));
+      for (size_t row = 0; row != kNumRows; ++row) {
+        QLValuePB value;
+        column.GetValue(row, &value);
+        const bool expected = row != 5 && ReferenceMatches(predicate, value);
+        ASSERT_EQ(expected, selection[row] != 0)
+            << "Predicate: " << predicate.ToString() << ", kernel: " << kernel << ", row: " << row
+            << ", value: " << value.ShortDebugString();
+      }
+    }
+  }
+}
+
+TEST_F(ColumnarPredicateTest, LayoutMismatch) {
+  ColumnarRowBatch batch;
+  FillBatch(10, &batch);
+  ColumnarPredicate predicate;
+  predicate.column_id = kIntColumn;
+  predicate.is_real = true;
+  ASSERT_FALSE(ApplyColumnarPredicate(predicate, &batch));
+  predicate.column_id = ColumnId(100);
+  predicate.is_real = false;
+  ASSERT_FALSE(ApplyColumnarPredicate(predicate, &batch));
+  ASSERT_EQ(batch.CountSelected(), 10);
+}
+
+// Predicates applied one after another to the batch with the best kernel should select only rows
+// matching all of them, i.e. the where clause conjunction.
+TEST_F(ColumnarPredicateTest, Conjunction) {
+  constexpr size_t kNumRows = 1003;
+  ColumnarRowBatch batch;
+  FillBatch(kNumRows, &batch);
+
+  std::vector<ColumnarPredicate> predicates;
+  for (const auto& predicate : AllPredicates()) {
+    if (predicate.op == ColumnarCompareOp::kGe || predicate.op == ColumnarCompareOp::kNe) {
+      predicates.push_back(predicate);
+    }
+  }
+  for (const auto& predicate : predicates) {
+    ASSERT_TRUE(ApplyColumnarPredicate(predicate, &batch));
+  }
+
+  size_t expected_selected = 0;
+  for (size_t row = 0; row != kNumRows; ++row) {
+    bool expected = true;
+    for (const auto& predicate : predicates) {
+      QLValuePB value;
+      batch.FindColumn(predicate.column_id)->GetValue(row, &value);
+      expected = expected && ReferenceMatches(predicate, value);
+    }
+    ASSERT_EQ(expected, batch.IsSelected(row)) << "Row: " << row;
+    expected_selected += expected;
+  }
+  ASSERT_GT(expected_selected, 0);
+  ASSERT_EQ(batch.CountSelected(), expected_selected);
+}
+
+}  // namespace docdb
+}  // namespace yb
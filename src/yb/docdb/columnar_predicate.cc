@@ -0,0 +1,386 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/columnar_predicate.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "yb/docdb/columnar_row_batch.h"
+
+#include "yb/gutil/cpu.h"
+#include "yb/gutil/macros.h"
+
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Scalar kernels. Also used to process the tail of the column by vectorized kernels.
+
+template <class Cmp>
+void ScalarLoop(const int64_t* data, size_t begin, size_t end, uint8_t* selection, Cmp cmp) {
+  for (size_t i = begin; i != end; ++i) {
+    selection[i] &= cmp(data[i]);
+  }
+}
+
+template <class Cmp>
+void ScalarLoop(const double* data, size_t begin, size_t end, uint8_t* selection, Cmp cmp) {
+  for (size_t i = begin; i != end; ++i) {
+    selection[i] &= cmp(data[i]);
+  }
+}
+
+void ScalarInt(
+    ColumnarCompareOp op, int64_t c, const int64_t* data, size_t begin, size_t end,
+    uint8_t* selection) {
+  switch (op) {
+    case ColumnarCompareOp::kEq:
+      ScalarLoop(data, begin, end, selection, [c](int64_t v) { return v == c; });
+      return;
+    case ColumnarCompareOp::kNe:
+      ScalarLoop(data, begin, end, selection, [c](int64_t v) { return v != c; });
+      return;
+    case ColumnarCompareOp::kLt:
+      ScalarLoop(data, begin, end, selection, [c](int64_t v) { return v < c; });
+      return;
+    case ColumnarCompareOp::kLe:
+      ScalarLoop(data, begin, end, selection, [c](int64_t v) { return v <= c; });
+      return;
+    case ColumnarCompareOp::kGt:
+      ScalarLoop(data, begin, end, selection, [c](int64_t v) { return v > c; });
+      return;
+    case ColumnarCompareOp::kGe:
+      ScalarLoop(data, begin, end, selection, [c](int64_t v) { return v >= c; });
+      return;
+  }
+  FATAL_INVALID_ENUM_VALUE(ColumnarCompareOp, op);
+}
+
+// NaN is greater than any other value, so it satisfies only kNe, kGt and kGe, provided that the
+// constant is not NaN.
+void ScalarReal(
+    ColumnarCompareOp op, double c, const double* data, size_t begin, size_t end,
+    uint8_t* selection) {
+  switch (op) {
+    case ColumnarCompareOp::kEq:
+      ScalarLoop(data, begin, end, selection, [c](double v) { return v == c; });
+      return;
+    case ColumnarCompareOp::kNe:
+      ScalarLoop(data, begin, end, selection, [c](double v) { return !(v == c); });
+      return;
+    case ColumnarCompareOp::kLt:
+      ScalarLoop(data, begin, end, selection, [c](double v) { return v < c; });
+      return;
+    case ColumnarCompareOp::kLe:
+      ScalarLoop(data, begin, end, selection, [c](double v) { return v <= c; });
+      return;
+    case ColumnarCompareOp::kGt:
+      ScalarLoop(data, begin, end, selection, [c](double v) { return !(v <= c); });
+      return;
+    case ColumnarCompareOp::kGe:
+      ScalarLoop(data, begin, end, selection, [c](double v) { return !(v < c); });
+      return;
+  }
+  FATAL_INVALID_ENUM_VALUE(ColumnarCompareOp, op);
+}
+
+#if defined(__x86_64__)
+
+// Selection byte for each lane of the comparison mask, i.e. kLaneBytes[mask] has byte i set to 1
+// when bit i of the mask is set. Used to AND comparison results into the selection vector.
+constexpr uint32_t LaneBytes(uint32_t mask) {
+  return (mask & 1) | ((mask & 2) << 7) | ((mask & 4) << 14) | ((mask & 8) << 21);
+}
+
+constexpr uint32_t kLaneBytes[16] = {
+    LaneBytes(0), LaneBytes(1), LaneBytes(2), LaneBytes(3),
+    LaneBytes(4), LaneBytes(5), LaneBytes(6), LaneBytes(7),
+    LaneBytes(8), LaneBytes(9), LaneBytes(10), LaneBytes(11),
+    LaneBytes(12), LaneBytes(13), LaneBytes(14), LaneBytes(15),
+};
+
+inline void AndSelection4(uint8_t* selection, uint32_t mask) {
+  uint32_t current;
+  memcpy(&current, selection, sizeof(current));
+  current &= kLaneBytes[mask];
+  memcpy(selection, &current, sizeof(current));
+}
+
+inline void AndSelection2(uint8_t* selection, uint32_t mask) {
+  selection[0] &= mask & 1;
+  selection[1] &= (mask >> 1) & 1;
+}
+
+__attribute__((target("avx2")))
+void Avx2Int(
+    ColumnarCompareOp op, int64_t c, const int64_t* data, size_t num_rows, uint8_t* selection) {
+  const __m256i constant = _mm256_set1_epi64x(c);
+  size_t i = 0;
+  for (; i + 4 <= num_rows; i += 4) {
+    const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i cmp = constant;
+    bool negate = false;
+    switch (op) {
+      case ColumnarCompareOp::kEq:
+        cmp = _mm256_cmpeq_epi64(values, constant);
+        break;
+      case ColumnarCompareOp::kNe:
+        cmp = _mm256_cmpeq_epi64(values, constant);
+        negate = true;
+        break;
+      case ColumnarCompareOp::kLt:
+        cmp = _mm256_cmpgt_epi64(constant, values);
+        break;
+      case ColumnarCompareOp::kLe:
+        cmp = _mm256_cmpgt_epi64(values, constant);
+        negate = true;
+        break;
+      case ColumnarCompareOp::kGt:
+        cmp = _mm256_cmpgt_epi64(values, constant);
+        break;
+      case ColumnarCompareOp::kGe:
+        cmp = _mm256_cmpgt_epi64(constant, values);
+        negate = true;
+        break;
+    }
+    uint32_t mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+    AndSelection4(selection + i, negate ? mask ^ 0xf : mask);
+  }
+  ScalarInt(op, c, data, i, num_rows, selection);
+}
+
+__attribute__((target("avx2")))
+void Avx2Real(
+    ColumnarCompareOp op, double c, const double* data, size_t num_rows, uint8_t* selection) {
+  const __m256d constant = _mm256_set1_pd(c);
+  size_t i = 0;
+  for (; i + 4 <= num_rows; i += 4) {
+    const __m256d values = _mm256_loadu_pd(data + i);
+    __m256d cmp = constant;
+    // Unordered predicates are true for NaN, that matches Postgres semantics for kNe, kGt, kGe.
+    switch (op) {
+      case ColumnarCompareOp::kEq:
+        cmp = _mm256_cmp_pd(values, constant, _CMP_EQ_OQ);
+        break;
+      case ColumnarCompareOp::kNe:
+        cmp = _mm256_cmp_pd(values, constant, _CMP_NEQ_UQ);
+        break;
+      case ColumnarCompareOp::kLt:
+        cmp = _mm256_cmp_pd(values, constant, _CMP_LT_OQ);
+        break;
+      case ColumnarCompareOp::kLe:
+        cmp = _mm256_cmp_pd(values, constant, _CMP_LE_OQ);
+        break;
+      case ColumnarCompareOp::kGt:
+        cmp = _mm256_cmp_pd(values, constant, _CMP_NLE_UQ);
+        break;
+      case ColumnarCompareOp::kGe:
+        cmp = _mm256_cmp_pd(values, constant, _CMP_NLT_UQ);
+        break;
+    }
+    AndSelection4(selection + i, _mm256_movemask_pd(cmp));
+  }
+  ScalarReal(op, c, data, i, num_rows, selection);
+}
+
+#if defined(__SSE4_2__)
+
+void Sse42Int(
+    ColumnarCompareOp op, int64_t c, const int64_t* data, size_t num_rows, uint8_t* selection) {
+  const __m128i constant = _mm_set1_epi64x(c);
+  size_t i = 0;
+  for (; i + 2 <= num_rows; i += 2) {
+    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i cmp = constant;
+    bool negate = false;
+    switch (op) {
+      case ColumnarCompareOp::kEq:
+        cmp = _mm_cmpeq_epi64(values, constant);
+        break;
+      case ColumnarCompareOp::kNe:
+        cmp = _mm_cmpeq_epi64(values, constant);
+        negate = true;
+        break;
+      case ColumnarCompareOp::kLt:
+        cmp = _mm_cmpgt_epi64(constant, values);
+        break;
+      case ColumnarCompareOp::kLe:
+        cmp = _mm_cmpgt_epi64(values, constant);
+        negate = true;
+        break;
+      case ColumnarCompareOp::kGt:
+        cmp = _mm_cmpgt_epi64(values, constant);
+        break;
+      case ColumnarCompareOp::kGe:
+        cmp = _mm_cmpgt_epi64(constant, values);
+        negate = true;
+        break;
+    }
+    uint32_t mask = _mm_movemask_pd(_mm_castsi128_pd(cmp));
+    AndSelection2(selection + i, negate ? mask ^ 0x3 : mask);
+  }
+  ScalarInt(op, c, data, i, num_rows, selection);
+}
+
+void Sse42Real(
+    ColumnarCompareOp op, double c, const double* data, size_t num_rows, uint8_t* selection) {
+  const __m128d constant = _mm_set1_pd(c);
+  size_t i = 0;
+  for (; i + 2 <= num_rows; i += 2) {
+    const __m128d values = _mm_loadu_pd(data + i);
+    __m128d cmp = constant;
+    // cmpneq, cmpnle and cmpnlt are unordered, i.e. true for NaN.
+    switch (op) {
+      case ColumnarCompareOp::kEq:
+        cmp = _mm_cmpeq_pd(values, constant);
+        break;
+      case ColumnarCompareOp::kNe:
+        cmp = _mm_cmpneq_pd(values, constant);
+        break;
+      case ColumnarCompareOp::kLt:
+        cmp = _mm_cmplt_pd(values, constant);
+        break;
+      case ColumnarCompareOp::kLe:
+        cmp = _mm_cmple_pd(values, constant);
+        break;
+      case ColumnarCompareOp::kGt:
+        cmp = _mm_cmpnle_pd(values, constant);
+        break;
+      case ColumnarCompareOp::kGe:
+        cmp = _mm_cmpnlt_pd(values, constant);
+        break;
+    }
+    AndSelection2(selection + i, _mm_movemask_pd(cmp));
+  }
+  ScalarReal(op, c, data, i, num_rows, selection);
+}
+
+#endif // defined(__SSE4_2__)
+
+#endif // defined(__x86_64__)
+
+PredicateKernel DetectBestPredicateKernel() {
+#if defined(__x86_64__)
+  base::CPU cpu;
+  if (cpu.has_avx2()) {
+    return PredicateKernel::kAvx2;
+  }
+#if defined(__SSE4_2__)
+  if (cpu.has_sse42()) {
+    return PredicateKernel::kSse42;
+  }
+#endif
+#endif
+  return PredicateKernel::kScalar;
+}
+
+// Null rows never satisfy the predicate. Null bitmap is sparse in most cases, so it is cheaper to
+// fix up selection after the comparison, than to mix null checks into the comparison loop.
+void UnselectNulls(const uint64_t* null_bitmap, size_t num_rows, uint8_t* selection) {
+  for (size_t base = 0; base < num_rows; base += 64) {
+    auto word = null_bitmap[base / 64];
+    while (word) {
+      selection[base + __builtin_ctzll(word)] = 0;
+      word &= word - 1;
+    }
+  }
+}
+
+} // namespace
+
+std::string ColumnarPredicate::ToString() const {
+  if (is_real) {
+    return Format("{ column_id: $0 op: $1 real_value: $2 }", column_id, op, real_value);
+  }
+  return Format("{ column_id: $0 op: $1 int_value: $2 }", column_id, op, int_value);
+}
+
+PredicateKernel BestPredicateKernel() {
+  static const PredicateKernel result = DetectBestPredicateKernel();
+  return result;
+}
+
+bool ApplyColumnarPredicate(
+    const ColumnarPredicate& predicate, const ColumnVector& column, size_t num_rows,
+    uint8_t* selection, PredicateKernel kernel) {
+  const auto expected_layout = predicate.is_real ? ColumnVector::Layout::kReal
+                                                 : ColumnVector::Layout::kInt;
+  if (column.layout() != expected_layout) {
+    return false;
+  }
+  DCHECK_LE(num_rows, column.size());
+  if (num_rows == 0) {
+    return true;
+  }
+  DCHECK(!predicate.is_real || !isnan(predicate.real_value)) << predicate.ToString();
+
+  kernel = std::min(kernel, BestPredicateKernel());
+  switch (kernel) {
+    case PredicateKernel::kAvx2:
+#if defined(__x86_64__)
+      if (predicate.is_real) {
+        Avx2Real(predicate.op, predicate.real_value, column.real_data(), num_rows, selection);
+      } else {
+        Avx2Int(predicate.op, predicate.int_value, column.int_data(), num_rows, selection);
+      }
+      break;
+#else
+      FALLTHROUGH_INTENDED;
+#endif
+    case PredicateKernel::kSse42:
+#if defined(__x86_64__) && defined(__SSE4_2__)
+      if (predicate.is_real) {
+        Sse42Real(predicate.op, predicate.real_value, column.real_data(), num_rows, selection);
+      } else {
+        Sse42Int(predicate.op, predicate.int_value, column.int_data(), num_rows, selection);
+      }
+      break;
+#else
+      FALLTHROUGH_INTENDED;
+#endif
+    case PredicateKernel::kScalar:
+      if (predicate.is_real) {
+        ScalarReal(predicate.op, predicate.real_value, column.real_data(), 0, num_rows, selection);
+      } else {
+        ScalarInt(predicate.op, predicate.int_value, column.int_data(), 0, num_rows, selection);
+      }
+      break;
+  }
+
+  UnselectNulls(column.null_bitmap(), num_rows, selection);
+  return true;
+}
+
+bool ApplyColumnarPredicate(
+    const ColumnarPredicate& predicate, ColumnarRowBatch* batch, PredicateKernel kernel) {
+  const auto* column = batch->FindColumn(predicate.column_id);
+  if (!column) {
+    return false;
+  }
+  return ApplyColumnarPredicate(
+      predicate, *column, batch->num_rows(), batch->mutable_selection(), kernel);
+}
+
+}  // namespace docdb
+}  // namespace yb
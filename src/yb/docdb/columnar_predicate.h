@@ -0,0 +1,66 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <string>
+
+#include "yb/common/column_id.h"
+
+#include "yb/docdb/docdb_fwd.h"
+
+#include "yb/util/enums.h"
+
+namespace yb {
+namespace docdb {
+
+YB_DEFINE_ENUM(ColumnarCompareOp, (kEq)(kNe)(kLt)(kLe)(kGt)(kGe));
+
+// Instruction sets available for predicate evaluation, in the order of preference.
+YB_DEFINE_ENUM(PredicateKernel, (kScalar)(kSse42)(kAvx2));
+
+// Comparison of a fixed width column with a constant: column <op> constant.
+// The predicate is evaluated over the column vector of a ColumnarRowBatch, rows that do not
+// satisfy the predicate are unselected. Null values never satisfy the predicate.
+//
+// Real values are compared using the Postgres rules, i.e. NaN is equal to itself and greater than
+// any other value. The real constant itself must not be NaN.
+struct ColumnarPredicate {
+  ColumnId column_id;
+  ColumnarCompareOp op = ColumnarCompareOp::kEq;
+  // Whether the constant is stored in real_value, int_value is used otherwise.
+  bool is_real = false;
+  int64_t int_value = 0;
+  double real_value = 0;
+
+  std::string ToString() const;
+};
+
+// Returns the best kernel supported by the current CPU.
+PredicateKernel BestPredicateKernel();
+
+// Evaluates predicate over the first num_rows values of the column. Clears selection entries for
+// rows that do not satisfy the predicate. Requested kernel is downgraded if it is not supported.
+// Returns false if predicate could not be applied to the column, i.e. column layout does not match
+// the constant type.
+bool ApplyColumnarPredicate(
+    const ColumnarPredicate& predicate, const ColumnVector& column, size_t num_rows,
+    uint8_t* selection, PredicateKernel kernel = BestPredicateKernel());
+
+// Same as above, but uses the column of the batch, referenced by the predicate.
+bool ApplyColumnarPredicate(
+    const ColumnarPredicate& predicate, ColumnarRowBatch* batch,
+    PredicateKernel kernel = BestPredicateKernel());
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,246 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/columnar_row_batch.h"
+
+#include "yb/common/ql_expr.h"
+#include "yb/common/ql_type.h"
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+
+#include "yb/gutil/bits.h"
+
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+ColumnVector::Layout LayoutForType(DataType type) {
+  switch (type) {
+    case DataType::INT8: FALLTHROUGH_INTENDED;
+    case DataType::INT16: FALLTHROUGH_INTENDED;
+    case DataType::INT32: FALLTHROUGH_INTENDED;
+    case DataType::INT64: FALLTHROUGH_INTENDED;
+    case DataType::BOOL: FALLTHROUGH_INTENDED;
+    case DataType::TIMESTAMP:
+      return ColumnVector::Layout::kInt;
+    case DataType::FLOAT: FALLTHROUGH_INTENDED;
+    case DataType::DOUBLE:
+      return ColumnVector::Layout::kReal;
+    default:
+      return ColumnVector::Layout::kValue;
+  }
+}
+
+} // namespace
+
+ColumnVector::ColumnVector(ColumnId id, DataType type)
+    : id_(id), type_(type), layout_(LayoutForType(type)) {
+}
+
+bool ColumnVector::IsFixedWidth(DataType type) {
+  return LayoutForType(type) != Layout::kValue;
+}
+
+void ColumnVector::AppendNullBit(bool is_null) {
+  if (size_ % 64 == 0) {
+    nulls_.push_back(0);
+  }
+  if (is_null) {
+    nulls_.back() |= 1ULL << (size_ % 64);
+  }
+  ++size_;
+}
+
+void ColumnVector::AppendNull() {
+  switch (layout_) {
+    case Layout::kInt:
+      ints_.push_back(0);
+      break;
+    case Layout::kReal:
+      reals_.push_back(0);
+      break;
+    case Layout::kValue:
+      values_.emplace_back();
+      break;
+  }
+  AppendNullBit(true);
+}
+
+void ColumnVector::Append(const QLValuePB& value) {
+  if (yb::IsNull(value)) {
+    AppendNull();
+    return;
+  }
+  switch (layout_) {
+    case Layout::kInt: {
+      int64_t v = 0;
+      switch (value.value_case()) {
+        case QLValuePB::kInt8Value: v = value.int8_value(); break;
+        case QLValuePB::kInt16Value: v = value.int16_value(); break;
+        case QLValuePB::kInt32Value: v = value.int32_value(); break;
+        case QLValuePB::kInt64Value: v = value.int64_value(); break;
+        case QLValuePB::kBoolValue: v = value.bool_value(); break;
+        case QLValuePB::kTimestampValue: v = value.timestamp_value(); break;
+        default:
+          LOG(DFATAL) << "Unexpected value for " << DataType_Name(type_) << " column: "
+                      << value.ShortDebugString();
+          AppendNull();
+          return;
+      }
+      ints_.push_back(v);
+      break;
+    }
+    case Layout::kReal:
+      if (value.value_case() == QLValuePB::kFloatValue) {
+        reals_.push_back(value.float_value());
+      } else if (value.value_case() == QLValuePB::kDoubleValue) {
+        reals_.push_back(value.double_value());
+      } else {
+        LOG(DFATAL) << "Unexpected value for " << DataType_Name(type_) << " column: "
+                    << value.ShortDebugString();
+        AppendNull();
+        return;
+      }
+      break;
+    case Layout::kValue:
+      values_.push_back(value);
+      break;
+  }
+  AppendNullBit(false);
+}
+
+void ColumnVector::PadTo(size_t num_rows) {
+  while (size_ < num_rows) {
+    AppendNull();
+  }
+}
+
+void ColumnVector::GetValue(size_t row, QLValuePB* out) const {
+  DCHECK_LT(row, size_);
+  if (IsNull(row)) {
+    out->Clear();
+    return;
+  }
+  switch (layout_) {
+    case Layout::kInt: {
+      const auto v = ints_[row];
+      switch (type_) {
+        case DataType::INT8: out->set_int8_value(static_cast<int32_t>(v)); return;
+        case DataType::INT16: out->set_int16_value(static_cast<int32_t>(v)); return;
+        case DataType::INT32: out->set_int32_value(static_cast<int32_t>(v)); return;
+        case DataType::INT64: out->set_int64_value(v); return;
+        case DataType::BOOL: out->set_bool_value(v != 0); return;
+        case DataType::TIMESTAMP: out->set_timestamp_value(v); return;
+        default: break;
+      }
+      break;
+    }
+    case Layout::kReal:
+      if (type_ == DataType::FLOAT) {
+        out->set_float_value(static_cast<float>(reals_[row]));
+      } else {
+        out->set_double_value(reals_[row]);
+      }
+      return;
+    case Layout::kValue:
+      *out = values_[row];
+      return;
+  }
+  LOG(DFATAL) << "Unexpected column type: " << DataType_Name(type_);
+  out->Clear();
+}
+
+size_t ColumnVector::CountNotNull() const {
+  if (size_ == 0) {
+    return 0;
+  }
+  size_t nulls = 0;
+  for (auto word : nulls_) {
+    nulls += Bits::CountOnes64(word);
+  }
+  return size_ - nulls;
+}
+
+void ColumnVector::Clear() {
+  size_ = 0;
+  ints_.clear();
+  reals_.clear();
+  values_.clear();
+  nulls_.clear();
+}
+
+ColumnVector& ColumnarRowBatch::AddColumn(ColumnId id, DataType type) {
+  DCHECK_EQ(num_rows_, 0);
+  columns_.emplace_back(id, type);
+  return columns_.back();
+}
+
+void ColumnarRowBatch::AddColumns(const Schema& schema) {
+  for (size_t i = 0; i != schema.num_columns(); ++i) {
+    AddColumn(schema.column_id(i), schema.column(i).type()->main());
+  }
+}
+
+const ColumnVector* ColumnarRowBatch::FindColumn(ColumnId id) const {
+  // Batches usually contain just several columns, so linear search is faster than a map.
+  for (const auto& column : columns_) {
+    if (column.id() == id) {
+      return &column;
+    }
+  }
+  return nullptr;
+}
+
+void ColumnarRowBatch::FinishRow() {
+  ++num_rows_;
+  for (auto& column : columns_) {
+    column.PadTo(num_rows_);
+  }
+  selection_.push_back(1);
+}
+
+void ColumnarRowBatch::Clear() {
+  for (auto& column : columns_) {
+    column.Clear();
+  }
+  selection_.clear();
+  num_rows_ = 0;
+}
+
+size_t ColumnarRowBatch::CountSelected() const {
+  size_t result = 0;
+  for (auto selected : selection_) {
+    result += selected;
+  }
+  return result;
+}
+
+void ColumnarRowBatch::ExtractRow(size_t row, QLTableRow* table_row) const {
+  for (const auto& column : columns_) {
+    if (!column.IsNull(row)) {
+      column.GetValue(row, &table_row->AllocColumn(column.id()).value);
+    }
+  }
+}
+
+std::string ColumnarRowBatch::ToString() const {
+  return Format("{ num_columns: $0 num_rows: $1 selected: $2 }",
+                columns_.size(), num_rows_, CountSelected());
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,187 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yb/common/column_id.h"
+#include "yb/common/common_fwd.h"
+#include "yb/common/value.pb.h"
+
+namespace yb {
+namespace docdb {
+
+// Values of a single column for a batch of rows.
+//
+// Fixed width types (integers, bool, timestamp, float and double) are stored in plain arrays, so
+// they could be consumed by tight loops without touching protobuf objects. Values of all other
+// types are stored as QLValuePB. Nulls are tracked by a separate bitmap.
+class ColumnVector {
+ public:
+  enum class Layout {
+    kInt,
+    kReal,
+    kValue,
+  };
+
+  ColumnVector(ColumnId id, DataType type);
+
+  ColumnId id() const {
+    return id_;
+  }
+
+  DataType type() const {
+    return type_;
+  }
+
+  Layout layout() const {
+    return layout_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool IsNull(size_t row) const {
+    return (nulls_[row / 64] >> (row % 64)) & 1;
+  }
+
+  // Number of non null values in the first size() rows.
+  size_t CountNotNull() const;
+
+  // Raw storage access. Valid only for the corresponding layout. Entries for null rows are zeroed.
+  const int64_t* int_data() const {
+    return ints_.data();
+  }
+
+  const double* real_data() const {
+    return reals_.data();
+  }
+
+  const uint64_t* null_bitmap() const {
+    return nulls_.data();
+  }
+
+  const QLValuePB& value(size_t row) const {
+    return values_[row];
+  }
+
+  void AppendNull();
+
+  // Appends value, that should have the type compatible with the column type.
+  void Append(const QLValuePB& value);
+
+  // Pads column with nulls up to the specified number of rows.
+  void PadTo(size_t num_rows);
+
+  // Converts value at the specified row back to QLValuePB.
+  void GetValue(size_t row, QLValuePB* out) const;
+
+  // Removes all values, but keeps allocated memory.
+  void Clear();
+
+  static bool IsFixedWidth(DataType type);
+
+ private:
+  void AppendNullBit(bool is_null);
+
+  ColumnId id_;
+  DataType type_;
+  Layout layout_;
+  size_t size_ = 0;
+  std::vector<int64_t> ints_;
+  std::vector<double> reals_;
+  std::vector<QLValuePB> values_;
+  std::vector<uint64_t> nulls_;
+};
+
+// Batch of rows in columnar format produced by YQLRowwiseIteratorIf::NextRowBatch.
+//
+// Columns are registered once, and then reused for subsequent batches, so memory allocated for
+// column data is reused as well. Each batch also contains a selection vector. Initially all rows
+// are selected, filters could unselect rows, that should not be processed further.
+class ColumnarRowBatch {
+ public:
+  ColumnarRowBatch() = default;
+
+  ColumnarRowBatch(const ColumnarRowBatch&) = delete;
+  void operator=(const ColumnarRowBatch&) = delete;
+
+  // Registers new column in batch. Should be called before first row is added.
+  ColumnVector& AddColumn(ColumnId id, DataType type);
+
+  // Registers all columns of the schema.
+  void AddColumns(const Schema& schema);
+
+  size_t num_columns() const {
+    return columns_.size();
+  }
+
+  size_t num_rows() const {
+    return num_rows_;
+  }
+
+  bool empty() const {
+    return num_rows_ == 0;
+  }
+
+  ColumnVector& column(size_t idx) {
+    return columns_[idx];
+  }
+
+  const ColumnVector& column(size_t idx) const {
+    return columns_[idx];
+  }
+
+  // Returns column with specified id, or nullptr if it was not registered.
+  const ColumnVector* FindColumn(ColumnId id) const;
+
+  // Completes row that is being added. Columns that were not filled for this row are set to null.
+  void FinishRow();
+
+  // Removes all rows, but keeps registered columns.
+  void Clear();
+
+  bool IsSelected(size_t row) const {
+    return selection_[row] != 0;
+  }
+
+  void Unselect(size_t row) {
+    selection_[row] = 0;
+  }
+
+  const uint8_t* selection() const {
+    return selection_.data();
+  }
+
+  uint8_t* mutable_selection() {
+    return selection_.data();
+  }
+
+  size_t CountSelected() const;
+
+  // Materializes the specified row into table_row. Used for fallback to row-by-row evaluation.
+  void ExtractRow(size_t row, QLTableRow* table_row) const;
+
+  std::string ToString() const;
+
+ private:
+  std::vector<ColumnVector> columns_;
+  std::vector<uint8_t> selection_;
+  size_t num_rows_ = 0;
+};
+
+}  // namespace docdb
+}  // namespace yb
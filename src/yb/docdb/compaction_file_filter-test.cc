@@ -477,5 +477,67 @@ TEST_F(ExpirationFilterTest, TestFilterMixTableAndValueTTLWithTrustValueTTLFlag)
   TestFilterFilesAgainstResults(&factory, frontiers, expected_results);
 }
 
+TEST_F(ExpirationFilterTest, TestOutputPathSelector) {
+  constexpr uint32_t kPickedPathId = 0;
+  constexpr uint32_t kColdPathId = 1;
+  DocDBCompactionOutputPathSelector selector(
+      clock_, MonoDelta::FromSeconds(1000), /* min_cold_ratio = */ 0.8, kColdPathId);
+  auto now = clock_->Now();
+  auto old_frontier = CreateConsensusFrontier(now.AddSeconds(-10000));
+  auto recent_frontier = CreateConsensusFrontier(now.AddSeconds(-10));
+
+  struct TestFile {
+    ConsensusFrontier frontier;
+    uint64_t size;
+    uint32_t path_id = kPickedPathId;
+  };
+  auto select = [&selector](const std::vector<TestFile>& files) {
+    std::vector<ConsensusFrontier> frontiers;
+    for (const auto& file : files) {
+      frontiers.push_back(file.frontier);
+    }
+    auto file_ptrs = CreateFilePtrs(frontiers);
+    for (size_t i = 0; i != files.size(); ++i) {
+      file_ptrs[i]->fd = rocksdb::FileDescriptor(
+          i + 1, files[i].path_id, files[i].size, files[i].size);
+    }
+    auto result = selector.SelectOutputPathId(file_ptrs, kPickedPathId);
+    DeleteFilePtrs(&file_ptrs);
+    return result;
+  };
+
+  // All files are older than cold age.
+  EXPECT_EQ(kColdPathId, select({
+    {old_frontier, 100},
+    {CreateConsensusFrontier(now.AddSeconds(-2000)), 100},
+  }));
+  // Most of the input is recent data.
+  EXPECT_EQ(kPickedPathId, select({
+    {old_frontier, 100},
+    {recent_frontier, 100},
+  }));
+  // Large old sorted run is compacted together with small recent ones, as universal compaction
+  // does.
+  EXPECT_EQ(kColdPathId, select({
+    {old_frontier, 1000},
+    {recent_frontier, 10},
+    {recent_frontier, 10},
+  }));
+  // File on the cold path has recent frontier, because it was produced by compaction that
+  // included recent data.
+  EXPECT_EQ(kColdPathId, select({
+    {recent_frontier, 1000, kColdPathId},
+    {recent_frontier, 10},
+  }));
+  EXPECT_EQ(kPickedPathId, select({
+    {recent_frontier, 10, kColdPathId},
+    {recent_frontier, 1000},
+  }));
+
+  // File without frontier is never considered cold.
+  auto file = CreateFile();
+  EXPECT_EQ(kPickedPathId, selector.SelectOutputPathId({&file}, kPickedPathId));
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -192,6 +192,36 @@ const char* DocDBCompactionFileFilterFactory::Name() const {
   return "DocDBCompactionFileFilterFactory";
 }
 
+uint32_t DocDBCompactionOutputPathSelector::SelectOutputPathId(
+    const vector<FileMetaData*>& input_files, uint32_t picked_path_id) {
+  const HybridTime cold_cutoff = clock_->Now().AddDelta(-cold_age_);
+  uint64_t total_size = 0;
+  uint64_t cold_size = 0;
+  for (auto file : input_files) {
+    // Count empty files as one byte, so they still affect the decision.
+    const auto size = std::max<uint64_t>(file->fd.GetTotalFileSize(), 1);
+    total_size += size;
+    // Output of a compaction placed on the cold path has the frontier of its newest input, so
+    // files already on the cold path are considered cold regardless of their frontier.
+    if (file->fd.GetPathId() == cold_path_id_ ||
+        ExtractExpirationTime(file).created_ht < cold_cutoff) {
+      cold_size += size;
+    }
+  }
+  if (total_size == 0 || cold_size < min_cold_ratio_ * total_size) {
+    VLOG(4) << "Cold input size " << cold_size << " of " << total_size << " for cold cutoff "
+            << cold_cutoff << ", keeping compaction output on path " << picked_path_id;
+    return picked_path_id;
+  }
+  VLOG(2) << "Cold input size " << cold_size << " of " << total_size << " for cold cutoff "
+          << cold_cutoff << ", placing compaction output on path " << cold_path_id_;
+  return cold_path_id_;
+}
+
+const char* DocDBCompactionOutputPathSelector::Name() const {
+  return "DocDBCompactionOutputPathSelector";
+}
+
 std::string ExpirationTime::ToString() const {
   return YB_STRUCT_TO_STRING(ttl_expiration_ht, created_ht);
 }
@@ -104,5 +104,33 @@ class DocDBCompactionFileFilterFactory : public rocksdb::CompactionFileFilterFac
   scoped_refptr<server::Clock> clock_;
 };
 
+// DocDBCompactionOutputPathSelector places output of a compaction on cold_path_id when cold input
+// files make up at least min_cold_ratio of the total input size. An input file is cold when it
+// already resides on cold_path_id, or when the maximum HybridTime of its ConsensusFrontier is older
+// than cold_age. Files without a frontier are never considered cold by age.
+//
+// Weighting by size is required for universal compaction, where every compaction includes the
+// newest sorted runs: a full compaction of a large old run with a few small recent ones still
+// moves the data to the cold path.
+class DocDBCompactionOutputPathSelector : public rocksdb::CompactionOutputPathSelector {
+ public:
+  DocDBCompactionOutputPathSelector(
+      scoped_refptr<server::Clock> clock, MonoDelta cold_age, double min_cold_ratio,
+      uint32_t cold_path_id)
+      : clock_(std::move(clock)), cold_age_(cold_age), min_cold_ratio_(min_cold_ratio),
+        cold_path_id_(cold_path_id) {}
+
+  uint32_t SelectOutputPathId(
+      const std::vector<rocksdb::FileMetaData*>& input_files, uint32_t picked_path_id) override;
+
+  const char* Name() const override;
+
+ private:
+  scoped_refptr<server::Clock> clock_;
+  const MonoDelta cold_age_;
+  const double min_cold_ratio_;
+  const uint32_t cold_path_id_;
+};
+
 }  // namespace docdb
 }  // namespace yb
@@ -14,15 +14,26 @@
 //
 
 #include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/table/data_block_boundaries.h"
+#include "yb/rocksdb/table_properties.h"
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/value_type.h"
 
 #include "yb/gutil/casts.h"
+#include "yb/util/flags.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 
+DEFINE_RUNTIME_bool(docdb_collect_data_block_boundaries, false,
+                    "Whether to store smallest and largest range key components of each data "
+                    "block in SST files, so range scans could skip data blocks that do not match "
+                    "their bounds. Applied to SST files created after the change. Boundaries are "
+                    "stored in table properties, so they grow linearly with the number of data "
+                    "blocks and are kept in memory for every open SST file.");
+TAG_FLAG(docdb_collect_data_block_boundaries, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -70,8 +81,111 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
   }
 };
 
+// Collects smallest and largest values of range components for each data block of SST file.
+// Only components present in all keys of the block are recorded. For instance, block containing
+// table tombstone, i.e. key without range components, does not get boundaries at all, since such
+// key affects rows with any range components.
+class DocDataBlockBoundariesCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  Status AddUserKey(const Slice& key, const Slice& value, rocksdb::EntryType type,
+                    rocksdb::SequenceNumber seq, uint64_t file_size) override {
+    if (!enabled_) {
+      return Status::OK();
+    }
+
+    values_.clear();
+    if (!extractor_.Extract(key, &values_).ok()) {
+      // Block with undecodable key is just not filtered.
+      values_.clear();
+    }
+
+    const bool first_key = num_block_keys_ == 0;
+    ++num_block_keys_;
+    if (first_key || values_.size() < num_components_) {
+      num_components_ = values_.size();
+      smallest_.resize(num_components_);
+      largest_.resize(num_components_);
+    }
+    for (size_t i = 0; i != num_components_; ++i) {
+      const auto& component = values_[i].value;
+      if (first_key || component.compare(smallest_[i]) < 0) {
+        smallest_[i].assign(component.cdata(), component.size());
+      }
+      if (first_key || component.compare(largest_[i]) > 0) {
+        largest_[i].assign(component.cdata(), component.size());
+      }
+    }
+    return Status::OK();
+  }
+
+  Status DataBlockFinished(uint64_t block_offset) override {
+    if (num_components_ != 0) {
+      boost::container::small_vector<rocksdb::UserBoundaryValueRef, 10> smallest, largest;
+      for (size_t i = 0; i != num_components_; ++i) {
+        const auto tag = TagForRangeComponent(i);
+        smallest.push_back(rocksdb::UserBoundaryValueRef {
+          .tag = tag,
+          .value = smallest_[i],
+        });
+        largest.push_back(rocksdb::UserBoundaryValueRef {
+          .tag = tag,
+          .value = largest_[i],
+        });
+      }
+      builder_.Add(block_offset, smallest, largest);
+    }
+    num_block_keys_ = 0;
+    num_components_ = 0;
+    return Status::OK();
+  }
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override {
+    if (!builder_.empty()) {
+      properties->emplace(rocksdb::kDataBlockBoundariesPropertyName, builder_.Finish());
+    }
+    return Status::OK();
+  }
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override {
+    return rocksdb::UserCollectedProperties();
+  }
+
+  const char* Name() const override {
+    return "DocDataBlockBoundariesCollector";
+  }
+
+ private:
+  const bool enabled_ = FLAGS_docdb_collect_data_block_boundaries;
+  DocBoundaryValuesExtractor extractor_;
+  boost::container::small_vector<rocksdb::UserBoundaryValueRef, 10> values_;
+  size_t num_block_keys_ = 0;
+  size_t num_components_ = 0;
+  std::vector<std::string> smallest_;
+  std::vector<std::string> largest_;
+  rocksdb::DataBlockBoundariesBuilder builder_;
+};
+
+class DocDataBlockBoundariesCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override {
+    return new DocDataBlockBoundariesCollector();
+  }
+
+  const char* Name() const override {
+    return "DocDataBlockBoundariesCollectorFactory";
+  }
+};
+
 } // namespace
 
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory>
+    DocDataBlockBoundariesCollectorFactoryInstance() {
+  static std::shared_ptr<rocksdb::TablePropertiesCollectorFactory> instance =
+      std::make_shared<DocDataBlockBoundariesCollectorFactory>();
+  return instance;
+}
+
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance() {
   static std::shared_ptr<rocksdb::BoundaryValuesExtractor> instance =
       std::make_shared<DocBoundaryValuesExtractor>();
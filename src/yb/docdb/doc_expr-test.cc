@@ -0,0 +1,203 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/bfpg/tserver_opcodes.h"
+
+#include "yb/common/ql_value.h"
+#include "yb/common/pgsql_protocol.pb.h"
+
+#include "yb/docdb/columnar_row_batch.h"
+#include "yb/docdb/doc_expr.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const ColumnId kInt32Column(10);
+const ColumnId kInt64Column(11);
+const ColumnId kFloatColumn(12);
+const ColumnId kDoubleColumn(13);
+
+struct ColumnInfo {
+  ColumnId id;
+  DataType type;
+};
+
+const std::vector<ColumnInfo> kColumns = {
+  {kInt32Column, DataType::INT32},
+  {kInt64Column, DataType::INT64},
+  {kFloatColumn, DataType::FLOAT},
+  {kDoubleColumn, DataType::DOUBLE},
+};
+
+// Each row contains value for every column from kColumns, null values are not set.
+using TestRow = std::vector<QLValuePB>;
+
+std::vector<TestRow> GenerateRows(size_t num_rows) {
+  std::vector<TestRow> result;
+  for (size_t i = 0; i != num_rows; ++i) {
+    TestRow row(kColumns.size());
+    // Use small integral values, so real sums are exact regardless of the evaluation order.
+    if (RandomUniformInt(0, 4) != 0) {
+      row[0].set_int32_value(RandomUniformInt(-100, 100));
+    }
+    if (RandomUniformInt(0, 4) != 0) {
+      row[1].set_int64_value(RandomUniformInt<int64_t>(-1000000, 1000000));
+    }
+    if (RandomUniformInt(0, 4) != 0) {
+      row[2].set_float_value(RandomUniformInt(-100, 100));
+    }
+    if (RandomUniformInt(0, 4) != 0) {
+      row[3].set_double_value(RandomUniformInt(-100, 100));
+    }
+    result.push_back(std::move(row));
+  }
+  return result;
+}
+
+PgsqlBCallPB MakeCall(bfpg::TSOpcode opcode, ColumnId column_id) {
+  PgsqlBCallPB result;
+  result.set_opcode(static_cast<int32_t>(opcode));
+  result.add_operands()->set_column_id(column_id.rep());
+  return result;
+}
+
+// COUNT(*) is sent as COUNT over a constant operand.
+PgsqlBCallPB MakeCountStar() {
+  PgsqlBCallPB result;
+  result.set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+  result.add_operands()->mutable_value()->set_int64_value(1);
+  return result;
+}
+
+std::vector<PgsqlBCallPB> AllCalls() {
+  std::vector<PgsqlBCallPB> result;
+  result.push_back(MakeCountStar());
+  for (const auto& column : kColumns) {
+    result.push_back(MakeCall(bfpg::TSOpcode::kCount, column.id));
+    result.push_back(MakeCall(bfpg::TSOpcode::kMin, column.id));
+    result.push_back(MakeCall(bfpg::TSOpcode::kMax, column.id));
+  }
+  result.push_back(MakeCall(bfpg::TSOpcode::kSumInt32, kInt32Column));
+  result.push_back(MakeCall(bfpg::TSOpcode::kSumInt64, kInt64Column));
+  result.push_back(MakeCall(bfpg::TSOpcode::kSumFloat, kFloatColumn));
+  result.push_back(MakeCall(bfpg::TSOpcode::kSumDouble, kDoubleColumn));
+  return result;
+}
+
+// Evaluates aggregate over rows one by one, the same way as it is done without columnar scan.
+QLValuePB EvalRowByRow(
+    const PgsqlBCallPB& call, const std::vector<TestRow>& rows, const std::vector<bool>& selected) {
+  DocExprExecutor executor;
+  QLValuePB result;
+  for (size_t i = 0; i != rows.size(); ++i) {
+    if (!selected[i]) {
+      continue;
+    }
+    QLTableRow table_row;
+    for (size_t c = 0; c != kColumns.size(); ++c) {
+      if (!IsNull(rows[i][c])) {
+        table_row.AllocColumn(kColumns[c].id, rows[i][c]);
+      }
+    }
+    CHECK_OK(executor.EvalTSCall(call, table_row, &result, nullptr));
+  }
+  return result;
+}
+
+// Evaluates aggregate over batches of up to batch_size rows.
+QLValuePB EvalBatched(
+    const PgsqlBCallPB& call, const std::vector<TestRow>& rows, const std::vector<bool>& selected,
+    size_t batch_size) {
+  DocExprExecutor executor;
+  QLValuePB result;
+  ColumnarRowBatch batch;
+  for (const auto& column : kColumns) {
+    batch.AddColumn(column.id, column.type);
+  }
+  size_t row = 0;
+  do {
+    batch.Clear();
+    auto batch_start = row;
+    for (; row != rows.size() && row - batch_start != batch_size; ++row) {
+      for (size_t c = 0; c != kColumns.size(); ++c) {
+        if (!IsNull(rows[row][c])) {
+          batch.column(c).Append(rows[row][c]);
+        }
+      }
+      batch.FinishRow();
+    }
+    for (size_t i = 0; i != batch.num_rows(); ++i) {
+      if (!selected[batch_start + i]) {
+        batch.Unselect(i);
+      }
+    }
+    // Empty batches are also evaluated, they should not affect the result.
+    CHECK_OK(executor.EvalAggregateBatch(call, batch, &result));
+  } while (row != rows.size());
+  return result;
+}
+
+void CheckAggregates(const std::vector<TestRow>& rows, const std::vector<bool>& selected) {
+  for (const auto& call : AllCalls()) {
+    auto expected = EvalRowByRow(call, rows, selected);
+    for (size_t batch_size : {1, 2, 5, 64}) {
+      auto actual = EvalBatched(call, rows, selected, batch_size);
+      ASSERT_EQ(expected.ShortDebugString(), actual.ShortDebugString())
+          << "Call: " << call.ShortDebugString() << ", batch size: " << batch_size
+          << ", rows: " << rows.size();
+    }
+  }
+}
+
+} // namespace
+
+TEST(DocExprTest, AggregateBatch) {
+  for (size_t num_rows : {0, 1, 5, 13, 64, 100}) {
+    auto rows = GenerateRows(num_rows);
+    std::vector<bool> selected(num_rows, true);
+    ASSERT_NO_FATALS(CheckAggregates(rows, selected));
+    for (size_t i = 0; i != num_rows; ++i) {
+      selected[i] = RandomUniformBool();
+    }
+    ASSERT_NO_FATALS(CheckAggregates(rows, selected));
+    std::fill(selected.begin(), selected.end(), false);
+    ASSERT_NO_FATALS(CheckAggregates(rows, selected));
+  }
+}
+
+TEST(DocExprTest, AggregateBatchAllNulls) {
+  std::vector<TestRow> rows(10, TestRow(kColumns.size()));
+  std::vector<bool> selected(rows.size(), true);
+  ASSERT_NO_FATALS(CheckAggregates(rows, selected));
+}
+
+TEST(DocExprTest, CountNullBatch) {
+  PgsqlBCallPB call;
+  call.set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+  SetNull(call.add_operands()->mutable_value());
+  auto rows = GenerateRows(10);
+  std::vector<bool> selected(rows.size(), true);
+  ASSERT_EQ(EvalRowByRow(call, rows, selected).ShortDebugString(),
+            EvalBatched(call, rows, selected, 3).ShortDebugString());
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -17,6 +17,7 @@
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
 
+#include "yb/docdb/columnar_row_batch.h"
 #include "yb/docdb/docdb_pgapi.h"
 
 #include "yb/gutil/endian.h"
@@ -422,6 +423,186 @@ Status DocExprExecutor::EvalAvg(const Val& val, Val *aggr_avg) {
 
 namespace {
 
+// Returns the batch column referenced by the aggregate operand, or nullptr if operand is not
+// a column reference.
+Result<const ColumnVector*> AggregateOperandColumn(
+    const PgsqlExpressionPB& operand, const ColumnarRowBatch& batch) {
+  if (!operand.has_column_id()) {
+    return nullptr;
+  }
+  const auto* column = batch.FindColumn(ColumnId(operand.column_id()));
+  SCHECK(column != nullptr, InternalError,
+         Format("Column $0 is missing in the row batch", operand.column_id()));
+  return column;
+}
+
+template <class Value>
+void SumBatch(
+    const ColumnarRowBatch& batch, const ColumnVector& column, const Value* data, Value* sum,
+    bool* found) {
+  for (size_t row = 0; row != batch.num_rows(); ++row) {
+    if (batch.IsSelected(row) && !column.IsNull(row)) {
+      // Real values are accumulated in the order of rows to match row by row evaluation.
+      *sum = *found ? *sum + data[row] : data[row];
+      *found = true;
+    }
+  }
+}
+
+// Finds the selected row with the minimal (kIsMin) or maximal value in the column.
+template <bool kIsMin, class Value>
+boost::optional<size_t> FindExtremeRow(
+    const ColumnarRowBatch& batch, const ColumnVector& column, const Value* data) {
+  boost::optional<size_t> result;
+  for (size_t row = 0; row != batch.num_rows(); ++row) {
+    if (!batch.IsSelected(row) || column.IsNull(row)) {
+      continue;
+    }
+    if (!result || (kIsMin ? data[row] < data[*result] : data[*result] < data[row])) {
+      result = row;
+    }
+  }
+  return result;
+}
+
+template <bool kIsMin>
+boost::optional<size_t> FindExtremeRow(const ColumnarRowBatch& batch, const ColumnVector& column) {
+  if (column.layout() == ColumnVector::Layout::kInt) {
+    return FindExtremeRow<kIsMin>(batch, column, column.int_data());
+  }
+  return FindExtremeRow<kIsMin>(batch, column, column.real_data());
+}
+
+} // namespace
+
+bool DocExprExecutor::CanEvalAggregateBatch(const PgsqlExpressionPB& expr, const Schema& schema) {
+  if (!expr.has_tscall() || expr.tscall().operands().size() != 1) {
+    return false;
+  }
+  const auto& operand = *expr.tscall().operands().begin();
+  const auto tsopcode = static_cast<bfpg::TSOpcode>(expr.tscall().opcode());
+  if (tsopcode == bfpg::TSOpcode::kCount && !operand.has_column_id()) {
+    return operand.has_value();
+  }
+  if (!operand.has_column_id() || operand.column_id() < 0) {
+    return false;
+  }
+  auto column = schema.column_by_id(ColumnId(operand.column_id()));
+  if (!column.ok()) {
+    return false;
+  }
+  const auto type = column->type()->main();
+  switch (tsopcode) {
+    case bfpg::TSOpcode::kCount:
+      return true;
+    case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt64:
+      return type == DataType::INT8 || type == DataType::INT16 || type == DataType::INT32 ||
+             type == DataType::INT64;
+    case bfpg::TSOpcode::kSumFloat:
+      return type == DataType::FLOAT;
+    case bfpg::TSOpcode::kSumDouble:
+      return type == DataType::DOUBLE;
+    case bfpg::TSOpcode::kMin: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kMax:
+      return ColumnVector::IsFixedWidth(type) && type != DataType::BOOL;
+    default:
+      return false;
+  }
+}
+
+Status DocExprExecutor::EvalAggregateBatch(
+    const PgsqlBCallPB& tscall, const ColumnarRowBatch& batch, QLValuePB* result) {
+  const auto& operand = *tscall.operands().begin();
+  const auto* column = VERIFY_RESULT(AggregateOperandColumn(operand, batch));
+  const auto tsopcode = static_cast<bfpg::TSOpcode>(tscall.opcode());
+  switch (tsopcode) {
+    case bfpg::TSOpcode::kCount: {
+      if (!column && operand.has_value() && IsNull(operand.value())) {
+        // We've got COUNT(null) which is bound to return zero.
+        return Status::OK();
+      }
+      int64_t count = 0;
+      for (size_t row = 0; row != batch.num_rows(); ++row) {
+        count += batch.IsSelected(row) && (!column || !column->IsNull(row));
+      }
+      if (count) {
+        result->set_int64_value(IsNull(*result) ? count : result->int64_value() + count);
+      }
+      return Status::OK();
+    }
+
+    case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt64: {
+      SCHECK(column && column->layout() == ColumnVector::Layout::kInt, InternalError,
+             "Integer column expected");
+      bool found = !IsNull(*result);
+      int64_t sum = found ? result->int64_value() : 0;
+      SumBatch(batch, *column, column->int_data(), &sum, &found);
+      if (found) {
+        result->set_int64_value(sum);
+      }
+      return Status::OK();
+    }
+
+    case bfpg::TSOpcode::kSumFloat: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumDouble: {
+      SCHECK(column && column->layout() == ColumnVector::Layout::kReal, InternalError,
+             "Real column expected");
+      bool found = !IsNull(*result);
+      if (tsopcode == bfpg::TSOpcode::kSumDouble) {
+        double sum = found ? result->double_value() : 0;
+        SumBatch(batch, *column, column->real_data(), &sum, &found);
+        if (found) {
+          result->set_double_value(sum);
+        }
+        return Status::OK();
+      }
+      // Float sum is accumulated with float precision, the same way as row by row evaluation does.
+      float sum = found ? result->float_value() : 0;
+      for (size_t row = 0; row != batch.num_rows(); ++row) {
+        if (batch.IsSelected(row) && !column->IsNull(row)) {
+          sum = found ? sum + static_cast<float>(column->real_data()[row])
+                      : static_cast<float>(column->real_data()[row]);
+          found = true;
+        }
+      }
+      if (found) {
+        result->set_float_value(sum);
+      }
+      return Status::OK();
+    }
+
+    case bfpg::TSOpcode::kMin: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kMax: {
+      SCHECK(column && column->layout() != ColumnVector::Layout::kValue, InternalError,
+             "Fixed width column expected");
+      auto row = tsopcode == bfpg::TSOpcode::kMin ? FindExtremeRow<true>(batch, *column)
+                                                  : FindExtremeRow<false>(batch, *column);
+      if (!row) {
+        return Status::OK();
+      }
+      QLValuePB value;
+      column->GetValue(*row, &value);
+      return tsopcode == bfpg::TSOpcode::kMin ? EvalMin(value, result) : EvalMax(value, result);
+    }
+
+    default:
+      break;
+  }
+  return STATUS_FORMAT(
+      NotSupported, "Batch evaluation is not supported for operator $0",
+      static_cast<int>(tsopcode));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+namespace {
+
 void UnpackUDTAndFrozen(const QLType::SharedPtr& type, QLValuePB* value) {
   if (type->IsUserDefined() && value->value_case() == QLValuePB::kMapValue) {
     // Change MAP<field_index:field_value> into MAP<field_name:field_value>
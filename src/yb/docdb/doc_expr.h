@@ -8,6 +8,8 @@
 
 #include "yb/common/ql_expr.h"
 
+#include "yb/docdb/docdb_fwd.h"
+
 namespace yb {
 namespace docdb {
 
@@ -38,6 +40,14 @@ class DocExprExecutor : public QLExprExecutor {
                     QLValuePB *result,
                     const Schema *schema) override;
 
+  // Whether the aggregate expression could be evaluated over a columnar row batch.
+  static bool CanEvalAggregateBatch(const PgsqlExpressionPB& expr, const Schema& schema);
+
+  // Accumulate aggregate function over the selected rows of the batch into result.
+  Status EvalAggregateBatch(const PgsqlBCallPB& tscall,
+                            const ColumnarRowBatch& batch,
+                            QLValuePB *result);
+
  protected:
   // Evaluate aggregate functions for each row.
   template <class Val>
@@ -11,8 +11,11 @@
 // under the License.
 //
 
+#include <map>
 #include <thread>
 
+#include "yb/bfpg/tserver_opcodes.h"
+
 #include "yb/common/common.pb.h"
 #include "yb/common/index.h"
 #include "yb/common/ql_protocol_util.h"
@@ -28,6 +31,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
+#include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/redis_operation.h"
 
@@ -42,6 +46,8 @@
 #include "yb/util/size_literals.h"
 #include "yb/util/tostring.h"
 
+#include "yb/yql/pggate/util/pg_wire.h"
+
 using std::vector;
 
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
@@ -49,6 +55,7 @@ DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
 DECLARE_int32(test_random_seed);
+DECLARE_uint64(ysql_grouped_aggregate_max_memory_bytes);
 
 using namespace std::literals; // NOLINT
 
@@ -655,6 +662,103 @@ SubDocKey(DocKey(0x0000, [101], []), [ColumnId(3); HT{ physical: 0 logical: 3000
   EXPECT_TRUE(IsNull(value_map_system.TestValue(3).value));
 }
 
+// When partial aggregates of the groups exceed the memory limit, accumulated groups are added to
+// the response and grouping starts over. Merged partial aggregates should match the whole data.
+TEST_F(DocOperationTest, PgsqlGroupedAggregateMemoryLimit) {
+  constexpr int32_t kNumRows = 200;
+  constexpr int32_t kNumGroups = 10;
+  constexpr size_t kValueSize = 1_KB;
+
+  const std::vector<ColumnSchema> columns({
+      ColumnSchema("k", INT32, false, false),
+      ColumnSchema("g", INT32, false, false),
+      ColumnSchema("v", STRING, false, false)});
+  const Schema schema(columns, CreateColumnIds(columns.size()), 1);
+  auto doc_read_context = DocReadContext::TEST_Create(schema);
+
+  // Expected max(v) and count(*) of each group.
+  std::map<int32_t, std::pair<std::string, int64_t>> expected;
+  for (int32_t k = 0; k != kNumRows; ++k) {
+    const auto group = k % kNumGroups;
+    const auto value = RandomHumanReadableString(kValueSize);
+    KeyBytes encoded_doc_key(DocKey(KeyEntryValues(k)).Encode());
+    ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, KeyEntryValue::MakeColumnId(ColumnId(1))),
+                           QLValue::Primitive(group), HybridTime(1000)));
+    ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, KeyEntryValue::MakeColumnId(ColumnId(2))),
+                           QLValue::Primitive(value), HybridTime(1000)));
+    auto& [max_value, count] = expected[group];
+    max_value = std::max(max_value, value);
+    ++count;
+  }
+
+  // SELECT g, max(v), count(*) FROM t GROUP BY g
+  PgsqlReadRequestPB request;
+  request.set_is_aggregate(true);
+  request.add_grouping_column_ids(1);
+  request.add_targets()->set_column_id(1);
+  auto* max_call = request.add_targets()->mutable_tscall();
+  max_call->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kMax));
+  max_call->add_operands()->set_column_id(2);
+  auto* count_call = request.add_targets()->mutable_tscall();
+  count_call->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+  count_call->add_operands()->mutable_value()->set_int64_value(0);
+  request.mutable_column_refs()->add_ids(1);
+  request.mutable_column_refs()->add_ids(2);
+
+  for (uint64_t memory_limit : {1_MB, 4_KB}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_grouped_aggregate_max_memory_bytes) = memory_limit;
+    PgsqlReadOperation read_op(request, kNonTransactionalOperationContext);
+    QLRocksDBStorage ql_storage(doc_db());
+    WriteBuffer rows_data(1024);
+    HybridTime read_restart_ht;
+    const auto num_rows = ASSERT_RESULT(read_op.Execute(
+        ql_storage, CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(1000),
+        false /* is_explicit_request_read_time */, doc_read_context,
+        nullptr /* index_doc_read_context */, &rows_data, &read_restart_ht));
+    LOG(INFO) << "Memory limit: " << memory_limit << ", returned rows: " << num_rows;
+    if (memory_limit > kNumGroups * 2 * kValueSize) {
+      ASSERT_EQ(kNumGroups, static_cast<int32_t>(num_rows));
+    } else {
+      // Max values alone do not fit into the limit, so groups are returned several times.
+      ASSERT_GT(static_cast<int32_t>(num_rows), kNumGroups);
+    }
+
+    // Merge partial aggregates, as client does.
+    auto data_str = rows_data.ToBuffer();
+    Slice data(data_str);
+    auto read_header = [&data] {
+      uint8_t header = 0;
+      data.remove_prefix(pggate::PgWire::ReadNumber(&data, &header));
+      ASSERT_FALSE(pggate::PgWireDataHeader(header).is_null());
+    };
+    int64_t wire_num_rows = 0;
+    data.remove_prefix(pggate::PgWire::ReadNumber(&data, &wire_num_rows));
+    ASSERT_EQ(static_cast<int64_t>(num_rows), wire_num_rows);
+    std::map<int32_t, std::pair<std::string, int64_t>> merged;
+    for (size_t i = 0; i != num_rows; ++i) {
+      int32_t group = 0;
+      ASSERT_NO_FATALS(read_header());
+      data.remove_prefix(pggate::PgWire::ReadNumber(&data, &group));
+      int64_t length = 0;
+      std::string max_value;
+      ASSERT_NO_FATALS(read_header());
+      data.remove_prefix(pggate::PgWire::ReadNumber(&data, &length));
+      // Text is written with trailing zero.
+      data.remove_prefix(pggate::PgWire::ReadString(&data, &max_value, length));
+      max_value.pop_back();
+      int64_t count = 0;
+      ASSERT_NO_FATALS(read_header());
+      data.remove_prefix(pggate::PgWire::ReadNumber(&data, &count));
+
+      auto& merged_group = merged[group];
+      merged_group.first = std::max(merged_group.first, max_value);
+      merged_group.second += count;
+    }
+    ASSERT_TRUE(data.empty());
+    ASSERT_EQ(expected, merged);
+  }
+}
+
 namespace {
 
 int32_t NewInt(std::mt19937_64* rng, std::unordered_set<int32_t>* existing) {
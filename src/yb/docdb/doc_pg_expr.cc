@@ -13,14 +13,22 @@
 
 #include <list>
 
+#include "yb/docdb/columnar_predicate.h"
+#include "yb/docdb/columnar_row_batch.h"
 #include "yb/docdb/doc_pg_expr.h"
 #include "yb/docdb/docdb_pgapi.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/yql/pggate/pg_value.h"
 
 using yb::pggate::PgValueToPB;
 
+DEFINE_RUNTIME_bool(ysql_enable_columnar_predicate_kernels, true,
+    "Evaluate simple comparisons of fixed width columns with constants, pushed down in YSQL where "
+    "clause, over columnar row batches using vectorized kernels instead of the Postgres "
+    "expression evaluator.");
+
 namespace yb {
 namespace docdb {
 
@@ -29,6 +37,29 @@ namespace docdb {
 // Deserialized Postgres expression paired with type information to convert results to DocDB format
 typedef std::pair<YbgPreparedExpr, DocPgVarRef> DocPgEvalExprData;
 
+// Where clause expression, that is a comparison of a column with a constant, so it could be
+// evaluated over a columnar row batch without the Postgres expression evaluator.
+struct DocPgColumnComparison {
+  YbgPreparedExpr expr;
+  YbgColumnComparison cmp;
+};
+
+namespace {
+
+ColumnarCompareOp ToColumnarCompareOp(YbgCompareOp op) {
+  switch (op) {
+    case YBG_CMP_EQ: return ColumnarCompareOp::kEq;
+    case YBG_CMP_NE: return ColumnarCompareOp::kNe;
+    case YBG_CMP_LT: return ColumnarCompareOp::kLt;
+    case YBG_CMP_LE: return ColumnarCompareOp::kLe;
+    case YBG_CMP_GT: return ColumnarCompareOp::kGt;
+    case YBG_CMP_GE: return ColumnarCompareOp::kGe;
+  }
+  FATAL_INVALID_ENUM_VALUE(YbgCompareOp, op);
+}
+
+} // namespace
+
 class DocPgExprExecutor::Private {
  public:
   Private() {
@@ -79,6 +110,15 @@ class DocPgExprExecutor::Private {
     RETURN_NOT_OK(prepare_pg_expr_call(ql_expr, schema, &expr, nullptr));
     // Store the Postgres expression in the list
     where_clause_.push_back(expr);
+    // Remember if the expression could be evaluated over a columnar row batch
+    DocPgColumnComparison comparison{expr, {}};
+    bool is_comparison = false;
+    RETURN_NOT_OK(DocPgGetColumnComparison(expr, &comparison.cmp, &is_comparison));
+    if (is_comparison) {
+      comparisons_.push_back(comparison);
+    } else {
+      batch_where_clause_.push_back(expr);
+    }
     VLOG(1) << "A condition has been added";
     return Status::OK();
   }
@@ -140,6 +180,15 @@ class DocPgExprExecutor::Private {
     return s;
   }
 
+  // Retrieve referenced values from the specified row of the batch
+  Status PreparePgRowData(const ColumnarRowBatch& batch, size_t row) {
+    if (var_map_.empty()) {
+      return Status::OK();
+    }
+    RETURN_NOT_OK(ensure_expr_context());
+    return DocPgPrepareExprCtx(batch, row, var_map_, expr_ctx_);
+  }
+
   // Create the expression context if does not exist
   Status ensure_expr_context() {
     if (expr_ctx_ == nullptr) {
@@ -154,13 +203,13 @@ class DocPgExprExecutor::Private {
   }
 
   // Evaluate where clause expressions
-  Status EvalWhereExprCalls(bool *result) {
-    // If where_clause_ is empty or all the expressions yield true, the result will remain true
+  Status EvalWhereExprCalls(const std::list<YbgPreparedExpr>& where_clause, bool *result) {
+    // If where_clause is empty or all the expressions yield true, the result will remain true
     *result = true;
 
     uint64_t datum;
     bool is_null;
-    for (auto expr : where_clause_) {
+    for (auto expr : where_clause) {
       // Evaluate expression
       RETURN_NOT_OK(DocPgEvalExpr(expr, expr_ctx_, &datum, &is_null));
       // Stop iteration and return false if expression does not yield true
@@ -199,6 +248,21 @@ class DocPgExprExecutor::Private {
     return Status::OK();
   }
 
+  // Make per row memory context current and clean it up. Returns previously current context.
+  YbgMemoryContext SwitchToRowContext() {
+    YbgMemoryContext old;
+    if (row_ctx_ == nullptr) {
+      // The first row, prepare memory context for per row allocations
+      YbgCreateMemoryContext(mem_ctx_, "DocPg Row Context", &row_ctx_);
+      YbgSetCurrentMemoryContext(row_ctx_, &old);
+    } else {
+      // Clean up memory allocations that may be still around after previous row was processed
+      YbgSetCurrentMemoryContext(row_ctx_, &old);
+      YbgResetMemoryContext();
+    }
+    return old;
+  }
+
   Status Exec(const QLTableRow& table_row,
               std::vector<QLExprResult>* results,
               bool* match) {
@@ -210,20 +274,11 @@ class DocPgExprExecutor::Private {
     }
 
     // Set the correct memory context
-    YbgMemoryContext old;
-    if (row_ctx_ == nullptr) {
-      // The first row, prepare memory context for per row allocations
-      YbgCreateMemoryContext(mem_ctx_, "DocPg Row Context", &row_ctx_);
-      YbgSetCurrentMemoryContext(row_ctx_, &old);
-    } else {
-      // Clean up memory allocations that may be still around after previous row was processed
-      YbgSetCurrentMemoryContext(row_ctx_, &old);
-      YbgResetMemoryContext();
-    }
+    YbgMemoryContext old = SwitchToRowContext();
 
     Status status = PreparePgRowData(table_row);
     if (status.ok())
-      status = EvalWhereExprCalls(match);
+      status = EvalWhereExprCalls(where_clause_, match);
 
     if (status.ok() && *match)
       status = EvalTargetExprCalls(results);
@@ -234,6 +289,83 @@ class DocPgExprExecutor::Private {
     return status;
   }
 
+  // Convert column comparisons to predicates over the batch columns. Comparisons that could not be
+  // converted are evaluated by Postgres along with other where clause expressions.
+  void PrepareColumnarPredicates(const ColumnarRowBatch& batch) {
+    const bool use_kernels = FLAGS_ysql_enable_columnar_predicate_kernels;
+    for (const auto& comparison : comparisons_) {
+      const auto& cmp = comparison.cmp;
+      const ColumnVector* column = nullptr;
+      auto it = var_map_.find(cmp.attno);
+      if (use_kernels && it != var_map_.end()) {
+        column = batch.FindColumn(ColumnId(it->second.var_colid));
+      }
+      const auto layout = cmp.is_real ? ColumnVector::Layout::kReal : ColumnVector::Layout::kInt;
+      if (!column || column->layout() != layout) {
+        batch_where_clause_.push_back(comparison.expr);
+        continue;
+      }
+      ColumnarPredicate predicate;
+      predicate.column_id = column->id();
+      predicate.op = ToColumnarCompareOp(cmp.op);
+      predicate.is_real = cmp.is_real;
+      predicate.int_value = cmp.int_value;
+      predicate.real_value = cmp.real_value;
+      VLOG(1) << "Columnar predicate has been added: " << predicate.ToString();
+      columnar_predicates_.push_back(predicate);
+    }
+    comparisons_.clear();
+    columnar_predicates_prepared_ = true;
+  }
+
+  Status ExecBatch(ColumnarRowBatch* batch) {
+    // Target expressions are not evaluated in batch mode, so only where clause matters
+    if (where_clause_.empty()) {
+      return Status::OK();
+    }
+
+    if (!columnar_predicates_prepared_) {
+      PrepareColumnarPredicates(*batch);
+    }
+    for (const auto& predicate : columnar_predicates_) {
+      SCHECK(ApplyColumnarPredicate(predicate, batch), IllegalState,
+             Format("Failed to apply $0 to $1", predicate, *batch));
+    }
+    if (batch_where_clause_.empty()) {
+      return Status::OK();
+    }
+
+    YbgMemoryContext old = nullptr;
+    bool context_switched = false;
+    Status status;
+    for (size_t row = 0; row != batch->num_rows() && status.ok(); ++row) {
+      if (!batch->IsSelected(row)) {
+        continue;
+      }
+      if (!context_switched) {
+        old = SwitchToRowContext();
+        context_switched = true;
+      } else {
+        YbgResetMemoryContext();
+      }
+      bool match = true;
+      status = PreparePgRowData(*batch, row);
+      if (status.ok()) {
+        status = EvalWhereExprCalls(batch_where_clause_, &match);
+      }
+      if (status.ok() && !match) {
+        batch->Unselect(row);
+      }
+    }
+
+    // Restore previous memory context
+    if (context_switched) {
+      YbgSetCurrentMemoryContext(old, nullptr);
+    }
+
+    return status;
+  }
+
  private:
   // Memory context for permanent allocations. Exists for executor's lifetime.
   YbgMemoryContext mem_ctx_ = nullptr;
@@ -244,6 +376,14 @@ class DocPgExprExecutor::Private {
   YbgExprContext expr_ctx_ = nullptr;
   // List of where clause expressions
   std::list<YbgPreparedExpr> where_clause_;
+  // Where clause expressions, that are comparisons of a column with a constant. Converted to
+  // columnar_predicates_ when the first batch is processed.
+  std::vector<DocPgColumnComparison> comparisons_;
+  // Where clause expressions evaluated by Postgres in batch mode.
+  std::list<YbgPreparedExpr> batch_where_clause_;
+  // Where clause expressions evaluated by vectorized kernels in batch mode.
+  std::vector<ColumnarPredicate> columnar_predicates_;
+  bool columnar_predicates_prepared_ = false;
   // List of target expressions with their type info
   std::list<DocPgEvalExprData> targets_;
   // Storage for column references. Key is the attribute number, value is basically DocDB column id
@@ -287,5 +427,9 @@ Status DocPgExprExecutor::Exec(
   return !private_.get() ? Status::OK() : private_->Exec(table_row, results, match);
 }
 
+Status DocPgExprExecutor::ExecBatch(ColumnarRowBatch* batch) {
+  return !private_.get() ? Status::OK() : private_->ExecBatch(batch);
+}
+
 }  // namespace docdb
 }  // namespace yb
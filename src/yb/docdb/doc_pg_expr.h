@@ -16,6 +16,7 @@
 #include "yb/common/ql_expr.h"
 #include "yb/common/pgsql_protocol.pb.h"
 #include "yb/common/schema.h"
+#include "yb/docdb/docdb_fwd.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -85,6 +86,13 @@ class DocPgExprExecutor {
               std::vector<QLExprResult>* results,
               bool* match);
 
+  // Evaluate the where clause expressions for the selected rows of the columnar batch.
+  // Rows that do not match the where clause are unselected in the batch. Target expressions are
+  // not evaluated, caller is expected to process the remaining selected rows itself.
+  // Values are converted to Postgres format directly from the batch columns, so QLTableRow is not
+  // constructed for the rows.
+  Status ExecBatch(ColumnarRowBatch* batch);
+
  private:
   // The relation schema
   const Schema *schema_;
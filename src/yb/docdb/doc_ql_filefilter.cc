@@ -19,6 +19,12 @@
 
 #include "yb/rocksdb/db/compaction.h"
 
+#include "yb/util/flags.h"
+
+DEFINE_RUNTIME_bool(docdb_filter_data_blocks_by_boundaries, true,
+                    "Whether range scans should skip SST data blocks whose range key components "
+                    "boundaries do not match scan bounds.");
+
 namespace yb {
 namespace docdb {
 extern rocksdb::UserBoundaryTag TagForRangeComponent(size_t index);
@@ -54,6 +60,16 @@ int Compare(const Slice *lhs, const Slice *rhs) {
   return lhs->compare(*rhs);
 }
 
+const Slice* ValueWithTag(const rocksdb::UserBoundaryValueRefs& values,
+                          rocksdb::UserBoundaryTag tag) {
+  for (const auto& value : values) {
+    if (value.tag == tag) {
+      return &value.value;
+    }
+  }
+  return nullptr;
+}
+
 
 QLRangeBasedFileFilter::QLRangeBasedFileFilter(const std::vector<KeyEntryValue>& lower_bounds,
                                                const std::vector<bool>& lower_bounds_inclusive,
@@ -89,5 +105,32 @@ bool QLRangeBasedFileFilter::Filter(const rocksdb::FdWithBoundaries& file) const
   return true;
 }
 
+bool QLRangeBasedFileFilter::FilterDataBlock(
+    const rocksdb::UserBoundaryValueRefs& smallest,
+    const rocksdb::UserBoundaryValueRefs& largest) const {
+  if (!FLAGS_docdb_filter_data_blocks_by_boundaries) {
+    return true;
+  }
+
+  for (size_t i = 0; i != lower_bounds_.size(); ++i) {
+    rocksdb::UserBoundaryTag tag = TagForRangeComponent(i);
+    const Slice *smallest_value = ValueWithTag(smallest, tag);
+    const Slice *largest_value = ValueWithTag(largest, tag);
+    // Component is not present in all keys of the block, so it could not be used for filtering.
+    if (smallest_value == nullptr || largest_value == nullptr) {
+      continue;
+    }
+
+    // Bound inclusiveness is ignored here, so block is kept when its boundary is equal to the
+    // bound. It is cheaper to read such block than to reason about exclusive bounds.
+    const Slice lower_bound = lower_bounds_[i].AsSlice();
+    const Slice upper_bound = upper_bounds_[i].AsSlice();
+    if (Compare(&upper_bound, smallest_value) < 0 || Compare(largest_value, &lower_bound) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -31,6 +31,10 @@ class QLRangeBasedFileFilter : public rocksdb::ReadFileFilter {
 
   bool Filter(const rocksdb::FdWithBoundaries& file) const override;
 
+  bool FilterDataBlock(
+      const rocksdb::UserBoundaryValueRefs& smallest,
+      const rocksdb::UserBoundaryValueRefs& largest) const override;
+
  private:
   std::vector<KeyBytes> lower_bounds_;
   std::vector<bool> lower_bounds_inclusive_;
@@ -16,10 +16,14 @@
 #include <string>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "yb/common/doc_hybrid_time.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/schema.h"
 #include "yb/common/transaction.h"
 
+#include "yb/docdb/columnar_row_batch.h"
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/shared_lock_manager_fwd.h"
 #include "yb/docdb/doc_key.h"
@@ -619,5 +623,74 @@ Result<bool> DocDBTableReader::Get(const Slice& root_doc_key, SubDocument* resul
   return helper.Run();
 }
 
+Result<bool> DocDBTableReader::AppendPackedRow(
+    const Slice& root_doc_key, const Schema& projection, size_t first_column,
+    ColumnarRowBatch* batch, size_t first_batch_column) {
+  if (table_expiration_) {
+    return false;
+  }
+
+  // Returns iterator to the start of the row, so it could be read by Get.
+  auto fallback = [this, &root_doc_key] {
+    iter_->Seek(root_doc_key);
+    return false;
+  };
+
+  const SchemaPacking* schema_packing;
+  {
+    IntentAwareIteratorPrefixScope prefix_scope(root_doc_key, iter_);
+    root_key_buffer_.Reset(root_doc_key);
+    iter_->SeekForward(&root_key_buffer_);
+
+    Slice value;
+    DocHybridTime doc_ht = table_tombstone_time_;
+    RETURN_NOT_OK(iter_->FindLatestRecord(root_doc_key, &doc_ht, &value));
+    if (!iter_->valid() || doc_ht == table_tombstone_time_) {
+      return fallback();
+    }
+    auto control_fields = VERIFY_RESULT(ValueControlFields::Decode(&value));
+    if (control_fields.has_ttl() || DecodeValueEntryType(value) != ValueEntryType::kPackedRow) {
+      return fallback();
+    }
+    value.consume_byte();
+    schema_packing = &VERIFY_RESULT(schema_packing_storage_.GetPacking(&value)).get();
+    // Value points to the iterator buffer, that is invalidated by the following seek.
+    packed_row_buffer_.Assign(value);
+
+    // Column level records could override values from the packed row.
+    iter_->SeekPastSubKey(root_doc_key);
+    if (iter_->valid()) {
+      return fallback();
+    }
+  }
+
+  const auto packed_row = packed_row_buffer_.AsSlice();
+  const auto num_columns = projection.num_columns() - first_column;
+  boost::container::small_vector<Slice, 16> column_values(num_columns);
+  for (size_t i = 0; i != num_columns; ++i) {
+    auto column_value = schema_packing->GetValue(
+        projection.column_id(first_column + i), packed_row);
+    if (!column_value || column_value->empty()) {
+      continue;
+    }
+    auto control_fields = VERIFY_RESULT(ValueControlFields::Decode(&*column_value));
+    if (control_fields.has_ttl()) {
+      return fallback();
+    }
+    column_values[i] = *column_value;
+  }
+
+  for (size_t i = 0; i != num_columns; ++i) {
+    // Missing columns are padded with nulls when the row is finished.
+    if (column_values[i].empty()) {
+      continue;
+    }
+    RETURN_NOT_OK(PrimitiveValue::DecodeToQLValuePB(
+        column_values[i], projection.column(first_column + i).type(), &column_value_));
+    batch->column(first_batch_column + i).Append(column_value_);
+  }
+  return true;
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -21,6 +21,7 @@
 
 #include "yb/common/common_types.pb.h"
 #include "yb/common/doc_hybrid_time.h"
+#include "yb/common/ql_value.h"
 #include "yb/common/read_hybrid_time.h"
 #include "yb/common/transaction.h"
 
@@ -30,6 +31,7 @@
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
 
+#include "yb/util/kv_util.h"
 #include "yb/util/monotime.h"
 #include "yb/util/status_fwd.h"
 #include "yb/util/strongly_typed_bool.h"
@@ -92,6 +94,15 @@ class DocDBTableReader {
   // Returns true if value was found, false otherwise.
   Result<bool> Get(const Slice& root_doc_key, SubDocument* result);
 
+  // Appends values of projection columns starting from first_column of the row identified by
+  // root_doc_key directly to the batch columns starting from first_batch_column, without building
+  // a SubDocument. Only rows stored as a single packed row without TTL and without column level
+  // updates are handled. Returns false for other rows, in which case nothing is appended, and
+  // the iterator is positioned so that Get could be used to read the row.
+  Result<bool> AppendPackedRow(
+      const Slice& root_doc_key, const Schema& projection, size_t first_column,
+      ColumnarRowBatch* batch, size_t first_batch_column);
+
  private:
   // Initializes the reader to read a row at sub_doc_key by seeking to and reading obsolescence info
   // at that row.
@@ -109,6 +120,11 @@ class DocDBTableReader {
   std::vector<KeyBytes> encoded_projection_;
   DocHybridTime table_tombstone_time_ = DocHybridTime::kMin;
   Expiration table_expiration_;
+
+  // Buffers reused by AppendPackedRow.
+  ValueBuffer packed_row_buffer_;
+  KeyBytes root_key_buffer_;
+  QLValuePB column_value_;
 };
 
 }  // namespace docdb
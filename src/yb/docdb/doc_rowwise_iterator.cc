@@ -28,6 +28,7 @@
 #include "yb/common/read_hybrid_time.h"
 #include "yb/common/transaction.h"
 
+#include "yb/docdb/columnar_row_batch.h"
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_path.h"
@@ -39,6 +40,7 @@
 #include "yb/docdb/docdb_types.h"
 #include "yb/docdb/expiration.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/key_bounds.h"
 #include "yb/docdb/primitive_value.h"
 #include "yb/docdb/scan_choices.h"
 #include "yb/docdb/subdocument.h"
@@ -54,6 +56,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
@@ -61,6 +64,13 @@
 
 using std::string;
 
+DEFINE_RUNTIME_uint32(docdb_max_prefetched_scan_keys, 0,
+    "When scan is restricted to a finite set of keys, e.g. IN list on leading range columns, "
+    "data blocks of up to this number of keys are prefetched into block cache with a single "
+    "batch of reads per SST file before the scan starts. Scans with more keys are not "
+    "prefetched, and at most as many keys as the row limit of the scan are prefetched. "
+    "0 disables prefetch.");
+
 namespace yb {
 namespace docdb {
 
@@ -124,6 +134,7 @@ Result<bool> DocRowwiseIterator::InitScanChoices(
     const DocQLScanSpec& doc_spec, const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key) {
   scan_choices_ = ScanChoices::Create(
       doc_read_context_.schema, doc_spec, lower_doc_key, upper_doc_key);
+  PrefetchScanKeys();
 
   if (scan_choices_ && scan_choices_->IsInitialPositionKnown()) {
     // Let's not seek to the lower doc key or upper doc key. We know exactly what we want.
@@ -139,6 +150,7 @@ Result<bool> DocRowwiseIterator::InitScanChoices(
     const KeyBytes& upper_doc_key) {
   scan_choices_ = ScanChoices::Create(
       doc_read_context_.schema, doc_spec, lower_doc_key, upper_doc_key);
+  PrefetchScanKeys();
 
   if (scan_choices_ && scan_choices_->IsInitialPositionKnown()) {
     // Let's not seek to the lower doc key or upper doc key. We know exactly what we want.
@@ -149,6 +161,27 @@ Result<bool> DocRowwiseIterator::InitScanChoices(
   return false;
 }
 
+void DocRowwiseIterator::PrefetchScanKeys() {
+  const auto max_keys = FLAGS_docdb_max_prefetched_scan_keys;
+  if (!scan_choices_ || max_keys == 0) {
+    return;
+  }
+  auto keys = scan_choices_->PointKeys(max_keys);
+  // Keys are enumerated in key order, so the scan visits them from the beginning when it is
+  // forward and from the end otherwise. Keys after the row limit are visited only when some of
+  // the preceding keys are missing, so they are not prefetched.
+  if (keys.size() > prefetch_row_limit_) {
+    if (!is_forward_scan_) {
+      keys.erase(keys.begin(), keys.begin() + (keys.size() - prefetch_row_limit_));
+    }
+    keys.resize(prefetch_row_limit_);
+  }
+  // Single key does not benefit from batching.
+  if (keys.size() > 1) {
+    db_iter_->PrefetchDataBlocks(&keys);
+  }
+}
+
 template <class T>
 Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   is_forward_scan_ = doc_spec.is_forward_scan();
@@ -167,9 +200,16 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
+  // Static columns of CQL tables are stored out of scan bounds, so bounds could be used to skip
+  // intents DB only for PGSQL tables.
+  boost::optional<KeyBounds> read_bounds;
+  if (table_type_ == TableType::PGSQL_TABLE_TYPE) {
+    read_bounds.emplace(lower_doc_key, upper_doc_key);
+  }
   db_iter_ = CreateIntentAwareIterator(
       doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      deadline_, read_time_, doc_spec.CreateFileFilter(), nullptr /* iterate_upper_bound */,
+      read_bounds.get_ptr());
 
   row_ready_ = false;
 
@@ -338,14 +378,28 @@ Result<bool> DocRowwiseIterator::HasNext() {
       }
     }
 
-    DCHECK(row_.type() == ValueEntryType::kObject);
-    row_.object_container().clear();
-    auto doc_found_res = doc_reader_->Get(doc_key, &row_);
-    if (!doc_found_res.ok()) {
-      has_next_status_ = doc_found_res.status();
-      return has_next_status_;
-    } else {
-      doc_found = *doc_found_res;
+    row_in_batch_ = false;
+    if (batch_) {
+      auto appended = doc_reader_->AppendPackedRow(
+          doc_key, projection_, projection_.num_key_columns(), batch_,
+          doc_read_context_.schema.num_key_columns());
+      if (!appended.ok()) {
+        has_next_status_ = appended.status();
+        return has_next_status_;
+      }
+      row_in_batch_ = *appended;
+      doc_found = row_in_batch_;
+    }
+    if (!row_in_batch_) {
+      DCHECK(row_.type() == ValueEntryType::kObject);
+      row_.object_container().clear();
+      auto doc_found_res = doc_reader_->Get(doc_key, &row_);
+      if (!doc_found_res.ok()) {
+        has_next_status_ = doc_found_res.status();
+        return has_next_status_;
+      } else {
+        doc_found = *doc_found_res;
+      }
     }
     if (scan_choices_ && !is_static_column) {
       has_next_status_ = scan_choices_->DoneWithCurrentTarget();
@@ -388,6 +442,29 @@ Status SetQLPrimaryKeyColumnValues(const Schema& schema,
   return decoder->ConsumeGroupEnd();
 }
 
+// Append primary key column values (hashed or range columns) to the columnar batch.
+Status AppendPrimaryKeyColumnValues(const Schema& schema,
+                                    const size_t begin_index,
+                                    const size_t column_count,
+                                    const char* column_type,
+                                    DocKeyDecoder* decoder,
+                                    QLValuePB* value,
+                                    ColumnarRowBatch* batch) {
+  if (begin_index + column_count > schema.num_columns()) {
+    return STATUS_SUBSTITUTE(
+        Corruption,
+        "$0 primary key columns between positions $1 and $2 go beyond table columns $3",
+        column_type, begin_index, begin_index + column_count - 1, schema.num_columns());
+  }
+  KeyEntryValue key_entry_value;
+  for (size_t i = 0, j = begin_index; i < column_count; i++, j++) {
+    RETURN_NOT_OK(decoder->DecodeKeyEntryValue(&key_entry_value));
+    key_entry_value.ToQLValuePB(schema.column(j).type(), value);
+    batch->column(j).Append(*value);
+  }
+  return decoder->ConsumeGroupEnd();
+}
+
 } // namespace
 
 void DocRowwiseIterator::SkipRow() {
@@ -419,6 +496,7 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   if (!row_ready_) {
     return STATUS(InternalError, "next row has not be prepared for reading");
   }
+  DCHECK(!row_in_batch_);
 
   DocKeyDecoder decoder(row_key_);
   RETURN_NOT_OK(decoder.DecodeCotableId());
@@ -459,6 +537,68 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+Result<size_t> DocRowwiseIterator::DoNextRowBatch(size_t max_rows, ColumnarRowBatch* batch) {
+  const auto& schema = doc_read_context_.schema;
+  const auto num_key_columns = schema.num_key_columns();
+  const auto first_projection_column = projection_.num_key_columns();
+  if (batch->num_columns() == 0) {
+    for (size_t i = 0; i != num_key_columns; ++i) {
+      batch->AddColumn(schema.column_id(i), schema.column(i).type()->main());
+    }
+    for (size_t i = first_projection_column; i != projection_.num_columns(); ++i) {
+      batch->AddColumn(projection_.column_id(i), projection_.column(i).type()->main());
+    }
+  }
+  SCHECK_EQ(batch->num_columns(),
+            num_key_columns + projection_.num_columns() - first_projection_column,
+            IllegalState, "Batch columns do not match iterator projection");
+
+  std::vector<KeyEntryValue> column_subkeys;
+  column_subkeys.reserve(projection_.num_columns() - first_projection_column);
+  for (size_t i = first_projection_column; i != projection_.num_columns(); ++i) {
+    column_subkeys.push_back(KeyEntryValue::MakeColumnId(projection_.column_id(i)));
+  }
+
+  // Rows that are stored as a single packed row are decoded by HasNext directly to the batch.
+  batch_ = batch;
+  auto se = ScopeExit([this] {
+    batch_ = nullptr;
+  });
+
+  QLValuePB value;
+  size_t num_rows = 0;
+  while (num_rows < max_rows && VERIFY_RESULT(HasNext())) {
+    DocKeyDecoder decoder(row_key_);
+    RETURN_NOT_OK(decoder.DecodeCotableId());
+    RETURN_NOT_OK(decoder.DecodeColocationId());
+    if (VERIFY_RESULT(decoder.DecodeHashCode())) {
+      RETURN_NOT_OK(AppendPrimaryKeyColumnValues(
+          schema, 0, schema.num_hash_key_columns(), "hash", &decoder, &value, batch));
+    }
+    if (!decoder.GroupEnded()) {
+      RETURN_NOT_OK(AppendPrimaryKeyColumnValues(
+          schema, schema.num_hash_key_columns(), schema.num_range_key_columns(), "range",
+          &decoder, &value, batch));
+    }
+
+    for (size_t i = 0; !row_in_batch_ && i != column_subkeys.size(); ++i) {
+      const SubDocument* column_value = row_.GetChild(column_subkeys[i]);
+      if (column_value != nullptr) {
+        column_value->ToQLValuePB(projection_.column(first_projection_column + i).type(), &value);
+        batch->column(num_key_columns + i).Append(value);
+      }
+    }
+
+    batch->FinishRow();
+    row_ready_ = false;
+    row_in_batch_ = false;
+    ++num_rows;
+  }
+
+  VLOG_WITH_FUNC(4) << "Returning batch: " << batch->ToString();
+  return num_rows;
+}
+
 Status DocRowwiseIterator::ValidateSystemKey() {
   // Currently we only have Table tombstone key as system key.
   DocKeyDecoder decoder(row_key_);
@@ -15,6 +15,7 @@
 
 #include <string>
 #include <atomic>
+#include <limits>
 
 #include "yb/docdb/doc_reader.h"
 #include "yb/rocksdb/db.h"
@@ -118,6 +119,12 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
     debug_dump_ = value;
   }
 
+  // Limits number of keys prefetched before the scan to the number of rows the scan could return.
+  // Should be called before Init.
+  void set_prefetch_row_limit(size_t value) {
+    prefetch_row_limit_ = value;
+  }
+
   static bool is_hybrid_scan_enabled();
 
  private:
@@ -131,6 +138,9 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
       const DocPgsqlScanSpec& doc_spec, const KeyBytes& lower_doc_key,
       const KeyBytes& upper_doc_key);
 
+  // Loads data blocks of all keys of scan choices into block cache, when keys could be enumerated.
+  void PrefetchScanKeys();
+
   // For reverse scans, moves the iterator to the first kv-pair of the previous row after having
   // constructed the current row. For forward scans nothing is necessary because GetSubDocument
   // ensures that the iterator will be positioned on the first kv-pair of the next row.
@@ -139,6 +149,10 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   Status DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  // Read next rows directly into columnar batch, bypassing QLTableRow. Batch contains primary key
+  // columns followed by non key columns of the projection.
+  Result<size_t> DoNextRowBatch(size_t max_rows, ColumnarRowBatch* batch) override;
+
   // Returns OK if row_key_ is pointing to a system key.
   Status ValidateSystemKey();
 
@@ -193,6 +207,13 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // It is initialized to false, to make sure first HasNext constructs a new row.
   bool row_ready_;
 
+  // When set, HasNext appends rows stored as a single packed row directly to this batch, instead
+  // of constructing row_. Set only while DoNextRowBatch is running.
+  ColumnarRowBatch* batch_ = nullptr;
+
+  // Whether the ready row was already appended to batch_.
+  bool row_in_batch_ = false;
+
   std::vector<KeyEntryValue> projection_subkeys_;
 
   // Used for keeping track of errors in HasNext.
@@ -207,6 +228,8 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   bool ignore_ttl_ = false;
 
   bool debug_dump_ = false;
+
+  size_t prefetch_row_limit_ = std::numeric_limits<size_t>::max();
 };
 
 }  // namespace docdb
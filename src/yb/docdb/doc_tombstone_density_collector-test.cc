@@ -0,0 +1,153 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <memory>
+#include <string>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_tombstone_density_collector.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/gutil/walltime.h"
+
+#include "yb/util/status_log.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_double(docdb_tombstone_density_compaction_threshold);
+DECLARE_uint64(docdb_tombstone_density_compaction_min_entries);
+
+namespace yb {
+namespace docdb {
+
+class DocTombstoneDensityCollectorTest : public YBTest {
+ protected:
+  std::unique_ptr<rocksdb::TablePropertiesCollector> CreateCollector() {
+    return std::unique_ptr<rocksdb::TablePropertiesCollector>(
+        DocTombstoneDensityCollectorFactoryInstance()->CreateTablePropertiesCollector({}));
+  }
+
+  void AddEntry(
+      rocksdb::TablePropertiesCollector* collector, int key, MicrosecondsInt64 write_time,
+      ValueEntryType value_type, MonoDelta ttl = ValueControlFields::kMaxTtl) {
+    auto encoded_key = SubDocKey(
+        DocKey(KeyEntryValues(key)), HybridTime::FromMicros(write_time)).Encode();
+    std::string value;
+    ValueControlFields{ .ttl = ttl }.AppendEncoded(&value);
+    value.push_back(static_cast<char>(value_type));
+    ASSERT_OK(collector->AddUserKey(
+        encoded_key.AsSlice(), value, rocksdb::kEntryPut, /* seq= */ 0, /* file_size= */ 0));
+  }
+
+  DocObsoleteEntriesStats Finish(rocksdb::TablePropertiesCollector* collector) {
+    rocksdb::UserCollectedProperties properties;
+    CHECK_OK(collector->Finish(&properties));
+    auto stats = CHECK_RESULT(DocObsoleteEntriesStats::FromProperties(properties));
+    CHECK(stats);
+    return *stats;
+  }
+};
+
+TEST_F(DocTombstoneDensityCollectorTest, Disabled) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_tombstone_density_compaction_threshold) = 0;
+  auto collector = CreateCollector();
+  for (int i = 0; i != 10; ++i) {
+    AddEntry(collector.get(), i, GetCurrentTimeMicros(), ValueEntryType::kTombstone);
+  }
+  ASSERT_FALSE(collector->NeedCompact());
+  rocksdb::UserCollectedProperties properties;
+  ASSERT_OK(collector->Finish(&properties));
+  ASSERT_TRUE(properties.empty());
+  ASSERT_FALSE(ASSERT_RESULT(DocObsoleteEntriesStats::FromProperties(properties)));
+}
+
+TEST_F(DocTombstoneDensityCollectorTest, Stats) {
+  constexpr int kNumEntries = 100;
+  constexpr MicrosecondsInt64 kSecond = 1000000;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_tombstone_density_compaction_threshold) = 0.5;
+
+  const auto now = GetCurrentTimeMicros();
+  const auto old_write_time = now - 60 * kSecond;
+  auto collector = CreateCollector();
+  for (int i = 0; i != kNumEntries; ++i) {
+    if (i % 4 == 0) {
+      AddEntry(collector.get(), i, i % 8 ? now : old_write_time, ValueEntryType::kTombstone);
+    } else if (i % 4 == 1) {
+      AddEntry(collector.get(), i, old_write_time, ValueEntryType::kString,
+               MonoDelta::FromSeconds(1));
+    } else if (i % 4 == 2) {
+      AddEntry(collector.get(), i, old_write_time, ValueEntryType::kString,
+               MonoDelta::FromSeconds(3601));
+    } else {
+      AddEntry(collector.get(), i, now, ValueEntryType::kString);
+    }
+  }
+  // Files are never marked for compaction when written, density is evaluated later.
+  ASSERT_FALSE(collector->NeedCompact());
+
+  auto stats = Finish(collector.get());
+  ASSERT_EQ(stats.num_entries, kNumEntries);
+  ASSERT_EQ(stats.num_tombstones, kNumEntries / 4);
+  ASSERT_EQ(stats.min_tombstone_ht, HybridTime::FromMicros(old_write_time));
+  ASSERT_EQ(stats.max_tombstone_ht, HybridTime::FromMicros(now));
+  ASSERT_EQ(stats.num_ttl_entries, kNumEntries / 2);
+  ASSERT_EQ(stats.min_ttl_expiration_ht, HybridTime::FromMicros(old_write_time + kSecond));
+  ASSERT_EQ(stats.max_ttl_expiration_ht, HybridTime::FromMicros(old_write_time + 3601 * kSecond));
+
+  // Nothing could be removed before the oldest tombstone.
+  ASSERT_EQ(stats.EstimateObsoleteEntries(HybridTime::FromMicros(old_write_time)), 0);
+  // Everything could be removed after the newest expiration.
+  ASSERT_EQ(stats.EstimateObsoleteEntries(HybridTime::FromMicros(now + 3600 * kSecond)),
+            3 * kNumEntries / 4);
+  // Values with TTL expire over time, while the history cutoff moves forward.
+  auto estimate = stats.EstimateObsoleteEntries(HybridTime::FromMicros(now));
+  ASSERT_GT(estimate, kNumEntries / 4);
+  ASSERT_LT(estimate, kNumEntries / 2);
+}
+
+TEST_F(DocTombstoneDensityCollectorTest, HighDensity) {
+  constexpr int kNumEntries = 100;
+  constexpr MicrosecondsInt64 kTtlSeconds = 60;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_tombstone_density_compaction_threshold) = 0.5;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_tombstone_density_compaction_min_entries) = kNumEntries;
+
+  const auto now = GetCurrentTimeMicros();
+  auto make_props = [this, now](int num_entries) {
+    auto collector = CreateCollector();
+    for (int i = 0; i != num_entries; ++i) {
+      // Values are written with the same TTL, and none of them is expired yet.
+      AddEntry(collector.get(), i, now, ValueEntryType::kString,
+               MonoDelta::FromSeconds(kTtlSeconds));
+    }
+    auto table_properties = std::make_shared<rocksdb::TableProperties>();
+    CHECK_OK(collector->Finish(&table_properties->user_collected_properties));
+    return rocksdb::TablePropertiesCollection{{"000010.sst", table_properties}};
+  };
+
+  auto props = make_props(kNumEntries);
+  const auto expiration = HybridTime::FromMicros(now + kTtlSeconds * 1000000);
+  ASSERT_FALSE(ASSERT_RESULT(HasHighTombstoneDensity(props, HybridTime::FromMicros(now))));
+  ASSERT_TRUE(ASSERT_RESULT(HasHighTombstoneDensity(props, expiration.AddMicroseconds(1))));
+
+  // Not enough entries.
+  props = make_props(kNumEntries - 1);
+  ASSERT_FALSE(ASSERT_RESULT(HasHighTombstoneDensity(props, expiration.AddMicroseconds(1))));
+
+  // Files written without the collector are ignored.
+  props["000011.sst"] = std::make_shared<rocksdb::TableProperties>();
+  ASSERT_FALSE(ASSERT_RESULT(HasHighTombstoneDensity(props, expiration.AddMicroseconds(1))));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,246 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/doc_tombstone_density_collector.h"
+
+#include <algorithm>
+
+#include "yb/common/doc_hybrid_time.h"
+#include "yb/common/hybrid_time.h"
+
+#include "yb/docdb/doc_ttl_util.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+#include "yb/util/status_format.h"
+#include "yb/util/stol_utils.h"
+#include "yb/util/tostring.h"
+
+DEFINE_RUNTIME_double(docdb_tombstone_density_compaction_threshold, 0,
+    "Estimated share of delete markers and expired values, that could be removed with the "
+    "current history cutoff, among entries of a regular DB SST file, starting from which "
+    "a full compaction of the tablet is scheduled. Only files written while this flag is set "
+    "are taken into account. 0 disables tombstone density triggered compactions.");
+TAG_FLAG(docdb_tombstone_density_compaction_threshold, advanced);
+
+DEFINE_RUNTIME_uint64(docdb_tombstone_density_compaction_min_entries, 10000,
+    "Minimal number of entries in SST file for it to trigger a full compaction because of "
+    "high density of delete markers and expired values.");
+TAG_FLAG(docdb_tombstone_density_compaction_min_entries, advanced);
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const char kEntriesPropertyName[] = "yb.docdb.entries";
+const char kTombstonesPropertyName[] = "yb.docdb.tombstones";
+const char kMinTombstoneHtPropertyName[] = "yb.docdb.min_tombstone_ht";
+const char kMaxTombstoneHtPropertyName[] = "yb.docdb.max_tombstone_ht";
+const char kTtlEntriesPropertyName[] = "yb.docdb.ttl_entries";
+const char kMinTtlExpirationHtPropertyName[] = "yb.docdb.min_ttl_expiration_ht";
+const char kMaxTtlExpirationHtPropertyName[] = "yb.docdb.max_ttl_expiration_ht";
+
+// Returns estimated number of entries among count entries with times uniformly distributed over
+// [min_ht, max_ht], whose time is before cutoff.
+double EstimateEntriesBefore(
+    uint64_t count, HybridTime min_ht, HybridTime max_ht, HybridTime cutoff) {
+  if (count == 0 || cutoff <= min_ht) {
+    return 0;
+  }
+  if (cutoff > max_ht) {
+    return count;
+  }
+  return count * static_cast<double>(cutoff.ToUint64() - min_ht.ToUint64()) /
+         (max_ht.ToUint64() - min_ht.ToUint64());
+}
+
+Result<uint64_t> GetUint64Property(
+    const rocksdb::UserCollectedProperties& properties, const char* name) {
+  auto it = properties.find(name);
+  if (it == properties.end()) {
+    return STATUS_FORMAT(Corruption, "Missing table property $0", name);
+  }
+  return CheckedStoull(it->second);
+}
+
+class DocTombstoneDensityCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  Status AddUserKey(const Slice& key, const Slice& value, rocksdb::EntryType type,
+                    rocksdb::SequenceNumber seq, uint64_t file_size) override {
+    if (!enabled_ || IsInternalRecordKeyType(DecodeKeyEntryType(key))) {
+      return Status::OK();
+    }
+    ++stats_.num_entries;
+    auto doc_ht = DocHybridTime::DecodeFromEnd(key);
+    if (!doc_ht.ok()) {
+      return Status::OK();
+    }
+    if (type == rocksdb::kEntryDelete || type == rocksdb::kEntrySingleDelete) {
+      stats_.AddTombstone(doc_ht->hybrid_time());
+      return Status::OK();
+    }
+    Slice value_slice = value;
+    auto control_fields = ValueControlFields::Decode(&value_slice);
+    if (!control_fields.ok()) {
+      return Status::OK();
+    }
+    if (DecodeValueEntryType(value_slice) == ValueEntryType::kTombstone) {
+      stats_.AddTombstone(doc_ht->hybrid_time());
+      return Status::OK();
+    }
+    // TTL-only merge records do not carry data to drop. Table level TTL is not known here, so
+    // only TTL stored in the value is taken into account.
+    if (!control_fields->has_ttl() ||
+        control_fields->merge_flags == ValueControlFields::kTtlFlag) {
+      return Status::OK();
+    }
+    auto expiration_ht = FileExpirationFromValueTTL(doc_ht->hybrid_time(), control_fields->ttl);
+    if (expiration_ht != kUseDefaultTTL && expiration_ht != kNoExpiration) {
+      stats_.AddTtlEntry(expiration_ht);
+    }
+    return Status::OK();
+  }
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override {
+    if (enabled_) {
+      stats_.ToProperties(properties);
+    }
+    return Status::OK();
+  }
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override {
+    rocksdb::UserCollectedProperties result;
+    stats_.ToProperties(&result);
+    return result;
+  }
+
+  const char* Name() const override {
+    return "DocTombstoneDensityCollector";
+  }
+
+ private:
+  const bool enabled_ = TombstoneDensityCompactionEnabled();
+  DocObsoleteEntriesStats stats_;
+};
+
+class DocTombstoneDensityCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override {
+    return new DocTombstoneDensityCollector();
+  }
+
+  const char* Name() const override {
+    return "DocTombstoneDensityCollectorFactory";
+  }
+};
+
+} // namespace
+
+void DocObsoleteEntriesStats::AddTombstone(HybridTime ht) {
+  ++num_tombstones;
+  min_tombstone_ht = std::min(min_tombstone_ht, ht);
+  max_tombstone_ht = std::max(max_tombstone_ht, ht);
+}
+
+void DocObsoleteEntriesStats::AddTtlEntry(HybridTime expiration_ht) {
+  ++num_ttl_entries;
+  min_ttl_expiration_ht = std::min(min_ttl_expiration_ht, expiration_ht);
+  max_ttl_expiration_ht = std::max(max_ttl_expiration_ht, expiration_ht);
+}
+
+double DocObsoleteEntriesStats::EstimateObsoleteEntries(HybridTime history_cutoff) const {
+  return EstimateEntriesBefore(num_tombstones, min_tombstone_ht, max_tombstone_ht,
+                               history_cutoff) +
+         EstimateEntriesBefore(num_ttl_entries, min_ttl_expiration_ht, max_ttl_expiration_ht,
+                               history_cutoff);
+}
+
+void DocObsoleteEntriesStats::ToProperties(rocksdb::UserCollectedProperties* properties) const {
+  auto& out = *properties;
+  out[kEntriesPropertyName] = std::to_string(num_entries);
+  out[kTombstonesPropertyName] = std::to_string(num_tombstones);
+  out[kMinTombstoneHtPropertyName] = std::to_string(min_tombstone_ht.ToUint64());
+  out[kMaxTombstoneHtPropertyName] = std::to_string(max_tombstone_ht.ToUint64());
+  out[kTtlEntriesPropertyName] = std::to_string(num_ttl_entries);
+  out[kMinTtlExpirationHtPropertyName] = std::to_string(min_ttl_expiration_ht.ToUint64());
+  out[kMaxTtlExpirationHtPropertyName] = std::to_string(max_ttl_expiration_ht.ToUint64());
+}
+
+Result<std::optional<DocObsoleteEntriesStats>> DocObsoleteEntriesStats::FromProperties(
+    const rocksdb::UserCollectedProperties& properties) {
+  if (!properties.count(kEntriesPropertyName)) {
+    return std::nullopt;
+  }
+  DocObsoleteEntriesStats result;
+  result.num_entries = VERIFY_RESULT(GetUint64Property(properties, kEntriesPropertyName));
+  result.num_tombstones = VERIFY_RESULT(GetUint64Property(properties, kTombstonesPropertyName));
+  result.min_tombstone_ht = HybridTime(
+      VERIFY_RESULT(GetUint64Property(properties, kMinTombstoneHtPropertyName)));
+  result.max_tombstone_ht = HybridTime(
+      VERIFY_RESULT(GetUint64Property(properties, kMaxTombstoneHtPropertyName)));
+  result.num_ttl_entries = VERIFY_RESULT(GetUint64Property(properties, kTtlEntriesPropertyName));
+  result.min_ttl_expiration_ht = HybridTime(
+      VERIFY_RESULT(GetUint64Property(properties, kMinTtlExpirationHtPropertyName)));
+  result.max_ttl_expiration_ht = HybridTime(
+      VERIFY_RESULT(GetUint64Property(properties, kMaxTtlExpirationHtPropertyName)));
+  return std::make_optional(result);
+}
+
+std::string DocObsoleteEntriesStats::ToString() const {
+  return YB_STRUCT_TO_STRING(
+      num_entries, num_tombstones, min_tombstone_ht, max_tombstone_ht, num_ttl_entries,
+      min_ttl_expiration_ht, max_ttl_expiration_ht);
+}
+
+bool TombstoneDensityCompactionEnabled() {
+  return FLAGS_docdb_tombstone_density_compaction_threshold > 0;
+}
+
+Result<bool> HasHighTombstoneDensity(
+    const rocksdb::TablePropertiesCollection& props, HybridTime history_cutoff) {
+  const auto threshold = FLAGS_docdb_tombstone_density_compaction_threshold;
+  const auto min_entries = FLAGS_docdb_tombstone_density_compaction_min_entries;
+  if (threshold <= 0) {
+    return false;
+  }
+  for (const auto& [file_name, table_properties] : props) {
+    auto stats = VERIFY_RESULT_PREPEND(
+        DocObsoleteEntriesStats::FromProperties(table_properties->user_collected_properties),
+        Format("Bad table properties of $0", file_name));
+    if (!stats || stats->num_entries == 0 || stats->num_entries < min_entries) {
+      continue;
+    }
+    const auto obsolete_entries = stats->EstimateObsoleteEntries(history_cutoff);
+    if (obsolete_entries >= threshold * stats->num_entries) {
+      VLOG(1) << "High density of obsolete entries in " << file_name << ": " << obsolete_entries
+              << " estimated for history cutoff " << history_cutoff << ", " << stats->ToString();
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory>
+    DocTombstoneDensityCollectorFactoryInstance() {
+  static std::shared_ptr<rocksdb::TablePropertiesCollectorFactory> instance =
+      std::make_shared<DocTombstoneDensityCollectorFactory>();
+  return instance;
+}
+
+}  // namespace docdb
+}  // namespace yb
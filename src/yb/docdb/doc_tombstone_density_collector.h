@@ -0,0 +1,78 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "yb/common/hybrid_time.h"
+
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/table_properties.h"
+
+#include "yb/util/result.h"
+
+namespace yb {
+namespace docdb {
+
+// Statistics of entries in a regular DB SST file that become obsolete over time: DocDB delete
+// markers, and values with TTL stored in the value. A delete marker could be removed once the
+// history cutoff passes its hybrid time, and a value with TTL once the history cutoff passes its
+// expiration time. Only the range of these times is stored, entries are assumed to be uniformly
+// distributed over it.
+struct DocObsoleteEntriesStats {
+  uint64_t num_entries = 0;
+
+  uint64_t num_tombstones = 0;
+  HybridTime min_tombstone_ht = HybridTime::kMax;
+  HybridTime max_tombstone_ht = HybridTime::kMin;
+
+  uint64_t num_ttl_entries = 0;
+  HybridTime min_ttl_expiration_ht = HybridTime::kMax;
+  HybridTime max_ttl_expiration_ht = HybridTime::kMin;
+
+  void AddTombstone(HybridTime ht);
+  void AddTtlEntry(HybridTime expiration_ht);
+
+  // Returns estimated number of entries that a major compaction with the specified history cutoff
+  // would remove.
+  double EstimateObsoleteEntries(HybridTime history_cutoff) const;
+
+  void ToProperties(rocksdb::UserCollectedProperties* properties) const;
+
+  // Returns none when the file was written without collecting these statistics.
+  static Result<std::optional<DocObsoleteEntriesStats>> FromProperties(
+      const rocksdb::UserCollectedProperties& properties);
+
+  std::string ToString() const;
+};
+
+// Returns true when tombstone density triggered compactions are enabled, i.e.
+// docdb_tombstone_density_compaction_threshold is set.
+bool TombstoneDensityCompactionEnabled();
+
+// Returns true when estimated share of obsolete entries of any file from props reaches
+// docdb_tombstone_density_compaction_threshold, so a full compaction with the specified history
+// cutoff is worth running.
+Result<bool> HasHighTombstoneDensity(
+    const rocksdb::TablePropertiesCollection& props, HybridTime history_cutoff);
+
+// Factory of table properties collectors that gather DocObsoleteEntriesStats for regular DB SST
+// files. Statistics are only collected while tombstone density triggered compactions are enabled.
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory>
+    DocTombstoneDensityCollectorFactoryInstance();
+
+}  // namespace docdb
+}  // namespace yb
@@ -21,16 +21,20 @@
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_ql_filefilter.h"
 #include "yb/docdb/doc_reader.h"
 #include "yb/docdb/doc_reader_redis.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.messages.h"
+#include "yb/docdb/docdb_debug.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/in_mem_docdb.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value.h"
+#include "yb/docdb/schema_packing.h"
 
 #include "yb/gutil/casts.h"
 #include "yb/gutil/stringprintf.h"
@@ -73,9 +77,14 @@ using rocksdb::WriteOptions;
 
 using namespace std::literals;
 
+DECLARE_bool(docdb_collect_data_block_boundaries);
+DECLARE_bool(docdb_filter_data_blocks_by_boundaries);
+DECLARE_int64(db_block_size_bytes);
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
 DECLARE_bool(TEST_docdb_sort_weak_intents);
+DECLARE_uint64(rocksdb_compaction_size_threshold_bytes);
+DECLARE_int32(rocksdb_max_subcompactions);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -2819,6 +2828,173 @@ TEST_F_EX(DocDBTest, BoundaryValuesMultiFiles, DocDBTestBoundaryValues) {
   TestBoundaryValues(350);
 }
 
+TEST_F(DocDBTestQl, DataBlockBoundaries) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_collect_data_block_boundaries) = true;
+  // Use small data blocks, so rows are spread over many blocks of the same SST file.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_db_block_size_bytes) = 1_KB;
+  ASSERT_OK(ReinitDBOptions());
+
+  constexpr int64_t kNumRows = 2000;
+  constexpr int64_t kLowerBound = 1000;
+  constexpr int64_t kUpperBound = 1099;
+  for (int64_t i = 0; i != kNumRows; ++i) {
+    DocKey doc_key(KeyEntryValues(i));
+    ASSERT_OK(SetPrimitive(
+        DocPath(doc_key.Encode()), QLValue::Primitive("value"), HybridTime::FromMicros(1000)));
+  }
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  auto file_filter = std::make_shared<QLRangeBasedFileFilter>(
+      KeyEntryValues(kLowerBound), std::vector<bool>{true},
+      KeyEntryValues(kUpperBound), std::vector<bool>{true});
+
+  for (bool filter_data_blocks : {false, true}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_filter_data_blocks_by_boundaries) = filter_data_blocks;
+    auto iter = CreateRocksDBIterator(
+        rocksdb(), &KeyBounds::kNoBounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
+        rocksdb::kDefaultQueryId, file_filter);
+    int64_t num_keys = 0;
+    int64_t num_matching_keys = 0;
+    for (iter.SeekToFirst(); iter.Valid(); iter.Next()) {
+      SubDocKey sub_doc_key;
+      ASSERT_OK(sub_doc_key.FullyDecodeFrom(iter.key()));
+      const auto value = sub_doc_key.doc_key().range_group()[0].GetInt64();
+      ++num_keys;
+      if (value >= kLowerBound && value <= kUpperBound) {
+        ++num_matching_keys;
+      }
+    }
+    ASSERT_OK(iter.status());
+    ASSERT_EQ(kUpperBound - kLowerBound + 1, num_matching_keys);
+    LOG(INFO) << "Filter data blocks: " << filter_data_blocks << ", keys read: " << num_keys;
+    if (filter_data_blocks) {
+      // Only blocks overlapping the range, i.e. a small fraction of the whole file, are read.
+      ASSERT_LT(num_keys, kNumRows / 4);
+    } else {
+      ASSERT_EQ(kNumRows, num_keys);
+    }
+  }
+}
+
+// Provides packing of a single table, so compaction packs column updates into rows.
+class DocDBSubcompactionTest : public DocDBTestBase, public SchemaPackingProvider {
+ protected:
+  static constexpr SchemaVersion kSchemaVersion = 1;
+
+  DocDBSubcompactionTest() {
+    schema_packing_provider_ = this;
+  }
+
+  Result<CompactionSchemaInfo> CotablePacking(
+      const Uuid& table_id, uint32_t schema_version, HybridTime history_cutoff) override {
+    return CompactionSchemaInfo {
+      .table_type = TableType::YQL_TABLE_TYPE,
+      .schema_version = kSchemaVersion,
+      .schema_packing = schema_packing_,
+      .cotable_id = table_id,
+      .deleted_cols = {},
+      .enabled = true,
+    };
+  }
+
+  Result<CompactionSchemaInfo> ColocationPacking(
+      ColocationId colocation_id, uint32_t schema_version, HybridTime history_cutoff) override {
+    return STATUS_FORMAT(NotFound, "Unknown colocation: $0", colocation_id);
+  }
+
+  // Writes packed rows, overwrites their columns and deletes some of them. Each round of updates
+  // is flushed to a separate file, so every file covers the whole key range.
+  void WriteRows(int64_t num_rows);
+
+  const Schema schema_{{
+      ColumnSchema("k", DataType::INT64, /* is_nullable = */ false),
+      ColumnSchema("v1", DataType::STRING, true),
+      ColumnSchema("v2", DataType::INT64, true),
+  }, {
+      10_ColId,
+      20_ColId,
+      30_ColId,
+  }, 1};
+  const std::shared_ptr<const SchemaPacking> schema_packing_ =
+      std::make_shared<SchemaPacking>(schema_);
+};
+
+void DocDBSubcompactionTest::WriteRows(int64_t num_rows) {
+  for (int64_t i = 0; i != num_rows; ++i) {
+    RowPacker packer(
+        kSchemaVersion, *schema_packing_,
+        /* packed_size_limit= */ std::numeric_limits<int64_t>::max(),
+        /* value_control_fields= */ Slice());
+    ASSERT_OK(packer.AddValue(20_ColId, QLValue::Primitive(Format("a$0", i))));
+    ASSERT_OK(packer.AddValue(30_ColId, QLValue::PrimitiveInt64(i)));
+    auto packed_row = ASSERT_RESULT(packer.Complete());
+    ASSERT_OK(SetPrimitive(
+        DocPath(DocKey(KeyEntryValues(i)).Encode()), ValueControlFields(), ValueRef(packed_row),
+        1000_usec_ht));
+  }
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  // Overwrite before history cutoff, compaction packs it into the row.
+  for (int64_t i = 0; i != num_rows; ++i) {
+    ASSERT_OK(SetPrimitive(
+        DocPath(DocKey(KeyEntryValues(i)).Encode(), KeyEntryValue::MakeColumnId(20_ColId)),
+        QLValue::Primitive(Format("b$0", i)), 2000_usec_ht));
+    if (i % 3 == 0) {
+      ASSERT_OK(DeleteSubDoc(DocPath(DocKey(KeyEntryValues(i)).Encode()), 3000_usec_ht));
+    }
+  }
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  // Updates after history cutoff, compaction keeps them with the history they overwrite.
+  for (int64_t i = 0; i != num_rows; ++i) {
+    const DocKey doc_key(KeyEntryValues(i));
+    if (i % 5 == 0) {
+      ASSERT_OK(DeleteSubDoc(DocPath(doc_key.Encode()), 4000_usec_ht));
+    } else {
+      ASSERT_OK(SetPrimitive(
+          DocPath(doc_key.Encode(), KeyEntryValue::MakeColumnId(30_ColId)),
+          QLValue::PrimitiveInt64(-i), 4000_usec_ht));
+    }
+  }
+  ASSERT_OK(FlushRocksDbAndWait());
+}
+
+TEST_F(DocDBSubcompactionTest, SameResultAsSingleCompaction) {
+  constexpr int64_t kNumRows = 3000;
+  constexpr auto kHistoryCutoff = 3500_usec_ht;
+
+  // Use small data blocks, so index of each file provides enough keys to split compaction, and
+  // small threshold, so compaction is large enough to be split.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_db_block_size_bytes) = 1_KB;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_compaction_size_threshold_bytes) = 8_KB;
+
+  SchemaPackingStorage schema_packing_storage;
+  schema_packing_storage.AddSchema(kSchemaVersion, schema_);
+
+  std::vector<std::string> dumps;
+  for (int max_subcompactions : {1, 4}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_max_subcompactions) = max_subcompactions;
+    ASSERT_OK(DestroyRocksDB());
+    ASSERT_OK(ReinitDBOptions());
+    ASSERT_OK(OpenRocksDB());
+
+    ASSERT_NO_FATALS(WriteRows(kNumRows));
+    ASSERT_NO_FATALS(FullyCompactHistoryBefore(kHistoryCutoff));
+
+    const auto num_files = NumSSTableFiles();
+    LOG(INFO) << "Max subcompactions: " << max_subcompactions << ", files: " << num_files;
+    if (max_subcompactions > 1) {
+      // Each subcompaction writes its own files.
+      ASSERT_GT(num_files, 1);
+    }
+    dumps.push_back(docdb::DocDBDebugDumpToStr(rocksdb(), schema_packing_storage));
+  }
+
+  // Rows are never split between subcompactions and all of them use the same history cutoff, so
+  // packing, overwrites and deletes are resolved exactly as by a single compaction.
+  ASSERT_EQ(dumps[0], dumps[1]);
+}
+
 TEST_P(DocDBTestWrapper, BloomFilterTest) {
   // Turn off "next instead of seek" optimization, because this test rely on DocDB to do seeks.
   FLAGS_max_nexts_to_avoid_seek = 0;
@@ -1131,17 +1131,30 @@ std::shared_ptr<rocksdb::CompactionContextFactory> CreateCompactionContextFactor
     SchemaPackingProvider* schema_packing_provider) {
   return std::make_shared<rocksdb::CompactionContextFactory>(
       [retention_policy, key_bounds, delete_marker_retention_provider, schema_packing_provider](
-      rocksdb::CompactionFeed* next_feed, const rocksdb::CompactionContextOptions& options) {
-    return std::make_unique<DocDBCompactionContext>(
-        next_feed,
-        retention_policy->GetRetentionDirective(),
-        MinHybridTime(options.level0_inputs),
-        delete_marker_retention_provider
-            ? delete_marker_retention_provider(options.level0_inputs)
-            : HybridTime::kMax,
-        options.boundary_extractor,
-        key_bounds,
-        schema_packing_provider);
+      const std::vector<rocksdb::CompactionFeed*>& next_feeds,
+      const rocksdb::CompactionContextOptions& options) {
+    // Directive is fetched once for all subcompactions, otherwise history cutoff could move
+    // between contexts and key ranges would be compacted with different cutoffs.
+    const auto retention = retention_policy->GetRetentionDirective();
+    const auto min_input_hybrid_time = MinHybridTime(options.level0_inputs);
+    const auto min_other_data_ht = delete_marker_retention_provider
+        ? delete_marker_retention_provider(options.level0_inputs)
+        : HybridTime::kMax;
+    std::vector<rocksdb::CompactionContextPtr> result;
+    result.reserve(next_feeds.size());
+    for (auto* next_feed : next_feeds) {
+      result.push_back(std::make_unique<DocDBCompactionContext>(
+          next_feed, retention, min_input_hybrid_time, min_other_data_ht,
+          options.boundary_extractor, key_bounds, schema_packing_provider));
+    }
+    return result;
+  });
+}
+
+std::shared_ptr<std::function<size_t(Slice)>> CreateSubcompactionBoundaryPrefixSize() {
+  return std::make_shared<std::function<size_t(Slice)>>([](Slice key) -> size_t {
+    auto size = DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey);
+    return size.ok() ? *size : 0;
   });
 }
 
@@ -111,6 +111,11 @@ std::shared_ptr<rocksdb::CompactionContextFactory> CreateCompactionContextFactor
     const DeleteMarkerRetentionTimeProvider& delete_marker_retention_provider,
     SchemaPackingProvider* schema_packing_provider);
 
+// Returns function that truncates key to its encoded DocKey, so all records of the same row are
+// processed by the same subcompaction and the compaction feed state stays correct.
+// Keys that are not DocKeys, e.g. transaction apply state, are not used as subcompaction boundaries.
+std::shared_ptr<std::function<size_t(Slice)>> CreateSubcompactionBoundaryPrefixSize();
+
 // A history retention policy that can be configured manually. Useful in tests. This class is
 // useful for testing and is thread-safe.
 class ManualHistoryRetentionPolicy : public HistoryRetentionPolicy {
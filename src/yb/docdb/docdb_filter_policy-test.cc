@@ -67,4 +67,107 @@ TEST_F(DocDBFilterPolicyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST_F(DocDBFilterPolicyTest, RibbonKeyMatching) {
+  DocDbAwareV3RibbonFilterPolicy policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr);
+  ASSERT_EQ(policy.GetFilterType(), rocksdb::FilterPolicy::kFixedSizeFilter);
+  std::string keys[] = { "foo", "bar", "test" };
+  std::string absent_key = "fake";
+
+  std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  ASSERT_NE(builder, nullptr);
+  for (const auto& key : keys) {
+    builder->AddKey(policy.GetKeyTransformer()->Transform(EncodeSimpleSubDocKey(key)));
+  }
+  std::unique_ptr<const char[]> buf;
+  rocksdb::Slice filter = builder->Finish(&buf);
+  ASSERT_LE(filter.size(), rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits / 8 + 7);
+
+  std::unique_ptr<FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+
+  auto may_match = [&](const std::string& sub_doc_key_str) {
+    return reader->MayMatch(policy.GetKeyTransformer()->Transform(sub_doc_key_str));
+  };
+
+  for (const auto &key : keys) {
+    ASSERT_TRUE(may_match(EncodeSimpleSubDocKey(key))) << "Key: " << key;
+    // V3 transformer keeps the first range component, so only subkey and time are changed.
+    ASSERT_TRUE(may_match(EncodeSubDocKey(key, "range_key", "another_sub_key", 55555L)))
+        << "Key: " << key;
+  }
+  ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
+}
+
+namespace {
+
+// Builds fixed-size filter blocks for transformed keys, then checks that all added keys match and
+// that false positive rate for absent keys is low.
+void CheckFilterPolicy(
+    const rocksdb::FilterPolicy& policy, const std::vector<std::string>& keys,
+    const std::vector<std::string>& absent_keys) {
+  std::vector<std::unique_ptr<const char[]>> buffers;
+  std::vector<rocksdb::Slice> filters;
+  // Index of the filter block containing the key with the same index.
+  std::vector<size_t> key_block(keys.size());
+
+  std::unique_ptr<FilterBitsBuilder> builder;
+  for (size_t i = 0; i != keys.size(); ++i) {
+    if (!builder) {
+      builder.reset(policy.GetFilterBitsBuilder());
+    }
+    builder->AddKey(keys[i]);
+    key_block[i] = filters.size();
+    if (builder->IsFull() || i + 1 == keys.size()) {
+      buffers.emplace_back();
+      filters.push_back(builder->Finish(&buffers.back()));
+      builder.reset();
+    }
+  }
+
+  std::vector<std::unique_ptr<FilterBitsReader>> readers;
+  for (const auto& filter : filters) {
+    readers.emplace_back(policy.GetFilterBitsReader(filter));
+  }
+
+  for (size_t i = 0; i != keys.size(); ++i) {
+    ASSERT_TRUE(readers[key_block[i]]->MayMatch(keys[i])) << "Key: " << i;
+  }
+
+  size_t false_positives = 0;
+  for (size_t i = 0; i != absent_keys.size(); ++i) {
+    false_positives += readers[i % readers.size()]->MayMatch(absent_keys[i]);
+  }
+  const auto false_positive_rate = false_positives * 1.0 / absent_keys.size();
+  LOG(INFO) << policy.Name() << ": " << filters.size() << " blocks, "
+            << "false positive rate: " << false_positive_rate;
+  ASSERT_LE(false_positive_rate, 0.02);
+}
+
+} // namespace
+
+TEST_F(DocDBFilterPolicyTest, FalsePositiveRate) {
+  constexpr size_t kNumKeys = 16384;
+  DocDbAwareV3FilterPolicy bloom_policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr);
+  DocDbAwareV3RibbonFilterPolicy ribbon_policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr);
+  // Both policies use the same key transformer.
+  const auto& transformer = *bloom_policy.GetKeyTransformer();
+
+  std::vector<std::string> encoded_keys;
+  std::vector<std::string> keys;
+  std::vector<std::string> absent_keys;
+  for (size_t i = 0; i != kNumKeys; ++i) {
+    encoded_keys.push_back(EncodeSimpleSubDocKey(Format("key_$0", i)));
+    keys.push_back(transformer.Transform(encoded_keys.back()).ToBuffer());
+    absent_keys.push_back(transformer.Transform(
+        EncodeSimpleSubDocKey(Format("absent_key_$0", i))).ToBuffer());
+  }
+  ASSERT_EQ(transformer.Transform(encoded_keys.front()),
+            ribbon_policy.GetKeyTransformer()->Transform(encoded_keys.front()));
+
+  ASSERT_NO_FATALS(CheckFilterPolicy(bloom_policy, keys, absent_keys));
+  ASSERT_NO_FATALS(CheckFilterPolicy(ribbon_policy, keys, absent_keys));
+}
+
 }  // namespace yb::docdb
@@ -111,4 +111,9 @@ DocDbAwareV3FilterPolicy::GetKeyTransformer() const {
   return &DocKeyComponentsExtractor<DocKeyPart::kUpToHashOrFirstRange>::GetInstance();
 }
 
+const rocksdb::FilterPolicy::KeyTransformer*
+DocDbAwareV3RibbonFilterPolicy::GetKeyTransformer() const {
+  return &DocKeyComponentsExtractor<DocKeyPart::kUpToHashOrFirstRange>::GetInstance();
+}
+
 }   // namespace yb::docdb
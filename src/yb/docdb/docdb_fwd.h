@@ -25,10 +25,13 @@
 namespace yb {
 namespace docdb {
 
+class ColumnVector;
+class ColumnarRowBatch;
 class ConsensusFrontier;
 class DeadlineInfo;
 class DocDBCompactionFilterFactory;
 class DocOperation;
+class DocPgExprExecutor;
 class DocPgsqlScanSpec;
 class DocQLScanSpec;
 class DocRowwiseIterator;
@@ -37,6 +40,7 @@ class ExternalTxnIntentsState;
 class HistoryRetentionPolicy;
 class IntentAwareIterator;
 class IntentAwareIteratorIf;
+class IntentsIndex;
 class KeyBytes;
 class KeyEntryValue;
 class ManualHistoryRetentionPolicy;
@@ -20,6 +20,8 @@
 #include "yb/common/ql_expr.h"
 #include "yb/common/schema.h"
 
+#include "yb/docdb/columnar_row_batch.h"
+
 #include "yb/gutil/singleton.h"
 #include "yb/yql/pggate/ybc_pg_typedefs.h"
 #include "yb/yql/pggate/pg_value.h"
@@ -223,6 +225,33 @@ Status DocPgPrepareExprCtx(const QLTableRow& table_row,
   return Status::OK();
 }
 
+Status DocPgPrepareExprCtx(const ColumnarRowBatch& batch,
+                           size_t row,
+                           const std::map<int, const DocPgVarRef>& var_map,
+                           YbgExprContext expr_ctx) {
+  PG_RETURN_NOT_OK(YbgExprContextReset(expr_ctx));
+  QLValuePB val;
+  for (auto it = var_map.begin(); it != var_map.end(); it++) {
+    const int& attno = it->first;
+    const DocPgVarRef& arg_ref = it->second;
+    const auto* column = batch.FindColumn(ColumnId(arg_ref.var_colid));
+    if (column) {
+      column->GetValue(row, &val);
+    } else {
+      val.Clear();
+    }
+    bool is_null = false;
+    uint64_t datum = 0;
+    PG_RETURN_NOT_OK(YbgValueFromPB(arg_ref.var_type,
+                                    arg_ref.var_type_attrs,
+                                    val,
+                                    &datum,
+                                    &is_null));
+    PG_RETURN_NOT_OK(YbgExprContextAddColValue(expr_ctx, attno, datum, is_null));
+  }
+  return Status::OK();
+}
+
 Status DocPgEvalExpr(YbgPreparedExpr expr,
                      YbgExprContext expr_ctx,
                      uint64_t *datum,
@@ -232,6 +261,13 @@ Status DocPgEvalExpr(YbgPreparedExpr expr,
   return Status::OK();
 }
 
+Status DocPgGetColumnComparison(YbgPreparedExpr expr,
+                                YbgColumnComparison *cmp,
+                                bool *is_comparison) {
+  PG_RETURN_NOT_OK(YbgExprGetColumnComparison(expr, cmp, is_comparison));
+  return Status::OK();
+}
+
 Status SetValueFromQLBinary(
     const QLValuePB ql_value, const int pg_data_type,
     const std::unordered_map<uint32_t, string> &enum_oid_label_map,
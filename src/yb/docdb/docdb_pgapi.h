@@ -30,6 +30,8 @@
 #include "yb/common/column_id.h"
 #include "yb/common/common_fwd.h"
 
+#include "yb/docdb/docdb_fwd.h"
+
 #include "yb/master/master_replication.pb.h"
 
 #include "yb/util/status_fwd.h"
@@ -91,11 +93,23 @@ Status DocPgPrepareExprCtx(const QLTableRow& table_row,
                            const std::map<int, const DocPgVarRef>& var_map,
                            YbgExprContext expr_ctx);
 
+// Same as above, but column values are taken from the specified row of the columnar batch.
+Status DocPgPrepareExprCtx(const ColumnarRowBatch& batch,
+                           size_t row,
+                           const std::map<int, const DocPgVarRef>& var_map,
+                           YbgExprContext expr_ctx);
+
 Status DocPgEvalExpr(YbgPreparedExpr expr,
                      YbgExprContext expr_ctx,
                      uint64_t *datum,
                      bool *is_null);
 
+// Check whether the expression is a comparison of a column with a constant, that could be
+// evaluated directly over column values. See YbgExprGetColumnComparison for details.
+Status DocPgGetColumnComparison(YbgPreparedExpr expr,
+                                YbgColumnComparison *cmp,
+                                bool *is_comparison);
+
 // Given a 'ql_value' with a binary value, interpret the binary value as a text
 // array, and store the individual elements in 'ql_value_vec';
 Result<std::vector<std::string>> ExtractTextArrayFromQLBinaryValue(const QLValuePB& ql_value);
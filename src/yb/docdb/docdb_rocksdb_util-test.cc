@@ -13,6 +13,7 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/rocksdb/table.h"
+#include "yb/rocksdb/util/compression.h"
 
 #include "yb/util/result.h"
 #include "yb/util/test_util.h"
@@ -51,6 +52,14 @@ TEST_F(DocDBRocksDBUtilTest, CaseInsensitiveCompressionType) {
 
   got_compression_type = CHECK_RESULT(TEST_GetConfiguredCompressionType("zLiB"));
   ASSERT_EQ(got_compression_type, rocksdb::kZlibCompression);
+
+  // ZSTD is accepted only when the server is built with ZSTD support.
+  if (rocksdb::ZSTD_Supported()) {
+    got_compression_type = CHECK_RESULT(TEST_GetConfiguredCompressionType("Zstd"));
+    ASSERT_EQ(got_compression_type, rocksdb::kZSTD);
+  } else {
+    ASSERT_NOK(TEST_GetConfiguredCompressionType("Zstd"));
+  }
 }
 
 TEST_F(DocDBRocksDBUtilTest, MaxBackgroundFlushesDefault) {
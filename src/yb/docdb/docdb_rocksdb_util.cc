@@ -18,11 +18,13 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include "yb/common/doc_hybrid_time.h"
 #include "yb/common/transaction.h"
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_tombstone_density_collector.h"
 #include "yb/docdb/docdb_filter_policy.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/key_bounds.h"
@@ -39,6 +41,7 @@
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/rate_limiter.h"
+#include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/filtering_iterator.h"
 #include "yb/rocksdb/types.h"
@@ -46,6 +49,7 @@
 
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flags.h"
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/priority_thread_pool.h"
@@ -104,6 +108,15 @@ DEFINE_UNKNOWN_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 102
              "Threshold beyond which compaction is considered large.");
 DEFINE_UNKNOWN_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_NON_RUNTIME_int32(rocksdb_max_subcompactions, -1,
+    "Max number of key range subcompactions, that a large compaction is split into. Compaction "
+    "is split only when its input exceeds 2 * rocksdb_compaction_size_threshold_bytes. "
+    "-1 - use the size of priority thread pool, 1 - do not split compactions.");
+DEFINE_NON_RUNTIME_bool(rocksdb_use_direct_io_for_flush_and_compaction, false,
+    "Use O_DIRECT for SST files written by flushes and compactions, and for SST files read by "
+    "compactions, so background I/O does not evict pages used by user reads from the OS page "
+    "cache. User reads keep using buffered I/O.");
+TAG_FLAG(rocksdb_use_direct_io_for_flush_and_compaction, advanced);
 DEFINE_UNKNOWN_int32(rocksdb_max_write_buffer_number, 2,
              "Maximum number of write buffers that are built up in memory.");
 
@@ -127,6 +140,12 @@ DEFINE_UNKNOWN_int32(memstore_size_mb, 128,
 
 DEFINE_UNKNOWN_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_NON_RUNTIME_bool(use_docdb_aware_ribbon_filter, false,
+    "Build ribbon filters instead of bloom filters for new SST files, when "
+    "use_docdb_aware_bloom_filter is set. Ribbon filter needs less memory for the same false "
+    "positive rate, but takes more CPU to build. Files with both filter types could be read "
+    "regardless of this flag.");
+TAG_FLAG(use_docdb_aware_ribbon_filter, advanced);
 // Empirically 2 is a minimal value that provides best performance on sequential scan.
 DEFINE_UNKNOWN_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
@@ -156,7 +175,13 @@ DEFINE_UNKNOWN_int32(priority_thread_pool_size, -1,
 
 DEFINE_UNKNOWN_string(compression_type, "Snappy",
               "On-disk compression type to use in RocksDB."
-              "By default, Snappy is used if supported.");
+              "By default, Snappy is used if supported. ZSTD is accepted only when the server is "
+              "built with ZSTD support, which is not part of the standard third-party "
+              "dependencies.");
+
+DEFINE_NON_RUNTIME_int32(compression_level, -1,
+    "Compression level used for on-disk compression, if supported by compression_type. "
+    "-1 to use the default level of the compression library.");
 
 DEFINE_UNKNOWN_int32(block_restart_interval, kDefaultDataBlockRestartInterval,
              "Controls the number of keys to look at for computing the diff encoding.");
@@ -167,10 +192,51 @@ DEFINE_UNKNOWN_int32(index_block_restart_interval, kDefaultIndexBlockRestartInte
 DEFINE_UNKNOWN_bool(prioritize_tasks_by_disk, false,
             "Consider disk load when considering compaction and flush priorities.");
 
+DEFINE_NON_RUNTIME_bool(use_data_block_hash_index, false,
+    "Build hash index in data blocks of new SST files, that maps key without HybridTime to "
+    "the restart interval. It allows point lookups to avoid binary search inside data block. "
+    "Has effect only after data_block_hash_index_supported is promoted. Versions without hash "
+    "index support could not read such SST files, so before downgrade turn this flag off and "
+    "run full compaction of all tablets to rewrite their SST files.");
+TAG_FLAG(use_data_block_hash_index, advanced);
+
+// Using class kExternal as data blocks with hash index could not be read by older versions, and
+// SST files are sent to xClusters during bootstrap.
+DEFINE_RUNTIME_AUTO_bool(data_block_hash_index_supported, kExternal, false, true,
+    "Whether all servers are able to read data blocks with hash index. Hash index is built "
+    "only when this flag and use_data_block_hash_index are set.");
+
 namespace yb {
 
 namespace {
 
+// Strips DocHybridTime with preceding kHybridTime from the key, so all versions of the same
+// SubDocKey, and seek key without DocHybridTime have the same prefix. Keys without DocHybridTime
+// are used as is.
+class DocHybridTimeStrippingTransform : public rocksdb::SliceTransform {
+ public:
+  const char* Name() const override { return "DocHybridTimeStrippingTransform"; }
+
+  Slice Transform(const Slice& key) const override {
+    const auto encoded_size = DocHybridTime::EncodedSizeOrZero(key);
+    if (encoded_size == 0 || key.size() <= encoded_size ||
+        key[key.size() - encoded_size - 1] != docdb::KeyEntryTypeAsChar::kHybridTime) {
+      return key;
+    }
+    return key.Prefix(key.size() - encoded_size - 1);
+  }
+
+  bool InDomain(const Slice& key) const override { return true; }
+
+  bool InRange(const Slice& prefix) const override { return true; }
+};
+
+const std::shared_ptr<const rocksdb::SliceTransform>& DocHybridTimeStrippingTransformInstance() {
+  static const std::shared_ptr<const rocksdb::SliceTransform> instance =
+      std::make_shared<DocHybridTimeStrippingTransform>();
+  return instance;
+}
+
 Result<rocksdb::CompressionType> GetConfiguredCompressionType(const std::string& flag_value) {
   if (!FLAGS_enable_ondisk_compression) {
     return rocksdb::kNoCompression;
@@ -179,7 +245,8 @@ Result<rocksdb::CompressionType> GetConfiguredCompressionType(const std::string&
     rocksdb::kNoCompression,
     rocksdb::kSnappyCompression,
     rocksdb::kZlibCompression,
-    rocksdb::kLZ4Compression
+    rocksdb::kLZ4Compression,
+    rocksdb::kZSTD
   };
   for (const auto& compression_type : kValidRocksDBCompressionTypes) {
     if (boost::iequals(flag_value, rocksdb::CompressionTypeToString(compression_type))) {
@@ -248,6 +315,8 @@ namespace yb {
 namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory>
+    DocDataBlockBoundariesCollectorFactoryInstance();
 
 void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter) {
   SeekForward(key_bytes.AsSlice(), iter);
@@ -370,12 +439,13 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
-    const Slice* iterate_upper_bound) {
+    const Slice* iterate_upper_bound,
+    const KeyBounds* read_bounds) {
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
       user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
   return std::make_unique<IntentAwareIterator>(
-      doc_db, read_opts, deadline, read_time, txn_op_context);
+      doc_db, read_opts, deadline, read_time, txn_op_context, read_bounds);
 }
 
 namespace {
@@ -618,7 +688,12 @@ void InitRocksDBOptions(
   options->info_log_level = YBRocksDBLogger::ConvertToRocksDBLogLevel(FLAGS_minloglevel);
   options->initial_seqno = FLAGS_initial_seqno;
   options->boundary_extractor = DocBoundaryValuesExtractorInstance();
+  options->table_properties_collector_factories = {
+      DocDataBlockBoundariesCollectorFactoryInstance(),
+      DocTombstoneDensityCollectorFactoryInstance() };
   options->compaction_measure_io_stats = FLAGS_rocksdb_compaction_measure_io_stats;
+  options->use_direct_io_for_flush_and_compaction =
+      FLAGS_rocksdb_use_direct_io_for_flush_and_compaction;
   options->memory_monitor = tablet_options.memory_monitor;
   options->disk_group_no = group_no;
   if (FLAGS_db_write_buffer_size != -1) {
@@ -637,6 +712,7 @@ void InitRocksDBOptions(
   // Since the flag validator for FLAGS_compression_type will fail if the result of this call is not
   // OK, this CHECK_RESULT should never fail and is safe.
   options->compression = CHECK_RESULT(GetConfiguredCompressionType(FLAGS_compression_type));
+  options->compression_opts.level = FLAGS_compression_level;
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -657,16 +733,31 @@ void InitRocksDBOptions(
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     const auto filter_block_size_bits = table_options.filter_block_size * 8;
-    table_options.filter_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
-        filter_block_size_bits, options->info_log.get());
+    rocksdb::BlockBasedTableOptions::FilterPolicyPtr bloom_policy =
+        std::make_shared<const DocDbAwareV3FilterPolicy>(
+            filter_block_size_bits, options->info_log.get());
+    rocksdb::BlockBasedTableOptions::FilterPolicyPtr ribbon_policy =
+        std::make_shared<const DocDbAwareV3RibbonFilterPolicy>(
+            filter_block_size_bits, options->info_log.get());
+    table_options.filter_policy = FLAGS_use_docdb_aware_ribbon_filter ? ribbon_policy
+                                                                       : bloom_policy;
     table_options.supported_filter_policies =
         std::make_shared<rocksdb::BlockBasedTableOptions::FilterPoliciesMap>();
+    // Both V3 policies are supported for reading, so the flag could be switched in both directions.
+    AddSupportedFilterPolicy(bloom_policy, &table_options);
+    AddSupportedFilterPolicy(ribbon_policy, &table_options);
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareHashedComponentsFilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV2FilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
   }
 
+  // Key transform is always set, so SST files with hash index could be efficiently read after the
+  // flag is turned off.
+  table_options.data_block_hash_index =
+      FLAGS_use_data_block_hash_index && GetAtomicFlag(&FLAGS_data_block_hash_index_supported);
+  table_options.data_block_hash_index_key_transform = DocHybridTimeStrippingTransformInstance();
+
   if (FLAGS_use_multi_level_index) {
     table_options.index_type = rocksdb::IndexType::kMultiLevelBinarySearch;
   } else {
@@ -702,6 +793,8 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions = static_cast<uint32_t>(FLAGS_rocksdb_max_subcompactions > 0
+        ? FLAGS_rocksdb_max_subcompactions : GetGlobalRocksDBPriorityThreadPoolSize());
     options->rate_limiter = tablet_options.rate_limiter ? tablet_options.rate_limiter
                                                         : CreateRocksDBRateLimiter();
   } else {
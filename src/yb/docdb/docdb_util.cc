@@ -479,7 +479,8 @@ Status DocDBRocksDBUtil::ReinitDBOptions() {
       [this](const std::vector<rocksdb::FileMetaData*>&) {
         return delete_marker_retention_time_;
       } ,
-      /* schema_packing_provider= */ nullptr);
+      schema_packing_provider_);
+  regular_db_options_.subcompaction_boundary_prefix_size = CreateSubcompactionBoundaryPrefixSize();
   regular_db_options_.compaction_file_filter_factory =
       compaction_file_filter_factory_;
   regular_db_options_.max_file_size_for_compaction =
@@ -237,6 +237,7 @@ class DocDBRocksDBUtil {
       std::make_shared<ManualHistoryRetentionPolicy>() };
   std::shared_ptr<rocksdb::CompactionFileFilterFactory> compaction_file_filter_factory_;
   std::shared_ptr<std::function<uint64_t()>> max_file_size_for_compaction_;
+  SchemaPackingProvider* schema_packing_provider_ = nullptr; // Owned externally.
 
   rocksdb::WriteOptions write_options_;
   DocReadContext doc_read_context_;
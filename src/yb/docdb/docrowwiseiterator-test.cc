@@ -20,6 +20,7 @@
 #include "yb/common/read_hybrid_time.h"
 #include "yb/common/transaction-test-util.h"
 
+#include "yb/docdb/columnar_row_batch.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_read_context.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
@@ -138,6 +139,7 @@ class DocRowwiseIteratorTest : public DocDBTestBase {
   void SetupDocRowwiseIteratorData();
   void TestDocRowwiseIterator();
   void TestDocRowwiseIteratorCallbackAPI();
+  void TestDocRowwiseIteratorRowBatch();
   void TestDocRowwiseIteratorDeletedDocument();
   void TestDocRowwiseIteratorWithRowDeletes();
   void TestBackfillInsert();
@@ -1122,6 +1124,101 @@ void DocRowwiseIteratorTest::TestDocRowwiseIteratorCallbackAPI() {
   }
 }
 
+void DocRowwiseIteratorTest::TestDocRowwiseIteratorRowBatch() {
+  SetupDocRowwiseIteratorData();
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+  auto doc_read_context = DocReadContext::TEST_Create(schema);
+  QLValuePB value;
+
+  {
+    auto iter = ASSERT_RESULT(CreateIterator(
+        projection, doc_read_context, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(5000)));
+
+    ColumnarRowBatch batch;
+    ASSERT_EQ(ASSERT_RESULT(iter->NextRowBatch(10, &batch)), 2);
+    ASSERT_EQ(batch.num_rows(), 2);
+    ASSERT_EQ(batch.CountSelected(), 2);
+
+    // Primary key columns are followed by the projection columns.
+    ASSERT_EQ(batch.num_columns(), 5);
+    ASSERT_EQ(batch.column(0).id(), schema.column_id(0));
+    ASSERT_EQ(batch.column(1).id(), schema.column_id(1));
+    for (size_t i = 0; i != projection.num_columns(); ++i) {
+      ASSERT_EQ(batch.column(2 + i).id(), projection.column_id(i));
+    }
+
+    batch.column(0).GetValue(0, &value);
+    ASSERT_EQ(kStrKey1, value.string_value());
+    batch.column(0).GetValue(1, &value);
+    ASSERT_EQ(kStrKey2, value.string_value());
+
+    const auto& int_key = batch.column(1);
+    ASSERT_EQ(int_key.layout(), ColumnVector::Layout::kInt);
+    ASSERT_EQ(int_key.int_data()[0], kIntKey1);
+    ASSERT_EQ(int_key.int_data()[1], kIntKey2);
+
+    const auto& c = *batch.FindColumn(projection.column_id(0));
+    ASSERT_FALSE(c.IsNull(0));
+    ASSERT_EQ("row1_c", c.value(0).string_value());
+    ASSERT_TRUE(c.IsNull(1));
+    ASSERT_EQ(c.CountNotNull(), 1);
+
+    const auto& d = *batch.FindColumn(projection.column_id(1));
+    ASSERT_EQ(d.layout(), ColumnVector::Layout::kInt);
+    ASSERT_FALSE(d.IsNull(0));
+    ASSERT_FALSE(d.IsNull(1));
+    ASSERT_EQ(d.int_data()[0], 10000);
+    ASSERT_EQ(d.int_data()[1], 30000);
+    d.GetValue(1, &value);
+    ASSERT_EQ(30000, value.int64_value());
+
+    const auto& e = *batch.FindColumn(projection.column_id(2));
+    ASSERT_EQ("row1_e", e.value(0).string_value());
+    ASSERT_EQ("row2_e_prime", e.value(1).string_value());
+
+    // Materialized row should be the same as the one returned by NextRow.
+    QLTableRow row;
+    batch.ExtractRow(1, &row);
+    QLValue ql_value;
+    ASSERT_OK(row.GetValue(projection.column_id(0), &ql_value));
+    ASSERT_TRUE(ql_value.IsNull());
+    ASSERT_OK(row.GetValue(projection.column_id(1), &ql_value));
+    ASSERT_EQ(30000, ql_value.int64_value());
+
+    batch.Clear();
+    ASSERT_EQ(ASSERT_RESULT(iter->NextRowBatch(10, &batch)), 0);
+    ASSERT_EQ(batch.num_columns(), 5);
+    ASSERT_TRUE(batch.empty());
+  }
+
+  // Batch size limit is respected and rows are not lost between batches.
+  {
+    auto iter = ASSERT_RESULT(CreateIterator(
+        projection, doc_read_context, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000)));
+
+    ColumnarRowBatch batch;
+    ASSERT_EQ(ASSERT_RESULT(iter->NextRowBatch(1, &batch)), 1);
+    ASSERT_EQ(batch.column(1).int_data()[0], kIntKey1);
+    ASSERT_EQ(batch.FindColumn(projection.column_id(1))->int_data()[0], 10000);
+
+    batch.Clear();
+    ASSERT_EQ(ASSERT_RESULT(iter->NextRowBatch(1, &batch)), 1);
+    ASSERT_EQ(batch.column(1).int_data()[0], kIntKey2);
+    ASSERT_EQ(batch.FindColumn(projection.column_id(1))->int_data()[0], 20000);
+
+    batch.Unselect(0);
+    ASSERT_EQ(batch.CountSelected(), 0);
+
+    batch.Clear();
+    ASSERT_EQ(ASSERT_RESULT(iter->NextRowBatch(1, &batch)), 0);
+    ASSERT_FALSE(ASSERT_RESULT(iter->HasNext()));
+  }
+}
+
 void DocRowwiseIteratorTest::TestDocRowwiseIteratorDeletedDocument() {
   ASSERT_OK(SetPrimitive(
       DocPath(kEncodedDocKey1, KeyEntryValue::MakeColumnId(30_ColId)),
@@ -2456,6 +2553,10 @@ TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorTestCallbackAPI) {
     TestDocRowwiseIteratorCallbackAPI();
 }
 
+TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorRowBatch) {
+    TestDocRowwiseIteratorRowBatch();
+}
+
 TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorDeletedDocumentTest) {
     TestDocRowwiseIteratorDeletedDocument();
 }
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/intent_aware_iterator.h"
 
+#include <algorithm>
 #include <future>
 
 #include "yb/common/doc_hybrid_time.h"
@@ -28,6 +29,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
 #include "yb/docdb/intent_iterator.h"
+#include "yb/docdb/intents_index.h"
 #include "yb/docdb/key_bounds.h"
 #include "yb/docdb/transaction_dump.h"
 #include "yb/docdb/value.h"
@@ -102,7 +104,8 @@ IntentAwareIterator::IntentAwareIterator(
     const rocksdb::ReadOptions& read_opts,
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
-    const TransactionOperationContext& txn_op_context)
+    const TransactionOperationContext& txn_op_context,
+    const KeyBounds* read_bounds)
     : read_time_(read_time),
       encoded_read_time_read_(EncodeHybridTime(read_time_.read)),
       encoded_read_time_local_limit_(EncodeHybridTime(read_time_.local_limit)),
@@ -111,13 +114,23 @@ IntentAwareIterator::IntentAwareIterator(
           read_time_.local_limit > read_time_.read ? Slice(encoded_read_time_local_limit_)
                                                    : Slice(encoded_read_time_read_)),
       txn_op_context_(txn_op_context),
+      regular_db_(doc_db.regular),
+      query_id_(read_opts.query_id),
       transaction_status_cache_(txn_op_context_, read_time, deadline) {
   VTRACE(1, __func__);
   VLOG(4) << "IntentAwareIterator, read_time: " << read_time
           << ", txn_op_context: " << txn_op_context_;
 
   if (txn_op_context) {
-    if (txn_op_context.txn_status_manager->MinRunningHybridTime() != HybridTime::kMax) {
+    // Intents index should be checked before regular DB iterator is created. Transaction is removed
+    // from the index only after its intents were applied to regular DB, so regular DB iterator
+    // created after the check will see all records of transactions that were missing in index.
+    if (txn_op_context.txn_status_manager->MinRunningHybridTime() == HybridTime::kMax) {
+      VLOG(4) << "No transactions running";
+    } else if (read_bounds && doc_db.intents_index &&
+               !doc_db.intents_index->MayHaveIntents(read_bounds->lower, read_bounds->upper)) {
+      VLOG(4) << "No intents in " << read_bounds->ToString();
+    } else {
       intent_iter_ = docdb::CreateRocksDBIterator(doc_db.intents,
                                                   doc_db.key_bounds,
                                                   docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
@@ -125,8 +138,6 @@ IntentAwareIterator::IntentAwareIterator(
                                                   rocksdb::kDefaultQueryId,
                                                   nullptr /* file_filter */,
                                                   &intent_upperbound_);
-    } else {
-      VLOG(4) << "No transactions running";
     }
   }
   // WARNING: Is is important for regular DB iterator to be created after intents DB iterator,
@@ -141,6 +152,22 @@ IntentAwareIterator::IntentAwareIterator(
   VTRACE(2, "Created iterator");
 }
 
+void IntentAwareIterator::PrefetchDataBlocks(std::vector<KeyBytes>* keys) {
+  std::sort(keys->begin(), keys->end());
+  keys->erase(std::unique(keys->begin(), keys->end()), keys->end());
+  std::vector<Slice> slices;
+  slices.reserve(keys->size());
+  for (const auto& key : *keys) {
+    slices.push_back(key.AsSlice());
+  }
+  rocksdb::ReadOptions read_opts;
+  read_opts.query_id = query_id_;
+  // Prefetch is an optimization, so its failure is not propagated. The following seek will read
+  // blocks on its own and report the error if any.
+  auto status = regular_db_->PrefetchDataBlocks(read_opts, slices);
+  VLOG_IF(1, !status.ok()) << "Prefetch of " << keys->size() << " keys failed: " << status;
+}
+
 void IntentAwareIterator::Seek(const DocKey &doc_key) {
   Seek(doc_key.Encode());
 }
@@ -53,6 +53,10 @@ YB_DEFINE_ENUM(SeekIntentIterNeeded, (kNoNeed)(kSeek)(kSeekForward));
 //
 // KeyBytes/Slice passed to Seek* methods should not contain hybrid time.
 // HybridTime of subdoc_key in Seek* methods would be ignored.
+//
+// When read_bounds are specified, the caller guarantees that only keys within them (inclusive)
+// and their prefixes will be read. In this case intents DB is not used at all if intents index of
+// the tablet does not have live transactions overlapping these bounds.
 class IntentAwareIterator : public IntentAwareIteratorIf {
  public:
   IntentAwareIterator(
@@ -60,7 +64,8 @@ class IntentAwareIterator : public IntentAwareIteratorIf {
       const rocksdb::ReadOptions& read_opts,
       CoarseTimePoint deadline,
       const ReadHybridTime& read_time,
-      const TransactionOperationContext& txn_op_context);
+      const TransactionOperationContext& txn_op_context,
+      const KeyBounds* read_bounds = nullptr);
 
   IntentAwareIterator(const IntentAwareIterator& other) = delete;
   void operator=(const IntentAwareIterator& other) = delete;
@@ -145,6 +150,11 @@ class IntentAwareIterator : public IntentAwareIteratorIf {
     upperbound_ = upperbound;
   }
 
+  // Loads data blocks of regular DB, that could contain specified keys, into block cache. Missing
+  // blocks are read with a single batch of reads per SST file, so subsequent seeks to these keys,
+  // e.g. targets of IN list, don't read blocks one by one. Keys are reordered by this call.
+  void PrefetchDataBlocks(std::vector<KeyBytes>* keys);
+
   void DebugDump();
 
   std::string DebugPosToString() override;
@@ -282,6 +292,8 @@ class IntentAwareIterator : public IntentAwareIteratorIf {
   Slice encoded_read_time_regular_limit_;
 
   const TransactionOperationContext txn_op_context_;
+  rocksdb::DB* const regular_db_;
+  const rocksdb::QueryId query_id_;
   docdb::BoundedRocksDbIterator intent_iter_;
   docdb::BoundedRocksDbIterator iter_;
   // iter_valid_ is true if and only if iter_ is positioned at key which matches top prefix from
@@ -0,0 +1,88 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/intents_index.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+KeyBytes RangeKey(int32_t value) {
+  return DocKey({KeyEntryValue::Int32(value)}).Encode();
+}
+
+KeyBytes ColumnKey(int32_t value, ColumnId column_id) {
+  return SubDocKey(DocKey({KeyEntryValue::Int32(value)}), KeyEntryValue::MakeColumnId(column_id))
+      .EncodeWithoutHt();
+}
+
+} // namespace
+
+class IntentsIndexTest : public YBTest {
+};
+
+TEST_F(IntentsIndexTest, Basic) {
+  IntentsIndex index;
+  // Not loaded index does not know about intents written before restart.
+  ASSERT_TRUE(index.MayHaveIntents(RangeKey(1), RangeKey(2)));
+  index.SetLoaded();
+  ASSERT_FALSE(index.MayHaveIntents(RangeKey(1), RangeKey(2)));
+  ASSERT_FALSE(index.MayHaveIntents(Slice(), Slice()));
+
+  const auto txn1 = TransactionId::GenerateRandom();
+  index.Add(txn1, ColumnKey(10, 1_ColId), ColumnKey(10, 1_ColId));
+  index.Add(txn1, ColumnKey(20, 2_ColId), ColumnKey(20, 2_ColId));
+  ASSERT_EQ(index.num_transactions(), 1);
+
+  ASSERT_FALSE(index.MayHaveIntents(RangeKey(1), RangeKey(5)));
+  ASSERT_FALSE(index.MayHaveIntents(RangeKey(21), Slice()));
+  ASSERT_TRUE(index.MayHaveIntents(RangeKey(15), RangeKey(16)));
+  ASSERT_TRUE(index.MayHaveIntents(RangeKey(10), RangeKey(10)));
+  ASSERT_TRUE(index.MayHaveIntents(Slice(), RangeKey(10)));
+  ASSERT_TRUE(index.MayHaveIntents(RangeKey(20), Slice()));
+
+  // Strong intent for the whole row affects reads of its columns.
+  const auto txn2 = TransactionId::GenerateRandom();
+  index.Add(txn2, RangeKey(30), RangeKey(30));
+  ASSERT_TRUE(index.MayHaveIntents(ColumnKey(30, 1_ColId), ColumnKey(30, 2_ColId)));
+  ASSERT_FALSE(index.MayHaveIntents(ColumnKey(31, 1_ColId), RangeKey(32)));
+
+  index.Remove(txn1);
+  ASSERT_FALSE(index.MayHaveIntents(RangeKey(15), RangeKey(16)));
+  ASSERT_TRUE(index.MayHaveIntents(RangeKey(25), RangeKey(35)));
+  index.Remove(txn2);
+  ASSERT_FALSE(index.MayHaveIntents(Slice(), Slice()));
+  ASSERT_EQ(index.num_transactions(), 0);
+}
+
+TEST_F(IntentsIndexTest, Unbounded) {
+  IntentsIndex index;
+  const auto txn = TransactionId::GenerateRandom();
+  index.AddUnbounded(txn);
+  index.SetLoaded();
+  ASSERT_TRUE(index.MayHaveIntents(RangeKey(1), RangeKey(2)));
+  // Range of transaction with unknown intents should not be narrowed.
+  index.Add(txn, RangeKey(10), RangeKey(10));
+  ASSERT_TRUE(index.MayHaveIntents(RangeKey(1), RangeKey(2)));
+  index.Remove(txn);
+  ASSERT_FALSE(index.MayHaveIntents(RangeKey(1), RangeKey(2)));
+}
+
+}  // namespace docdb
+}  // namespace yb
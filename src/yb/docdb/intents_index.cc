@@ -0,0 +1,129 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/intents_index.h"
+
+#include <algorithm>
+
+#include "yb/util/flags.h"
+#include "yb/util/shared_lock.h"
+
+DEFINE_RUNTIME_uint64(intents_index_max_transactions, 64,
+    "Max number of live transactions, whose key ranges are checked to decide whether read could "
+    "skip intents DB. When tablet has more live transactions, intents DB is always used.");
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Checks whether [min_key, max_key] intersects [lower, upper] or contains a prefix of lower.
+bool RangeMayAffectRead(
+    const Slice& min_key, const Slice& max_key, const Slice& lower, const Slice& upper) {
+  if (min_key.empty()) {
+    return true;
+  }
+  if (!upper.empty() && min_key.compare(upper) > 0) {
+    return false;
+  }
+  if (lower.empty() || max_key.compare(lower) >= 0) {
+    return true;
+  }
+  // All prefixes of lower are ordered by their length. The longest one, that does not exceed
+  // max_key, is the common prefix of lower and max_key, so it is enough to check only it.
+  const auto common_prefix = max_key.difference_offset(lower);
+  if (common_prefix == max_key.size()) {
+    return true;
+  }
+  return common_prefix != 0 && Slice(lower.data(), common_prefix).compare(min_key) >= 0;
+}
+
+} // namespace
+
+std::vector<IntentsIndex::Entry>::iterator IntentsIndex::Find(const TransactionId& id) {
+  return std::find_if(
+      entries_.begin(), entries_.end(), [&id](const Entry& entry) { return entry.id == id; });
+}
+
+void IntentsIndex::Add(const TransactionId& id, const Slice& min_key, const Slice& max_key) {
+  DCHECK(!min_key.empty());
+  DCHECK_LE(min_key.compare(max_key), 0);
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  auto it = Find(id);
+  if (it == entries_.end()) {
+    entries_.push_back(Entry {
+      .id = id,
+      .min_key = KeyBytes(min_key),
+      .max_key = KeyBytes(max_key),
+    });
+    return;
+  }
+  if (it->min_key.empty()) {
+    return;
+  }
+  if (it->min_key.CompareTo(min_key) > 0) {
+    it->min_key.Reset(min_key);
+  }
+  if (it->max_key.CompareTo(max_key) < 0) {
+    it->max_key.Reset(max_key);
+  }
+}
+
+void IntentsIndex::AddUnbounded(const TransactionId& id) {
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  auto it = Find(id);
+  if (it == entries_.end()) {
+    entries_.push_back(Entry { .id = id });
+    return;
+  }
+  it->min_key.Clear();
+  it->max_key.Clear();
+}
+
+void IntentsIndex::Remove(const TransactionId& id) {
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  auto it = Find(id);
+  if (it == entries_.end()) {
+    return;
+  }
+  if (it != entries_.end() - 1) {
+    *it = std::move(entries_.back());
+  }
+  entries_.pop_back();
+}
+
+void IntentsIndex::SetLoaded() {
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  loaded_ = true;
+}
+
+bool IntentsIndex::MayHaveIntents(const Slice& lower, const Slice& upper) const {
+  SharedLock<rw_spinlock> lock(mutex_);
+  if (!loaded_ || entries_.size() > FLAGS_intents_index_max_transactions) {
+    return true;
+  }
+  for (const auto& entry : entries_) {
+    if (RangeMayAffectRead(entry.min_key, entry.max_key, lower, upper)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t IntentsIndex::num_transactions() const {
+  SharedLock<rw_spinlock> lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,81 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <vector>
+
+#include "yb/common/transaction.h"
+
+#include "yb/docdb/key_bytes.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/locks.h"
+
+namespace yb {
+namespace docdb {
+
+// In-memory index of key ranges covered by strong intents of live transactions of a tablet.
+// Used to skip intents DB when a read does not overlap any provisional record.
+//
+// The index is conservative: it could report intents that are not present, but never misses
+// intents of a live transaction. So transaction should be added before its intents become visible
+// to readers, and removed only after its intents were applied to regular DB or it was aborted.
+//
+// Each transaction is represented by a single [min, max] range of its strong intent keys, so index
+// stays small and is checked with a linear scan over contiguous memory.
+class IntentsIndex {
+ public:
+  IntentsIndex() = default;
+
+  IntentsIndex(const IntentsIndex&) = delete;
+  void operator=(const IntentsIndex&) = delete;
+
+  // Extends range of the specified transaction with [min_key, max_key].
+  void Add(const TransactionId& id, const Slice& min_key, const Slice& max_key);
+
+  // Marks transaction as covering the whole key space. Used for transactions, that were loaded
+  // from intents DB, so their key ranges are unknown.
+  void AddUnbounded(const TransactionId& id);
+
+  void Remove(const TransactionId& id);
+
+  // Invoked once all transactions present in intents DB were added via AddUnbounded.
+  // Before that index reports that any range could have intents.
+  void SetLoaded();
+
+  // Returns true if there could be intents that affect read of keys in [lower, upper].
+  // Empty bound means that range is not bounded from this side.
+  // Strong intents written for a prefix of lower, e.g. row deletion, are also taken into account.
+  bool MayHaveIntents(const Slice& lower, const Slice& upper) const;
+
+  size_t num_transactions() const;
+
+ private:
+  struct Entry {
+    TransactionId id;
+    // Both bounds are inclusive. Empty min and max mean that range is unbounded.
+    KeyBytes min_key;
+    KeyBytes max_key;
+  };
+
+  std::vector<Entry>::iterator Find(const TransactionId& id) REQUIRES(mutex_);
+
+  mutable rw_spinlock mutex_;
+  bool loaded_ GUARDED_BY(mutex_) = false;
+  std::vector<Entry> entries_ GUARDED_BY(mutex_);
+};
+
+}  // namespace docdb
+}  // namespace yb
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/key_bytes.h"
 #include "yb/rocksdb/rocksdb_fwd.h"
 
@@ -51,6 +52,8 @@ struct DocDB {
   rocksdb::DB* regular = nullptr;
   rocksdb::DB* intents = nullptr;
   const KeyBounds* key_bounds = nullptr;
+  // Index of key ranges of live transactions, used to skip intents DB when possible.
+  const IntentsIndex* intents_index = nullptr;
 
   static DocDB FromRegularUnbounded(rocksdb::DB* regular) {
     return {regular, nullptr /* intents */, &KeyBounds::kNoBounds};
@@ -16,6 +16,7 @@
 #include <limits>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <boost/optional/optional_io.hpp>
@@ -24,6 +25,7 @@
 #include "yb/common/pg_system_attr.h"
 #include "yb/common/ql_value.h"
 
+#include "yb/docdb/columnar_row_batch.h"
 #include "yb/docdb/doc_path.h"
 #include "yb/docdb/doc_pg_expr.h"
 #include "yb/docdb/doc_pgsql_scanspec.h"
@@ -43,8 +45,11 @@
 
 #include "yb/util/algorithm_util.h"
 #include "yb/util/flags.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/memory/memory_usage.h"
 #include "yb/util/result.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/trace.h"
 
@@ -54,6 +59,7 @@ using std::vector;
 using std::string;
 
 using namespace std::literals;
+using namespace yb::size_literals;  // NOLINT.
 
 DECLARE_bool(ysql_disable_index_backfill);
 
@@ -87,6 +93,20 @@ DEFINE_UNKNOWN_uint64(
     ysql_packed_row_size_limit, 0,
     "Packed row size limit for YSQL in bytes. 0 to make this equal to SSTable block size.");
 
+DEFINE_RUNTIME_bool(ysql_enable_columnar_aggregate_scan, false,
+    "Whether to evaluate pushed down YSQL aggregates over columnar row batches, instead of "
+    "materializing every scanned row. Used only for aggregates over fixed width columns that "
+    "support batch evaluation.");
+
+DEFINE_RUNTIME_uint64(ysql_columnar_scan_batch_size, 1024,
+    "Max number of rows fetched from the DocDB iterator per columnar row batch.");
+
+DEFINE_RUNTIME_uint64(ysql_grouped_aggregate_max_memory_bytes, 16_MB,
+    "Max amount of memory used by a single pushed down YSQL aggregate with GROUP BY to hold "
+    "partial aggregates of the groups. When the limit is reached, or the tablet server is out of "
+    "memory, accumulated partial aggregates are added to the response, and grouping starts over. "
+    "The final aggregation is performed by the client.");
+
 DEFINE_test_flag(bool, ysql_suppress_ybctid_corruption_details, false,
                  "Whether to show less details on ybctid corruption error status message.  Useful "
                  "during tests that require consistent output.");
@@ -94,6 +114,33 @@ DEFINE_test_flag(bool, ysql_suppress_ybctid_corruption_details, false,
 namespace yb {
 namespace docdb {
 
+namespace {
+
+// Rough estimate of the memory used by the hash map entry, not counting key and partial aggregates.
+constexpr size_t kGroupEntryOverhead = 64;
+
+const MemTrackerPtr& GroupedAggregateMemTracker() {
+  static const MemTrackerPtr tracker = MemTracker::FindOrCreateTracker("YSQL Grouped Aggregates");
+  return tracker;
+}
+
+// Memory allocated by the partial aggregate value outside of QLValuePB itself.
+size_t AggregateValueDynamicSize(const QLValuePB& value) {
+  switch (value.value_case()) {
+    case QLValuePB::kStringValue:
+      return DynamicMemoryUsageOf(value.string_value());
+    case QLValuePB::kBinaryValue:
+      return DynamicMemoryUsageOf(value.binary_value());
+    case QLValuePB::kDecimalValue:
+      return DynamicMemoryUsageOf(value.decimal_value());
+    default:
+      // Other values returned to YSQL have fixed width.
+      return 0;
+  }
+}
+
+} // namespace
+
 bool ShouldYsqlPackRow(bool is_colocated) {
   return FLAGS_ysql_enable_packed_row &&
          (!is_colocated || FLAGS_ysql_enable_packed_row_for_colocated_table);
@@ -1232,7 +1279,7 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   CoarseTimePoint stop_scan = deadline - FLAGS_ysql_scan_deadline_margin_ms * 1ms;
 
   // Fetching data.
-  int match_count = 0;
+  size_t match_count = 0;
   QLTableRow table_row;
   YQLScanCallback callback = [&](const QLTableRow& row) -> Result<ContinueScan> {
     bool is_match = true;
@@ -1283,7 +1330,9 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
     }
 
     match_count++;
-    if (request_.is_aggregate()) {
+    if (request_.is_aggregate() && !request_.grouping_column_ids().empty()) {
+      fetched_rows += VERIFY_RESULT(EvalGroupedAggregate(*row_ptr, result_buffer));
+    } else if (request_.is_aggregate()) {
       RETURN_NOT_OK(EvalAggregate(*row_ptr));
     } else {
       RETURN_NOT_OK(PopulateResultSet(*row_ptr, result_buffer));
@@ -1297,14 +1346,21 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
                                                                    : ContinueScan::kFalse;
   };
 
-  RETURN_NOT_OK(iter->Iterate(std::move(callback)));
+  if (!request_.has_index_request() && UseColumnarAggregate(doc_schema)) {
+    match_count = VERIFY_RESULT(EvalAggregateBatches(
+        iter, &doc_expr_exec, stop_scan, &scan_time_exceeded));
+  } else {
+    RETURN_NOT_OK(iter->Iterate(std::move(callback)));
+  }
 
   VLOG(1) << "Stopped iterator after " << match_count << " matches, "
           << fetched_rows << " rows fetched";
   VLOG(1) << "Deadline is " << (scan_time_exceeded ? "" : "not ") << "exceeded";
 
   // Output aggregate values accumulated while looping over rows
-  if (request_.is_aggregate() && match_count > 0) {
+  if (!request_.grouping_column_ids().empty()) {
+    fetched_rows += VERIFY_RESULT(PopulateGroupedAggregates(result_buffer));
+  } else if (request_.is_aggregate() && match_count > 0) {
     RETURN_NOT_OK(PopulateAggregate(result_buffer));
     ++fetched_rows;
   }
@@ -1449,6 +1505,126 @@ Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
   return Status::OK();
 }
 
+Result<size_t> PgsqlReadOperation::EvalGroupedAggregate(
+    const QLTableRow& table_row, WriteBuffer *result_buffer) {
+  KeyBytes group_key;
+  for (auto column_id : request_.grouping_column_ids()) {
+    const auto value = table_row.GetValue(column_id);
+    if (value) {
+      KeyEntryValue::FromQLValuePBForKey(*value, SortingType::kNotSpecified).AppendToKey(
+          &group_key);
+    } else {
+      KeyEntryValue::NullValue(SortingType::kNotSpecified).AppendToKey(&group_key);
+    }
+  }
+
+  auto key = group_key.ToStringBuffer();
+  auto it = grouped_aggr_result_.find(key);
+  if (it == grouped_aggr_result_.end()) {
+    if (!grouped_aggr_consumption_) {
+      grouped_aggr_consumption_ = ScopedTrackedConsumption(GroupedAggregateMemTracker(), 0);
+    }
+    it = grouped_aggr_result_.emplace(std::move(key), GroupedAggregate {
+      .results = std::vector<QLExprResult>(request_.targets_size()),
+    }).first;
+  }
+
+  // Column references are evaluated to the grouping column values, same for every row of the
+  // group, and aggregates accumulate values of the rows.
+  auto& group = it->second;
+  size_t group_size = kGroupEntryOverhead + it->first.size() +
+                      group.results.size() * sizeof(QLExprResult);
+  size_t aggr_index = 0;
+  for (const PgsqlExpressionPB& expr : request_.targets()) {
+    auto& result = group.results[aggr_index++];
+    RETURN_NOT_OK(EvalExpr(expr, table_row, result.Writer()));
+    // Column reference points to the value of the current row, that does not outlive the scan
+    // callback, so the group keeps its own copy.
+    group_size += AggregateValueDynamicSize(result.ForceNewValue());
+  }
+
+  // Text and numeric partial aggregates, like min and max, could grow with every row of the group.
+  // Limits are checked only when consumption grows, i.e. for new groups and grown aggregates.
+  const auto old_group_size = std::exchange(group.consumption, group_size);
+  grouped_aggr_consumption_.Add(
+      static_cast<int64_t>(group_size) - static_cast<int64_t>(old_group_size));
+  if (group_size <= old_group_size ||
+      (static_cast<uint64_t>(grouped_aggr_consumption_.consumption()) <=
+           FLAGS_ysql_grouped_aggregate_max_memory_bytes &&
+       !GroupedAggregateMemTracker()->AnyLimitExceeded())) {
+    return 0;
+  }
+
+  // Partial aggregates are mergeable, so when out of memory, we could send accumulated groups to
+  // the client and start over. The client merges partial aggregates of the same group anyway.
+  VLOG(1) << "Flushing " << grouped_aggr_result_.size() << " groups, consumption: "
+          << grouped_aggr_consumption_.consumption();
+  return PopulateGroupedAggregates(result_buffer);
+}
+
+Result<size_t> PgsqlReadOperation::PopulateGroupedAggregates(WriteBuffer *result_buffer) {
+  const auto result = grouped_aggr_result_.size();
+  for (auto& [group_key, group] : grouped_aggr_result_) {
+    for (auto& column : group.results) {
+      RETURN_NOT_OK(pggate::WriteColumn(column.Value(), result_buffer));
+    }
+  }
+  grouped_aggr_result_.clear();
+  if (grouped_aggr_consumption_) {
+    grouped_aggr_consumption_.Reset(0);
+  }
+  return result;
+}
+
+bool PgsqlReadOperation::UseColumnarAggregate(const Schema& schema) const {
+  if (!FLAGS_ysql_enable_columnar_aggregate_scan || !request_.is_aggregate() ||
+      !request_.grouping_column_ids().empty() || request_.targets().empty()) {
+    return false;
+  }
+  for (const PgsqlExpressionPB& expr : request_.targets()) {
+    if (!CanEvalAggregateBatch(expr, schema)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Result<size_t> PgsqlReadOperation::EvalAggregateBatches(YQLRowwiseIteratorIf* iter,
+                                                        DocPgExprExecutor* expr_exec,
+                                                        CoarseTimePoint stop_scan,
+                                                        bool* scan_time_exceeded) {
+  if (aggr_result_.empty()) {
+    aggr_result_.resize(request_.targets().size());
+  }
+
+  const auto batch_size = std::max<uint64_t>(FLAGS_ysql_columnar_scan_batch_size, 1);
+  ColumnarRowBatch batch;
+  size_t match_count = 0;
+  for (;;) {
+    batch.Clear();
+    if (VERIFY_RESULT(iter->NextRowBatch(batch_size, &batch)) == 0) {
+      break;
+    }
+
+    // Match the rows with the where condition, and aggregate the remaining rows.
+    RETURN_NOT_OK(expr_exec->ExecBatch(&batch));
+    match_count += batch.CountSelected();
+
+    size_t aggr_index = 0;
+    for (const PgsqlExpressionPB& expr : request_.targets()) {
+      RETURN_NOT_OK(EvalAggregateBatch(
+          expr.tscall(), batch, &aggr_result_[aggr_index++].Writer().NewValue()));
+    }
+
+    // Check if we are running out of time
+    if (CoarseMonoClock::now() >= stop_scan) {
+      *scan_time_exceeded = true;
+      break;
+    }
+  }
+  return match_count;
+}
+
 Status PgsqlReadOperation::PopulateAggregate(WriteBuffer *result_buffer) {
   int column_count = request_.targets().size();
   for (int rscol_index = 0; rscol_index < column_count; rscol_index++) {
@@ -13,6 +13,10 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "yb/common/pgsql_protocol.pb.h"
 
 #include "yb/docdb/doc_expr.h"
@@ -21,6 +25,7 @@
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/ql_rowwise_iterator_interface.h"
 
+#include "yb/util/mem_tracker.h"
 #include "yb/util/write_buffer.h"
 
 namespace yb {
@@ -205,6 +210,25 @@ class PgsqlReadOperation : public DocExprExecutor {
 
   Status PopulateAggregate(WriteBuffer *result_buffer);
 
+  // Accumulate aggregates of the row into the partial aggregates of its group. If the memory
+  // allocated for groups is exhausted, accumulated groups are written to result_buffer first.
+  // Returns the number of groups written.
+  Result<size_t> EvalGroupedAggregate(const QLTableRow& table_row, WriteBuffer *result_buffer);
+
+  // Write partial aggregates of all accumulated groups to result_buffer and reset the groups.
+  // Returns the number of groups written.
+  Result<size_t> PopulateGroupedAggregates(WriteBuffer *result_buffer);
+
+  // Whether all the aggregate targets of the request could be evaluated over columnar batches.
+  bool UseColumnarAggregate(const Schema& schema) const;
+
+  // Read rows from the iterator in columnar batches, filter them with expr_exec and accumulate
+  // aggregates. Returns the number of rows matching the where condition.
+  Result<size_t> EvalAggregateBatches(YQLRowwiseIteratorIf* iter,
+                                      DocPgExprExecutor* expr_exec,
+                                      CoarseTimePoint stop_scan,
+                                      bool* scan_time_exceeded);
+
   // Checks whether we have processed enough rows for a page and sets the appropriate paging
   // state in the response object.
   Status SetPagingState(
@@ -219,6 +243,15 @@ class PgsqlReadOperation : public DocExprExecutor {
   PgsqlResponsePB response_;
   YQLRowwiseIteratorIf::UniPtr table_iter_;
   YQLRowwiseIteratorIf::UniPtr index_iter_;
+  struct GroupedAggregate {
+    std::vector<QLExprResult> results;
+    // Memory accounted for the group in grouped_aggr_consumption_.
+    size_t consumption = 0;
+  };
+  // Partial aggregates of a grouped aggregate request, keyed by encoded grouping column values.
+  std::unordered_map<std::string, GroupedAggregate> grouped_aggr_result_;
+  // Memory consumed by grouped_aggr_result_.
+  ScopedTrackedConsumption grouped_aggr_consumption_;
 };
 
 }  // namespace docdb
@@ -167,6 +167,9 @@ Status QLRocksDBStorage::GetIterator(
 
   auto doc_iter = std::make_unique<DocRowwiseIterator>(
       projection, doc_read_context, txn_op_context, doc_db_, deadline, read_time);
+  if (request.has_limit()) {
+    doc_iter->set_prefetch_row_limit(request.limit());
+  }
 
   if (range_components.size() == schema.num_range_key_columns()) {
     // Construct the scan spec basing on the RANGE condition as all range columns are specified.
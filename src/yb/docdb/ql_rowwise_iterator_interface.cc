@@ -13,6 +13,11 @@
 
 #include "yb/docdb/ql_rowwise_iterator_interface.h"
 
+#include "yb/common/ql_expr.h"
+#include "yb/common/schema.h"
+
+#include "yb/docdb/columnar_row_batch.h"
+
 #include "yb/util/result.h"
 
 namespace yb {
@@ -38,6 +43,32 @@ Status YQLRowwiseIteratorIf::NextRow(QLTableRow* table_row) {
   return DoNextRow(schema(), table_row);
 }
 
+Result<size_t> YQLRowwiseIteratorIf::NextRowBatch(size_t max_rows, ColumnarRowBatch* batch) {
+  return DoNextRowBatch(max_rows, batch);
+}
+
+Result<size_t> YQLRowwiseIteratorIf::DoNextRowBatch(size_t max_rows, ColumnarRowBatch* batch) {
+  if (batch->num_columns() == 0) {
+    batch->AddColumns(schema());
+  }
+  QLTableRow row;
+  size_t num_rows = 0;
+  while (num_rows < max_rows && VERIFY_RESULT(HasNext())) {
+    row.Clear();
+    RETURN_NOT_OK(DoNextRow(schema(), &row));
+    for (size_t i = 0; i != batch->num_columns(); ++i) {
+      auto& column = batch->column(i);
+      const auto* value = row.GetColumn(column.id().rep());
+      if (value) {
+        column.Append(*value);
+      }
+    }
+    batch->FinishRow();
+    ++num_rows;
+  }
+  return num_rows;
+}
+
 Status YQLRowwiseIteratorIf::Iterate(const YQLScanCallback& callback) {
   return STATUS(NotSupported, "This iterator does not support iterate with callback.");
 }
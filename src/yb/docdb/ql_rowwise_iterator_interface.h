@@ -82,6 +82,11 @@ class YQLRowwiseIteratorIf {
 
   Status NextRow(QLTableRow* table_row);
 
+  // Read up to max_rows next rows into the batch using the iterator projection. If batch does not
+  // have any columns yet, the iterator registers the columns it produces. Returns the number of
+  // rows added, zero means that iteration is finished.
+  Result<size_t> NextRowBatch(size_t max_rows, ColumnarRowBatch* batch);
+
   // Iterates over the rows until --
   //  - callback fails or returns false.
   //  - Iterator reaches end of iteration.
@@ -89,6 +94,9 @@ class YQLRowwiseIteratorIf {
 
  private:
   virtual Status DoNextRow(const Schema& projection, QLTableRow* table_row) = 0;
+
+  // Default implementation reads rows one by one and converts them to columnar format.
+  virtual Result<size_t> DoNextRowBatch(size_t max_rows, ColumnarRowBatch* batch);
 };
 
 }  // namespace docdb
@@ -260,6 +260,13 @@ Status TransactionalWriter::operator()(
     return Status::OK();
   }
 
+  if (min_strong_intent_key_.empty() || min_strong_intent_key_.CompareTo(*key) > 0) {
+    min_strong_intent_key_.Reset(key->AsSlice());
+  }
+  if (max_strong_intent_key_.CompareTo(*key) < 0) {
+    max_strong_intent_key_.Reset(key->AsSlice());
+  }
+
   const auto transaction_value_type = ValueEntryTypeAsChar::kTransactionId;
   const auto write_id_value_type = ValueEntryTypeAsChar::kWriteId;
   const auto row_lock_value_type = ValueEntryTypeAsChar::kRowLock;
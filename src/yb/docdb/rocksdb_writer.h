@@ -80,6 +80,16 @@ class TransactionalWriter : public rocksdb::DirectWriter {
     metadata_to_store_ = value;
   }
 
+  // Smallest and largest keys of strong intents written by this writer.
+  // Empty when no strong intents were written.
+  const KeyBytes& min_strong_intent_key() const {
+    return min_strong_intent_key_;
+  }
+
+  const KeyBytes& max_strong_intent_key() const {
+    return max_strong_intent_key_;
+  }
+
   Status operator()(
       IntentStrength intent_strength, FullDocKey, Slice value_slice, KeyBytes* key,
       LastKey last_key);
@@ -109,6 +119,8 @@ class TransactionalWriter : public rocksdb::DirectWriter {
   SubTransactionId subtransaction_id_;
   IntentTypeSet strong_intent_types_;
   std::unordered_map<KeyBuffer, IntentTypeSet, ByteBufferHash> weak_intents_;
+  KeyBytes min_strong_intent_key_;
+  KeyBytes max_strong_intent_key_;
 };
 
 // Base class used by IntentsWriter to handle found intents.
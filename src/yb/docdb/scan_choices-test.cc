@@ -276,6 +276,39 @@ TEST_F(ScanChoicesTest, SimpleInFilterHybridScan) {
   CheckSkipTargetsUpTo(schema, conds, {{{4, 4}, {5, 5}}, {{5, 7}, {6, 5}}});
 }
 
+TEST_F(ScanChoicesTest, PointKeys) {
+  PgsqlConditionPB cond;
+  SetupCondition(
+      &cond,
+      {{{10_ColId}, QL_OP_IN, {{5}, {6}}},
+       {{11_ColId}, QL_OP_IN, {{7}, {8}}}});
+  InitializeScanChoicesInstance(test_range_schema, cond);
+
+  auto keys = choices_->PointKeys(10);
+  ASSERT_EQ(keys.size(), 4);
+  size_t idx = 0;
+  for (int r1 : {5, 6}) {
+    for (int r2 : {7, 8}) {
+      auto expected = DocKey({KeyEntryValue::Int32(r1), KeyEntryValue::Int32(r2)}).Encode();
+      ASSERT_EQ(keys[idx].AsSlice(), expected.AsSlice())
+          << "Expected: " << DocKey::DebugSliceToString(expected.AsSlice())
+          << " but got: " << DocKey::DebugSliceToString(keys[idx].AsSlice());
+      ++idx;
+    }
+  }
+  // Too many keys.
+  ASSERT_TRUE(choices_->PointKeys(3).empty());
+
+  // Range condition on the leading column prevents enumeration.
+  cond.Clear();
+  SetupCondition(
+      &cond,
+      {{{10_ColId}, QL_OP_LESS_THAN_EQUAL, {{21}}},
+       {{11_ColId}, QL_OP_IN, {{5}, {6}}}});
+  InitializeScanChoicesInstance(test_range_schema, cond);
+  ASSERT_TRUE(choices_->PointKeys(10).empty());
+}
+
 TEST_F(ScanChoicesTest, SimplePartialFilterHybridScan) {
   std::vector<TestCondition> conds =
     {{{10_ColId}, QL_OP_IN, {{5}, {6}}}};
@@ -13,6 +13,8 @@
 
 #include "yb/docdb/scan_choices.h"
 
+#include <algorithm>
+
 #include "yb/common/ql_scanspec.h"
 #include "yb/common/schema.h"
 
@@ -754,6 +756,82 @@ Status HybridScanChoices::SeekToCurrentTarget(IntentAwareIteratorIf* db_iter) {
   return Status::OK();
 }
 
+std::vector<KeyBytes> HybridScanChoices::PointKeys(size_t max_keys) {
+  // Number of leading range columns, restricted to finite sets of values.
+  size_t num_point_columns = 0;
+  for (const auto& options : range_cols_scan_options_) {
+    const bool all_points = std::all_of(
+        options.begin(), options.end(), [](const OptionRange& option) {
+          return option.lower_inclusive() && option.upper_inclusive() &&
+                 option.lower() == option.upper();
+        });
+    if (!all_points) {
+      break;
+    }
+    ++num_point_columns;
+  }
+  if (num_point_columns == 0 || lower_doc_key_.empty()) {
+    return {};
+  }
+
+  DocKeyDecoder decoder(lower_doc_key_);
+  if (!decoder.DecodeToRangeGroup().ok()) {
+    return {};
+  }
+  const Slice prefix(lower_doc_key_.AsSlice().cdata(), decoder.left_input().cdata());
+
+  // Columns of the same group share logical option index, so keys are enumerated over groups.
+  // Each group is identified by its first column.
+  std::vector<size_t> group_of_column(num_point_columns);
+  std::vector<size_t> group_first_columns;
+  std::vector<size_t> group_sizes;
+  size_t num_keys = 1;
+  for (size_t column = 0; column != num_point_columns; ++column) {
+    const auto& group = col_groups_.GetGroup(column);
+    auto it = std::find(group_first_columns.begin(), group_first_columns.end(), group.front());
+    if (it == group_first_columns.end()) {
+      group_first_columns.push_back(group.front());
+      group_sizes.push_back(range_cols_scan_options_[group.back()].back().end_idx());
+      num_keys *= group_sizes.back();
+      if (num_keys > max_keys) {
+        return {};
+      }
+      it = group_first_columns.end() - 1;
+    }
+    group_of_column[column] = it - group_first_columns.begin();
+  }
+
+  std::vector<KeyBytes> result;
+  result.reserve(num_keys);
+  std::vector<size_t> option_indexes(group_sizes.size());
+  for (;;) {
+    KeyBytes key(prefix);
+    for (size_t column = 0; column != num_point_columns; ++column) {
+      const auto& options = range_cols_scan_options_[column];
+      const auto option_index = option_indexes[group_of_column[column]];
+      auto option = std::upper_bound(
+          options.begin(), options.end(), option_index,
+          [](size_t index, const OptionRange& range) { return index < range.end_idx(); });
+      DCHECK(option != options.end() && option->HasIndex(option_index));
+      option->lower().AppendToKey(&key);
+    }
+    if (num_point_columns == range_cols_scan_options_.size()) {
+      key.AppendKeyEntryType(KeyEntryType::kGroupEnd);
+    }
+    result.push_back(std::move(key));
+
+    // Advance to the next combination of group options.
+    size_t group = group_sizes.size();
+    while (group > 0 && ++option_indexes[group - 1] == group_sizes[group - 1]) {
+      option_indexes[--group] = 0;
+    }
+    if (group == 0) {
+      break;
+    }
+  }
+  return result;
+}
+
 ScanChoicesPtr ScanChoices::Create(
     const Schema& schema, const DocQLScanSpec& doc_spec,
     const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key) {
@@ -55,6 +55,13 @@ class ScanChoices {
   // current target.
   virtual Status SeekToCurrentTarget(IntentAwareIteratorIf* db_iter) = 0;
 
+  // Returns keys of all rows that could match scan choices, when they could be enumerated, i.e.
+  // leading range columns are restricted to finite sets of values. Keys are prefixes of doc keys
+  // in case only some of the range columns are restricted.
+  // Keys are returned in key order, regardless of the scan direction.
+  // Returns empty vector when keys could not be enumerated or there are more than max_keys.
+  virtual std::vector<KeyBytes> PointKeys(size_t max_keys) { return {}; }
+
   static Result<std::vector<KeyEntryValue>> DecodeKeyEntryValue(
       DocKeyDecoder* decoder, size_t num_cols);
 
@@ -270,6 +277,7 @@ class HybridScanChoices : public ScanChoices {
   Result<bool> SkipTargetsUpTo(const Slice& new_target) override;
   Status DoneWithCurrentTarget() override;
   Status SeekToCurrentTarget(IntentAwareIteratorIf* db_iter) override;
+  std::vector<KeyBytes> PointKeys(size_t max_keys) override;
 
  protected:
   friend class ScanChoicesTest;
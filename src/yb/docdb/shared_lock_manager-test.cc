@@ -22,6 +22,8 @@
 #include "yb/rpc/thread_pool.h"
 
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/flags.h"
+#include "yb/util/monotime.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/result.h"
 #include "yb/util/test_macros.h"
@@ -203,5 +205,48 @@ TEST_F(SharedLockManagerTest, DumpKeys) {
       "{ key: 626172 intent_types: [kStrongRead, kStrongWrite] }]");
 }
 
+// Hot row writes take weak intents on the shared keys, i.e. table and row prefixes, and a strong
+// intent on the column being updated. Such batches for different columns should not block each
+// other, while a strong intent on the row should wait for them.
+TEST_F(SharedLockManagerTest, HotRowColumnUpdates) {
+  constexpr size_t kNumThreads = 8;
+  constexpr size_t kNumIterations = 1000;
+  const RefCntPrefix kTableKey("table"s);
+  const RefCntPrefix kRowKey("table/row"s);
+  const auto weak_intents = IntentTypeSet({IntentType::kWeakRead, IntentType::kWeakWrite});
+  const auto strong_intents = IntentTypeSet({IntentType::kStrongRead, IntentType::kStrongWrite});
+  auto column_batch = [&](size_t column_idx, CoarseTimePoint deadline) {
+    return LockBatch(&lm_,
+                     {{kTableKey, weak_intents}, {kRowKey, weak_intents},
+                      {RefCntPrefix(Format("table/row/column_$0", column_idx)), strong_intents}},
+                     deadline);
+  };
+
+  {
+    auto lb1 = column_batch(0, CoarseTimePoint::max());
+    ASSERT_OK(lb1.status());
+    auto lb2 = column_batch(1, CoarseMonoClock::now() + 10ms);
+    ASSERT_OK(lb2.status());
+    LockBatch row_lb(&lm_, {{kRowKey, strong_intents}}, CoarseMonoClock::now() + 10ms);
+    ASSERT_NOK(row_lb.status());
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t thread_idx = 0; thread_idx != kNumThreads; ++thread_idx) {
+    threads.emplace_back([&, thread_idx] {
+      for (size_t i = 0; i != kNumIterations; ++i) {
+        auto lb = column_batch(thread_idx, CoarseMonoClock::now() + 10s);
+        ASSERT_OK(lb.status());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  LockBatch row_lb(&lm_, {{kRowKey, strong_intents}}, CoarseMonoClock::now() + 10ms);
+  ASSERT_OK(row_lb.status());
+}
+
 } // namespace docdb
 } // namespace yb
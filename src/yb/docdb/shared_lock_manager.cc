@@ -13,6 +13,7 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include <algorithm>
 #include <array>
 #include <condition_variable>
 #include <mutex>
@@ -24,13 +25,21 @@
 
 #include "yb/docdb/lock_batch.h"
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/enums.h"
+#include "yb/util/flags.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
 
 using std::string;
 
+DEFINE_NON_RUNTIME_uint32(shared_lock_manager_num_shards, 16,
+                          "Number of shards in the lock table of each tablet. Keys are distributed "
+                          "between shards by hash, so batches locking different keys contend on "
+                          "the same mutex only when their keys fall into the same shard.");
+
 namespace yb {
 namespace docdb {
 
@@ -135,8 +144,8 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and covers this field for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the shard owning this
+  // entry is locked.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -161,29 +170,48 @@ class SharedLockManager::Impl {
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  Impl()
+      : num_shards_(std::max<size_t>(FLAGS_shared_lock_manager_num_shards, 1)),
+        shards_(new Shard[num_shards_]) {}
+
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (size_t i = 0; i != num_shards_; ++i) {
+      auto& shard = shards_[i];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  // Part of the lock table, responsible for keys with the same hash modulo number of shards.
+  // Aligned to cache line, so mutexes of different shards don't share cache lines.
+  struct CACHELINE_ALIGNED Shard {
+    // Taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  };
+
+  Shard& ShardFor(const RefCntPrefix& key) {
+    return shards_[RefCntPrefixHash()(key) % num_shards_];
+  }
+
+  // Make sure the entries exist in the locks map of the corresponding shard and return pointers so
+  // we can access them without holding the shard lock. Pointers are stored to the locked field
+  // of the batch entries.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
-
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  const size_t num_shards_;
+  std::unique_ptr<Shard[]> shards_;
 };
 
 std::string SharedLockManager::ToString(const LockState& state) {
@@ -303,16 +331,17 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& shard = ShardFor(key_and_intent_type.key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& value = shard.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!shard.free_lock_entries.empty()) {
+        value = shard.free_lock_entries.back();
+        shard.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        shard.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = shard.lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -331,11 +360,12 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (const auto& item : key_to_intent_type) {
+    auto& shard = ShardFor(item.key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      shard.locks.erase(item.key);
+      shard.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -37,6 +37,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 
 #include "yb/rocksdb/statistics.h"
@@ -66,6 +67,15 @@ extern std::shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern std::shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new cache based on CLOCK eviction algorithm. Lookup and Release of such cache do not
+// acquire any locks, so it scales better than LRU cache when many threads read hot blocks.
+// Each shard uses a fixed size table, that is sized using estimated_entry_charge, i.e. expected
+// charge of a single entry. When all slots of the shard are occupied, entries are evicted even if
+// the shard has spare capacity.
+extern std::shared_ptr<Cache> NewClockCache(size_t capacity, size_t estimated_entry_charge,
+                                            int num_shard_bits,
+                                            bool strict_capacity_limit = false);
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
@@ -189,6 +199,17 @@ class Cache {
   // Tries to evict specified amount of bytes from cache.
   virtual size_t Evict(size_t required) { return 0; }
 
+  // Invoked for entries evicted from the cache to free space for new entries, but not for erased
+  // or replaced entries, and not for entries released by Evict, since its goal is to reduce memory
+  // usage. Invoked without holding cache locks, right before the entry deleter.
+  using EvictionCallback = std::function<void(
+      const Slice& key, void* value, void (*deleter)(const Slice& key, void* value))>;
+
+  // Sets callback for evicted entries. Should be invoked before the cache is used.
+  virtual void SetEvictionCallback(EvictionCallback callback) {
+    // default implementation is noop
+  }
+
   // Returns the single-touch and multi-touch cache usages for each of the shard.
   virtual std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() = 0;
 
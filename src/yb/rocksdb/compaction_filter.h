@@ -182,4 +182,18 @@ class CompactionFileFilterFactory {
   virtual const char* Name() const = 0;
 };
 
+// Chooses db_paths entry for the output of a compaction, based on metadata of its input files.
+class CompactionOutputPathSelector {
+ public:
+  virtual ~CompactionOutputPathSelector() = default;
+
+  // Returns path id for output files of compaction of input_files. picked_path_id is the path
+  // chosen by the compaction picker, and should be returned when selector has no preference.
+  virtual uint32_t SelectOutputPathId(
+      const std::vector<FileMetaData*>& input_files, uint32_t picked_path_id) = 0;
+
+  // Returns a name that identifies this selector.
+  virtual const char* Name() const = 0;
+};
+
 }  // namespace rocksdb
@@ -281,6 +281,13 @@ class DB {
                     keys, values);
   }
 
+  // Loads data blocks of SST files, that could contain specified keys, into block cache, so
+  // subsequent seeks to these keys don't have to read blocks one by one. Blocks missing from
+  // block cache are read with a single batch of reads per SST file. Keys should be sorted.
+  virtual Status PrefetchDataBlocks(const ReadOptions& options, const std::vector<Slice>& keys) {
+    return Status::OK();
+  }
+
   // If the key definitely does not exist in the database, then this method
   // returns false, else true. If the caller wants to obtain value when the key
   // is found in memory, a bool for 'value_found' must be passed. 'value_found'
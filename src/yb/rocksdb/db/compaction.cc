@@ -588,7 +588,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // Single level universal compaction could be split by key ranges, since it could produce
+    // several output files at level 0.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
@@ -32,9 +32,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
@@ -72,7 +74,9 @@
 #include "yb/rocksdb/util/stop_watch.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/result.h"
 #include "yb/util/stats/perf_step_timer.h"
 #include "yb/util/stats/iostats_context_imp.h"
@@ -80,8 +84,22 @@
 
 using std::unique_ptr;
 
+DECLARE_bool(use_priority_thread_pool_for_compactions);
+
 namespace rocksdb {
 
+namespace {
+
+// Number of keys sampled from index of each input file per subcompaction, when looking for
+// boundaries of universal compaction subcompactions.
+constexpr size_t kIndexSampleKeysPerSubcompaction = 8;
+
+// Subcompactions are formed only for large compactions, so their tasks use the base priority of
+// large compaction and the same disk priority as compaction tasks, see DBImpl::CompactionTask.
+constexpr int kSubcompactionPriority = 0;
+
+} // namespace
+
 // Maintains state for each sub-compaction
 struct CompactionJob::SubcompactionState : public CompactionFeed {
   Compaction* compaction;
@@ -112,6 +130,9 @@ struct CompactionJob::SubcompactionState : public CompactionFeed {
   CompactionFeed* feed = nullptr; // Owned externally.
   CompactionContextPtr context;
 
+  // Suspender of the thread pool task, that processes this subcompaction.
+  yb::PriorityThreadPoolSuspender* suspender;
+
   Output* current_output() {
     if (outputs.empty()) {
       // This subcompaction's outptut could be empty if compaction was aborted
@@ -140,6 +161,7 @@ struct CompactionJob::SubcompactionState : public CompactionFeed {
         boundary_extractor(boundary_extractor_),
         start(start_),
         end(end_),
+        suspender(compaction_->suspender()),
         approx_size(size) {
   }
 
@@ -336,6 +358,12 @@ void CompactionJob::GenSubcompactionBoundaries() {
   std::vector<Slice> bounds;
   int start_lvl = c->start_level();
   int out_lvl = c->output_level();
+  const bool single_level_universal = c->IsCompactionStyleUniversal() && c->number_levels() == 1;
+  if (single_level_universal &&
+      c->CalculateTotalInputSize() / 2 < db_options_.compaction_size_threshold_bytes) {
+    sizes_.emplace_back(c->CalculateTotalInputSize());
+    return;
+  }
 
   // Add the starting and/or ending key of certain input files as a potential
   // boundary
@@ -356,6 +384,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
           bounds.emplace_back(flevel->files[i].smallest.key);
           bounds.emplace_back(flevel->files[i].largest.key);
         }
+        if (single_level_universal) {
+          // The whole DB could consist of a few large files, so their index blocks are sampled
+          // to find keys inside of them.
+          AddIndexSampleKeys(*flevel, &bounds);
+        }
       } else {
         // For all other levels add the smallest/largest key in the level to
         // encompass the range covered by that level
@@ -374,6 +407,10 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   }
 
+  if (db_options_.subcompaction_boundary_prefix_size) {
+    AdjustBoundariesToPrefix(&bounds);
+  }
+
   std::sort(bounds.begin(), bounds.end(),
     [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
       return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
@@ -384,6 +421,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
       return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) == 0;
     }), bounds.end());
 
+  if (bounds.size() < 2) {
+    sizes_.emplace_back(c->CalculateTotalInputSize());
+    return;
+  }
+
   // Combine consecutive pairs of boundaries into ranges with an approximate
   // size of data covered by keys in that range
   uint64_t sum = 0;
@@ -405,9 +447,13 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  // Output file size is not limited for single level universal compaction, so minimal size of
+  // subcompaction is limited instead.
+  uint64_t max_output_files = single_level_universal
+      ? sum / std::max<uint64_t>(db_options_.compaction_size_threshold_bytes, 1)
+      : static_cast<uint64_t>(std::ceil(
+            sum / min_file_fill_percent /
+            cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -441,6 +487,187 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 }
 
+void CompactionJob::AddIndexSampleKeys(const LevelFilesBrief& files, std::vector<Slice>* bounds) {
+  auto* cfd = compact_->compaction->column_family_data();
+  const auto max_keys = db_options_.max_subcompactions * kIndexSampleKeysPerSubcompaction;
+  for (size_t i = 0; i != files.num_files; ++i) {
+    auto trwh = cfd->table_cache()->GetTableReader(
+        env_options_, cfd->internal_comparator(), files.files[i].fd, kDefaultQueryId,
+        /* no_io = */ false, /* file_read_hist = */ nullptr, /* skip_filters = */ true);
+    if (!trwh.ok()) {
+      RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+           "[%s] Failed to get table reader for subcompaction boundaries: %s",
+           cfd->GetName().c_str(), trwh.status().ToString().c_str());
+      continue;
+    }
+    auto keys = trwh->table_reader->GetSampleKeys(max_keys);
+    if (!keys.ok()) {
+      continue;
+    }
+    for (auto& key : *keys) {
+      // Index keys might be shortened, so could be shorter than internal key footer.
+      if (key.size() >= kLastInternalComponentSize) {
+        bounds->emplace_back(boundary_keys_.emplace_back(std::move(key)));
+      }
+    }
+  }
+}
+
+void CompactionJob::AdjustBoundariesToPrefix(std::vector<Slice>* bounds) {
+  const auto& prefix_size = *db_options_.subcompaction_boundary_prefix_size;
+  auto w = bounds->begin();
+  for (const auto& bound : *bounds) {
+    const auto user_key = ExtractUserKey(bound);
+    const auto size = prefix_size(user_key);
+    if (size == 0) {
+      continue;
+    }
+    if (size >= user_key.size()) {
+      *w++ = bound;
+      continue;
+    }
+    // Internal key of the prefix is ordered before all keys with this prefix.
+    auto& key = boundary_keys_.emplace_back();
+    AppendInternalKey(
+        &key, ParsedInternalKey(user_key.Prefix(size), kMaxSequenceNumber, kValueTypeForSeek));
+    *w++ = key;
+  }
+  bounds->erase(w, bounds->end());
+}
+
+// Subcompactions that were not started yet. Shared by compaction job and subcompaction tasks
+// submitted to the priority thread pool. Task could be picked by the pool after compaction job was
+// completed, in this case it finds that there is nothing to process and does not touch the job.
+class CompactionJob::SubcompactionQueue {
+ public:
+  SubcompactionQueue(CompactionJob* job, FileNumbersHolder* holder)
+      : job_(job), holder_(holder), size_(job->compact_->sub_compact_states.size()) {}
+
+  // Processes next not started subcompaction. Returns false when all subcompactions were started.
+  bool ProcessNext(yb::PriorityThreadPoolSuspender* suspender) {
+    SubcompactionState* sub_compact;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (next_ == size_) {
+        return false;
+      }
+      sub_compact = &job_->compact_->sub_compact_states[next_++];
+      ++running_;
+    }
+    sub_compact->suspender = suspender;
+    job_->ProcessKeyValueCompaction(holder_, sub_compact);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_;
+    }
+    cond_.notify_all();
+    return true;
+  }
+
+  // Waits until all started subcompactions are finished.
+  void WaitRunning() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return running_ == 0; });
+  }
+
+ private:
+  CompactionJob* const job_;
+  FileNumbersHolder* const holder_;
+  const size_t size_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  size_t next_ = 0;
+  size_t running_ = 0;
+};
+
+class CompactionJob::SubcompactionTask : public yb::PriorityThreadPoolTask {
+ public:
+  SubcompactionTask(std::shared_ptr<SubcompactionQueue> queue, int job_id)
+      : queue_(std::move(queue)), job_id_(job_id) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+    // Subcompactions of aborted task are processed by other tasks or by the compaction thread.
+    if (!status.ok()) {
+      return;
+    }
+    while (queue_->ProcessNext(suspender)) {
+    }
+  }
+
+  bool ShouldRemoveWithKey(void* key) override {
+    // Subcompaction task does not block anything, so it is never removed.
+    return false;
+  }
+
+  std::string ToString() const override {
+    return yb::Format("{ subcompaction job_id: $0 serial_no: $1 }", job_id_, SerialNo());
+  }
+
+  int CalculateGroupNoPriority(int active_tasks) const override {
+    return kTopDiskCompactionPriority - active_tasks;
+  }
+
+ private:
+  std::shared_ptr<SubcompactionQueue> queue_;
+  const int job_id_;
+};
+
+void CompactionJob::RunSubcompactionsInThreadPool(
+    yb::PriorityThreadPool* thread_pool, FileNumbersHolder* holder) {
+  auto queue = std::make_shared<SubcompactionQueue>(this, holder);
+  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
+    auto task = std::make_unique<SubcompactionTask>(queue, job_id_);
+    auto status = thread_pool->Submit(kSubcompactionPriority, &task, db_options_.disk_group_no);
+    if (!status.ok()) {
+      RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+           "[JOB %d] Failed to submit subcompaction task: %s", job_id_, status.ToString().c_str());
+      break;
+    }
+  }
+
+  // Current thread also processes subcompactions, so compaction makes progress even when all
+  // threads of the pool are busy.
+  while (queue->ProcessNext(compact_->compaction->suspender())) {
+  }
+  queue->WaitRunning();
+}
+
+void CompactionJob::CreateCompactionContexts() {
+  if (!db_options_.compaction_context_factory) {
+    for (auto& sub_compact : compact_->sub_compact_states) {
+      sub_compact.feed = &sub_compact;
+    }
+    return;
+  }
+
+  // Contexts of all subcompactions are created by a single factory call, so they share the same
+  // history retention directive and process all key ranges consistently.
+  std::vector<CompactionFeed*> feeds;
+  feeds.reserve(compact_->sub_compact_states.size());
+  for (auto& sub_compact : compact_->sub_compact_states) {
+    feeds.push_back(&sub_compact);
+  }
+  auto context_options = CompactionContextOptions {
+    .level0_inputs = *compact_->compaction->inputs(0),
+    .boundary_extractor = compact_->sub_compact_states.front().boundary_extractor,
+  };
+  auto contexts = (*db_options_.compaction_context_factory)(feeds, context_options);
+  CHECK_EQ(contexts.size(), compact_->sub_compact_states.size());
+  for (size_t i = 0; i != contexts.size(); ++i) {
+    auto& sub_compact = compact_->sub_compact_states[i];
+    sub_compact.context = std::move(contexts[i]);
+    sub_compact.feed = sub_compact.context->Feed();
+    // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
+    // filter.
+    auto frontier = sub_compact.context->GetLargestUserFrontier();
+    if (frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier_, std::move(frontier), UpdateUserValueType::kLargest);
+    }
+  }
+}
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   TEST_SYNC_POINT("CompactionJob::Run():Start");
   log_buffer_->FlushBufferToLog();
@@ -450,23 +677,32 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
 
-  // Launch a thread for each of subcompactions 1...num_threads-1
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(num_threads - 1);
   FileNumbersHolder file_numbers_holder(file_numbers_provider_->CreateHolder());
   file_numbers_holder.Reserve(num_threads);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
-                             &compact_->sub_compact_states[i]);
-  }
+  CreateCompactionContexts();
+
+  auto* priority_thread_pool = db_options_.priority_thread_pool_for_compactions_and_flushes;
+  if (num_threads > 1 && priority_thread_pool &&
+      FLAGS_use_priority_thread_pool_for_compactions) {
+    RunSubcompactionsInThreadPool(priority_thread_pool, &file_numbers_holder);
+  } else {
+    // Launch a thread for each of subcompactions 1...num_threads-1
+    std::vector<std::thread> thread_pool;
+    thread_pool.reserve(num_threads - 1);
+    for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
+      thread_pool.emplace_back(
+          &CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
+          &compact_->sub_compact_states[i]);
+    }
 
-  // Always schedule the first subcompaction (whether or not there are also
-  // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
+    // Always schedule the first subcompaction (whether or not there are also
+    // others) in the current thread to be efficient with resources
+    ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
 
-  // Wait for all other threads (if there are any) to finish execution
-  for (auto& thread : thread_pool) {
-    thread.join();
+    // Wait for all other threads (if there are any) to finish execution
+    for (auto& thread : thread_pool) {
+      thread.join();
+    }
   }
 
   if (output_directory_ && !db_options_.disableDataSync) {
@@ -629,17 +865,6 @@ void CompactionJob::ProcessKeyValueCompaction(
     input->SeekToFirst();
   }
 
-  if (db_options_.compaction_context_factory) {
-    auto context = CompactionContextOptions {
-      .level0_inputs = *compact_->compaction->inputs(0),
-      .boundary_extractor = sub_compact->boundary_extractor,
-    };
-    sub_compact->context = (*db_options_.compaction_context_factory)(sub_compact, context);
-    sub_compact->feed = sub_compact->context->Feed();
-  } else {
-    sub_compact->feed = sub_compact;
-  }
-
   Status status;
   sub_compact->c_iter = std::make_unique<CompactionIterator>(
       input.get(), cfd->user_comparator(), &merge, versions_->LastSequence(),
@@ -708,12 +933,6 @@ void CompactionJob::ProcessKeyValueCompaction(
     status = sub_compact->feed->Flush();
   }
 
-  // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
-  // filter.
-  if (sub_compact->context) {
-    largest_user_frontier_ = sub_compact->context->GetLargestUserFrontier();
-  }
-
   sub_compact->num_input_records = c_iter_stats.num_input_records;
   sub_compact->compaction_job_stats.num_input_deletion_records =
       c_iter_stats.num_input_deletion_records;
@@ -1015,7 +1234,7 @@ Status CompactionJob::OpenCompactionOutputFile(
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
       writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+          std::move(*writable_file), env_options_, sub_compact->suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
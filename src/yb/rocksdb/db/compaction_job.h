@@ -66,6 +66,10 @@ class VersionSet;
 class Arena;
 class FileNumbersProvider;
 class FileNumbersHolder;
+struct LevelFilesBrief;
+
+// Priority of compaction tasks in their disk group, when there are no active tasks in the group.
+constexpr int kTopDiskCompactionPriority = 100;
 
 class CompactionJob {
  public:
@@ -101,8 +105,18 @@ class CompactionJob {
  private:
   struct SubcompactionState;
 
+  class SubcompactionQueue;
+  class SubcompactionTask;
+
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Adds keys sampled from index blocks of the specified files to bounds.
+  void AddIndexSampleKeys(const LevelFilesBrief& files, std::vector<Slice>* bounds);
+  // Replaces bounds with their prefixes provided by DBOptions::subcompaction_boundary_prefix_size.
+  void AdjustBoundariesToPrefix(std::vector<Slice>* bounds);
+  void CreateCompactionContexts();
+  void RunSubcompactionsInThreadPool(
+      yb::PriorityThreadPool* thread_pool, FileNumbersHolder* holder);
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -176,6 +190,8 @@ class CompactionJob {
   bool measure_io_stats_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<Slice> boundaries_;
+  // Keys referenced by boundaries_, that are not present in file metadata.
+  std::deque<std::string> boundary_keys_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
 
@@ -276,6 +276,29 @@ bool CompactionPicker::FilesInCompaction(
   return false;
 }
 
+uint32_t CompactionPicker::SelectOutputPathId(
+    const std::vector<CompactionInputFiles>& inputs, uint32_t picked_path_id) const {
+  auto* selector = ioptions_.compaction_output_path_selector;
+  if (!selector || ioptions_.db_paths.size() <= 1) {
+    return picked_path_id;
+  }
+  std::vector<FileMetaData*> input_files;
+  for (const auto& input : inputs) {
+    input_files.insert(input_files.end(), input.files.begin(), input.files.end());
+  }
+  if (input_files.empty()) {
+    return picked_path_id;
+  }
+  auto path_id = selector->SelectOutputPathId(input_files, picked_path_id);
+  if (path_id >= ioptions_.db_paths.size()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, ioptions_.info_log,
+        "%s selected path id %" PRIu32 " out of %" ROCKSDB_PRIszt " db paths, using %" PRIu32,
+        selector->Name(), path_id, ioptions_.db_paths.size(), picked_path_id);
+    return picked_path_id;
+  }
+  return path_id;
+}
+
 std::unique_ptr<Compaction> CompactionPicker::FormCompaction(
     const CompactionOptions& compact_options,
     const std::vector<CompactionInputFiles>& input_files, int output_level,
@@ -533,6 +556,7 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         return nullptr;
       }
     }
+    output_path_id = SelectOutputPathId(inputs, output_path_id);
     auto c = Compaction::Create(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
@@ -636,6 +660,7 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
 
   std::vector<FileMetaData*> grandparents;
   GetGrandparents(vstorage, inputs, output_level_inputs, &grandparents);
+  output_path_id = SelectOutputPathId(compaction_inputs, output_path_id);
   auto compaction = Compaction::Create(
       vstorage, mutable_cf_options, std::move(compaction_inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level),
@@ -1781,6 +1806,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   } else {
     compaction_reason = CompactionReason::kUniversalSizeRatio;
   }
+  path_id = SelectOutputPathId(inputs, path_id);
   return Compaction::Create(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
@@ -1966,6 +1992,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
                 cf_name.c_str(), file_num_buf);
   }
 
+  path_id = SelectOutputPathId(inputs, path_id);
   return Compaction::Create(
       vstorage, mutable_cf_options, std::move(inputs), vstorage->num_levels() - 1,
       mutable_cf_options.MaxFileSizeForLevel(vstorage->num_levels() - 1),
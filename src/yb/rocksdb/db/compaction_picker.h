@@ -185,6 +185,11 @@ class CompactionPicker {
   static void MarkL0FilesForDeletion(const VersionStorageInfo* vstorage,
                                      const ImmutableCFOptions* ioptions);
 
+  // Returns output path id for compaction of inputs, consulting
+  // compaction_output_path_selector when it is configured. picked_path_id is returned otherwise.
+  uint32_t SelectOutputPathId(
+      const std::vector<CompactionInputFiles>& inputs, uint32_t picked_path_id) const;
+
   const ImmutableCFOptions& ioptions_;
 
   // A helper function to SanitizeCompactionInputFiles() that
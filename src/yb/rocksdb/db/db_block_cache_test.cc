@@ -217,6 +217,56 @@ TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
 }
 #endif
 
+// Checks that PrefetchDataBlocks loads data blocks of the specified keys into block cache, so
+// subsequent reads of these keys don't read blocks from file.
+TEST_F(DBBlockCacheTest, PrefetchDataBlocks) {
+  std::vector<CompressionType> compression_types = {kNoCompression};
+#ifdef SNAPPY
+  // Blocks read by batch should be uncompressed before they are added to block cache.
+  compression_types.push_back(kSnappyCompression);
+#endif
+  const std::string expected_value(kValueSize, 'a');
+  for (auto compression_type : compression_types) {
+    auto table_options = GetTableOptions();
+    auto options = GetOptions(table_options);
+    options.compression = compression_type;
+    DestroyAndReopen(options);
+    InitTable(options);
+    ASSERT_OK(Flush());
+
+    std::shared_ptr<Cache> cache = NewLRUCache(1024 * 1024);
+    table_options.block_cache = cache;
+    options.table_factory.reset(new BlockBasedTableFactory(table_options));
+    Reopen(options);
+
+    // Keys should be sorted, the last one is after all keys of the table.
+    const std::vector<std::string> keys = {"1", "3", "5", "9", "x"};
+    const std::vector<Slice> key_slices(keys.begin(), keys.end());
+    ReadOptions read_options;
+    read_options.verify_checksums = true;
+    ASSERT_OK(db_->PrefetchDataBlocks(read_options, key_slices));
+    ASSERT_LT(0, cache->GetUsage());
+    ASSERT_EQ(0, cache->GetPinnedUsage());
+
+    const auto data_misses = TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS);
+    const auto data_hits = TestGetTickerCount(options, BLOCK_CACHE_DATA_HIT);
+    for (size_t i = 0; i + 1 != keys.size(); ++i) {
+      ASSERT_EQ(expected_value, Get(keys[i]));
+    }
+    ASSERT_EQ(data_misses, TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS));
+    ASSERT_LE(data_hits + keys.size() - 1, TestGetTickerCount(options, BLOCK_CACHE_DATA_HIT));
+
+    // Block of a key that was not prefetched is read on demand.
+    ASSERT_EQ(expected_value, Get("2"));
+    ASSERT_EQ(data_misses + 1, TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS));
+
+    // Blocks that are already in block cache are not read again.
+    const auto usage = cache->GetUsage();
+    ASSERT_OK(db_->PrefetchDataBlocks(read_options, key_slices));
+    ASSERT_EQ(usage, cache->GetUsage());
+  }
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -38,6 +38,7 @@
 #include "yb/util/test_thread_holder.h"
 #include "yb/util/tsan_util.h"
 
+DECLARE_double(compaction_priority_read_amp_weight);
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_bool(use_priority_thread_pool_for_compactions);
 DECLARE_bool(use_priority_thread_pool_for_flushes);
@@ -369,6 +370,94 @@ TEST_F(DBCompactionTest, SkipStatsUpdateTest) {
   ASSERT_GT(env_->random_file_open_counter_.load(), kMaxFileOpenCount);
 }
 
+namespace {
+
+class FileNumbersFilter : public ReadFileFilter {
+ public:
+  explicit FileNumbersFilter(std::unordered_set<uint64_t> file_numbers)
+      : file_numbers_(std::move(file_numbers)) {}
+
+  bool Filter(const FdWithBoundaries& file) const override {
+    return file_numbers_.count(file.fd.GetNumber()) != 0;
+  }
+
+ private:
+  std::unordered_set<uint64_t> file_numbers_;
+};
+
+} // namespace
+
+TEST_F(DBCompactionTest, ReadAmpTracker) {
+  constexpr int kNumFiles = 4;
+  constexpr int kNumFilteredFiles = 2;
+  constexpr int kNumSeeks = 50;
+
+  google::FlagSaver flag_saver;
+  FLAGS_compaction_priority_read_amp_weight = 1;
+
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_OK(Put(Key(i), "value"));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(NumTableFilesAtLevel(0), kNumFiles);
+
+  auto& tracker = dbfull()->TEST_read_amp_tracker();
+  ASSERT_EQ(tracker.FilesPerSeek(0), 0);
+
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    for (int i = 0; i != kNumSeeks; ++i) {
+      iter->Seek(Key(i % kNumFiles));
+      ASSERT_TRUE(iter->Valid());
+    }
+    // Seeks are reported when iterator is destroyed.
+    ASSERT_EQ(tracker.FilesPerSeek(0), 0);
+  }
+  ASSERT_EQ(tracker.FilesPerSeek(kNumSeeks + 1), 0);
+  ASSERT_DOUBLE_EQ(tracker.FilesPerSeek(kNumSeeks), kNumFiles);
+
+  // Files skipped by the file filter are not read, so they are not counted.
+  {
+    std::vector<LiveFileMetaData> files;
+    db_->GetLiveFilesMetaData(&files);
+    ASSERT_EQ(files.size(), static_cast<size_t>(kNumFiles));
+    std::unordered_set<uint64_t> file_numbers;
+    for (int i = 0; i != kNumFilteredFiles; ++i) {
+      file_numbers.insert(files[i].name_id);
+    }
+    ReadOptions read_options;
+    read_options.file_filter = std::make_shared<FileNumbersFilter>(std::move(file_numbers));
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    for (int i = 0; i != kNumSeeks; ++i) {
+      iter->Seek(Key(i % kNumFiles));
+    }
+  }
+  ASSERT_DOUBLE_EQ(tracker.FilesPerSeek(0), (kNumFiles + kNumFilteredFiles) / 2.0);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    for (int i = 0; i != kNumSeeks; ++i) {
+      iter->Seek(Key(i % kNumFiles));
+    }
+  }
+  ASSERT_DOUBLE_EQ(tracker.FilesPerSeek(0), (kNumFiles + kNumFilteredFiles + 1) / 3.0);
+
+  // Seeks are not tracked when read amplification does not affect compaction priority.
+  FLAGS_compaction_priority_read_amp_weight = 0;
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    for (int i = 0; i != kNumSeeks; ++i) {
+      iter->Seek(Key(i % kNumFiles));
+    }
+  }
+  ASSERT_DOUBLE_EQ(tracker.FilesPerSeek(0), (kNumFiles + kNumFilteredFiles + 1) / 3.0);
+}
+
 TEST_F(DBCompactionTest, TestTableReaderForCompaction) {
   Options options;
   options = CurrentOptions(options);
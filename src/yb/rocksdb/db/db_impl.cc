@@ -158,6 +158,17 @@ DEFINE_UNKNOWN_int32(automatic_compaction_extra_priority, 50,
              "enabled. This deprioritizes manual compactions including those induced by the "
              "tserver (e.g. post-split compactions). Suggested value between 0 and 50.");
 
+DEFINE_RUNTIME_double(compaction_priority_read_amp_weight, 0,
+    "Compaction task of DB gets this extra priority for every SST file above one that is touched "
+    "by an iterator seek on average during the last minutes. 0 disables read amplification based "
+    "compaction priority and tracking of iterator seeks.");
+TAG_FLAG(compaction_priority_read_amp_weight, advanced);
+
+DEFINE_RUNTIME_uint64(compaction_priority_read_amp_min_seeks, 100,
+    "Minimal number of recent iterator seeks in DB required for its read amplification to affect "
+    "compaction priority.");
+TAG_FLAG(compaction_priority_read_amp_min_seeks, advanced);
+
 DECLARE_bool(enable_automatic_tablet_splitting);
 
 DEFINE_UNKNOWN_bool(rocksdb_use_logging_iterator, false,
@@ -244,11 +255,12 @@ class DBImpl::ThreadPoolTask : public yb::PriorityThreadPoolTask {
 };
 
 constexpr int kNoDiskPriority = 0;
-constexpr int kTopDiskCompactionPriority = 100;
 constexpr int kTopDiskFlushPriority = 200;
 constexpr int kShuttingDownPriority = 200;
 constexpr int kFlushPriority = 100;
 constexpr int kNoJobId = -1;
+// Read amplification should not let compactions overtake flushes.
+constexpr int kMaxReadAmpExtraPriority = 20;
 
 // Returns a pointer to the set of task state metrics based on the current task state.
 RocksDBTaskStateMetrics* GetRocksDBTaskStateMetrics(
@@ -453,6 +465,10 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       result += FLAGS_small_compaction_extra_priority;
     }
 
+    // DBs whose readers touch many SST files per seek are compacted first. The set of compacted
+    // files is not affected, so it does not increase total compaction I/O.
+    result += CalcReadAmpPriority();
+
     // Adding extra priority to automatic compactions can have a large positive impact on
     // performance for situations with many manual major compactions (e.g. insert-heavy workloads
     // with tablet splitting enabled).
@@ -463,6 +479,21 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
     return result;
   }
 
+  int CalcReadAmpPriority() const {
+    auto weight = FLAGS_compaction_priority_read_amp_weight;
+    if (weight <= 0) {
+      return 0;
+    }
+    auto files_per_seek = db_impl_->read_amp_tracker_.FilesPerSeek(
+        FLAGS_compaction_priority_read_amp_min_seeks);
+    // Touching a single file per seek is the best we could get, so only extra files count.
+    auto extra_priority = (files_per_seek - 1) * weight;
+    if (extra_priority <= 0) {
+      return 0;
+    }
+    return static_cast<int>(std::min<double>(extra_priority, kMaxReadAmpExtraPriority));
+  }
+
   void SetTaskInfo() {
     size_t levels = compaction_->num_input_levels();
     uint64_t file_count = 0;
@@ -636,6 +667,12 @@ DBOptions SanitizeOptions(const std::string& dbname, const DBOptions& src) {
     result.db_paths.emplace_back(dbname, std::numeric_limits<uint64_t>::max());
   }
 
+  if (result.use_direct_io_for_flush_and_compaction && result.compaction_readahead_size == 0) {
+    // Direct reads are not served from page cache, so compaction inputs should be read by large
+    // chunks.
+    result.compaction_readahead_size = 2 * 1024 * 1024;
+  }
+
   if (result.compaction_readahead_size > 0) {
     result.new_table_reader_for_compaction_inputs = true;
   }
@@ -736,6 +773,8 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname)
       next_job_id_(1),
       has_unpersisted_data_(false),
       env_options_(db_options_),
+      env_options_for_compaction_(
+          db_options_.env->OptimizeForCompactionTableWrite(env_options_, db_options_)),
       wal_manager_(db_options_, env_options_),
       event_logger_(db_options_.info_log.get()),
       bg_work_paused_(0),
@@ -1890,7 +1929,7 @@ Status DBImpl::WriteLevel0TableForRecovery(int job_id, ColumnFamilyData* cfd,
         s = BuildTable(dbname_,
                        env_,
                        *cfd->ioptions(),
-                       env_options_,
+                       env_options_for_compaction_,
                        cfd->table_cache(),
                        iter.get(),
                        &meta,
@@ -1966,7 +2005,7 @@ Result<FileNumbersHolder> DBImpl::FlushMemTableToOutputFile(
   }
 
   FlushJob flush_job(
-      dbname_, cfd, db_options_, mutable_cf_options, env_options_,
+      dbname_, cfd, db_options_, mutable_cf_options, env_options_for_compaction_,
       versions_.get(), &mutex_, &shutting_down_, &disable_flush_on_shutdown_, snapshot_seqs,
       earliest_write_conflict_snapshot, mem_table_flush_filter, pending_outputs_.get(),
       job_context, log_buffer, directories_.GetDbDir(), directories_.GetDataDir(0U),
@@ -2379,7 +2418,7 @@ Status DBImpl::CompactFilesImpl(
 
   assert(is_snapshot_supported_ || snapshots_.empty());
   CompactionJob compaction_job(
-      job_context->job_id, c.get(), db_options_, env_options_, versions_.get(),
+      job_context->job_id, c.get(), db_options_, env_options_for_compaction_, versions_.get(),
       &shutting_down_, log_buffer, directories_.GetDbDir(),
       directories_.GetDataDir(c->output_path_id()), stats_.get(), &mutex_, &bg_error_,
       snapshot_seqs, earliest_write_conflict_snapshot, pending_outputs_.get(), table_cache_,
@@ -3718,7 +3757,7 @@ Result<FileNumbersHolder> DBImpl::BackgroundCompaction(
 
     assert(is_snapshot_supported_ || snapshots_.empty());
     CompactionJob compaction_job(
-        job_context->job_id, c.get(), db_options_, env_options_,
+        job_context->job_id, c.get(), db_options_, env_options_for_compaction_,
         versions_.get(), &shutting_down_, log_buffer, directories_.GetDbDir(),
         directories_.GetDataDir(c->output_path_id()), stats_.get(), &mutex_,
         &bg_error_, snapshot_seqs, earliest_write_conflict_snapshot,
@@ -3938,7 +3977,8 @@ static void CleanupIteratorState(void* arg1, void* arg2) {
 InternalIterator* DBImpl::NewInternalIterator(const ReadOptions& read_options,
                                               ColumnFamilyData* cfd,
                                               SuperVersion* super_version,
-                                              Arena* arena) {
+                                              Arena* arena,
+                                              size_t* num_sst_iterators) {
   InternalIterator* internal_iter;
   assert(arena != nullptr);
   // Need to create internal iterator from the arena.
@@ -3949,8 +3989,11 @@ InternalIterator* DBImpl::NewInternalIterator(const ReadOptions& read_options,
   // Collect all needed child iterators for immutable memtables
   super_version->imm->AddIterators(read_options, &merge_iter_builder);
   // Collect iterators for files in L0 - Ln
-  super_version->current->AddIterators(read_options, env_options_,
-                                       &merge_iter_builder);
+  auto num_sst = super_version->current->AddIterators(read_options, env_options_,
+                                                      &merge_iter_builder);
+  if (num_sst_iterators) {
+    *num_sst_iterators = num_sst;
+  }
   internal_iter = merge_iter_builder.Finish();
   IterState* cleanup = new IterState(this, &mutex_, super_version);
   internal_iter->RegisterCleanup(CleanupIteratorState, cleanup, nullptr);
@@ -4199,6 +4242,14 @@ std::vector<Status> DBImpl::MultiGet(
   return stat_list;
 }
 
+Status DBImpl::PrefetchDataBlocks(const ReadOptions& options, const std::vector<Slice>& keys) {
+  auto cfd = down_cast<ColumnFamilyHandleImpl*>(DefaultColumnFamily())->cfd();
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  auto status = sv->current->PrefetchDataBlocks(options, keys);
+  ReturnAndCleanupSuperVersion(cfd, sv);
+  return status;
+}
+
 Status DBImpl::AddFile(ColumnFamilyHandle* column_family,
                        const std::string& file_path, bool move_file) {
   Status status;
@@ -4757,9 +4808,13 @@ Iterator* DBImpl::NewIterator(const ReadOptions& read_options,
         sv->version_number, read_options.iterate_upper_bound,
         read_options.prefix_same_as_start, read_options.pin_data);
 
-    InternalIterator* internal_iter =
-        NewInternalIterator(read_options, cfd, sv, db_iter->GetArena());
+    size_t num_sst_iterators = 0;
+    InternalIterator* internal_iter = NewInternalIterator(
+        read_options, cfd, sv, db_iter->GetArena(), &num_sst_iterators);
     db_iter->SetIterUnderDBIter(internal_iter);
+    if (FLAGS_compaction_priority_read_amp_weight > 0) {
+      db_iter->SetReadAmpTracker(&read_amp_tracker_, num_sst_iterators);
+    }
 
     if (yb::GetAtomicFlag(&FLAGS_rocksdb_use_logging_iterator)) {
       return new TransitionLoggingIteratorWrapper(db_iter, LogPrefix());
@@ -6136,6 +6191,10 @@ Status DBImpl::CheckConsistency() {
   std::string corruption_messages;
   for (const auto& md : metadata) {
     std::string base_file_path = md.FullName();
+    if (db_options_.db_paths.size() > 1 && !env_->FileExists(base_file_path).ok()) {
+      // File could reside on a path different from the one recorded in the manifest.
+      base_file_path = FindTableFileName(env_, db_options_.db_paths, md.name_id, 0);
+    }
     uint64_t base_fsize = 0;
     Status s = env_->GetFileSize(base_file_path, &base_fsize);
     if (!s.ok() &&
@@ -43,6 +43,7 @@
 #include "yb/rocksdb/db/internal_stats.h"
 #include "yb/rocksdb/db/log_writer.h"
 #include "yb/rocksdb/db/memtable_list.h"
+#include "yb/rocksdb/db/read_amp_tracker.h"
 #include "yb/rocksdb/db/snapshot_impl.h"
 #include "yb/rocksdb/db/version_edit.h"
 #include "yb/rocksdb/db/wal_manager.h"
@@ -111,6 +112,8 @@ class DBImpl : public DB {
       const std::vector<Slice>& keys,
       std::vector<std::string>* values) override;
 
+  Status PrefetchDataBlocks(const ReadOptions& options, const std::vector<Slice>& keys) override;
+
   virtual Status CreateColumnFamily(const ColumnFamilyOptions& options,
                                     const std::string& column_family,
                                     ColumnFamilyHandle** handle) override;
@@ -393,6 +396,8 @@ class DBImpl : public DB {
 
   Cache* TEST_table_cache() { return table_cache_.get(); }
 
+  ReadAmpTracker& TEST_read_amp_tracker() { return read_amp_tracker_; }
+
   WriteController& TEST_write_controler() { return write_controller_; }
 
   // Return maximum background compaction alowed to be scheduled based on
@@ -498,10 +503,13 @@ class DBImpl : public DB {
   std::unique_ptr<VersionSet> versions_;
   const DBOptions db_options_;
   std::shared_ptr<Statistics> stats_;
+  // If num_sst_iterators is not null, it is set to the number of SST files touched by a seek of
+  // the returned iterator.
   InternalIterator* NewInternalIterator(const ReadOptions&,
                                         ColumnFamilyData* cfd,
                                         SuperVersion* super_version,
-                                        Arena* arena);
+                                        Arena* arena,
+                                        size_t* num_sst_iterators = nullptr);
 
   // Except in DB::Open(), WriteOptionsFile can only be called when:
   // 1. WriteThread::Writer::EnterUnbatched() is used.
@@ -888,6 +896,10 @@ class DBImpl : public DB {
   // And we remove them from this set, when they are processed/aborted by thread pool.
   std::unordered_set<CompactionTask*> compaction_tasks_;
 
+  // Number of SST files touched by recent iterator seeks, used to prioritize compactions of DBs
+  // with heavy read workload.
+  ReadAmpTracker read_amp_tracker_;
+
   // stores the total number of compactions that are currently running
   int num_total_running_compactions_;
 
@@ -965,6 +977,9 @@ class DBImpl : public DB {
   // The options to access storage files
   const EnvOptions env_options_;
 
+  // The options to write table files by flush and compaction.
+  const EnvOptions env_options_for_compaction_;
+
   WalManager wal_manager_;
 
   // Unified interface for logging events
@@ -27,6 +27,7 @@
 #include <limits>
 
 #include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/db/read_amp_tracker.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/merge_operator.h"
@@ -101,6 +102,9 @@ class DBIter: public Iterator {
   }
   virtual ~DBIter() {
     RecordTick(statistics_, NO_ITERATORS, -1);
+    if (read_amp_tracker_) {
+      read_amp_tracker_->Record(num_seeks_, num_sst_iterators_);
+    }
     if (!arena_mode_) {
       delete iter_;
     } else {
@@ -114,6 +118,10 @@ class DBIter: public Iterator {
       CHECK_OK(iter_->PinData());
     }
   }
+  void SetReadAmpTracker(ReadAmpTracker* tracker, size_t num_sst_iterators) {
+    read_amp_tracker_ = tracker;
+    num_sst_iterators_ = num_sst_iterators;
+  }
   bool Valid() const override { return valid_; }
   Slice key() const override {
     assert(valid_);
@@ -236,6 +244,10 @@ class DBIter: public Iterator {
   IterKey prefix_start_;
   bool prefix_same_as_start_;
   bool iter_pinned_;
+  // Seeks are accumulated locally and reported to read_amp_tracker_ once, on destruction.
+  ReadAmpTracker* read_amp_tracker_ = nullptr;
+  size_t num_sst_iterators_ = 0;
+  uint64_t num_seeks_ = 0;
   // List of operands for merge operator.
   std::deque<std::string> merge_operands_;
 
@@ -763,6 +775,7 @@ void DBIter::Seek(const Slice& target) {
   }
 
   RecordTick(statistics_, NUMBER_DB_SEEK);
+  ++num_seeks_;
   if (iter_->Valid()) {
     direction_ = kForward;
     ClearSavedValue();
@@ -796,6 +809,7 @@ void DBIter::SeekToFirst() {
   }
 
   RecordTick(statistics_, NUMBER_DB_SEEK);
+  ++num_seeks_;
   if (iter_->Valid()) {
     FindNextUserEntry(false /* not skipping */);
     if (statistics_ != nullptr) {
@@ -825,6 +839,7 @@ void DBIter::SeekToLast() {
     PERF_TIMER_GUARD(seek_internal_seek_time);
     iter_->SeekToLast();
   }
+  ++num_seeks_;
   // When the iterate_upper_bound is set to a value,
   // it will seek to the last key before the
   // ReadOptions.iterate_upper_bound
@@ -901,6 +916,10 @@ void ArenaWrappedDBIter::SetIterUnderDBIter(InternalIterator* iter) {
   static_cast<DBIter*>(db_iter_)->SetIter(iter);
 }
 
+void ArenaWrappedDBIter::SetReadAmpTracker(ReadAmpTracker* tracker, size_t num_sst_iterators) {
+  db_iter_->SetReadAmpTracker(tracker, num_sst_iterators);
+}
+
 inline bool ArenaWrappedDBIter::Valid() const { return db_iter_->Valid(); }
 inline void ArenaWrappedDBIter::SeekToFirst() { db_iter_->SeekToFirst(); }
 inline void ArenaWrappedDBIter::SeekToLast() { db_iter_->SeekToLast(); }
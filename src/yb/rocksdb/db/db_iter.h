@@ -37,6 +37,7 @@ namespace rocksdb {
 class Arena;
 class DBIter;
 class InternalIterator;
+class ReadAmpTracker;
 
 // Return a new iterator that converts internal keys (yielded by
 // "*internal_iter") that were live at the specified "sequence" number
@@ -68,6 +69,11 @@ class ArenaWrappedDBIter : public Iterator {
   // Set the internal iterator wrapped inside the DB Iterator. Usually it is
   // a merging iterator.
   virtual void SetIterUnderDBIter(InternalIterator* iter);
+
+  // Seeks of the DB Iterator are reported to tracker on destruction, num_sst_iterators is the
+  // number of SST files touched by every seek.
+  void SetReadAmpTracker(ReadAmpTracker* tracker, size_t num_sst_iterators);
+
   virtual bool Valid() const override;
   virtual void SeekToFirst() override;
   virtual void SeekToLast() override;
@@ -21,6 +21,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "yb/rocksdb/db/db_test_util.h"
+#include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/port/stack_trace.h"
 
 namespace rocksdb {
@@ -71,6 +72,73 @@ TEST_F(DBTest2, IteratorPropertyVersionNumber) {
   delete iter2;
   delete iter3;
 }
+
+// Flush and compaction with direct I/O should produce files of exact size, readable by both direct
+// compaction reads and regular user reads.
+TEST_F(DBTest2, DirectIOForFlushAndCompaction) {
+  {
+    EnvOptions env_options;
+    env_options.use_direct_writes = true;
+    const auto probe_fname = dbname_ + "/direct_io_probe";
+    std::unique_ptr<WritableFile> file;
+    ASSERT_OK(env_->NewWritableFile(probe_fname, &file, env_options));
+    const bool direct_io_supported = file->UseDirectIO();
+    file.reset();
+    ASSERT_OK(env_->DeleteFile(probe_fname));
+    if (!direct_io_supported) {
+      GTEST_SKIP() << "Direct I/O is not supported by file system of " << dbname_;
+    }
+  }
+
+  Options options = CurrentOptions();
+  options.use_direct_io_for_flush_and_compaction = true;
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  constexpr int kNumFiles = 4;
+  constexpr int kKeysPerFile = 1000;
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  for (int f = 0; f != kNumFiles; ++f) {
+    for (int i = 0; i != kKeysPerFile; ++i) {
+      // Overlapping keys, so compaction has to merge files.
+      const auto key = Key(i * kNumFiles + f / 2);
+      const auto value = RandomString(&rnd, 1 + rnd.Uniform(500));
+      ASSERT_OK(Put(key, value));
+      expected[key] = value;
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(kNumFiles, NumTableFilesAtLevel(0));
+
+  auto check_files_and_data = [this, &expected] {
+    std::vector<LiveFileMetaData> files;
+    db_->GetLiveFilesMetaData(&files);
+    ASSERT_FALSE(files.empty());
+    for (const auto& meta : files) {
+      uint64_t base_size = 0;
+      uint64_t data_size = 0;
+      ASSERT_OK(env_->GetFileSize(meta.FullName(), &base_size));
+      ASSERT_OK(env_->GetFileSize(TableBaseToDataFileName(meta.FullName()), &data_size));
+      // Padded tail of the last direct write should be truncated.
+      ASSERT_EQ(meta.base_size, base_size);
+      ASSERT_EQ(meta.total_size, base_size + data_size);
+    }
+    for (const auto& [key, value] : expected) {
+      ASSERT_EQ(value, Get(key));
+    }
+  };
+
+  ASSERT_NO_FATAL_FAILURE(check_files_and_data());
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  ASSERT_NO_FATAL_FAILURE(check_files_and_data());
+
+  Reopen(options);
+  ASSERT_NO_FATAL_FAILURE(check_files_and_data());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
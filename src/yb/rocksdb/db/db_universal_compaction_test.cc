@@ -1464,6 +1464,128 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+TEST_F(DBTestUniversalCompaction, SingleLevelSubcompactions) {
+  constexpr int kNumFiles = 4;
+  constexpr int kKeysPerFile = 1000;
+  constexpr int kMaxSubcompactions = 4;
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.write_buffer_size = 10_MB;
+  options.disable_auto_compactions = true;
+  options.max_subcompactions = kMaxSubcompactions;
+  options.compaction_size_threshold_bytes = 32_KB;
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  // Each file covers the whole key range, so only index sample keys could split compaction.
+  Random rnd(301);
+  for (int file = 0; file < kNumFiles; ++file) {
+    for (int i = file; i < kNumFiles * kKeysPerFile; i += kNumFiles) {
+      ASSERT_OK(Put(Key(i), RandomString(&rnd, 100)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(NumTableFilesAtLevel(0), kNumFiles);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  std::vector<LiveFileMetaData> metadata;
+  db_->GetLiveFilesMetaData(&metadata);
+  ASSERT_GT(metadata.size(), 1);
+  ASSERT_LE(metadata.size(), kMaxSubcompactions);
+  std::sort(metadata.begin(), metadata.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.smallest.key < rhs.smallest.key;
+  });
+  for (size_t i = 1; i < metadata.size(); ++i) {
+    ASSERT_LT(metadata[i - 1].largest.key, metadata[i].smallest.key);
+  }
+  for (int i = 0; i < kNumFiles * kKeysPerFile; ++i) {
+    ASSERT_NE(Get(Key(i)), "NOT_FOUND") << i;
+  }
+}
+
+namespace {
+
+class TestOutputPathSelector : public CompactionOutputPathSelector {
+ public:
+  uint32_t SelectOutputPathId(
+      const std::vector<FileMetaData*>& input_files, uint32_t picked_path_id) override {
+    auto path_id = path_id_.load();
+    return path_id >= 0 ? static_cast<uint32_t>(path_id) : picked_path_id;
+  }
+
+  const char* Name() const override { return "TestOutputPathSelector"; }
+
+  void SetPathId(int path_id) { path_id_ = path_id; }
+
+ private:
+  std::atomic<int> path_id_{-1};
+};
+
+} // namespace
+
+TEST_F(DBTestUniversalCompaction, CompactionOutputPathSelector) {
+  constexpr int kNumKeys = 100;
+  constexpr int kColdPathId = 1;
+
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.db_paths.emplace_back(dbname_, std::numeric_limits<uint64_t>::max());
+  options.db_paths.emplace_back(dbname_ + "_cold", std::numeric_limits<uint64_t>::max());
+  auto selector = std::make_shared<TestOutputPathSelector>();
+  options.compaction_output_path_selector = selector;
+  DestroyAndReopen(options);
+
+  auto write_file = [this](int start) {
+    for (int i = start; i < start + kNumKeys; ++i) {
+      ASSERT_OK(Put(Key(i), Key(i)));
+    }
+    ASSERT_OK(Flush());
+  };
+  auto check_keys = [this](int count) {
+    for (int i = 0; i < count; ++i) {
+      ASSERT_EQ(Key(i), Get(Key(i))) << i;
+    }
+  };
+
+  // Selector does not change path chosen by the compaction picker.
+  ASSERT_NO_FATALS(write_file(0));
+  ASSERT_NO_FATALS(write_file(kNumKeys));
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(1, GetSstFileCount(options.db_paths[0].path));
+  ASSERT_EQ(0, GetSstFileCount(options.db_paths[1].path));
+
+  // Flushes are not affected by selector, while compaction output goes to the cold path.
+  selector->SetPathId(kColdPathId);
+  ASSERT_NO_FATALS(write_file(2 * kNumKeys));
+  ASSERT_EQ(2, GetSstFileCount(options.db_paths[0].path));
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(0, GetSstFileCount(options.db_paths[0].path));
+  ASSERT_EQ(1, GetSstFileCount(options.db_paths[1].path));
+  ASSERT_NO_FATALS(check_keys(3 * kNumKeys));
+
+  // Move the file to the first path, as it happens when DB is restored from a checkpoint.
+  Close();
+  std::vector<std::string> files;
+  ASSERT_OK(env_->GetChildren(options.db_paths[1].path, &files));
+  for (const auto& file : files) {
+    uint64_t number;
+    FileType type;
+    if (ParseFileName(file, &number, &type) &&
+        (type == kTableFile || type == kTableSBlockFile)) {
+      ASSERT_OK(env_->RenameFile(
+          options.db_paths[1].path + "/" + file, options.db_paths[0].path + "/" + file));
+    }
+  }
+  ASSERT_EQ(0, GetSstFileCount(options.db_paths[1].path));
+
+  // Table file should be found in the other path.
+  Reopen(options);
+  ASSERT_NO_FATALS(check_keys(3 * kNumKeys));
+}
+
 }  // namespace rocksdb
 
 
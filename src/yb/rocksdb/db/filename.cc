@@ -132,6 +132,21 @@ std::string TableFileName(const std::vector<DbPath>& db_paths, uint64_t number,
   return MakeTableFileName(path, number);
 }
 
+std::string FindTableFileName(Env* env, const std::vector<DbPath>& db_paths, uint64_t number,
+                              uint32_t path_id) {
+  auto result = TableFileName(db_paths, number, path_id);
+  if (db_paths.size() <= 1 || env->FileExists(result).ok()) {
+    return result;
+  }
+  for (const auto& db_path : db_paths) {
+    auto fname = MakeTableFileName(db_path.path, number);
+    if (fname != result && env->FileExists(fname).ok()) {
+      return fname;
+    }
+  }
+  return result;
+}
+
 extern std::string TableBaseToDataFileName(const std::string& base_fname) {
   return base_fname + "." + kRocksDbTSBlockExtSuffix + ".0";
 }
@@ -87,6 +87,12 @@ extern uint64_t TableFileNameToNumber(const std::string& name);
 extern std::string TableFileName(const std::vector<DbPath>& db_paths,
                                  uint64_t number, uint32_t path_id);
 
+// Same as TableFileName, but when the file is absent from db_paths[path_id], looks for it in
+// other db_paths. Table files could reside on a path different from the one recorded in the
+// manifest, for instance when a checkpoint taken from a DB with multiple paths is opened.
+extern std::string FindTableFileName(Env* env, const std::vector<DbPath>& db_paths,
+                                     uint64_t number, uint32_t path_id);
+
 // Return data file name of the sstable for specific base file name.
 extern std::string TableBaseToDataFileName(const std::string& base_fname);
 
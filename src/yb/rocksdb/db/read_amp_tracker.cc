@@ -0,0 +1,56 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/db/read_amp_tracker.h"
+
+namespace rocksdb {
+
+void ReadAmpTracker::Record(uint64_t num_seeks, uint64_t num_files) {
+  if (num_seeks == 0) {
+    return;
+  }
+  MaybeRotate(yb::CoarseMonoClock::Now());
+  current_.seeks.fetch_add(num_seeks, std::memory_order_relaxed);
+  current_.files.fetch_add(num_seeks * num_files, std::memory_order_relaxed);
+}
+
+double ReadAmpTracker::FilesPerSeek(uint64_t min_seeks) {
+  MaybeRotate(yb::CoarseMonoClock::Now());
+  auto seeks = current_.seeks.load(std::memory_order_relaxed) +
+               previous_.seeks.load(std::memory_order_relaxed);
+  if (seeks == 0 || seeks < min_seeks) {
+    return 0;
+  }
+  auto files = current_.files.load(std::memory_order_relaxed) +
+               previous_.files.load(std::memory_order_relaxed);
+  return static_cast<double>(files) / seeks;
+}
+
+void ReadAmpTracker::MaybeRotate(yb::CoarseTimePoint now) {
+  int64_t window = now.time_since_epoch() / kWindow;
+  auto old_window = window_.load(std::memory_order_acquire);
+  if (window <= old_window || !window_.compare_exchange_strong(old_window, window)) {
+    return;
+  }
+  auto seeks = current_.seeks.exchange(0, std::memory_order_relaxed);
+  auto files = current_.files.exchange(0, std::memory_order_relaxed);
+  // Samples from windows that ended long ago do not describe the recent workload.
+  if (window != old_window + 1) {
+    seeks = 0;
+    files = 0;
+  }
+  previous_.seeks.store(seeks, std::memory_order_relaxed);
+  previous_.files.store(files, std::memory_order_relaxed);
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,51 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "yb/util/monotime.h"
+
+namespace rocksdb {
+
+// Tracks read amplification of a DB, i.e. the average number of SST files touched by an iterator
+// seek. Samples are aggregated over the current and the previous time window, so the value
+// reflects the recent read workload only.
+class ReadAmpTracker {
+ public:
+  static constexpr auto kWindow = std::chrono::seconds(60);
+
+  // Records num_seeks seeks performed by an iterator that spans num_files SST files.
+  void Record(uint64_t num_seeks, uint64_t num_files);
+
+  // Returns the average number of SST files touched per seek over the recent windows, or 0 if
+  // there were fewer than min_seeks seeks.
+  double FilesPerSeek(uint64_t min_seeks);
+
+ private:
+  struct Counters {
+    std::atomic<uint64_t> seeks{0};
+    std::atomic<uint64_t> files{0};
+  };
+
+  void MaybeRotate(yb::CoarseTimePoint now);
+
+  std::atomic<int64_t> window_{0};
+  Counters current_;
+  Counters previous_;
+};
+
+}  // namespace rocksdb
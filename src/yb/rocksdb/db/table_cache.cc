@@ -136,7 +136,8 @@ Status TableCache::DoGetTableReader(
     const InternalKeyComparatorPtr& internal_comparator, const FileDescriptor& fd,
     bool sequential_mode, bool record_read_stats, HistogramImpl* file_read_hist,
     unique_ptr<TableReader>* table_reader, bool skip_filters) {
-  const std::string base_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
+  const std::string base_fname = FindTableFileName(
+      ioptions_.env, ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
 
   Status s;
   {
@@ -254,8 +255,10 @@ Status TableCache::DoGetTableReaderForIterator(
     HistogramImpl* file_read_hist,
     bool for_compaction,
     bool skip_filters) {
+  // Table readers that use direct I/O are never cached, so user reads keep using buffered I/O.
   const bool create_new_table_reader =
-      (for_compaction && ioptions_.new_table_reader_for_compaction_inputs);
+      for_compaction &&
+      (ioptions_.new_table_reader_for_compaction_inputs || env_options.use_direct_reads);
   if (create_new_table_reader) {
     unique_ptr<TableReader> table_reader_unique_ptr;
     Status s = DoGetTableReader(
@@ -46,6 +46,9 @@ class IntTblPropCollector {
   virtual Status InternalAdd(const Slice& key, const Slice& value,
                              uint64_t file_size) = 0;
 
+  // @params block_offset  the offset of the finished data block in the data file.
+  virtual Status DataBlockFinished(uint64_t block_offset) { return Status::OK(); }
+
   virtual UserCollectedProperties GetReadableProperties() const = 0;
 
   virtual bool NeedCompact() const { return false; }
@@ -113,6 +116,10 @@ class UserKeyTablePropertiesCollector : public IntTblPropCollector {
   virtual Status InternalAdd(const Slice& key, const Slice& value,
                              uint64_t file_size) override;
 
+  virtual Status DataBlockFinished(uint64_t block_offset) override {
+    return collector_->DataBlockFinished(block_offset);
+  }
+
   virtual Status Finish(UserCollectedProperties* properties) override;
 
   virtual const char* Name() const override { return collector_->Name(); }
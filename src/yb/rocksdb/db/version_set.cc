@@ -606,8 +606,8 @@ Status Version::GetTableProperties(std::shared_ptr<const TableProperties>* tp,
         *fname, &file, vset_->env_options_);
   } else {
     s = ioptions->env->NewRandomAccessFile(
-        TableFileName(vset_->db_options_->db_paths, file_meta->fd.GetNumber(),
-                      file_meta->fd.GetPathId()),
+        FindTableFileName(ioptions->env, vset_->db_options_->db_paths, file_meta->fd.GetNumber(),
+                          file_meta->fd.GetPathId()),
         &file, vset_->env_options_);
   }
   if (!s.ok()) {
@@ -648,8 +648,8 @@ Status Version::GetPropertiesOfAllTables(TablePropertiesCollection* props,
                                          int level) {
   for (const auto& file_meta : storage_info_.files_[level]) {
     auto fname =
-        TableFileName(vset_->db_options_->db_paths, file_meta->fd.GetNumber(),
-                      file_meta->fd.GetPathId());
+        FindTableFileName(vset_->env_, vset_->db_options_->db_paths, file_meta->fd.GetNumber(),
+                          file_meta->fd.GetPathId());
     // 1. If the table is already present in table cache, load table
     // properties from there.
     std::shared_ptr<const TableProperties> table_properties;
@@ -674,9 +674,9 @@ Status Version::GetPropertiesOfTablesInRange(
       std::vector<FileMetaData*> files;
       storage_info_.GetOverlappingInputs(level, &k1, &k2, &files, -1, nullptr, false);
       for (const auto& file_meta : files) {
-        auto fname =
-            TableFileName(vset_->db_options_->db_paths,
-                          file_meta->fd.GetNumber(), file_meta->fd.GetPathId());
+        auto fname = FindTableFileName(
+            vset_->env_, vset_->db_options_->db_paths, file_meta->fd.GetNumber(),
+            file_meta->fd.GetPathId());
         if (props->count(fname) == 0) {
           // 1. If the table is already present in table cache, load table
           // properties from there.
@@ -805,16 +805,34 @@ uint64_t VersionStorageInfo::GetEstimatedActiveKeys() const {
   }
 }
 
-void Version::AddIterators(const ReadOptions& read_options,
-                           const EnvOptions& soptions,
-                           MergeIteratorBuilder* merge_iter_builder) {
+namespace {
+
+bool AnyFilePassesFilter(const ReadOptions& read_options, const LevelFilesBrief& files) {
+  if (!read_options.file_filter) {
+    return true;
+  }
+  for (size_t i = 0; i != files.num_files; ++i) {
+    if (read_options.file_filter->Filter(files.files[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+size_t Version::AddIterators(const ReadOptions& read_options,
+                             const EnvOptions& soptions,
+                             MergeIteratorBuilder* merge_iter_builder) {
   assert(storage_info_.finalized_);
 
   if (storage_info_.num_non_empty_levels() == 0) {
     // No file in the Version.
-    return;
+    return 0;
   }
 
+  size_t num_sst_iterators = 0;
+
   auto* arena = merge_iter_builder->GetArena();
 
   // Merge all level zero files together since they may overlap
@@ -839,15 +857,20 @@ void Version::AddIterators(const ReadOptions& read_options,
       }
       if (file_iter) {
         merge_iter_builder->AddIterator(file_iter);
+        // Only files that are actually read add to read amplification.
+        if (s.ok()) {
+          ++num_sst_iterators;
+        }
       }
     }
   }
 
   // For levels > 0, we can use a concatenating iterator that sequentially
   // walks through the non-overlapping files in the level, opening them
-  // lazily.
+  // lazily. Level is skipped when file filter rejects all its files, same as level zero files.
   for (int level = 1; level < storage_info_.num_non_empty_levels(); level++) {
-    if (storage_info_.LevelFilesBrief(level).num_files != 0) {
+    if (storage_info_.LevelFilesBrief(level).num_files != 0 &&
+        AnyFilePassesFilter(read_options, storage_info_.LevelFilesBrief(level))) {
       auto* mem = arena->AllocateAligned(sizeof(LevelFileIteratorState));
       auto* state = new (mem)
           LevelFileIteratorState(cfd_->table_cache(), read_options, soptions,
@@ -860,8 +883,11 @@ void Version::AddIterators(const ReadOptions& read_options,
       auto* first_level_iter = new (mem) LevelFileNumIterator(
           *cfd_->internal_comparator(), &storage_info_.LevelFilesBrief(level));
       merge_iter_builder->AddIterator(NewTwoLevelIterator(state, first_level_iter, arena, false));
+      ++num_sst_iterators;
     }
   }
+
+  return num_sst_iterators;
 }
 
 VersionStorageInfo::VersionStorageInfo(
@@ -2081,6 +2107,47 @@ static bool compareKeys(MiddleKeyWithSize f1,
 
 } // namespace
 
+Status Version::PrefetchDataBlocks(
+    const ReadOptions& read_options, const std::vector<Slice>& user_keys) {
+  if (user_keys.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<InternalKey> internal_keys;
+  internal_keys.reserve(user_keys.size());
+  for (const auto& user_key : user_keys) {
+    internal_keys.push_back(InternalKey::MaxPossibleForUserKey(user_key));
+  }
+
+  const auto* ucmp = user_comparator();
+  std::vector<Slice> file_keys;
+  for (int level = 0; level < storage_info_.num_non_empty_levels(); ++level) {
+    const auto& files = storage_info_.files_[level];
+    for (size_t file_idx = 0; file_idx != files.size(); ++file_idx) {
+      const auto* file = files[file_idx];
+      const auto smallest = file->smallest.key.user_key();
+      const auto largest = file->largest.key.user_key();
+      auto it = std::lower_bound(
+          user_keys.begin(), user_keys.end(), smallest,
+          [ucmp](const Slice& lhs, const Slice& rhs) { return ucmp->Compare(lhs, rhs) < 0; });
+      file_keys.clear();
+      for (; it != user_keys.end() && ucmp->Compare(*it, largest) <= 0; ++it) {
+        file_keys.push_back(internal_keys[it - user_keys.begin()].Encode());
+      }
+      if (file_keys.empty()) {
+        continue;
+      }
+
+      auto trwh = VERIFY_RESULT(table_cache_->GetTableReader(
+          vset_->env_options_, cfd_->internal_comparator(), file->fd, read_options.query_id,
+          /* no_io = */ false, cfd_->internal_stats()->GetFileReadHist(level),
+          IsFilterSkipped(level, file_idx + 1 == files.size())));
+      RETURN_NOT_OK(trwh.table_reader->PrefetchDataBlocks(read_options, file_keys));
+    }
+  }
+  return Status::OK();
+}
+
 Result<std::string> Version::GetMiddleOfMiddleKeys() {
   const auto level = storage_info_.num_levels_ - 1;
   // Largest files are at lowest level.
@@ -2178,7 +2245,8 @@ VersionSet::VersionSet(const std::string& dbname, const DBOptions* db_options,
       dbname_(dbname),
       db_options_(db_options),
       env_options_(storage_options),
-      env_options_compactions_(env_options_) {}
+      env_options_compactions_(
+          db_options->env->OptimizeForCompactionTableRead(env_options_, *db_options)) {}
 
 VersionSet::~VersionSet() {
   // we need to delete column_family_set_ because its destructor depends on
@@ -3653,7 +3721,7 @@ InternalIterator* VersionSet::MakeInputIterator(Compaction* c) {
         // Create concatenating iterator for the files from this level
         list[num++] = NewTwoLevelIterator(
             new LevelFileIteratorState(
-                cfd->table_cache(), read_options, env_options_,
+                cfd->table_cache(), read_options, env_options_compactions_,
                 cfd->internal_comparator(),
                 nullptr /* no per level latency histogram */,
                 true /* for_compaction */, false /* prefix enabled */,
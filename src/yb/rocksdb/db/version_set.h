@@ -440,8 +440,10 @@ class Version {
   // Append to *iters a sequence of iterators that will
   // yield the contents of this Version when merged together.
   // REQUIRES: This version has been saved (see VersionSet::SaveTo)
-  void AddIterators(const ReadOptions&, const EnvOptions& soptions,
-                    MergeIteratorBuilder* merger_iter_builder);
+  // Returns the number of SST files touched by a seek of the merged iterator, i.e. the number of
+  // added level 0 file iterators plus one per every other non-empty level.
+  size_t AddIterators(const ReadOptions&, const EnvOptions& soptions,
+                      MergeIteratorBuilder* merger_iter_builder);
 
   // Lookup the value for key.  If found, store it in *val and
   // return OK.  Else return a non-OK status.
@@ -464,6 +466,11 @@ class Version {
            bool* value_found = nullptr, bool* key_exists = nullptr,
            SequenceNumber* seq = nullptr);
 
+  // Loads data blocks of SST files, that could contain specified user keys, into block cache.
+  // Keys should be sorted.
+  // REQUIRES: lock is not held
+  Status PrefetchDataBlocks(const ReadOptions& read_options, const std::vector<Slice>& user_keys);
+
   // Loads some stats information from files. Call without mutex held. It needs
   // to be called before applying the version to the version set.
   void PrepareApply(const MutableCFOptions& mutable_cf_options,
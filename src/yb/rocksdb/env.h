@@ -111,6 +111,14 @@ struct EnvOptions : public yb::FileSystemOptions {
 
   // If not nullptr, write rate limiting is enabled for flush and compaction
   RateLimiter* rate_limiter = nullptr;
+
+  // If true, then files are read with O_DIRECT, bypassing page cache.
+  // Falls back to buffered reads if file system does not support direct I/O.
+  bool use_direct_reads = false;
+
+  // If true, then files are written with O_DIRECT, bypassing page cache.
+  // Falls back to buffered writes if file system does not support direct I/O.
+  bool use_direct_writes = false;
 };
 
 // RocksDBFileFactory is the implementation of all NewxxxFile Env methods as well as any methods
@@ -420,6 +428,17 @@ class Env {
   virtual EnvOptions OptimizeForManifestWrite(const EnvOptions& env_options)
       const;
 
+  // OptimizeForCompactionTableWrite will create a new EnvOptions object that is a copy of the
+  // EnvOptions in the parameters, but is optimized for writing table files by flush and
+  // compaction.
+  virtual EnvOptions OptimizeForCompactionTableWrite(const EnvOptions& env_options,
+                                                     const DBOptions& db_options) const;
+
+  // OptimizeForCompactionTableRead will create a new EnvOptions object that is a copy of the
+  // EnvOptions in the parameters, but is optimized for reading table files by compaction.
+  virtual EnvOptions OptimizeForCompactionTableRead(const EnvOptions& env_options,
+                                                    const DBOptions& db_options) const;
+
   virtual bool IsPlainText() const {
     return true;
   }
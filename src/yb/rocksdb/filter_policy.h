@@ -214,4 +214,15 @@ extern const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
 extern const FilterPolicy* NewFixedSizeFilterPolicy(size_t total_bits,
                                                     double error_rate,
                                                     Logger* logger);
+
+// Return a new filter policy that uses a ribbon filter divided into fixed-size blocks with
+// specified parameters. It has the same parameters as NewFixedSizeFilterPolicy, but needs ~25%
+// less space per key for the same false positive rate, at the cost of more CPU used to build
+// filter blocks.
+//
+// Callers must delete the result after any database that is using the filter policy has been
+// closed.
+extern const FilterPolicy* NewFixedSizeRibbonFilterPolicy(size_t total_bits,
+                                                          double error_rate,
+                                                          Logger* logger);
 }  // namespace rocksdb
@@ -135,6 +135,8 @@ struct ImmutableCFOptions {
 
   CompactionFileFilterFactory* compaction_file_filter_factory;
 
+  CompactionOutputPathSelector* compaction_output_path_selector;
+
   std::shared_ptr<RocksDBPriorityThreadPoolMetrics> priority_thread_pool_metrics;
 };
 
@@ -81,7 +81,9 @@ YB_DEFINE_ENUM(CompactionReason,
   // Scheduled full compaction
   (kScheduledFullCompaction)
   // Post-split compaction
-  (kPostSplitCompaction));
+  (kPostSplitCompaction)
+  // Full compaction triggered by high density of delete markers and expired values
+  (kTombstoneDensityCompaction));
 
 
 struct TableFileDeletionInfo {
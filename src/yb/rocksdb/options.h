@@ -31,6 +31,8 @@
 #include <limits>
 #include <unordered_map>
 
+#include <boost/container/container_fwd.hpp>
+
 #include "yb/rocksdb/rocksdb_fwd.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/listener.h"
@@ -59,6 +61,7 @@ class CompactionFilterFactory;
 class Comparator;
 class Env;
 class CompactionFileFilterFactory;
+class CompactionOutputPathSelector;
 enum InfoLogLevel : unsigned char;
 class SstFileManager;
 class FilterPolicy;
@@ -95,7 +98,9 @@ enum CompressionType : char {
   kBZip2Compression = 0x3,
   kLZ4Compression = 0x4,
   kLZ4HCCompression = 0x5,
-  // zstd format is not finalized yet so it's subject to changes.
+  kZSTD = 0x7,
+  // Blocks written by older versions with the same ZSTD format as kZSTD. Still accepted, but
+  // new files should use kZSTD.
   kZSTDNotFinalCompression = 0x40,
 };
 
@@ -826,8 +831,11 @@ typedef std::function<yb::Result<bool>(const MemTable&)> MemTableFilter;
 using IteratorReplacer =
     std::function<InternalIterator*(InternalIterator*, Arena*, const Slice&)>;
 
-using CompactionContextFactory = std::function<CompactionContextPtr(
-    CompactionFeed* feed, const CompactionContextOptions& options)>;
+// Creates compaction contexts for all subcompactions of a compaction, one context per feed.
+// Contexts are created by a single call, so they could share state that should be the same for
+// all key ranges of the compaction.
+using CompactionContextFactory = std::function<std::vector<CompactionContextPtr>(
+    const std::vector<CompactionFeed*>& feeds, const CompactionContextOptions& options)>;
 
 struct DBOptions {
   // Some functions that make it easier to optimize RocksDB
@@ -1012,6 +1020,9 @@ struct DBOptions {
   // This value represents the maximum number of threads that will
   // concurrently perform a compaction job by breaking it into multiple,
   // smaller ones that are run simultaneously.
+  // For universal compaction of single level DB, compaction is split only when its input size
+  // exceeds compaction_size_threshold_bytes, and each subcompaction processes at least
+  // compaction_size_threshold_bytes of input.
   // Default: 1 (i.e. no subcompactions)
   uint32_t max_subcompactions;
 
@@ -1171,6 +1182,16 @@ struct DBOptions {
   // Default: 0
   size_t compaction_readahead_size;
 
+  // If true, then table files written by flush and compaction, and table files read by
+  // compaction, are accessed with O_DIRECT. So background I/O does not evict pages of hot files
+  // used by user reads from the OS page cache. User reads still use buffered I/O.
+  //
+  // When true, we also force new_table_reader_for_compaction_inputs to true, and use 2MB as
+  // compaction_readahead_size if it is not specified.
+  //
+  // Default: false
+  bool use_direct_io_for_flush_and_compaction = false;
+
   // This is a maximum buffer size that is used by WinMmapReadableFile in
   // unbuffered disk I/O mode. We need to maintain an aligned buffer for
   // reads. We allow the buffer to grow until the specified value and then
@@ -1328,6 +1349,12 @@ struct DBOptions {
 
   std::shared_ptr<CompactionContextFactory> compaction_context_factory;
 
+  // Returns size of the user key prefix, that should be used as subcompaction boundary instead of
+  // the key itself, so all keys with this prefix are processed by the same subcompaction.
+  // 0 means that key could not be used as a boundary.
+  // When not set, boundaries are not adjusted.
+  std::shared_ptr<std::function<size_t(Slice)>> subcompaction_boundary_prefix_size;
+
   // Function that returns max file size for compaction.
   // Supported only for level0 of universal style compactions.
   std::shared_ptr<std::function<uint64_t()>> max_file_size_for_compaction;
@@ -1354,6 +1381,11 @@ struct DBOptions {
   // completely expired based on their table and/or column TTL.
   std::shared_ptr<CompactionFileFilterFactory> compaction_file_filter_factory;
 
+  // Picks db_paths entry for compaction output based on compaction input files, could be used to
+  // move old data to a slower storage tier. When not set, the path is chosen by the compaction
+  // picker using db_paths target sizes.
+  std::shared_ptr<CompactionOutputPathSelector> compaction_output_path_selector;
+
   // Metrics tracker for tasks in the priority thread pool.
   std::shared_ptr<RocksDBPriorityThreadPoolMetrics> priority_thread_pool_metrics;
 
@@ -1403,10 +1435,20 @@ enum ReadTier {
 };
 
 struct FdWithBoundaries;
+struct UserBoundaryValueRef;
 class ReadFileFilter {
  public:
   virtual bool Filter(const FdWithBoundaries&) const = 0;
 
+  // Returns false if data block with specified smallest and largest user boundary values cannot
+  // contain keys interesting for the reader, so block based table iterator could skip it.
+  // Tags missing from boundaries should not be used for filtering.
+  virtual bool FilterDataBlock(
+      const boost::container::small_vector_base<UserBoundaryValueRef>& smallest,
+      const boost::container::small_vector_base<UserBoundaryValueRef>& largest) const {
+    return true;
+  }
+
  protected:
   virtual ~ReadFileFilter() {}
 };
@@ -1521,6 +1563,7 @@ struct ReadOptions {
   // files from being added to MergeIterator. By default doesn't filter files.
   std::shared_ptr<TableAwareReadFileFilter> table_aware_file_filter;
 
+  // Filter for pruning SST files and data blocks of SST files, see ReadFileFilter.
   std::shared_ptr<ReadFileFilter> file_filter;
 
   static const ReadOptions kDefault;
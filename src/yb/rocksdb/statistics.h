@@ -215,6 +215,9 @@ enum Tickers : uint32_t {
   COMPACTION_FILES_FILTERED,
   COMPACTION_FILES_NOT_FILTERED,
 
+  // # of data blocks skipped by iterators using per data block boundary values.
+  DATA_BLOCKS_FILTERED,
+
   // End of ticker enum.
   TICKER_ENUM_MAX,
 };
@@ -318,6 +321,8 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
 
     {COMPACTION_FILES_FILTERED, "rocksdb_compaction_files_filtered"},
     {COMPACTION_FILES_NOT_FILTERED, "rocksdb_compaction_files_not_filtered"},
+
+    {DATA_BLOCKS_FILTERED, "rocksdb_data_blocks_filtered"},
 };
 
 /**
@@ -45,6 +45,7 @@ namespace rocksdb {
 
 // -- Block-based Table
 class FlushBlockPolicyFactory;
+class SliceTransform;
 struct TableReaderOptions;
 struct TableBuilderOptions;
 class TableBuilder;
@@ -163,6 +164,20 @@ struct BlockBasedTableOptions {
   KeyValueEncodingFormat data_block_key_value_encoding_format =
       KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
 
+  // If true, data blocks are built with hash index, that maps key prefix to the restart interval,
+  // so Seek to a key that is present in the block does not need binary search over restart points.
+  // See data_block_hash_index.h for details.
+  // Blocks with hash index could not be read by versions without its support, so it should be
+  // enabled only when all readers of SST files support it.
+  bool data_block_hash_index = false;
+
+  // Ratio of the number of distinct key prefixes to the number of hash index buckets.
+  double data_block_hash_table_util_ratio = 0.75;
+
+  // Extracts key prefix used by data block hash index from the user key. Whole user key is used
+  // if not set. Should be the same when reading SST files, that were written with hash index.
+  std::shared_ptr<const SliceTransform> data_block_hash_index_key_transform;
+
   // If non-nullptr, use the specified filter policy for new SST files to reduce disk reads.
   // Many applications will benefit from passing the result of
   // NewBloomFilterPolicy() here.
@@ -185,6 +185,8 @@ void BlockIter::Seek(const Slice& target) {
   bool ok = false;
   if (prefix_index_) {
     ok = PrefixSeek(target, &index);
+  } else if (data_block_hash_index_) {
+    ok = DataBlockHashSeek(target, &index);
   } else {
     ok = hash_index_ ? HashSeek(target, &index)
       : BinarySeek(target, 0, num_restarts_ - 1, &index);
@@ -537,9 +539,38 @@ bool BlockIter::PrefixSeek(const Slice& target, uint32_t* index) {
   }
 }
 
+// Uses data block hash index to find restart interval for target. Restart interval from the index
+// is verified using adjacent restart keys, so the result is always the same as for BinarySeek.
+bool BlockIter::DataBlockHashSeek(const Slice& target, uint32_t* index) {
+  assert(data_block_hash_index_);
+  const uint32_t restart_index = data_block_hash_index_->Lookup(target, hash_index_key_transform_);
+  if (restart_index >= num_restarts_) {
+    // No entry, collision or corrupted index.
+    return BinarySeek(target, 0, num_restarts_ - 1, index);
+  }
+  if (restart_index > 0 && CompareBlockKey(restart_index, target) > 0) {
+    if (!status_.ok()) {
+      return false;
+    }
+    return BinarySeek(target, 0, restart_index - 1, index);
+  }
+  if (restart_index + 1 < num_restarts_ && CompareBlockKey(restart_index + 1, target) <= 0) {
+    return BinarySeek(target, restart_index + 1, num_restarts_ - 1, index);
+  }
+  if (!status_.ok()) {
+    return false;
+  }
+  *index = restart_index;
+  return true;
+}
+
+void DeleteCachedBlock(const Slice& key, void* value) {
+  delete static_cast<Block*>(value);
+}
+
 uint32_t Block::NumRestarts() const {
   assert(size_ >= kMinBlockSize);
-  return DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  return DecodeFixed32(data_ + size_ - sizeof(uint32_t)) & ~kDataBlockHashIndexFlag;
 }
 
 Block::Block(BlockContents&& contents)
@@ -549,9 +580,15 @@ Block::Block(BlockContents&& contents)
   if (size_ < sizeof(uint32_t)) {
     size_ = 0;  // Error marker
   } else {
-    restart_offset_ =
-        static_cast<uint32_t>(size_) - (1 + NumRestarts()) * sizeof(uint32_t);
-    if (restart_offset_ > size_ - sizeof(uint32_t)) {
+    auto restarts_end = static_cast<uint32_t>(size_ - sizeof(uint32_t));
+    if (DecodeFixed32(data_ + restarts_end) & kDataBlockHashIndexFlag) {
+      if (!data_block_hash_index_.Initialize(data_, restarts_end, &restarts_end)) {
+        size_ = 0;  // Error marker
+        return;
+      }
+    }
+    restart_offset_ = restarts_end - NumRestarts() * static_cast<uint32_t>(sizeof(uint32_t));
+    if (restart_offset_ > restarts_end) {
       // The size is too small for NumRestarts() and therefore
       // restart_offset_ wrapped around.
       size_ = 0;
@@ -561,7 +598,7 @@ Block::Block(BlockContents&& contents)
 
 InternalIterator* Block::NewIterator(
     const Comparator* cmp, const KeyValueEncodingFormat key_value_encoding_format, BlockIter* iter,
-    const bool total_order_seek) const {
+    const bool total_order_seek, const SliceTransform* hash_index_key_transform) const {
   if (size_ < kMinBlockSize) {
     if (iter != nullptr) {
       iter->SetStatus(BadBlockContentsError());
@@ -591,6 +628,9 @@ InternalIterator* Block::NewIterator(
       iter = new BlockIter(cmp, data_, key_value_encoding_format, restart_offset_, num_restarts,
                            hash_index_ptr, prefix_index_ptr);
     }
+    if (data_block_hash_index_.valid()) {
+      iter->SetDataBlockHashIndex(&data_block_hash_index_, hash_index_key_transform);
+    }
   }
 
   return iter;
@@ -701,4 +741,25 @@ yb::Result<std::string> Block::GetMiddleKey(
       /* restart_idx = */ 0, cmp, key_value_encoding_format, middle_entry_policy));
 }
 
+yb::Result<std::vector<std::string>> Block::GetSampleKeys(
+    const size_t max_keys, const KeyValueEncodingFormat key_value_encoding_format) const {
+  std::vector<std::string> result;
+  if (size_ < kMinBlockSize) {
+    return BadBlockContentsError();
+  }
+  if (size_ == kMinBlockSize || max_keys == 0) {
+    return result;
+  }
+  const size_t num_restarts = NumRestarts();
+  const auto num_keys = std::min(max_keys, num_restarts);
+  result.reserve(num_keys);
+  for (size_t i = 0; i != num_keys; ++i) {
+    // Take restart point from the middle of the i-th of num_keys equal parts of the block.
+    const auto restart_idx = static_cast<uint32_t>((2 * i + 1) * num_restarts / (2 * num_keys));
+    const auto key = VERIFY_RESULT(GetRestartKey(restart_idx, key_value_encoding_format));
+    result.push_back(key.ToBuffer());
+  }
+  return result;
+}
+
 }  // namespace rocksdb
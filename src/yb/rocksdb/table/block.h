@@ -28,12 +28,16 @@
 #include <malloc.h>
 #endif
 
+#include <string>
+#include <vector>
+
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
 #include "yb/rocksdb/table/block_hash_index.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/internal_iterator.h"
 
@@ -75,6 +79,11 @@ class Block {
     return contents_.compression_type;
   }
 
+  // Compression type of the block in the file, even if the block itself is uncompressed.
+  CompressionType disk_compression_type() const {
+    return contents_.disk_compression_type;
+  }
+
   // If hash index lookup is enabled and `use_hash_index` is true. This block
   // will do hash lookup for the key prefix.
   //
@@ -90,10 +99,14 @@ class Block {
   // This option only applies for index block. For data block, hash_index_
   // and prefix_index_ are null, so this option does not matter.
   // key_value_encoding_format specifies what kind of algorithm to use for decoding entries.
+  //
+  // If the block contains data block hash index, it is used by Seek, and hash_index_key_transform
+  // should be the same as the one used for building the block.
   InternalIterator* NewIterator(const Comparator* comparator,
                                 KeyValueEncodingFormat key_value_encoding_format,
                                 BlockIter* iter = nullptr,
-                                bool total_order_seek = true) const;
+                                bool total_order_seek = true,
+                                const SliceTransform* hash_index_key_transform = nullptr) const;
 
   inline InternalIterator* NewIndexIterator(
       const Comparator* comparator, BlockIter* iter = nullptr, bool total_order_seek = true) const {
@@ -104,6 +117,8 @@ class Block {
   void SetBlockHashIndex(BlockHashIndex* hash_index);
   void SetBlockPrefixIndex(BlockPrefixIndex* prefix_index);
 
+  bool has_data_block_hash_index() const { return data_block_hash_index_.valid(); }
+
   // Report an approximation of how much memory has been used.
   size_t ApproximateMemoryUsage() const;
 
@@ -124,6 +139,11 @@ class Block {
       MiddlePointPolicy middle_entry_policy = MiddlePointPolicy::kMiddleLow
   ) const;
 
+  // Returns up to max_keys keys of restart points, evenly distributed over the block.
+  // Returns empty vector for empty block.
+  yb::Result<std::vector<std::string>> GetSampleKeys(
+      size_t max_keys, KeyValueEncodingFormat key_value_encoding_format) const;
+
  private:
   // Returns key for corresponding restart block.
   yb::Result<Slice> GetRestartKey(
@@ -141,12 +161,17 @@ class Block {
   uint32_t restart_offset_;     // Offset in data_ of restart array
   std::unique_ptr<BlockHashIndex> hash_index_;
   std::unique_ptr<BlockPrefixIndex> prefix_index_;
+  DataBlockHashIndex data_block_hash_index_;
 
   // No copying allowed
   Block(const Block&);
   void operator=(const Block&);
 };
 
+// Deleter of blocks stored in block cache. Also used to distinguish blocks from other entries of
+// block cache.
+void DeleteCachedBlock(const Slice& key, void* value);
+
 class BlockIter : public InternalIterator {
  public:
   BlockIter()
@@ -158,7 +183,9 @@ class BlockIter : public InternalIterator {
         restart_index_(0),
         status_(Status::OK()),
         hash_index_(nullptr),
-        prefix_index_(nullptr) {}
+        prefix_index_(nullptr),
+        data_block_hash_index_(nullptr),
+        hash_index_key_transform_(nullptr) {}
 
   BlockIter(
       const Comparator* comparator, const char* data,
@@ -175,6 +202,12 @@ class BlockIter : public InternalIterator {
       KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts, uint32_t num_restarts,
       const BlockHashIndex* hash_index, const BlockPrefixIndex* prefix_index);
 
+  void SetDataBlockHashIndex(
+      const DataBlockHashIndex* data_block_hash_index, const SliceTransform* key_transform) {
+    data_block_hash_index_ = data_block_hash_index;
+    hash_index_key_transform_ = key_transform;
+  }
+
   void SetStatus(Status s) {
     status_ = s;
   }
@@ -241,6 +274,8 @@ class BlockIter : public InternalIterator {
   Status status_;
   const BlockHashIndex* hash_index_;
   const BlockPrefixIndex* prefix_index_;
+  const DataBlockHashIndex* data_block_hash_index_;
+  const SliceTransform* hash_index_key_transform_;
 
   inline int Compare(const Slice& a, const Slice& b) const {
     return comparator_->Compare(a, b);
@@ -285,6 +320,8 @@ class BlockIter : public InternalIterator {
 
   bool PrefixSeek(const Slice& target, uint32_t* index);
 
+  bool DataBlockHashSeek(const Slice& target, uint32_t* index);
+
 };
 
 }  // namespace rocksdb
@@ -106,6 +106,8 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
   return compressed_size < raw_size - (raw_size / 8u);
 }
 
+}  // namespace
+
 // format_version is the block format as defined in include/rocksdb/table.h
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
@@ -161,6 +163,7 @@ Slice CompressBlock(const Slice& raw,
         return *compressed_output;
       }
       break;     // fall back to no compression.
+    case kZSTD:
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
                         compressed_output) &&
@@ -177,8 +180,6 @@ Slice CompressBlock(const Slice& raw,
   return raw;
 }
 
-}  // namespace
-
 // kBlockBasedTableMagicNumber was picked by running
 //    echo rocksdb.table.block_based | sha1sum
 // and taking the leading 64 bits.
@@ -401,6 +402,12 @@ BlockBasedTableBuilder::Rep::Rep(
   table_properties_collectors.emplace_back(new BlockBasedTablePropertiesCollector(
       this, table_options.index_type, table_options.whole_key_filtering,
       _ioptions.prefix_extractor != nullptr, table_options.data_block_key_value_encoding_format));
+
+  if (table_options.data_block_hash_index) {
+    data_block_builder.EnableDataBlockHashIndex(
+        table_options.data_block_hash_index_key_transform.get(),
+        table_options.data_block_hash_table_util_ratio);
+  }
 }
 
 BlockBasedTableBuilder::BlockBasedTableBuilder(
@@ -503,6 +510,9 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   if (!r->data_block_builder.empty()) {
     data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
         r->data_writer.get());
+    if (!ok()) return;
+    NotifyCollectTableCollectorsOnDataBlockFinished(
+        r->data_pending_handle.offset(), r->table_properties_collectors, r->ioptions.info_log);
   }
   if (!ok()) return;
 
@@ -45,6 +45,15 @@ struct BlockBasedTableOptions;
 extern const uint64_t kBlockBasedTableMagicNumber;
 extern const uint64_t kLegacyBlockBasedTableMagicNumber;
 
+// Compresses raw block contents using *type. When compression is not supported or does not reduce
+// size enough, sets *type to kNoCompression and returns raw. Otherwise returns slice pointing to
+// compressed_output.
+// format_version is the block format as defined in rocksdb/table.h.
+Slice CompressBlock(const Slice& raw,
+                    const CompressionOptions& compression_options,
+                    CompressionType* type, uint32_t format_version,
+                    std::string* compressed_output);
+
 class BlockBasedTableBuilder : public TableBuilder {
  public:
   // Create a builder that will store the contents of the table it is
@@ -32,6 +32,7 @@
 #include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/flush_block_policy.h"
 #include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/table/block_based_table_builder.h"
 #include "yb/rocksdb/table/block_based_table_reader.h"
 #include "yb/rocksdb/table/format.h"
@@ -180,6 +181,16 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
   snprintf(buffer, kBufferSize, "  index_block_restart_interval: %d\n",
            table_options_.index_block_restart_interval);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_hash_index: %d\n",
+           table_options_.data_block_hash_index);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_hash_table_util_ratio: %lf\n",
+           table_options_.data_block_hash_table_util_ratio);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_hash_index_key_transform: %s\n",
+           table_options_.data_block_hash_index_key_transform == nullptr ?
+             "nullptr" : table_options_.data_block_hash_index_key_transform->Name());
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  filter_policy: %s\n",
            table_options_.filter_policy == nullptr ?
              "nullptr" : table_options_.filter_policy->Name());
@@ -23,6 +23,7 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -43,6 +44,7 @@
 #include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_hash_index.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
+#include "yb/rocksdb/table/data_block_boundaries.h"
 #include "yb/rocksdb/table/filter_block.h"
 #include "yb/rocksdb/table/fixed_size_filter_block.h"
 #include "yb/rocksdb/table/format.h"
@@ -241,6 +243,10 @@ struct BlockBasedTable::Rep {
   // block to extract prefix without knowing if a key is internal or not.
   unique_ptr<SliceTransform> internal_prefix_transform;
 
+  // Boundary values of data blocks, if they were collected for this table. References data of
+  // table_properties.
+  DataBlockBoundariesReader data_block_boundaries;
+
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
 };
@@ -260,6 +266,12 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    if (block_type_ == BlockType::kData && read_options_.file_filter &&
+        !table_->DataBlockMayMatch(*read_options_.file_filter, index_value)) {
+      // Two level iterator treats empty data block iterator as exhausted and advances to the next
+      // data block.
+      return NewEmptyInternalIterator();
+    }
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
   }
 
@@ -571,6 +583,17 @@ Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
       rep_->data_block_key_value_encoding_format =
           static_cast<KeyValueEncodingFormat>(DecodeFixed8(it->second.c_str()));
     }
+
+    it = props.find(kDataBlockBoundariesPropertyName);
+    if (it != props.end()) {
+      auto status = rep_->data_block_boundaries.Init(it->second);
+      if (!status.ok()) {
+        // Boundaries are used for optimization only, so table is still readable without them.
+        RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+            "Failed to parse data block boundaries: %s", status.ToString().c_str());
+        rep_->data_block_boundaries = DataBlockBoundariesReader();
+      }
+    }
   }
 
   return Status::OK();
@@ -815,7 +838,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
     if (block_cache != nullptr && block->value->cachable() &&
         read_options.fill_cache) {
       s = block_cache->Insert(block_cache_key, read_options.query_id, block->value,
-                              block->value->usable_size(), &DeleteCachedEntry<Block>,
+                              block->value->usable_size(), &DeleteCachedBlock,
                               &block->cache_handle, statistics);
       if (!s.ok()) {
         delete block->value;
@@ -862,7 +885,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   if (block_cache_compressed != nullptr && raw_block != nullptr &&
       raw_block->cachable()) {
     s = block_cache_compressed->Insert(compressed_block_cache_key, read_options.query_id, raw_block,
-                                       raw_block->usable_size(), &DeleteCachedEntry<Block>);
+                                       raw_block->usable_size(), &DeleteCachedBlock);
     if (s.ok()) {
       // Avoid the following code to delete this cached block.
       raw_block = nullptr;
@@ -878,7 +901,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   if (block_cache != nullptr && block->value->cachable()) {
     s = block_cache->Insert(block_cache_key, read_options.query_id, block->value,
                             block->value->usable_size(),
-                            &DeleteCachedEntry<Block>, &block->cache_handle, statistics);
+                            &DeleteCachedBlock, &block->cache_handle, statistics);
     if (!s.ok()) {
       delete block->value;
       block->value = nullptr;
@@ -1258,7 +1281,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   auto block = RetrieveBlock(ro, index_value, block_type);
   if (block) {
     InternalIterator* iter = block->value->NewIterator(
-        rep_->comparator.get(), GetKeyValueEncodingFormat(block_type), input_iter);
+        rep_->comparator.get(), GetKeyValueEncodingFormat(block_type), input_iter,
+        /* total_order_seek = */ true,
+        rep_->table_options.data_block_hash_index_key_transform.get());
     if (block->cache_handle) {
       Cache* block_cache = rep_->table_options.block_cache.get();
       iter->RegisterCleanup(&ReleaseCachedEntry, block_cache, block->cache_handle);
@@ -1277,6 +1302,24 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 }
 
+bool BlockBasedTable::DataBlockMayMatch(const ReadFileFilter& filter, const Slice& index_value) {
+  if (rep_->data_block_boundaries.empty()) {
+    return true;
+  }
+  BlockHandle handle;
+  Slice input = index_value;
+  if (!handle.DecodeFrom(&input).ok()) {
+    return true;
+  }
+  boost::container::small_vector<UserBoundaryValueRef, 10> smallest, largest;
+  if (!rep_->data_block_boundaries.Get(handle.offset(), &smallest, &largest) ||
+      filter.FilterDataBlock(smallest, largest)) {
+    return true;
+  }
+  RecordTick(rep_->ioptions.statistics, DATA_BLOCKS_FILTERED);
+  return false;
+}
+
 // This will be broken if the user specifies an unusual implementation
 // of Options.comparator, or if the user specifies an unusual
 // definition of prefixes in BlockBasedTableOptions.filter_policy.
@@ -1540,6 +1583,106 @@ Status BlockBasedTable::Prefetch(const Slice* const begin,
   return Status::OK();
 }
 
+Status BlockBasedTable::PrefetchDataBlocks(
+    const ReadOptions& read_options, const std::vector<Slice>& internal_keys) {
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache_compressed = rep_->table_options.block_cache_compressed.get();
+  if (block_cache == nullptr || read_options.read_tier == kBlockCacheTier ||
+      !read_options.fill_cache) {
+    return Status::OK();
+  }
+
+  Statistics* statistics = rep_->ioptions.statistics;
+  FileReaderWithCachePrefix* reader = GetBlockReader(BlockType::kData);
+  char cache_key[block_based_table::kCacheKeyBufferSize];
+  char compressed_cache_key[block_based_table::kCacheKeyBufferSize];
+
+  IndexIteratorHolder iiter_holder(this, read_options);
+  InternalIterator& iiter = *iiter_holder.iter();
+  RETURN_NOT_OK(iiter.status());
+
+  // Handles of blocks missing from block cache.
+  std::vector<BlockHandle> handles;
+  uint64_t last_offset = std::numeric_limits<uint64_t>::max();
+  for (const auto& internal_key : internal_keys) {
+    // We are only using fixed-size bloom filters for DocDB, see BloomFilterAwareFileFilter.
+    if (rep_->filter_type == FilterType::kFixedSizeFilter) {
+      const auto filter_key = GetFilterKeyFromInternalKey(internal_key);
+      if (!filter_key.empty()) {
+        auto filter_entry = GetFilter(read_options.query_id, /* no_io = */ false, &filter_key);
+        const bool may_match = NonBlockBasedFilterKeyMayMatch(filter_entry.value, filter_key);
+        filter_entry.Release(block_cache);
+        if (!may_match) {
+          RecordTick(statistics, BLOOM_FILTER_USEFUL);
+          continue;
+        }
+      }
+    }
+
+    iiter.Seek(internal_key);
+    if (!iiter.Valid()) {
+      // Keys are sorted, so all remaining keys are after the last block.
+      RETURN_NOT_OK(iiter.status());
+      break;
+    }
+    BlockHandle handle;
+    Slice input = iiter.value();
+    RETURN_NOT_OK(handle.DecodeFrom(&input));
+    // Keys from the same block are adjacent, so block lookup is shared by them.
+    if (handle.offset() == last_offset) {
+      continue;
+    }
+    last_offset = handle.offset();
+
+    auto* cache_handle = block_cache->Lookup(
+        GetCacheKey(reader->cache_key_prefix, handle, cache_key), read_options.query_id);
+    if (cache_handle) {
+      block_cache->Release(cache_handle);
+      continue;
+    }
+    handles.push_back(handle);
+  }
+
+  if (handles.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<BlockContents> contents;
+  std::vector<Status> statuses;
+  {
+    StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
+    ReadBlockContentsBatch(
+        reader->reader.get(), rep_->footer, read_options, handles, &contents, &statuses,
+        rep_->mem_tracker, block_cache_compressed == nullptr);
+  }
+
+  for (size_t i = 0; i != handles.size(); ++i) {
+    RETURN_NOT_OK(statuses[i]);
+    Slice key = GetCacheKey(reader->cache_key_prefix, handles[i], cache_key);
+    Slice ckey;
+    if (block_cache_compressed != nullptr) {
+      ckey = GetCacheKey(reader->compressed_cache_key_prefix, handles[i], compressed_cache_key);
+    }
+    CachableEntry<Block> block;
+    auto status = PutDataBlockToCache(
+        key, ckey, block_cache, block_cache_compressed, read_options, statistics, &block,
+        new Block(std::move(contents[i])), rep_->table_options.format_version,
+        rep_->mem_tracker);
+    if (!status.ok()) {
+      // Block was not cached, it will be read again by iterator.
+      continue;
+    }
+    if (block.cache_handle) {
+      block.Release(block_cache);
+    } else {
+      // Block is not cachable.
+      delete block.value;
+    }
+  }
+
+  return Status::OK();
+}
+
 bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
                                       const Slice& key) {
   std::unique_ptr<InternalIterator> iiter(NewIndexIterator(options));
@@ -1959,6 +2102,17 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
       rep_->comparator.get(), MiddlePointPolicy::kMiddleHigh);
 }
 
+yb::Result<std::vector<std::string>> BlockBasedTable::GetSampleKeys(size_t max_keys) {
+  auto index_reader = VERIFY_RESULT(GetIndexReader(ReadOptions::kDefault));
+
+  // TODO: remove this trick after https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
+  auto se = yb::ScopeExit([this, &index_reader] {
+    index_reader.Release(rep_->table_options.block_cache.get());
+  });
+
+  return index_reader.value->GetSampleKeys(max_keys);
+}
+
 yb::Result<IndexReaderCleanablePtr> BlockBasedTable::TEST_GetIndexReader() {
   auto index_reader = VERIFY_RESULT(GetIndexReader(ReadOptions::kDefault));
   auto cache = rep_->table_options.block_cache;
@@ -140,6 +140,10 @@ class BlockBasedTable : public TableReader {
 
   bool PrefixMayMatch(const Slice& internal_key);
 
+  // Returns false if data block referenced by index_value could be skipped according to the
+  // boundary values of this block and filter.
+  bool DataBlockMayMatch(const ReadFileFilter& filter, const Slice& index_value);
+
   // Returns a new iterator over the table contents.
   // The result of NewIterator() is initially invalid (caller must
   // call one of the Seek methods on the iterator before using it).
@@ -158,6 +162,12 @@ class BlockBasedTable : public TableReader {
   // IO or iteration error.
   Status Prefetch(const Slice* begin, const Slice* end) override;
 
+  // Loads data blocks, that could contain specified internal keys, into block cache. Keys that
+  // don't match bloom filter are skipped. Blocks missing from block cache are read with a single
+  // batch of reads.
+  Status PrefetchDataBlocks(
+      const ReadOptions& read_options, const std::vector<Slice>& internal_keys) override;
+
   // Given a key, return an approximate byte offset in the file where
   // the data for that key begins (or would begin if the key were
   // present in the file).  The returned value is in terms of file
@@ -203,6 +213,8 @@ class BlockBasedTable : public TableReader {
 
   yb::Result<std::string> GetMiddleKey() override;
 
+  yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) override;
+
   // Helper function that force reading block from a file and takes care about block cleanup.
   yb::Result<std::unique_ptr<Block>> RetrieveBlockFromFile(const ReadOptions& ro,
       const Slice& index_value, BlockType block_type);
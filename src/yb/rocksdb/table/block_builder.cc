@@ -44,6 +44,8 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+// Data blocks could also contain hash index between restarts and num_restarts, see
+// data_block_hash_index.h.
 
 #include "yb/rocksdb/table/block_builder.h"
 
@@ -73,6 +75,12 @@ BlockBuilder::BlockBuilder(
   restarts_.push_back(0);       // First restart point is at offset 0
 }
 
+void BlockBuilder::EnableDataBlockHashIndex(
+    const SliceTransform* key_transform, double util_ratio) {
+  assert(empty());
+  hash_index_builder_.emplace(key_transform, util_ratio);
+}
+
 void BlockBuilder::Reset() {
   buffer_.clear();
   restarts_.clear();
@@ -80,6 +88,9 @@ void BlockBuilder::Reset() {
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
+  if (hash_index_builder_) {
+    hash_index_builder_->Reset();
+  }
 }
 
 size_t BlockBuilder::CurrentSizeEstimate() const {
@@ -88,6 +99,9 @@ size_t BlockBuilder::CurrentSizeEstimate() const {
     // Restarts haven't been flushed to buffer yet.
     size += restarts_.size() * sizeof(uint32_t) +    // Restart array.
             sizeof(uint32_t);                        // Restart array length.
+    if (hash_index_builder_ && hash_index_builder_->Valid(restarts_.size())) {
+      size += hash_index_builder_->EstimateSize();
+    }
   }
   return size;
 }
@@ -335,7 +349,12 @@ Slice BlockBuilder::Finish() {
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
   }
-  PutFixed32(&buffer_, static_cast<uint32_t>(restarts_.size()));
+  auto num_restarts = static_cast<uint32_t>(restarts_.size());
+  if (hash_index_builder_ && hash_index_builder_->Valid(num_restarts)) {
+    hash_index_builder_->Finish(&buffer_);
+    num_restarts |= kDataBlockHashIndexFlag;
+  }
+  PutFixed32(&buffer_, num_restarts);
   finished_ = true;
   return Slice(buffer_);
 }
@@ -374,6 +393,11 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
     }
   }
 
+  if (hash_index_builder_) {
+    hash_index_builder_->Add(
+        key, static_cast<uint32_t>(restarts_.size() - 1), /* is_restart_key = */ counter_ == 0);
+  }
+
   DVLOG_WITH_FUNC(4) << "key: " << Slice(key).ToDebugHexString() << " size: " << key.size()
                     << " offset: " << buffer_.size() << " counter: " << counter_;
 
@@ -24,8 +24,11 @@
 #pragma once
 
 #include <stdint.h>
+
+#include <optional>
 #include <vector>
 
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/types.h"
 
 #include "yb/util/slice.h"
@@ -41,6 +44,10 @@ class BlockBuilder {
                         KeyValueEncodingFormat key_value_encoding_format,
                         bool use_delta_encoding = true);
 
+  // Build data block hash index for keys added to this builder, see data_block_hash_index.h.
+  // Keys should be internal keys. key_transform is not owned and should outlive the builder.
+  void EnableDataBlockHashIndex(const SliceTransform* key_transform, double util_ratio);
+
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
 
@@ -77,6 +84,7 @@ class BlockBuilder {
   int                   counter_;   // Number of entries emitted since restart
   bool                  finished_;  // Has Finish() been called?
   std::string           last_key_;
+  std::optional<DataBlockHashIndexBuilder> hash_index_builder_;
 };
 
 }  // namespace rocksdb
@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -528,6 +529,123 @@ TEST_F(BlockTest, GetMiddleKey) {
   }
 }
 
+TEST_F(BlockTest, GetSampleKeys) {
+  for (const auto key_value_encoding_format : KeyValueEncodingFormatList()) {
+    BlockBuilder builder(/* block_restart_interval = */ 2, key_value_encoding_format);
+    for (int i = 0; i < 20; ++i) {
+      const auto padded_num = GetPaddedNum(i);
+      builder.Add("k" + padded_num, "v" + padded_num);
+    }
+    BlockContents contents;
+    contents.data = builder.Finish();
+    contents.cachable = false;
+    Block reader(std::move(contents));
+
+    // 10 restart points with keys k0, k2, ..., k18.
+    auto keys = ASSERT_RESULT(reader.GetSampleKeys(2, key_value_encoding_format));
+    ASSERT_EQ(keys, std::vector<std::string>({"k" + GetPaddedNum(4), "k" + GetPaddedNum(14)}));
+    keys = ASSERT_RESULT(reader.GetSampleKeys(100, key_value_encoding_format));
+    ASSERT_EQ(keys.size(), 10);
+    ASSERT_EQ(keys.front(), "k" + GetPaddedNum(0));
+    ASSERT_EQ(keys.back(), "k" + GetPaddedNum(18));
+    ASSERT_TRUE(ASSERT_RESULT(reader.GetSampleKeys(0, key_value_encoding_format)).empty());
+
+    BlockBuilder empty_builder(/* block_restart_interval = */ 2, key_value_encoding_format);
+    BlockContents empty_contents;
+    empty_contents.data = empty_builder.Finish();
+    empty_contents.cachable = false;
+    Block empty_reader(std::move(empty_contents));
+    ASSERT_TRUE(ASSERT_RESULT(empty_reader.GetSampleKeys(2, key_value_encoding_format)).empty());
+  }
+}
+
+namespace {
+
+std::unique_ptr<Block> BuildDataBlock(
+    const std::vector<std::string>& keys, KeyValueEncodingFormat key_value_encoding_format,
+    const SliceTransform* hash_index_key_transform, std::string* buffer) {
+  BlockBuilder builder(/* block_restart_interval = */ 4, key_value_encoding_format);
+  if (hash_index_key_transform) {
+    builder.EnableDataBlockHashIndex(hash_index_key_transform, /* util_ratio = */ 0.75);
+  }
+  for (const auto& key : keys) {
+    builder.Add(key, "value_" + key);
+  }
+  *buffer = builder.Finish().ToBuffer();
+  BlockContents contents;
+  contents.data = *buffer;
+  contents.cachable = false;
+  return std::make_unique<Block>(std::move(contents));
+}
+
+} // namespace
+
+TEST_F(BlockTest, DataBlockHashIndex) {
+  // Key prefix is 7 bytes, the rest of user key is a version.
+  std::unique_ptr<const SliceTransform> key_transform(NewFixedPrefixTransform(7));
+  InternalKeyComparator comparator(BytewiseComparator());
+
+  std::vector<std::string> keys;
+  for (int i = 0; i < 200; i += 2) {
+    for (int version = i % 5; version >= 0; --version) {
+      keys.push_back(InternalKey(
+          StringPrintf("%06d", i) + "_" + std::to_string(version), 1000, kTypeValue)
+          .Encode().ToString());
+    }
+  }
+  std::sort(keys.begin(), keys.end(), [&comparator](const auto& lhs, const auto& rhs) {
+    return comparator.Compare(lhs, rhs) < 0;
+  });
+
+  for (const auto key_value_encoding_format : KeyValueEncodingFormatList()) {
+    std::string hashed_buffer, plain_buffer;
+    auto hashed = BuildDataBlock(
+        keys, key_value_encoding_format, key_transform.get(), &hashed_buffer);
+    auto plain = BuildDataBlock(keys, key_value_encoding_format, nullptr, &plain_buffer);
+    ASSERT_TRUE(hashed->has_data_block_hash_index());
+    ASSERT_FALSE(plain->has_data_block_hash_index());
+    ASSERT_EQ(hashed->NumRestarts(), plain->NumRestarts());
+
+    std::unique_ptr<InternalIterator> hashed_iter(hashed->NewIterator(
+        &comparator, key_value_encoding_format, nullptr, /* total_order_seek = */ true,
+        key_transform.get()));
+    std::unique_ptr<InternalIterator> plain_iter(
+        plain->NewIterator(&comparator, key_value_encoding_format));
+
+    // Seek to present and absent prefixes, to the prefix without version, and to the versions
+    // between existing ones should give the same results as seek without hash index.
+    for (int i = 0; i <= 200; ++i) {
+      const auto prefix = StringPrintf("%06d", i) + "_";
+      std::vector<std::string> targets = {
+          InternalKey(prefix, kMaxSequenceNumber, kValueTypeForSeek).Encode().ToString()};
+      for (int version = 0; version <= 5; ++version) {
+        for (auto seq : {kMaxSequenceNumber, SequenceNumber(1000), SequenceNumber(0)}) {
+          targets.push_back(InternalKey(prefix + std::to_string(version), seq, kValueTypeForSeek)
+              .Encode().ToString());
+        }
+      }
+      for (const auto& target : targets) {
+        hashed_iter->Seek(target);
+        plain_iter->Seek(target);
+        ASSERT_OK(hashed_iter->status());
+        ASSERT_EQ(hashed_iter->Valid(), plain_iter->Valid());
+        if (plain_iter->Valid()) {
+          ASSERT_EQ(hashed_iter->key(), plain_iter->key());
+          ASSERT_EQ(hashed_iter->value(), plain_iter->value());
+        }
+      }
+    }
+
+    // Hash index should not affect sequential iteration.
+    size_t count = 0;
+    for (hashed_iter->SeekToFirst(); hashed_iter->Valid(); hashed_iter->Next()) {
+      ASSERT_EQ(hashed_iter->key(), Slice(keys[count]));
+      ++count;
+    }
+    ASSERT_EQ(count, keys.size());
+  }
+}
+
 TEST_F(BlockTest, EncodeThreeSharedPartsSizes) {
   constexpr auto kNumIters = 100000;
 
@@ -0,0 +1,261 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/compressed_secondary_cache.h"
+
+#include <string>
+
+#include "yb/rocksdb/table/block.h"
+#include "yb/rocksdb/table/block_based_table_builder.h"
+#include "yb/rocksdb/table/format.h"
+
+#include "yb/util/cache_metrics.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Blocks are kept only in memory, so we are free to use the latest compression format.
+// See GetCompressFormatForVersion.
+constexpr uint32_t kCompressFormatVersion = 2;
+
+// Block kept in the secondary tier. Last byte of data is compression type, as expected by
+// UncompressBlockContents.
+struct CompressedBlock {
+  std::string data;
+  size_t charge = 0;
+  yb::ScopedTrackedConsumption consumption;
+  std::shared_ptr<yb::CompressedCacheMetrics> metrics;
+
+  ~CompressedBlock() {
+    if (metrics) {
+      metrics->cache_usage->DecrementBy(charge);
+    }
+  }
+};
+
+void DeleteCompressedBlock(const Slice& key, void* value) {
+  delete static_cast<CompressedBlock*>(value);
+}
+
+class CompressedSecondaryCache : public Cache {
+ public:
+  CompressedSecondaryCache(
+      std::shared_ptr<Cache> primary, size_t secondary_capacity, int num_shard_bits,
+      yb::MemTrackerPtr mem_tracker)
+      : primary_(std::move(primary)),
+        secondary_(NewLRUCache(secondary_capacity, num_shard_bits)),
+        mem_tracker_(std::move(mem_tracker)) {
+    const auto total_capacity = primary_->GetCapacity() + secondary_capacity;
+    secondary_fraction_ =
+        total_capacity ? static_cast<double>(secondary_capacity) / total_capacity : 0;
+    primary_->SetEvictionCallback(
+        [this](const Slice& key, void* value, void (*deleter)(const Slice&, void*)) {
+      BlockEvicted(key, value, deleter);
+    });
+  }
+
+  ~CompressedSecondaryCache() {
+    primary_->SetEvictionCallback(nullptr);
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    return primary_->Insert(key, query_id, value, charge, deleter, handle, statistics);
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    auto* handle = primary_->Lookup(key, query_id, statistics);
+    if (handle != nullptr || query_id == kNoCacheQueryId) {
+      return handle;
+    }
+    auto block = TakeFromSecondary(key);
+    if (!block) {
+      return nullptr;
+    }
+    const auto charge = block->usable_size();
+    auto* value = block.release();
+    auto status = primary_->Insert(
+        key, query_id, value, charge, &DeleteCachedBlock, &handle, statistics);
+    if (!status.ok()) {
+      delete value;
+      return nullptr;
+    }
+    return handle;
+  }
+
+  void Release(Handle* handle) override {
+    primary_->Release(handle);
+  }
+
+  void* Value(Handle* handle) override {
+    return primary_->Value(handle);
+  }
+
+  void Erase(const Slice& key) override {
+    primary_->Erase(key);
+    secondary_->Erase(key);
+  }
+
+  uint64_t NewId() override {
+    return primary_->NewId();
+  }
+
+  void SetCapacity(size_t capacity) override {
+    const auto secondary_capacity = static_cast<size_t>(capacity * secondary_fraction_);
+    secondary_->SetCapacity(secondary_capacity);
+    primary_->SetCapacity(capacity - secondary_capacity);
+  }
+
+  bool HasStrictCapacityLimit() const override {
+    return primary_->HasStrictCapacityLimit();
+  }
+
+  size_t GetCapacity() const override {
+    return primary_->GetCapacity() + secondary_->GetCapacity();
+  }
+
+  size_t GetUsage() const override {
+    return primary_->GetUsage() + secondary_->GetUsage();
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return primary_->GetUsage(handle);
+  }
+
+  size_t GetPinnedUsage() const override {
+    return primary_->GetPinnedUsage() + secondary_->GetPinnedUsage();
+  }
+
+  SubCacheType GetSubCacheType(Handle* handle) const override {
+    return primary_->GetSubCacheType(handle);
+  }
+
+  void DisownData() override {
+    primary_->DisownData();
+    secondary_->DisownData();
+  }
+
+  // Only entries of primary cache are visited, since secondary tier contains compressed blocks.
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    primary_->ApplyToAllCacheEntries(callback, thread_safe);
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    primary_->SetMetrics(entity);
+    metrics_ = std::make_shared<yb::CompressedCacheMetrics>(entity);
+  }
+
+  // Compressed blocks are cheaper to lose, so they are evicted first. Blocks evicted from primary
+  // cache here are dropped instead of being moved to the secondary tier, since the goal is to
+  // release memory.
+  size_t Evict(size_t required) override {
+    auto evicted = secondary_->Evict(required);
+    if (evicted < required) {
+      evicted += primary_->Evict(required - evicted);
+    }
+    return evicted;
+  }
+
+  void SetEvictionCallback(EvictionCallback callback) override {
+    LOG(DFATAL) << "Eviction callback is not supported by compressed secondary cache";
+  }
+
+  std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
+    return primary_->TEST_GetIndividualUsages();
+  }
+
+ private:
+  std::unique_ptr<Block> TakeFromSecondary(const Slice& key) {
+    auto* handle = secondary_->Lookup(key, kDefaultQueryId);
+    if (handle == nullptr) {
+      if (metrics_) {
+        metrics_->cache_misses->Increment();
+      }
+      return nullptr;
+    }
+    const auto& compressed = *static_cast<CompressedBlock*>(secondary_->Value(handle));
+    BlockContents contents;
+    auto status = UncompressBlockContents(
+        compressed.data.data(), compressed.data.size() - 1, &contents, kCompressFormatVersion,
+        mem_tracker_);
+    secondary_->Release(handle);
+    // Block is moved to primary cache, so it should not occupy memory in the secondary tier.
+    secondary_->Erase(key);
+    if (!status.ok()) {
+      LOG(DFATAL) << "Failed to uncompress block from compressed secondary cache: " << status;
+      return nullptr;
+    }
+    if (metrics_) {
+      metrics_->cache_hits->Increment();
+    }
+    return std::make_unique<Block>(std::move(contents));
+  }
+
+  void BlockEvicted(const Slice& key, void* value, void (*deleter)(const Slice&, void*)) {
+    if (deleter != &DeleteCachedBlock) {
+      return;
+    }
+    const auto& block = *static_cast<Block*>(value);
+    auto type = block.disk_compression_type();
+    if (type == kNoCompression || block.compression_type() != kNoCompression ||
+        !block.cachable() || block.size() == 0) {
+      return;
+    }
+
+    auto compressed = std::make_unique<CompressedBlock>();
+    CompressBlock(
+        Slice(block.data(), block.size()), CompressionOptions(), &type, kCompressFormatVersion,
+        &compressed->data);
+    if (type == kNoCompression) {
+      return;
+    }
+    compressed->data.push_back(type);
+    compressed->data.shrink_to_fit();
+    compressed->charge = compressed->data.capacity() + sizeof(CompressedBlock);
+    if (mem_tracker_) {
+      compressed->consumption = yb::ScopedTrackedConsumption(mem_tracker_, compressed->charge);
+    }
+    compressed->metrics = metrics_;
+    const auto charge = compressed->charge;
+    if (metrics_) {
+      // Usage is decreased by CompressedBlock destructor, even if insert fails.
+      metrics_->cache_usage->IncrementBy(charge);
+    }
+    auto status = secondary_->Insert(
+        key, kDefaultQueryId, compressed.release(), charge, &DeleteCompressedBlock);
+    if (status.ok() && metrics_) {
+      metrics_->inserts->Increment();
+    }
+  }
+
+  const std::shared_ptr<Cache> primary_;
+  const std::shared_ptr<Cache> secondary_;
+  const yb::MemTrackerPtr mem_tracker_;
+  double secondary_fraction_;
+  std::shared_ptr<yb::CompressedCacheMetrics> metrics_;
+};
+
+} // namespace
+
+std::shared_ptr<Cache> NewCompressedSecondaryCache(
+    std::shared_ptr<Cache> primary, size_t secondary_capacity, int num_shard_bits,
+    yb::MemTrackerPtr mem_tracker) {
+  return std::make_shared<CompressedSecondaryCache>(
+      std::move(primary), secondary_capacity, num_shard_bits, std::move(mem_tracker));
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,39 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <memory>
+
+#include "yb/rocksdb/cache.h"
+
+#include "yb/util/mem_tracker.h"
+
+namespace rocksdb {
+
+// Creates block cache with two tiers. Blocks evicted from primary cache are compressed using the
+// same compression type, that was used for them in SST file, and are kept in the secondary tier of
+// secondary_capacity bytes. When lookup misses primary cache, but finds block in the secondary
+// tier, block is uncompressed and moved back to primary cache. So the same block is never kept in
+// both tiers, and the secondary tier holds several times more blocks per byte than primary.
+//
+// Blocks that are not compressed on disk and entries other than blocks, e.g. index and filter
+// readers, are dropped on eviction as usual.
+//
+// Memory of uncompressed blocks promoted from the secondary tier and of compressed blocks is
+// accounted to mem_tracker.
+extern std::shared_ptr<Cache> NewCompressedSecondaryCache(
+    std::shared_ptr<Cache> primary, size_t secondary_capacity, int num_shard_bits,
+    yb::MemTrackerPtr mem_tracker);
+
+}  // namespace rocksdb
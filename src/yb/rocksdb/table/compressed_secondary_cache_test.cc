@@ -0,0 +1,142 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "yb/rocksdb/table/block.h"
+#include "yb/rocksdb/table/block_based_table_builder.h"
+#include "yb/rocksdb/table/block_builder.h"
+#include "yb/rocksdb/table/compressed_secondary_cache.h"
+#include "yb/rocksdb/table/format.h"
+#include "yb/rocksdb/util/compression.h"
+#include "yb/rocksdb/util/testutil.h"
+
+#include "yb/util/format.h"
+#include "yb/util/test_macros.h"
+
+namespace rocksdb {
+
+class CompressedSecondaryCacheTest : public RocksDBTest {
+ protected:
+  // Returns uncompressed block, that was stored with snappy compression in SST file.
+  std::unique_ptr<Block> MakeBlock(char fill) {
+    BlockBuilder builder(16, kIndexBlockKeyValueEncodingFormat);
+    for (int i = 0; i != 100; ++i) {
+      builder.Add(yb::Format("key_$0_$1", fill, 1000 + i), std::string(100, fill));
+    }
+    auto raw = builder.Finish();
+    auto type = kSnappyCompression;
+    std::string compressed;
+    CompressBlock(raw, CompressionOptions(), &type, 2, &compressed);
+    EXPECT_EQ(type, kSnappyCompression);
+    compressed.push_back(type);
+    BlockContents contents;
+    EXPECT_OK(UncompressBlockContents(
+        compressed.data(), compressed.size() - 1, &contents, 2, nullptr));
+    EXPECT_EQ(contents.disk_compression_type, kSnappyCompression);
+    return std::make_unique<Block>(std::move(contents));
+  }
+
+  static size_t SecondaryUsage(const Cache& cache, const Cache& primary) {
+    return cache.GetUsage() - primary.GetUsage();
+  }
+
+  void Insert(Cache* cache, const std::string& key, std::unique_ptr<Block> block) {
+    const auto charge = block->usable_size();
+    ASSERT_OK(cache->Insert(key, kDefaultQueryId, block.release(), charge, &DeleteCachedBlock));
+  }
+
+  // Returns first byte of value of the first entry of the block with specified key,
+  // or 0 if block is not found.
+  char Lookup(Cache* cache, const std::string& key) {
+    auto* handle = cache->Lookup(key, kDefaultQueryId);
+    if (handle == nullptr) {
+      return 0;
+    }
+    auto* block = static_cast<Block*>(cache->Value(handle));
+    std::unique_ptr<InternalIterator> iter(
+        block->NewIterator(BytewiseComparator(), kIndexBlockKeyValueEncodingFormat));
+    iter->SeekToFirst();
+    const auto result = iter->Valid() ? iter->value()[0] : 0;
+    cache->Release(handle);
+    return result;
+  }
+};
+
+TEST_F(CompressedSecondaryCacheTest, EvictAndPromote) {
+  if (!Snappy_Supported()) {
+    LOG(INFO) << "Skipping test, snappy is not supported";
+    return;
+  }
+
+  const auto block_size = MakeBlock('a')->usable_size();
+  // Primary cache fits only one block.
+  auto primary = NewLRUCache(block_size * 3 / 2, 0);
+  auto cache = NewCompressedSecondaryCache(primary, block_size * 10, 0, nullptr);
+
+  Insert(cache.get(), "a", MakeBlock('a'));
+  ASSERT_EQ(SecondaryUsage(*cache, *primary), 0U);
+
+  // Block a is moved to the secondary tier in compressed form.
+  Insert(cache.get(), "b", MakeBlock('b'));
+  ASSERT_EQ(primary->GetUsage(), block_size);
+  ASSERT_GT(SecondaryUsage(*cache, *primary), 0U);
+  ASSERT_LT(SecondaryUsage(*cache, *primary), block_size / 2);
+
+  // Lookup of block a promotes it back to primary cache, and block b is moved to secondary tier.
+  ASSERT_EQ(Lookup(cache.get(), "a"), 'a');
+  ASSERT_EQ(Lookup(primary.get(), "a"), 'a');
+  ASSERT_EQ(Lookup(primary.get(), "b"), 0);
+  ASSERT_EQ(Lookup(cache.get(), "b"), 'b');
+  ASSERT_EQ(Lookup(cache.get(), "a"), 'a');
+
+  // Erase removes block from both tiers.
+  cache->Erase("a");
+  cache->Erase("b");
+  ASSERT_EQ(Lookup(cache.get(), "a"), 0);
+  ASSERT_EQ(Lookup(cache.get(), "b"), 0);
+  ASSERT_EQ(cache->GetUsage(), 0U);
+}
+
+TEST_F(CompressedSecondaryCacheTest, Evict) {
+  if (!Snappy_Supported()) {
+    LOG(INFO) << "Skipping test, snappy is not supported";
+    return;
+  }
+
+  const auto block_size = MakeBlock('a')->usable_size();
+  auto primary = NewLRUCache(block_size * 3 / 2, 0);
+  auto cache = NewCompressedSecondaryCache(primary, block_size * 10, 0, nullptr);
+  Insert(cache.get(), "a", MakeBlock('a'));
+  Insert(cache.get(), "b", MakeBlock('b'));
+
+  // Compressed blocks are evicted first, then blocks of primary cache. Blocks evicted from primary
+  // cache to release memory are not moved to the secondary tier.
+  const auto secondary = SecondaryUsage(*cache, *primary);
+  ASSERT_GT(secondary, 0U);
+  ASSERT_EQ(cache->Evict(secondary), secondary);
+  ASSERT_EQ(primary->GetUsage(), block_size);
+  ASSERT_EQ(Lookup(cache.get(), "a"), 0);
+  ASSERT_EQ(cache->Evict(cache->GetCapacity()), block_size);
+  ASSERT_EQ(cache->GetUsage(), 0U);
+  ASSERT_EQ(Lookup(cache.get(), "b"), 0);
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
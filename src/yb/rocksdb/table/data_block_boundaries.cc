@@ -0,0 +1,98 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/data_block_boundaries.h"
+
+#include <algorithm>
+
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/status_format.h"
+
+namespace rocksdb {
+
+const char kDataBlockBoundariesPropertyName[] = "rocksdb.data.block.boundaries";
+
+void DataBlockBoundariesBuilder::Add(
+    uint64_t block_offset, const UserBoundaryValueRefs& smallest,
+    const UserBoundaryValueRefs& largest) {
+  DCHECK_EQ(smallest.size(), largest.size());
+  PutVarint64(&buffer_, block_offset);
+  PutVarint32(&buffer_, static_cast<uint32_t>(smallest.size()));
+  for (size_t i = 0; i != smallest.size(); ++i) {
+    DCHECK_EQ(smallest[i].tag, largest[i].tag);
+    PutVarint32(&buffer_, smallest[i].tag);
+    PutLengthPrefixedSlice(&buffer_, smallest[i].value);
+    PutLengthPrefixedSlice(&buffer_, largest[i].value);
+  }
+}
+
+std::string DataBlockBoundariesBuilder::Finish() {
+  std::string result;
+  result.swap(buffer_);
+  return result;
+}
+
+Status DataBlockBoundariesReader::Init(Slice encoded) {
+  entries_.clear();
+  while (!encoded.empty()) {
+    uint64_t block_offset;
+    uint32_t num_values;
+    if (!GetVarint64(&encoded, &block_offset) || !GetVarint32(&encoded, &num_values)) {
+      return STATUS(Corruption, "Bad data block boundaries header");
+    }
+    if (!entries_.empty() && entries_.back().first >= block_offset) {
+      return STATUS_FORMAT(
+          Corruption, "Data block boundaries are not ordered: $0 after $1",
+          block_offset, entries_.back().first);
+    }
+    const auto* values_start = encoded.data();
+    for (uint32_t i = 0; i != num_values; ++i) {
+      uint32_t tag;
+      Slice smallest, largest;
+      if (!GetVarint32(&encoded, &tag) || !GetLengthPrefixedSlice(&encoded, &smallest) ||
+          !GetLengthPrefixedSlice(&encoded, &largest)) {
+        return STATUS_FORMAT(Corruption, "Bad data block boundaries at $0", block_offset);
+      }
+    }
+    entries_.emplace_back(block_offset, Slice(values_start, encoded.data()));
+  }
+  return Status::OK();
+}
+
+bool DataBlockBoundariesReader::Get(
+    uint64_t block_offset, UserBoundaryValueRefs* smallest, UserBoundaryValueRefs* largest) const {
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), block_offset,
+      [](const auto& entry, uint64_t offset) { return entry.first < offset; });
+  if (it == entries_.end() || it->first != block_offset) {
+    return false;
+  }
+  smallest->clear();
+  largest->clear();
+  // Entry was validated by Init, so it is safe to skip error checks here.
+  Slice input = it->second;
+  while (!input.empty()) {
+    UserBoundaryValueRef smallest_value, largest_value;
+    GetVarint32(&input, &smallest_value.tag);
+    GetLengthPrefixedSlice(&input, &smallest_value.value);
+    GetLengthPrefixedSlice(&input, &largest_value.value);
+    largest_value.tag = smallest_value.tag;
+    smallest->push_back(smallest_value);
+    largest->push_back(largest_value);
+  }
+  return true;
+}
+
+} // namespace rocksdb
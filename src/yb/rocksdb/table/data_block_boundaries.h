@@ -0,0 +1,76 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yb/rocksdb/metadata.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace rocksdb {
+
+// Smallest and largest user boundary values of keys stored in each data block of SST file,
+// i.e. block level analogue of FileBoundaryValues. Boundaries are collected by table properties
+// collector and stored as user collected property with kDataBlockBoundariesPropertyName name.
+// Readers could use them to skip data blocks, that cannot contain keys they are interested in.
+//
+// Encoding: sequence of entries, one per data block with known boundaries, ordered by block
+// offset:
+//   block_offset: varint64
+//   num_values: varint32
+//   num_values times: tag: varint32, smallest: length prefixed slice, largest: length prefixed slice
+extern const char kDataBlockBoundariesPropertyName[];
+
+class DataBlockBoundariesBuilder {
+ public:
+  // Adds boundaries of data block with specified offset. Both smallest and largest should contain
+  // the same tags in the same order. Offsets should be added in increasing order.
+  void Add(uint64_t block_offset, const UserBoundaryValueRefs& smallest,
+           const UserBoundaryValueRefs& largest);
+
+  bool empty() const {
+    return buffer_.empty();
+  }
+
+  // Returns encoded boundaries and resets builder.
+  std::string Finish();
+
+ private:
+  std::string buffer_;
+};
+
+class DataBlockBoundariesReader {
+ public:
+  // Parses encoded boundaries. Referenced data should outlive reader.
+  Status Init(Slice encoded);
+
+  bool empty() const {
+    return entries_.empty();
+  }
+
+  // Fills boundaries of data block with specified offset. Returns false when block boundaries are
+  // unknown, i.e. block should not be filtered.
+  bool Get(uint64_t block_offset, UserBoundaryValueRefs* smallest,
+           UserBoundaryValueRefs* largest) const;
+
+ private:
+  // Block offset and encoded values of this block.
+  std::vector<std::pair<uint64_t, Slice>> entries_;
+};
+
+} // namespace rocksdb
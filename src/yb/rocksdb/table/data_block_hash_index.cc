@@ -0,0 +1,130 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/data_block_hash_index.h"
+
+#include <algorithm>
+
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/slice_transform.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
+
+#include "yb/util/cast.h"
+
+namespace rocksdb {
+
+namespace {
+
+inline bool ExtractPrefix(
+    const Slice& internal_key, const SliceTransform* key_transform, Slice* prefix) {
+  if (internal_key.size() < kLastInternalComponentSize) {
+    return false;
+  }
+  *prefix = ExtractUserKey(internal_key);
+  if (key_transform != nullptr) {
+    if (!key_transform->InDomain(*prefix)) {
+      return false;
+    }
+    *prefix = key_transform->Transform(*prefix);
+  }
+  return true;
+}
+
+inline uint32_t PrefixHash(const Slice& prefix) {
+  return GetSliceHash(prefix);
+}
+
+} // namespace
+
+DataBlockHashIndexBuilder::DataBlockHashIndexBuilder(
+    const SliceTransform* key_transform, double util_ratio)
+    : key_transform_(key_transform), util_ratio_(util_ratio > 0 ? util_ratio : 0.75) {
+}
+
+void DataBlockHashIndexBuilder::Add(
+    const Slice& internal_key, uint32_t restart_index, bool is_restart_key) {
+  if (!valid_) {
+    return;
+  }
+  if (restart_index >= kDataBlockHashIndexMaxRestarts) {
+    valid_ = false;
+    return;
+  }
+  Slice prefix;
+  if (!ExtractPrefix(internal_key, key_transform_, &prefix)) {
+    valid_ = false;
+    return;
+  }
+  if (!entries_.empty() && prefix == Slice(last_prefix_)) {
+    // Only the first key with the same prefix is indexed.
+    return;
+  }
+  last_prefix_.assign(prefix.cdata(), prefix.size());
+  const auto anchor = is_restart_key && restart_index > 0 ? restart_index - 1 : restart_index;
+  entries_.emplace_back(PrefixHash(prefix), static_cast<uint8_t>(anchor));
+}
+
+size_t DataBlockHashIndexBuilder::EstimateSize() const {
+  return static_cast<size_t>(entries_.size() / util_ratio_) + 1 + sizeof(uint32_t);
+}
+
+void DataBlockHashIndexBuilder::Finish(std::string* buffer) {
+  // Odd number of buckets gives better distribution of hashes.
+  const auto num_buckets = std::max<uint32_t>(
+      static_cast<uint32_t>(entries_.size() / util_ratio_), 1) | 1;
+  const auto buckets_offset = buffer->size();
+  buffer->append(num_buckets, static_cast<char>(kDataBlockHashIndexNoEntry));
+  auto* buckets = pointer_cast<uint8_t*>(&(*buffer)[buckets_offset]);
+  for (const auto& entry : entries_) {
+    auto& bucket = buckets[entry.first % num_buckets];
+    if (bucket == kDataBlockHashIndexNoEntry) {
+      bucket = entry.second;
+    } else if (bucket != entry.second) {
+      bucket = kDataBlockHashIndexCollision;
+    }
+  }
+  PutFixed32(buffer, num_buckets);
+}
+
+void DataBlockHashIndexBuilder::Reset() {
+  entries_.clear();
+  last_prefix_.clear();
+  valid_ = true;
+}
+
+bool DataBlockHashIndex::Initialize(
+    const char* data, uint32_t index_end, uint32_t* index_offset) {
+  if (index_end < sizeof(uint32_t)) {
+    return false;
+  }
+  const auto num_buckets = DecodeFixed32(data + index_end - sizeof(uint32_t));
+  if (num_buckets == 0 || num_buckets > index_end - sizeof(uint32_t)) {
+    return false;
+  }
+  *index_offset = index_end - static_cast<uint32_t>(sizeof(uint32_t)) - num_buckets;
+  buckets_ = pointer_cast<const uint8_t*>(data + *index_offset);
+  num_buckets_ = num_buckets;
+  return true;
+}
+
+uint8_t DataBlockHashIndex::Lookup(
+    const Slice& internal_key, const SliceTransform* key_transform) const {
+  Slice prefix;
+  if (!ExtractPrefix(internal_key, key_transform, &prefix)) {
+    return kDataBlockHashIndexNoEntry;
+  }
+  return buckets_[PrefixHash(prefix) % num_buckets_];
+}
+
+}  // namespace rocksdb
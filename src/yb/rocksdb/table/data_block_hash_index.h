@@ -0,0 +1,108 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+class SliceTransform;
+
+// Data block hash index maps hash of the key prefix to the restart interval, where the first key
+// with this prefix is located. Key prefix is obtained by applying key transform to the user key,
+// for DocDB it is the key without HybridTime suffix. Whole user key is used when transform is not
+// specified.
+//
+// The index is stored right after the restart array of the data block:
+//     buckets: uint8[num_buckets]
+//     num_buckets: uint32
+//     num_restarts: uint32
+// The highest bit of num_restarts is set when the block contains the hash index.
+//
+// Each bucket contains the restart index to start seek from, kDataBlockHashIndexNoEntry if there
+// are no keys with prefix hashed to this bucket, or kDataBlockHashIndexCollision if different
+// prefixes are hashed to this bucket.
+//
+// When the first key with prefix is the restart key, the previous restart interval is stored, since
+// seeking to the latest version of the key, or to the key without HybridTime, goes to the previous
+// restart interval in this case.
+//
+// Bucket contents are only a hint, BlockIter verifies that the target is within the restart
+// interval using the adjacent restart keys, so seek result does not depend on the key transform
+// used for reading. But the same transform should be used for writing and reading to get benefit
+// from the index.
+
+constexpr uint32_t kDataBlockHashIndexFlag = 1u << 31;
+constexpr uint8_t kDataBlockHashIndexNoEntry = 255;
+constexpr uint8_t kDataBlockHashIndexCollision = 254;
+// Blocks with larger number of restarts are built without hash index.
+constexpr size_t kDataBlockHashIndexMaxRestarts = 253;
+
+class DataBlockHashIndexBuilder {
+ public:
+  DataBlockHashIndexBuilder(const SliceTransform* key_transform, double util_ratio);
+
+  // Registers internal key that is added to restart interval with specified index.
+  // is_restart_key is true for the first key of restart interval.
+  void Add(const Slice& internal_key, uint32_t restart_index, bool is_restart_key);
+
+  // Returns true if index could be built for the added keys.
+  bool Valid(size_t num_restarts) const {
+    return valid_ && num_restarts <= kDataBlockHashIndexMaxRestarts && !entries_.empty();
+  }
+
+  // Returns estimated size of the index.
+  size_t EstimateSize() const;
+
+  // Appends buckets and num_buckets to buffer.
+  void Finish(std::string* buffer);
+
+  void Reset();
+
+ private:
+  const SliceTransform* const key_transform_;
+  const double util_ratio_;
+
+  // Pairs of prefix hash and restart index.
+  std::vector<std::pair<uint32_t, uint8_t>> entries_;
+  std::string last_prefix_;
+  bool valid_ = true;
+};
+
+class DataBlockHashIndex {
+ public:
+  // Initializes index from block data. index_end is offset of the num_restarts field.
+  // On success sets *index_offset to the offset of the first bucket, i.e. the end of restart
+  // array. Returns false if the block is corrupted.
+  bool Initialize(const char* data, uint32_t index_end, uint32_t* index_offset);
+
+  bool valid() const { return num_buckets_ != 0; }
+
+  // Returns restart index for specified internal key, or kDataBlockHashIndexNoEntry/
+  // kDataBlockHashIndexCollision if the restart index is unknown.
+  uint8_t Lookup(const Slice& internal_key, const SliceTransform* key_transform) const;
+
+  size_t size() const { return num_buckets_ + sizeof(uint32_t); }
+
+ private:
+  const uint8_t* buckets_ = nullptr;
+  uint32_t num_buckets_ = 0;
+};
+
+}  // namespace rocksdb
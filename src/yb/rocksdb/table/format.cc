@@ -487,6 +487,66 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   return status;
 }
 
+void ReadBlockContentsBatch(RandomAccessFileReader* file, const Footer& footer,
+                            const ReadOptions& options, const std::vector<BlockHandle>& handles,
+                            std::vector<BlockContents>* contents, std::vector<Status>* statuses,
+                            const yb::MemTrackerPtr& mem_tracker, bool decompression_requested) {
+  const auto count = handles.size();
+  contents->clear();
+  contents->resize(count);
+  statuses->assign(count, Status::OK());
+
+  std::vector<std::unique_ptr<char[]>> buffers(count);
+  std::vector<yb::RandomAccessFile::ReadRequest> requests(count);
+  for (size_t i = 0; i != count; ++i) {
+    const auto expected_read_size = static_cast<size_t>(handles[i].size()) + kBlockTrailerSize;
+    buffers[i].reset(new char[expected_read_size]);
+    auto& request = requests[i];
+    request.offset = handles[i].offset();
+    request.n = expected_read_size;
+    request.scratch = reinterpret_cast<uint8_t*>(buffers[i].get());
+  }
+
+  {
+    PERF_TIMER_GUARD(block_read_time);
+    file->MultiRead(requests.data(), count);
+  }
+  PERF_COUNTER_ADD(block_read_count, count);
+
+  for (size_t i = 0; i != count; ++i) {
+    const auto& handle = handles[i];
+    const auto& request = requests[i];
+    auto& status = (*statuses)[i];
+    const auto n = static_cast<size_t>(handle.size());
+    PERF_COUNTER_ADD(block_read_byte, request.n);
+
+    status = request.status;
+    if (status.ok() && request.result.size() != request.n) {
+      status = STATUS_FORMAT(
+          Corruption, "Truncated block read in file: $0, block handle: $1, expected size: $2",
+          file->file()->filename(), handle.ToDebugString(), request.n);
+    }
+    if (status.ok() && options.verify_checksums) {
+      status = VerifyBlockChecksum(file, footer, handle, request.result.cdata(), n);
+    }
+    if (!status.ok()) {
+      continue;
+    }
+
+    const char* data = request.result.cdata();
+    auto compression_type = static_cast<rocksdb::CompressionType>(data[n]);
+    if (decompression_requested && compression_type != kNoCompression) {
+      PERF_TIMER_GUARD(block_decompress_time);
+      status = UncompressBlockContents(data, n, &(*contents)[i], footer.version(), mem_tracker);
+    } else if (data != buffers[i].get()) {
+      (*contents)[i] = BlockContents(Slice(data, n), false, compression_type);
+    } else {
+      (*contents)[i] = BlockContents(
+          std::move(buffers[i]), n, true, compression_type, mem_tracker);
+    }
+  }
+}
+
 //
 // The 'data' points to the raw block contents that was read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -564,6 +624,7 @@ Status UncompressBlockContents(const char* data, size_t n,
       *contents =
           BlockContents(std::move(ubuf), decompress_size, true, kNoCompression, mem_tracker);
       break;
+    case kZSTD:
     case kZSTDNotFinalCompression:
       ubuf =
           std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size));
@@ -578,6 +639,7 @@ Status UncompressBlockContents(const char* data, size_t n,
     default:
       return STATUS(Corruption, "bad block type");
   }
+  contents->disk_compression_type = static_cast<CompressionType>(data[n]);
   return Status::OK();
 }
 
@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 #include "yb/util/slice.h"
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/options.h"
@@ -232,6 +233,8 @@ struct BlockContents {
   bool cachable;        // True iff data can be cached
   CompressionType compression_type;
   TrackedAllocation allocation;
+  // Compression type of the block in the file, preserved when contents are uncompressed.
+  CompressionType disk_compression_type = kNoCompression;
 
   BlockContents() : cachable(false), compression_type(kNoCompression) {}
 
@@ -257,6 +260,18 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
                                 bool do_uncompress);
 
+// Reads blocks identified by "handles" from "file" with a single batch of reads, see
+// RandomAccessFile::MultiRead. Result and status of reading i-th block are stored in
+// (*contents)[i] and (*statuses)[i].
+extern void ReadBlockContentsBatch(RandomAccessFileReader* file,
+                                   const Footer& footer,
+                                   const ReadOptions& options,
+                                   const std::vector<BlockHandle>& handles,
+                                   std::vector<BlockContents>* contents,
+                                   std::vector<Status>* statuses,
+                                   const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                   bool do_uncompress);
+
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
 // contents are uncompresed into this buffer. This buffer is
@@ -44,6 +44,10 @@ Result<std::string> BinarySearchIndexReader::GetMiddleKey() const {
   return index_block_->GetMiddleKey(kIndexBlockKeyValueEncodingFormat);
 }
 
+Result<std::vector<std::string>> BinarySearchIndexReader::GetSampleKeys(size_t max_keys) const {
+  return index_block_->GetSampleKeys(max_keys, kIndexBlockKeyValueEncodingFormat);
+}
+
 Status HashIndexReader::Create(const SliceTransform* hash_key_extractor,
                        const Footer& footer, RandomAccessFileReader* file,
                        Env* env, const ComparatorPtr& comparator,
@@ -133,6 +137,10 @@ Result<std::string> HashIndexReader::GetMiddleKey() const {
   return index_block_->GetMiddleKey(kIndexBlockKeyValueEncodingFormat);
 }
 
+Result<std::vector<std::string>> HashIndexReader::GetSampleKeys(size_t max_keys) const {
+  return index_block_->GetSampleKeys(max_keys, kIndexBlockKeyValueEncodingFormat);
+}
+
 class MultiLevelIterator : public InternalIterator {
  public:
   static constexpr auto kIterChainInitialCapacity = 4;
@@ -322,4 +330,8 @@ Result<std::string> MultiLevelIndexReader::GetMiddleKey() const {
   return middle_key;
 }
 
+Result<std::vector<std::string>> MultiLevelIndexReader::GetSampleKeys(size_t max_keys) const {
+  return top_level_index_block_->GetSampleKeys(max_keys, kIndexBlockKeyValueEncodingFormat);
+}
+
 } // namespace rocksdb
@@ -61,6 +61,11 @@ class IndexReader {
   // written into the index (see ShortenedIndexBuilder).
   virtual Result<std::string> GetMiddleKey() const = 0;
 
+  // Returns up to max_keys keys from the index, evenly distributed over the key range of the SST
+  // file. The same as for GetMiddleKey, returned keys might not match any key written to SST file.
+  // For multi-level index only top level is sampled, so fewer keys could be returned.
+  virtual Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) const = 0;
+
   // The size of the index.
   virtual size_t size() const = 0;
   // Memory usage of the index block
@@ -113,6 +118,8 @@ class BinarySearchIndexReader : public IndexReader {
 
   Result<std::string> GetMiddleKey() const override;
 
+  Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) const override;
+
  private:
   BinarySearchIndexReader(const ComparatorPtr& comparator,
                           std::unique_ptr<Block>&& index_block)
@@ -159,6 +166,8 @@ class HashIndexReader : public IndexReader {
 
   Result<std::string> GetMiddleKey() const override;
 
+  Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) const override;
+
  private:
   HashIndexReader(const ComparatorPtr& comparator, std::unique_ptr<Block>&& index_block)
       : IndexReader(comparator), index_block_(std::move(index_block)) {
@@ -200,6 +209,8 @@ class MultiLevelIndexReader : public IndexReader {
 
   Result<std::string> GetMiddleKey() const override;
 
+  Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) const override;
+
   uint32_t TEST_GetNumLevels() const {
     return num_levels_;
   }
@@ -137,7 +137,7 @@ Slice PropertyBlockBuilder::Finish() {
 
 void LogPropertiesCollectionError(
     Logger* info_log, const std::string& method, const std::string& name) {
-  assert(method == "Add" || method == "Finish");
+  assert(method == "Add" || method == "DataBlockFinished" || method == "Finish");
 
   std::string msg =
     "Encountered error when calling TablePropertiesCollector::" +
@@ -161,6 +161,22 @@ bool NotifyCollectTableCollectorsOnAdd(
   return all_succeeded;
 }
 
+bool NotifyCollectTableCollectorsOnDataBlockFinished(
+    uint64_t block_offset,
+    const std::vector<std::unique_ptr<IntTblPropCollector>>& collectors,
+    Logger* info_log) {
+  bool all_succeeded = true;
+  for (auto& collector : collectors) {
+    Status s = collector->DataBlockFinished(block_offset);
+    all_succeeded = all_succeeded && s.ok();
+    if (!s.ok()) {
+      LogPropertiesCollectionError(info_log, "DataBlockFinished" /* method */,
+                                   collector->Name());
+    }
+  }
+  return all_succeeded;
+}
+
 bool NotifyCollectTableCollectorsOnFinish(
     const std::vector<std::unique_ptr<IntTblPropCollector>>& collectors,
     Logger* info_log, PropertyBlockBuilder* builder) {
@@ -104,6 +104,13 @@ bool NotifyCollectTableCollectorsOnAdd(
     const std::vector<std::unique_ptr<IntTblPropCollector>>& collectors,
     Logger* info_log);
 
+// NotifyCollectTableCollectorsOnDataBlockFinished() triggers the `DataBlockFinished` event for
+// all property collectors.
+bool NotifyCollectTableCollectorsOnDataBlockFinished(
+    uint64_t block_offset,
+    const std::vector<std::unique_ptr<IntTblPropCollector>>& collectors,
+    Logger* info_log);
+
 // NotifyCollectTableCollectorsOnAdd() triggers the `Finish` event for all
 // property collectors. The collected properties will be added to `builder`.
 bool NotifyCollectTableCollectorsOnFinish(
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "yb/rocksdb/status.h"
 
@@ -113,6 +114,13 @@ class TableReader {
     return Status::OK();
   }
 
+  // Loads data blocks, that could contain specified internal keys, into block cache. Keys should
+  // be sorted. Default implementation does nothing.
+  virtual Status PrefetchDataBlocks(
+      const ReadOptions& read_options, const std::vector<Slice>& internal_keys) {
+    return Status::OK();
+  }
+
   // convert db file to a human readable form
   virtual Status DumpTable(WritableFile* out_file) {
     return STATUS(NotSupported, "DumpTable() not supported");
@@ -123,6 +131,12 @@ class TableReader {
   virtual yb::Result<std::string> GetMiddleKey() {
     return STATUS(NotSupported, "GetMiddleKey() not supported");
   }
+
+  // Returns up to max_keys internal keys, that split SST file into parts of approximately the same
+  // size. Keys are not necessary present in the file.
+  virtual yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) {
+    return STATUS(NotSupported, "GetSampleKeys() not supported");
+  }
 };
 
 }  // namespace rocksdb
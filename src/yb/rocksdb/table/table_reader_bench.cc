@@ -280,6 +280,11 @@ DEFINE_UNKNOWN_string(table_factory, "block_based",
 DEFINE_UNKNOWN_string(time_unit, "microsecond",
               "The time unit used for measuring performance. User can specify "
               "`microsecond` (default) or `nanosecond`");
+DEFINE_NON_RUNTIME_bool(data_block_hash_index, false,
+                        "Build hash index in data blocks of block based table.");
+DEFINE_NON_RUNTIME_double(data_block_hash_table_util_ratio, 0.75,
+                          "Ratio of the number of keys to the number of data block hash index "
+                          "buckets.");
 
 int main(int argc, char** argv) {
   SetUsageMessage(std::string("\nUSAGE:\n") + std::string(argv[0]) +
@@ -310,7 +315,10 @@ int main(int argc, char** argv) {
     options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(
         FLAGS_prefix_len));
   } else if (FLAGS_table_factory == "block_based") {
-    tf.reset(new rocksdb::BlockBasedTableFactory());
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.data_block_hash_index = FLAGS_data_block_hash_index;
+    table_options.data_block_hash_table_util_ratio = FLAGS_data_block_hash_table_util_ratio;
+    tf.reset(new rocksdb::BlockBasedTableFactory(table_options));
   } else {
     fprintf(stderr, "Invalid table type %s\n", FLAGS_table_factory.c_str());
   }
@@ -148,6 +148,13 @@ class TablePropertiesCollector {
     return Add(key, value);
   }
 
+  // DataBlockFinished() will be called when a data block, containing all keys added since the
+  // previous call, has been written to the file.
+  // @params block_offset  the offset of the block in the data file.
+  virtual Status DataBlockFinished(uint64_t /*block_offset*/) {
+    return Status::OK();
+  }
+
   // Finish() will be called when a table has already been built and is ready
   // for writing the properties block.
   // @params properties  User will add their collected statistics to
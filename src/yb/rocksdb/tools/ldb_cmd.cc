@@ -318,7 +318,7 @@ Options LDBCommand::PrepareOptionsForOpenDB() {
     } else if (comp == "lz4hc") {
       opt.compression = kLZ4HCCompression;
     } else if (comp == "zstd") {
-      opt.compression = kZSTDNotFinalCompression;
+      opt.compression = kZSTD;
     } else {
       // Unknown compression.
       exec_state_ =
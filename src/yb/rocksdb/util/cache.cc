@@ -351,21 +351,35 @@ void LRUSubCache::LRU_Append(LRUHandle *e) {
 
 class LRUHandleDeleter {
  public:
-  explicit LRUHandleDeleter(yb::CacheMetrics* metrics) : metrics_(metrics) {}
+  LRUHandleDeleter(yb::CacheMetrics* metrics, const Cache::EvictionCallback& eviction_callback)
+      : metrics_(metrics), eviction_callback_(eviction_callback) {}
 
   void Add(LRUHandle* handle) {
     handles_.push_back(handle);
   }
 
+  void AddEvicted(LRUHandle* handle) {
+    evicted_handles_.push_back(handle);
+  }
+
   size_t TotalCharge() const {
     size_t result = 0;
     for (LRUHandle* handle : handles_) {
       result += handle->charge;
     }
+    for (LRUHandle* handle : evicted_handles_) {
+      result += handle->charge;
+    }
     return result;
   }
 
   ~LRUHandleDeleter() {
+    for (LRUHandle* handle : evicted_handles_) {
+      if (eviction_callback_) {
+        eviction_callback_(handle->key(), handle->value, handle->deleter);
+      }
+      handle->Free(metrics_);
+    }
     for (LRUHandle* handle : handles_) {
       handle->Free(metrics_);
     }
@@ -373,7 +387,9 @@ class LRUHandleDeleter {
 
  private:
   yb::CacheMetrics* metrics_;
+  const Cache::EvictionCallback& eviction_callback_;
   autovector<LRUHandle*> handles_;
+  autovector<LRUHandle*> evicted_handles_;
 };
 
 // A single shard of sharded cache.
@@ -392,6 +408,10 @@ class LRUCache {
     table_.SetMetrics(metrics);
   }
 
+  void SetEvictionCallback(const Cache::EvictionCallback& callback) {
+    eviction_callback_ = callback;
+  }
+
   // Set the flag to reject insertion if cache if full.
   void SetStrictCapacityLimit(bool strict_capacity_limit);
 
@@ -474,6 +494,9 @@ class LRUCache {
   HandleTable table_;
 
   shared_ptr<yb::CacheMetrics> metrics_;
+
+  // Set before the cache is used, so could be accessed without mutex.
+  Cache::EvictionCallback eviction_callback_;
 };
 
 LRUCache::LRUCache() {}
@@ -551,12 +574,12 @@ void LRUCache::EvictFromLRU(const size_t charge,
     old->in_cache = false;
     Unref(old);
     sub_cache->DecrementUsage(old->charge);
-    deleted->Add(old);
+    deleted->AddEvicted(old);
   }
 }
 
 void LRUCache::SetCapacity(size_t capacity) {
-  LRUHandleDeleter last_reference_list(metrics_.get());
+  LRUHandleDeleter last_reference_list(metrics_.get(), eviction_callback_);
 
   {
     MutexLock l(&mutex_);
@@ -579,6 +602,8 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
+  // Declared before the lock, so evicted entries are deleted after the mutex is released.
+  LRUHandleDeleter multi_touch_eviction_list(metrics_.get(), eviction_callback_);
   MutexLock l(&mutex_);
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
@@ -593,10 +618,7 @@ Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId q
     // Now the handle will be added to the multi touch pool only if it exists.
     if (FLAGS_cache_single_touch_ratio < 1 && e->GetSubCacheType() != MULTI_TOUCH &&
         e->query_id != query_id) {
-      {
-        LRUHandleDeleter multi_touch_eviction_list(metrics_.get());
-        EvictFromLRU(e->charge, &multi_touch_eviction_list, MULTI_TOUCH);
-      }
+      EvictFromLRU(e->charge, &multi_touch_eviction_list, MULTI_TOUCH);
       // Cannot have any single touch elements in this case.
       assert(FLAGS_cache_single_touch_ratio != 0);
       if (!strict_capacity_limit_ ||
@@ -692,7 +714,10 @@ void LRUCache::Release(Cache::Handle* handle) {
 }
 
 size_t LRUCache::Evict(size_t required) {
-  LRUHandleDeleter evicted(metrics_.get());
+  // Memory is released on request of memory manager, so evicted entries should not be moved to
+  // another cache tier.
+  const Cache::EvictionCallback no_eviction_callback;
+  LRUHandleDeleter evicted(metrics_.get(), no_eviction_callback);
   {
     MutexLock l(&mutex_);
     EvictFromLRU(required, &evicted, SINGLE_TOUCH);
@@ -716,7 +741,7 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
   LRUHandle* e = reinterpret_cast<LRUHandle*>(
                     new char[sizeof(LRUHandle) - 1 + key.size()]);
   Status s;
-  LRUHandleDeleter last_reference_list(metrics_.get());
+  LRUHandleDeleter last_reference_list(metrics_.get(), eviction_callback_);
 
   e->value = value;
   e->deleter = deleter;
@@ -1006,6 +1031,13 @@ class ShardedLRUCache : public Cache {
     }
   }
 
+  void SetEvictionCallback(EvictionCallback callback) override {
+    int num_shards = 1 << num_shard_bits_;
+    for (int s = 0; s < num_shards; s++) {
+      shards_[s].SetEvictionCallback(callback);
+    }
+  }
+
   virtual std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
     std::vector<std::pair<size_t, size_t>> cache_sizes;
     cache_sizes.reserve(1 << num_shard_bits_);
@@ -32,6 +32,10 @@ int main() {
 #include <inttypes.h>
 #include <sys/types.h>
 #include <stdio.h>
+
+#include <string>
+#include <vector>
+
 #include "yb/util/flags.h"
 
 #include "yb/rocksdb/db.h"
@@ -49,6 +53,12 @@ DEFINE_UNKNOWN_int32(threads, 16, "Number of concurrent threads to run.");
 DEFINE_UNKNOWN_int64(cache_size, 8 * KB * KB,
              "Number of bytes to use as a cache of uncompressed data.");
 DEFINE_UNKNOWN_int32(num_shard_bits, 4, "shard_bits.");
+DEFINE_UNKNOWN_string(cache_type, "lru",
+             "Cache implementation to benchmark: lru, clock or all to compare them.");
+DEFINE_UNKNOWN_uint64(value_charge, 4 * KB,
+             "Charge of each inserted entry, default is the size of a typical data block.");
+DEFINE_UNKNOWN_uint64(estimated_entry_charge, 4 * KB,
+             "Expected charge of a single entry, used to size the table of clock cache.");
 
 DEFINE_UNKNOWN_int64(max_key, 1 * KB * KB * KB, "Max number of key to place in cache");
 DEFINE_UNKNOWN_uint64(ops_per_thread, 1200000, "Number of operations per thread.");
@@ -144,20 +154,21 @@ struct ThreadState {
 
 class CacheBench {
  public:
-  CacheBench() :
-      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
+  explicit CacheBench(std::shared_ptr<Cache> cache) :
+      cache_(std::move(cache)),
       num_threads_(FLAGS_threads) {}
 
   ~CacheBench() {}
 
   void PopulateCache() {
     Random rnd(1);
-    for (int64_t i = 0; i < FLAGS_cache_size; i++) {
+    const auto num_entries = FLAGS_cache_size / static_cast<int64_t>(FLAGS_value_charge);
+    for (int64_t i = 0; i < num_entries; i++) {
       uint64_t rand_key = rnd.Next() % FLAGS_max_key;
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      cache_->Insert(key, new char[10], FLAGS_value_charge, &deleter);
     }
   }
 
@@ -235,7 +246,7 @@ class CacheBench {
       int32_t prob_op = thread->rnd.Uniform(100);
       if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
+        cache_->Insert(key, new char[10], FLAGS_value_charge, &deleter);
       } else if (prob_op -= FLAGS_insert_percent &&
                  prob_op < FLAGS_lookup_percent) {
         // do lookup
@@ -274,15 +285,31 @@ int main(int argc, char** argv) {
     exit(1);
   }
 
-  rocksdb::CacheBench bench;
-  if (FLAGS_populate_cache) {
-    bench.PopulateCache();
-  }
-  if (bench.Run()) {
-    return 0;
+  std::vector<std::string> cache_types;
+  if (FLAGS_cache_type == "all") {
+    cache_types = {"lru", "clock"};
+  } else if (FLAGS_cache_type == "lru" || FLAGS_cache_type == "clock") {
+    cache_types = {FLAGS_cache_type};
   } else {
-    return 1;
+    fprintf(stderr, "unknown cache type: %s\n", FLAGS_cache_type.c_str());
+    exit(1);
+  }
+
+  for (const auto& cache_type : cache_types) {
+    printf("Cache type          : %s\n", cache_type.c_str());
+    auto cache = cache_type == "clock"
+        ? rocksdb::NewClockCache(
+              FLAGS_cache_size, FLAGS_estimated_entry_charge, FLAGS_num_shard_bits)
+        : rocksdb::NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits);
+    rocksdb::CacheBench bench(std::move(cache));
+    if (FLAGS_populate_cache) {
+      bench.PopulateCache();
+    }
+    if (!bench.Run()) {
+      return 1;
+    }
   }
+  return 0;
 }
 
 #endif  // GFLAGS
@@ -32,6 +32,7 @@
 
 #include "yb/util/string_util.h"
 #include "yb/util/test_macros.h"
+#include "yb/util/test_thread_holder.h"
 #include "yb/rocksdb/util/testutil.h"
 
 using std::shared_ptr;
@@ -745,6 +746,182 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+TEST_F(CacheTest, ClockCacheHitAndMiss) {
+  auto cache = NewClockCache(kCacheSize, 1, kNumShardBits);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+
+  ASSERT_OK(Insert(cache, 100, 101));
+  ASSERT_OK(Insert(cache, 200, 201));
+  ASSERT_EQ(101, Lookup(cache, 100));
+  ASSERT_EQ(201, Lookup(cache, 200));
+  ASSERT_EQ(-1, Lookup(cache, 300));
+
+  ASSERT_OK(Insert(cache, 100, 102));
+  ASSERT_EQ(102, Lookup(cache, 100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(100, deleted_keys_[0]);
+  ASSERT_EQ(101, deleted_values_[0]);
+
+  Erase(cache, 100);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_EQ(201, Lookup(cache, 200));
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(1U, cache->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheEntriesArePinned) {
+  auto cache = NewClockCache(kCacheSize, 1, kNumShardBits);
+  ASSERT_OK(Insert(cache, 100, 101));
+  Cache::Handle* h1 = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(101, DecodeValue(cache->Value(h1)));
+  ASSERT_EQ(1U, cache->GetPinnedUsage());
+
+  ASSERT_OK(Insert(cache, 100, 102));
+  Cache::Handle* h2 = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(102, DecodeValue(cache->Value(h2)));
+  ASSERT_EQ(0U, deleted_keys_.size());
+  ASSERT_EQ(2U, cache->GetUsage());
+  ASSERT_EQ(2U, cache->GetPinnedUsage());
+
+  // Replaced entry is freed by the last release.
+  cache->Release(h1);
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(101, deleted_values_[0]);
+  ASSERT_EQ(1U, cache->GetUsage());
+
+  Erase(cache, 100);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+
+  cache->Release(h2);
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(0U, cache->GetUsage());
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
+TEST_F(CacheTest, ClockCacheEvictionPolicy) {
+  auto cache = NewClockCache(kCacheSize, 1, kNumShardBits);
+  ASSERT_OK(Insert(cache, 100, 101));
+
+  // Frequently used entry must be kept around.
+  for (int i = 0; i < kCacheSize * 2; i++) {
+    ASSERT_OK(Insert(cache, 1000 + i, 2000 + i));
+    ASSERT_EQ(101, Lookup(cache, 100));
+  }
+  ASSERT_EQ(101, Lookup(cache, 100));
+  ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kCacheSize));
+}
+
+// Lookup probes past entries colliding with the looked up key, such entries should not be treated
+// as recently used.
+TEST_F(CacheTest, ClockCacheProbedEntriesNotProtected) {
+  FLAGS_cache_single_touch_ratio = 1;
+  constexpr int kCapacity = 100;
+  auto cache = NewClockCache(kCapacity, 1, 0);
+  for (int i = 0; i < kCapacity; i++) {
+    ASSERT_OK(Insert(cache, i, i));
+  }
+  // Hit the first half of entries.
+  for (int i = 0; i < kCapacity / 2; i++) {
+    ASSERT_EQ(i, Lookup(cache, i));
+  }
+  // Missing keys are spread over the whole table, so their lookups probe past all entries.
+  for (int i = 0; i < kCapacity * 100; i++) {
+    ASSERT_EQ(-1, Lookup(cache, 1000000 + i));
+  }
+
+  // Entries that were not hit should be evicted first.
+  for (int i = 0; i < kCapacity / 2; i++) {
+    ASSERT_OK(Insert(cache, 1000 + i, i));
+  }
+  for (int i = 0; i < kCapacity / 2; i++) {
+    ASSERT_EQ(i, Lookup(cache, i)) << "Hit entry " << i << " was evicted";
+  }
+  ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kCapacity));
+
+  // Returning the flag back.
+  FLAGS_cache_single_touch_ratio = 0.2;
+}
+
+TEST_F(CacheTest, ClockCacheScanResistance) {
+  constexpr int kCapacity = 100;
+  auto cache = NewClockCache(kCapacity, 1, 0);
+  // Entries accessed by two queries are moved to multi-touch sub-cache.
+  for (int i = 0; i < 10; i++) {
+    ASSERT_OK(Insert(cache, i, i));
+    ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, i, i, kTestQueryId + 1));
+  }
+
+  // Long scan should not evict multi-touch entries.
+  for (int i = 0; i < kCapacity * 10; i++) {
+    ASSERT_OK(Insert(cache, 1000 + i, i));
+  }
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(i, Lookup(cache, i));
+  }
+  ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kCapacity));
+}
+
+TEST_F(CacheTest, ClockCacheTableFull) {
+  // Estimated entry charge is much larger than actual, so shard runs out of slots before it
+  // reaches its capacity.
+  auto cache = NewClockCache(kCacheSize, kCacheSize, 0);
+  std::vector<Cache::Handle*> handles;
+  for (int i = 0;; ++i) {
+    Cache::Handle* handle = nullptr;
+    auto status = cache->Insert(
+        EncodeKey(i), kTestQueryId, EncodeValue(i), 1, &CacheTest::Deleter, &handle);
+    if (!status.ok()) {
+      ASSERT_TRUE(status.IsIncomplete());
+      ASSERT_EQ(handle, nullptr);
+      break;
+    }
+    handles.push_back(handle);
+  }
+  ASSERT_EQ(cache->GetPinnedUsage(), handles.size());
+  for (auto* handle : handles) {
+    cache->Release(handle);
+  }
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+
+  // Unreferenced entries are evicted to free slots.
+  for (int i = 0; i < kCacheSize; ++i) {
+    ASSERT_OK(Insert(cache, 10000 + i, i));
+  }
+  ASSERT_EQ(cache->GetUsage(), handles.size());
+}
+
+TEST_F(CacheTest, ClockCacheConcurrent) {
+  constexpr int kCapacity = 1000;
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = kCapacity * 2;
+  constexpr int kOpsPerThread = 100000;
+  auto cache = NewClockCache(kCapacity, 1, 2);
+  yb::TestThreadHolder thread_holder;
+  for (int t = 0; t != kNumThreads; ++t) {
+    thread_holder.AddThreadFunctor([cache, t] {
+      for (int i = 0; i != kOpsPerThread; ++i) {
+        const auto key = EncodeKey((i * 7919 + t) % kNumKeys);
+        auto* handle = cache->Lookup(key, t);
+        if (handle) {
+          ASSERT_EQ(DecodeKey(key), DecodeValue(cache->Value(handle)));
+          cache->Release(handle);
+        } else if (i % 3 == 0) {
+          cache->Erase(key);
+        } else {
+          ASSERT_OK(cache->Insert(
+              key, t, EncodeValue(DecodeKey(key)), 1, [](const Slice&, void*) {}));
+        }
+      }
+    });
+  }
+  thread_holder.JoinAll();
+  ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kCapacity));
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
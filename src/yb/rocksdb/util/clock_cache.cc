@@ -0,0 +1,904 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string.h>
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/util/hash.h"
+#include "yb/rocksdb/util/statistics.h"
+
+#include "yb/gutil/bits.h"
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/cache_metrics.h"
+#include "yb/util/enums.h"
+#include "yb/util/flags.h"
+#include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
+
+DECLARE_double(cache_single_touch_ratio);
+DECLARE_bool(cache_overflow_single_touch);
+
+namespace rocksdb {
+
+namespace {
+
+// CLOCK cache implementation.
+//
+// Each shard keeps entries in a fixed size open addressing table. Lookup and Release do not take
+// any locks, they only update the atomic meta word of the slot. Insert, Erase and eviction are
+// serialized by the shard mutex, but readers are never blocked by them.
+//
+// Meta word of the slot contains:
+// - state, see below.
+// - clock countdown, set to max on each hit and decremented by the clock hand. Unreferenced entry
+//   with zero countdown is evicted.
+// - number of external references, i.e. handles returned by Lookup/Insert and not yet released.
+//
+// Slot states:
+// kEmpty - slot does not contain an entry.
+// kConstruction - slot is exclusively owned by a thread, that fills or frees it.
+// kVisible - slot contains an entry that could be found by Lookup.
+// kInvisible - entry was erased or replaced, but still referenced. It is freed by the thread
+//              that releases the last reference.
+//
+// Lookup acquires a reference only via CAS from kVisible state, so after the reference is
+// acquired the entry could not be freed and its key could be safely compared.
+//
+// Scan resistance is the same as in LRU cache: entry is inserted into the single-touch sub-cache
+// and moved to the multi-touch one, when it is accessed by a different query. Each sub-cache has
+// its own capacity and the clock hand evicts entries of the sub-cache that is over capacity.
+//
+// Each slot also counts entries, that were placed further along the probe sequence passing
+// through this slot. So Lookup stops probing at the first slot with zero counter.
+
+using Meta = uint64_t;
+
+constexpr Meta kRefsMask = (1ULL << 32) - 1;
+constexpr Meta kOneRef = 1;
+constexpr int kClockShift = 32;
+constexpr Meta kClockMask = 3ULL << kClockShift;
+constexpr Meta kMaxClock = 3;
+constexpr int kStateShift = 62;
+
+enum class SlotState : uint64_t {
+  kEmpty = 0,
+  kConstruction = 1,
+  kVisible = 2,
+  kInvisible = 3,
+};
+
+inline SlotState GetState(Meta meta) {
+  return static_cast<SlotState>(meta >> kStateShift);
+}
+
+inline Meta GetRefs(Meta meta) {
+  return meta & kRefsMask;
+}
+
+inline Meta GetClock(Meta meta) {
+  return (meta & kClockMask) >> kClockShift;
+}
+
+inline Meta MakeMeta(SlotState state, Meta clock, Meta refs) {
+  return (static_cast<Meta>(state) << kStateShift) | (clock << kClockShift) | refs;
+}
+
+inline Meta WithState(Meta meta, SlotState state) {
+  return MakeMeta(state, GetClock(meta), GetRefs(meta));
+}
+
+inline Meta WithClock(Meta meta, Meta clock) {
+  return MakeMeta(GetState(meta), clock, GetRefs(meta));
+}
+
+inline SubCacheType SubCacheTypeOf(QueryId query_id) {
+  return query_id == kInMultiTouchId ? MULTI_TOUCH : SINGLE_TOUCH;
+}
+
+// Table is sized so that at most this fraction of slots is occupied, when all entries have
+// estimated charge.
+constexpr double kLoadFactor = 0.7;
+constexpr size_t kMinSlotsPerShard = 16;
+
+struct ClockHandle {
+  std::atomic<Meta> meta{0};
+  // Number of entries that passed this slot while looking for a free slot.
+  std::atomic<uint32_t> displacements{0};
+  uint32_t hash;
+  std::atomic<QueryId> query_id{kDefaultQueryId};
+  size_t charge;
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  std::unique_ptr<char[]> key_data;
+  size_t key_size;
+
+  Slice key() const {
+    return Slice(key_data.get(), key_size);
+  }
+
+  SubCacheType GetSubCacheType() const {
+    return SubCacheTypeOf(query_id.load(std::memory_order_acquire));
+  }
+};
+
+// Entry removed from the table, whose deleter should be invoked after the shard mutex is released.
+struct RemovedEntry {
+  std::unique_ptr<char[]> key_data;
+  size_t key_size;
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  size_t charge;
+  SubCacheType sub_cache_type;
+  // Whether entry was evicted to free space, i.e. was not erased or replaced.
+  bool evicted = false;
+};
+
+class RemovedEntries {
+ public:
+  RemovedEntries(yb::CacheMetrics* metrics, const Cache::EvictionCallback& eviction_callback)
+      : metrics_(metrics), eviction_callback_(eviction_callback) {}
+
+  RemovedEntries(const RemovedEntries&) = delete;
+  void operator=(const RemovedEntries&) = delete;
+
+  ~RemovedEntries() {
+    for (auto& entry : entries_) {
+      const Slice key(entry.key_data.get(), entry.key_size);
+      if (entry.evicted && eviction_callback_) {
+        eviction_callback_(key, entry.value, entry.deleter);
+      }
+      (*entry.deleter)(key, entry.value);
+      if (metrics_) {
+        if (entry.sub_cache_type == MULTI_TOUCH) {
+          metrics_->multi_touch_cache_usage->DecrementBy(entry.charge);
+        } else {
+          metrics_->single_touch_cache_usage->DecrementBy(entry.charge);
+        }
+        metrics_->cache_usage->DecrementBy(entry.charge);
+      }
+    }
+  }
+
+  void Add(RemovedEntry entry) {
+    total_charge_ += entry.charge;
+    entries_.push_back(std::move(entry));
+  }
+
+  size_t TotalCharge() const {
+    return total_charge_;
+  }
+
+  size_t size() const {
+    return entries_.size();
+  }
+
+ private:
+  yb::CacheMetrics* metrics_;
+  const Cache::EvictionCallback& eviction_callback_;
+  std::vector<RemovedEntry> entries_;
+  size_t total_charge_ = 0;
+};
+
+// A single shard of clock cache.
+class ClockCacheShard {
+ public:
+  ClockCacheShard() = default;
+
+  ~ClockCacheShard() {
+    RemovedEntries removed(metrics_.get(), eviction_callback_);
+    for (size_t i = 0; i != num_slots_; ++i) {
+      auto& slot = slots_[i];
+      if (GetState(slot.meta.load(std::memory_order_relaxed)) != SlotState::kEmpty) {
+        removed.Add(TakeEntry(&slot));
+      }
+    }
+  }
+
+  void Init(size_t num_slots, bool strict_capacity_limit) {
+    num_slots_ = num_slots;
+    slots_.reset(new ClockHandle[num_slots]);
+    strict_capacity_limit_ = strict_capacity_limit;
+  }
+
+  void SetMetrics(std::shared_ptr<yb::CacheMetrics> metrics) {
+    metrics_ = std::move(metrics);
+  }
+
+  void SetEvictionCallback(const Cache::EvictionCallback& callback) {
+    eviction_callback_ = callback;
+  }
+
+  void SetCapacity(size_t capacity) {
+    RemovedEntries removed(metrics_.get(), eviction_callback_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    multi_touch_capacity_.store(
+        static_cast<size_t>(round((1 - FLAGS_cache_single_touch_ratio) * capacity)),
+        std::memory_order_relaxed);
+    total_capacity_ = capacity;
+    EvictFromSubCache(0, MULTI_TOUCH, &removed);
+    EvictFromSubCache(0, SINGLE_TOUCH, &removed);
+  }
+
+  Status Insert(const Slice& key, uint32_t hash, QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value), Cache::Handle** handle,
+                Statistics* statistics);
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, QueryId query_id, Statistics* statistics);
+  void Release(Cache::Handle* handle);
+  void Erase(const Slice& key, uint32_t hash);
+  size_t Evict(size_t required);
+
+  size_t GetUsage() const {
+    return usage_[SINGLE_TOUCH].load(std::memory_order_relaxed) +
+           usage_[MULTI_TOUCH].load(std::memory_order_relaxed);
+  }
+
+  size_t GetPinnedUsage() const {
+    return pinned_usage_.load(std::memory_order_relaxed);
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) {
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    if (thread_safe) {
+      lock.lock();
+    }
+    for (size_t i = 0; i != num_slots_; ++i) {
+      auto& slot = slots_[i];
+      if (GetState(slot.meta.load(std::memory_order_acquire)) == SlotState::kVisible) {
+        callback(slot.value, slot.charge);
+      }
+    }
+  }
+
+  std::pair<size_t, size_t> TEST_GetIndividualUsages() {
+    return std::pair<size_t, size_t>(
+        usage_[SINGLE_TOUCH].load(std::memory_order_relaxed),
+        usage_[MULTI_TOUCH].load(std::memory_order_relaxed));
+  }
+
+ private:
+  // Returns index of the i-th slot of the probe sequence for the specified hash.
+  size_t ProbeIndex(uint32_t hash, size_t i) const {
+    // num_slots_ is a power of 2, so odd step visits all slots.
+    const uint64_t mixed = hash * 0x9E3779B97F4A7C15ULL;
+    const size_t start = mixed & (num_slots_ - 1);
+    const size_t step = (mixed >> 32) | 1;
+    return (start + i * step) & (num_slots_ - 1);
+  }
+
+  SubCacheType EffectiveSubCacheType(SubCacheType type) const {
+    if (FLAGS_cache_single_touch_ratio == 0) {
+      return MULTI_TOUCH;
+    } else if (FLAGS_cache_single_touch_ratio == 1) {
+      return SINGLE_TOUCH;
+    }
+    return type;
+  }
+
+  size_t SubCacheUsage(SubCacheType type) const {
+    return usage_[EffectiveSubCacheType(type)].load(std::memory_order_relaxed);
+  }
+
+  size_t GetSubCacheCapacity(SubCacheType type) const REQUIRES(mutex_) {
+    switch (EffectiveSubCacheType(type)) {
+      case SINGLE_TOUCH:
+        if (FLAGS_cache_single_touch_ratio == 1) {
+          return total_capacity_;
+        }
+        if (strict_capacity_limit_ || !FLAGS_cache_overflow_single_touch) {
+          return total_capacity_ - multi_touch_capacity_.load(std::memory_order_relaxed);
+        }
+        return total_capacity_ - std::min(SubCacheUsage(MULTI_TOUCH), total_capacity_);
+      case MULTI_TOUCH:
+        return FLAGS_cache_single_touch_ratio == 0
+            ? total_capacity_ : multi_touch_capacity_.load(std::memory_order_relaxed);
+    }
+    FATAL_INVALID_ENUM_VALUE(SubCacheType, type);
+  }
+
+  // Finds visible entry with the specified key. Could be used only while holding the mutex, since
+  // keys are compared without acquiring a reference.
+  ClockHandle* FindVisible(const Slice& key, uint32_t hash) REQUIRES(mutex_) {
+    for (size_t i = 0; i != num_slots_; ++i) {
+      auto& slot = slots_[ProbeIndex(hash, i)];
+      if (GetState(slot.meta.load(std::memory_order_acquire)) == SlotState::kVisible &&
+          slot.hash == hash && slot.key() == key) {
+        return &slot;
+      }
+      if (slot.displacements.load(std::memory_order_acquire) == 0) {
+        break;
+      }
+    }
+    return nullptr;
+  }
+
+  // Tries to acquire reference to the entry in the slot, returns false if slot does not contain
+  // visible entry. Clock countdown is not touched, since the key of the entry is not checked yet.
+  bool TryRef(ClockHandle* slot) {
+    auto meta = slot->meta.load(std::memory_order_acquire);
+    for (;;) {
+      if (GetState(meta) != SlotState::kVisible) {
+        return false;
+      }
+      if (slot->meta.compare_exchange_weak(meta, meta + kOneRef, std::memory_order_acq_rel)) {
+        if (GetRefs(meta) == 0) {
+          pinned_usage_.fetch_add(slot->charge, std::memory_order_relaxed);
+        }
+        return true;
+      }
+    }
+  }
+
+  // Sets clock countdown of the referenced entry to max, so it survives the next sweeps of the
+  // clock hand.
+  void Touch(ClockHandle* slot) {
+    if (GetClock(slot->meta.load(std::memory_order_relaxed)) != kMaxClock) {
+      // All countdown bits are set in max value, so they could be updated without CAS.
+      static_assert((kMaxClock << kClockShift) == kClockMask, "Max clock should fill its bits");
+      slot->meta.fetch_or(kClockMask, std::memory_order_acq_rel);
+    }
+  }
+
+  // Moves entry out of the slot, that should be exclusively owned by the current thread, and
+  // makes slot available for new entries.
+  RemovedEntry TakeEntry(ClockHandle* slot) {
+    const auto sub_cache_type = EffectiveSubCacheType(slot->GetSubCacheType());
+    RemovedEntry result {
+      .key_data = std::move(slot->key_data),
+      .key_size = slot->key_size,
+      .value = slot->value,
+      .deleter = slot->deleter,
+      .charge = slot->charge,
+      .sub_cache_type = sub_cache_type,
+    };
+    usage_[sub_cache_type].fetch_sub(slot->charge, std::memory_order_relaxed);
+    const auto index = slot - slots_.get();
+    for (size_t i = 0;; ++i) {
+      const auto probe = ProbeIndex(slot->hash, i);
+      if (probe == static_cast<size_t>(index)) {
+        break;
+      }
+      slots_[probe].displacements.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    slot->meta.store(MakeMeta(SlotState::kEmpty, 0, 0), std::memory_order_release);
+    return result;
+  }
+
+  // Makes visible entry invisible, freeing it when there are no references.
+  void MakeInvisible(ClockHandle* slot, RemovedEntries* removed) REQUIRES(mutex_) {
+    auto meta = slot->meta.load(std::memory_order_acquire);
+    for (;;) {
+      DCHECK(GetState(meta) == SlotState::kVisible);
+      const auto new_state =
+          GetRefs(meta) == 0 ? SlotState::kConstruction : SlotState::kInvisible;
+      if (slot->meta.compare_exchange_weak(
+              meta, WithState(meta, new_state), std::memory_order_acq_rel)) {
+        if (new_state == SlotState::kConstruction) {
+          removed->Add(TakeEntry(slot));
+        }
+        return;
+      }
+    }
+  }
+
+  // Moves clock hand evicting unreferenced entries of the specified sub-cache, until its usage
+  // with additional charge fits into its capacity.
+  void EvictFromSubCache(size_t charge, SubCacheType type, RemovedEntries* removed)
+      REQUIRES(mutex_) {
+    const auto capacity = GetSubCacheCapacity(type);
+    DoEvict(removed, [this, charge, type, capacity](SubCacheType slot_type) {
+      if (SubCacheUsage(type) + charge <= capacity) {
+        return std::optional<bool>();
+      }
+      return std::optional<bool>(EffectiveSubCacheType(slot_type) == EffectiveSubCacheType(type));
+    });
+  }
+
+  // Moves clock hand. should_evict returns nullopt when eviction should be stopped, otherwise
+  // whether entry of the specified sub-cache type is candidate for eviction.
+  template <class ShouldEvict>
+  void DoEvict(RemovedEntries* removed, const ShouldEvict& should_evict) REQUIRES(mutex_) {
+    // Each slot is visited at most kMaxClock + 1 times, since its countdown is decremented on each
+    // visit.
+    const size_t max_steps = num_slots_ * (kMaxClock + 1);
+    for (size_t step = 0; step != max_steps; ++step) {
+      auto& slot = slots_[clock_hand_];
+      clock_hand_ = (clock_hand_ + 1) & (num_slots_ - 1);
+      auto meta = slot.meta.load(std::memory_order_acquire);
+      if (GetState(meta) != SlotState::kVisible || GetRefs(meta) != 0) {
+        continue;
+      }
+      auto candidate = should_evict(slot.GetSubCacheType());
+      if (!candidate) {
+        return;
+      }
+      if (!*candidate) {
+        continue;
+      }
+      const auto clock = GetClock(meta);
+      if (clock != 0) {
+        // Failure means that entry was referenced concurrently, so it should not be evicted.
+        slot.meta.compare_exchange_strong(
+            meta, WithClock(meta, clock - 1), std::memory_order_acq_rel);
+        continue;
+      }
+      if (slot.meta.compare_exchange_strong(
+              meta, WithState(meta, SlotState::kConstruction), std::memory_order_acq_rel)) {
+        auto entry = TakeEntry(&slot);
+        entry.evicted = true;
+        removed->Add(std::move(entry));
+      }
+    }
+  }
+
+  // Finds empty slot along the probe sequence of the hash and moves it to construction state.
+  ClockHandle* AcquireEmptySlot(uint32_t hash) REQUIRES(mutex_) {
+    for (size_t i = 0; i != num_slots_; ++i) {
+      auto& slot = slots_[ProbeIndex(hash, i)];
+      auto meta = slot.meta.load(std::memory_order_acquire);
+      if (GetState(meta) == SlotState::kEmpty &&
+          slot.meta.compare_exchange_strong(
+              meta, MakeMeta(SlotState::kConstruction, 0, 0), std::memory_order_acq_rel)) {
+        for (size_t j = 0; j != i; ++j) {
+          slots_[ProbeIndex(hash, j)].displacements.fetch_add(1, std::memory_order_acq_rel);
+        }
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+
+  void RecordLookup(ClockHandle* slot, Statistics* statistics) {
+    if (statistics != nullptr) {
+      if (slot) {
+        RecordTick(statistics, BLOCK_CACHE_HIT);
+        RecordTick(statistics, BLOCK_CACHE_BYTES_READ, slot->charge);
+        if (slot->GetSubCacheType() == SINGLE_TOUCH) {
+          RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_HIT);
+          RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_READ, slot->charge);
+        } else {
+          RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_HIT);
+          RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, slot->charge);
+        }
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MISS);
+      }
+    }
+    if (metrics_ != nullptr) {
+      metrics_->lookups->Increment();
+      if (slot) {
+        metrics_->cache_hits->Increment();
+      } else {
+        metrics_->cache_misses->Increment();
+      }
+    }
+  }
+
+  // Moves referenced single-touch entry to multi-touch sub-cache, if it was accessed by another
+  // query.
+  void MaybePromote(ClockHandle* slot, QueryId query_id) {
+    if (FLAGS_cache_single_touch_ratio == 0 || FLAGS_cache_single_touch_ratio == 1) {
+      return;
+    }
+    auto old_query_id = slot->query_id.load(std::memory_order_acquire);
+    if (old_query_id == kInMultiTouchId || old_query_id == query_id) {
+      return;
+    }
+    // Over capacity of multi-touch cache is resolved by the next insert, except strict capacity
+    // limit mode, where entry is not promoted.
+    if (strict_capacity_limit_ &&
+        usage_[MULTI_TOUCH].load(std::memory_order_relaxed) + slot->charge >
+            multi_touch_capacity_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    if (!slot->query_id.compare_exchange_strong(
+            old_query_id, kInMultiTouchId, std::memory_order_acq_rel)) {
+      return;
+    }
+    usage_[SINGLE_TOUCH].fetch_sub(slot->charge, std::memory_order_relaxed);
+    usage_[MULTI_TOUCH].fetch_add(slot->charge, std::memory_order_relaxed);
+    if (metrics_) {
+      metrics_->multi_touch_cache_usage->IncrementBy(slot->charge);
+      metrics_->single_touch_cache_usage->DecrementBy(slot->charge);
+    }
+  }
+
+  size_t num_slots_ = 0;
+  std::unique_ptr<ClockHandle[]> slots_;
+  bool strict_capacity_limit_ = false;
+
+  // Protects total_capacity_, clock_hand_ and serializes changes of slot states, except freeing
+  // of invisible entries by Release.
+  std::mutex mutex_;
+  size_t total_capacity_ GUARDED_BY(mutex_) = 0;
+  // Read without mutex by MaybePromote.
+  std::atomic<size_t> multi_touch_capacity_{0};
+  size_t clock_hand_ GUARDED_BY(mutex_) = 0;
+
+  // Usage of single-touch and multi-touch sub-caches, indexed by SubCacheType.
+  std::atomic<size_t> usage_[2] = {0, 0};
+  std::atomic<size_t> pinned_usage_{0};
+
+  std::shared_ptr<yb::CacheMetrics> metrics_;
+
+  // Set before the cache is used, so could be accessed without mutex.
+  Cache::EvictionCallback eviction_callback_;
+};
+
+Status ClockCacheShard::Insert(
+    const Slice& key, uint32_t hash, QueryId query_id, void* value, size_t charge,
+    void (*deleter)(const Slice& key, void* value), Cache::Handle** handle,
+    Statistics* statistics) {
+  std::unique_ptr<char[]> key_data(new char[key.size()]);
+  memcpy(key_data.get(), key.data(), key.size());
+
+  RemovedEntries removed(metrics_.get(), eviction_callback_);
+  Status s;
+  SubCacheType sub_cache_type;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto* old = FindVisible(key, hash);
+    if (FLAGS_cache_single_touch_ratio == 0) {
+      query_id = kInMultiTouchId;
+    } else if (FLAGS_cache_single_touch_ratio != 1 && old != nullptr &&
+               (old->GetSubCacheType() == MULTI_TOUCH ||
+                old->query_id.load(std::memory_order_acquire) != query_id)) {
+      query_id = kInMultiTouchId;
+    }
+    sub_cache_type = EffectiveSubCacheType(SubCacheTypeOf(query_id));
+
+    EvictFromSubCache(charge, sub_cache_type, &removed);
+    ClockHandle* slot = nullptr;
+    if (strict_capacity_limit_ &&
+        SubCacheUsage(sub_cache_type) + charge > GetSubCacheCapacity(sub_cache_type)) {
+      s = STATUS(Incomplete, "Insert failed due to clock cache being full.");
+    } else {
+      slot = AcquireEmptySlot(hash);
+      if (slot == nullptr) {
+        // All slots are occupied, evict any unreferenced entry to get a free slot.
+        DoEvict(&removed, [&removed, initial_size = removed.size()](SubCacheType) {
+          return removed.size() != initial_size ? std::optional<bool>() : std::optional<bool>(true);
+        });
+        slot = AcquireEmptySlot(hash);
+      }
+      if (slot == nullptr) {
+        s = STATUS(Incomplete, "Insert failed due to all clock cache entries being referenced.");
+      }
+    }
+
+    if (slot != nullptr) {
+      // Old entry could be evicted while looking for a free slot.
+      old = FindVisible(key, hash);
+      slot->hash = hash;
+      slot->query_id.store(query_id, std::memory_order_relaxed);
+      slot->charge = charge;
+      slot->value = value;
+      slot->deleter = deleter;
+      slot->key_data = std::move(key_data);
+      slot->key_size = key.size();
+      usage_[sub_cache_type].fetch_add(charge, std::memory_order_relaxed);
+      const Meta refs = handle != nullptr ? 1 : 0;
+      if (refs) {
+        pinned_usage_.fetch_add(charge, std::memory_order_relaxed);
+      }
+      slot->meta.store(MakeMeta(SlotState::kVisible, 1, refs), std::memory_order_release);
+      if (handle != nullptr) {
+        *handle = reinterpret_cast<Cache::Handle*>(slot);
+      }
+      if (old != nullptr) {
+        MakeInvisible(old, &removed);
+      }
+      if (sub_cache_type == MULTI_TOUCH && FLAGS_cache_single_touch_ratio != 0) {
+        // Overflown single touch entries should be evicted when multi touch cache grows.
+        EvictFromSubCache(0, SINGLE_TOUCH, &removed);
+      }
+    }
+  }
+
+  if (!s.ok()) {
+    if (handle == nullptr) {
+      (*deleter)(key, value);
+    } else {
+      *handle = nullptr;
+    }
+  }
+  if (statistics != nullptr) {
+    if (s.ok()) {
+      RecordTick(statistics, BLOCK_CACHE_ADD);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+      if (sub_cache_type == SINGLE_TOUCH) {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_ADD);
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_WRITE, charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_ADD);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, charge);
+      }
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    }
+  }
+  if (metrics_ != nullptr && s.ok()) {
+    if (sub_cache_type == MULTI_TOUCH) {
+      metrics_->multi_touch_cache_usage->IncrementBy(charge);
+    } else {
+      metrics_->single_touch_cache_usage->IncrementBy(charge);
+    }
+    metrics_->cache_usage->IncrementBy(charge);
+  }
+  return s;
+}
+
+Cache::Handle* ClockCacheShard::Lookup(
+    const Slice& key, uint32_t hash, QueryId query_id, Statistics* statistics) {
+  ClockHandle* result = nullptr;
+  for (size_t i = 0; i != num_slots_; ++i) {
+    auto& slot = slots_[ProbeIndex(hash, i)];
+    if (TryRef(&slot)) {
+      if (slot.hash == hash && slot.key() == key) {
+        result = &slot;
+        break;
+      }
+      Release(reinterpret_cast<Cache::Handle*>(&slot));
+    }
+    if (slot.displacements.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+  }
+  if (result) {
+    Touch(result);
+    MaybePromote(result, query_id);
+  }
+  RecordLookup(result, statistics);
+  return reinterpret_cast<Cache::Handle*>(result);
+}
+
+void ClockCacheShard::Release(Cache::Handle* handle) {
+  auto* slot = reinterpret_cast<ClockHandle*>(handle);
+  const auto charge = slot->charge;
+  const auto old_meta = slot->meta.fetch_sub(kOneRef, std::memory_order_acq_rel);
+  DCHECK_GT(GetRefs(old_meta), 0);
+  if (GetRefs(old_meta) != 1) {
+    return;
+  }
+  pinned_usage_.fetch_sub(charge, std::memory_order_relaxed);
+  if (GetState(old_meta) != SlotState::kInvisible) {
+    return;
+  }
+  // Last reference to the erased entry, no other thread could acquire it, since Lookup references
+  // only visible entries.
+  auto meta = old_meta - kOneRef;
+  if (!slot->meta.compare_exchange_strong(
+          meta, WithState(meta, SlotState::kConstruction), std::memory_order_acq_rel)) {
+    return;
+  }
+  RemovedEntries removed(metrics_.get(), eviction_callback_);
+  removed.Add(TakeEntry(slot));
+}
+
+void ClockCacheShard::Erase(const Slice& key, uint32_t hash) {
+  RemovedEntries removed(metrics_.get(), eviction_callback_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto* slot = FindVisible(key, hash);
+  if (slot != nullptr) {
+    MakeInvisible(slot, &removed);
+  }
+}
+
+size_t ClockCacheShard::Evict(size_t required) {
+  // Memory is released on request of memory manager, so evicted entries should not be moved to
+  // another cache tier.
+  const Cache::EvictionCallback no_eviction_callback;
+  RemovedEntries removed(metrics_.get(), no_eviction_callback);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto type : {SINGLE_TOUCH, MULTI_TOUCH}) {
+      DoEvict(&removed, [required, type, &removed](SubCacheType slot_type) {
+        if (removed.TotalCharge() >= required) {
+          return std::optional<bool>();
+        }
+        return std::optional<bool>(slot_type == type);
+      });
+    }
+  }
+  return removed.TotalCharge();
+}
+
+class ShardedClockCache : public Cache {
+ public:
+  ShardedClockCache(
+      size_t capacity, size_t estimated_entry_charge, int num_shard_bits,
+      bool strict_capacity_limit)
+      : num_shard_bits_(num_shard_bits),
+        capacity_(capacity),
+        strict_capacity_limit_(strict_capacity_limit) {
+    const size_t num_shards = 1ULL << num_shard_bits_;
+    shards_ = new ClockCacheShard[num_shards];
+    const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
+    const auto estimated_entries = static_cast<size_t>(
+        per_shard / std::max<size_t>(estimated_entry_charge, 1) / kLoadFactor);
+    const auto num_slots = 1ULL << yb::Bits::Log2Ceiling64(
+        std::max<size_t>(estimated_entries, kMinSlotsPerShard));
+    for (size_t s = 0; s != num_shards; ++s) {
+      shards_[s].Init(num_slots, strict_capacity_limit);
+      shards_[s].SetCapacity(per_shard);
+    }
+  }
+
+  virtual ~ShardedClockCache() {
+    delete[] shards_;
+  }
+
+  void SetCapacity(size_t capacity) override {
+    const size_t num_shards = 1ULL << num_shard_bits_;
+    const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
+    std::lock_guard<std::mutex> lock(capacity_mutex_);
+    for (size_t s = 0; s != num_shards; ++s) {
+      shards_[s].SetCapacity(per_shard);
+    }
+    capacity_ = capacity;
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    if (query_id == kNoCacheQueryId) {
+      return Status::OK();
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Insert(
+        key, hash, query_id, value, charge, deleter, handle, statistics);
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    if (query_id == kNoCacheQueryId) {
+      return nullptr;
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Lookup(key, hash, query_id, statistics);
+  }
+
+  void Release(Handle* handle) override {
+    if (handle == nullptr) {
+      return;
+    }
+    shards_[Shard(reinterpret_cast<ClockHandle*>(handle)->hash)].Release(handle);
+  }
+
+  void Erase(const Slice& key) override {
+    const uint32_t hash = HashSlice(key);
+    shards_[Shard(hash)].Erase(key, hash);
+  }
+
+  void* Value(Handle* handle) override {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+  }
+
+  uint64_t NewId() override {
+    return last_id_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  size_t GetCapacity() const override {
+    return capacity_;
+  }
+
+  bool HasStrictCapacityLimit() const override {
+    return strict_capacity_limit_;
+  }
+
+  size_t GetUsage() const override {
+    size_t usage = 0;
+    for (size_t s = 0; s != 1ULL << num_shard_bits_; ++s) {
+      usage += shards_[s].GetUsage();
+    }
+    return usage;
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return reinterpret_cast<ClockHandle*>(handle)->charge;
+  }
+
+  size_t GetPinnedUsage() const override {
+    size_t usage = 0;
+    for (size_t s = 0; s != 1ULL << num_shard_bits_; ++s) {
+      usage += shards_[s].GetPinnedUsage();
+    }
+    return usage;
+  }
+
+  SubCacheType GetSubCacheType(Handle* handle) const override {
+    return reinterpret_cast<ClockHandle*>(handle)->GetSubCacheType();
+  }
+
+  void DisownData() override {
+    shards_ = nullptr;
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    for (size_t s = 0; s != 1ULL << num_shard_bits_; ++s) {
+      shards_[s].ApplyToAllCacheEntries(callback, thread_safe);
+    }
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    metrics_ = std::make_shared<yb::CacheMetrics>(entity);
+    for (size_t s = 0; s != 1ULL << num_shard_bits_; ++s) {
+      shards_[s].SetMetrics(metrics_);
+    }
+  }
+
+  void SetEvictionCallback(EvictionCallback callback) override {
+    for (size_t s = 0; s != 1ULL << num_shard_bits_; ++s) {
+      shards_[s].SetEvictionCallback(callback);
+    }
+  }
+
+  size_t Evict(size_t bytes_to_evict) override {
+    const size_t num_shards = 1ULL << num_shard_bits_;
+    size_t total_evicted = 0;
+    // Start at random shard.
+    auto index = Shard(yb::RandomUniformInt<uint32_t>());
+    for (size_t i = 0; bytes_to_evict > total_evicted && i != num_shards; ++i) {
+      total_evicted += shards_[index].Evict(bytes_to_evict - total_evicted);
+      index = (index + 1) & (num_shards - 1);
+    }
+    return total_evicted;
+  }
+
+  std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
+    std::vector<std::pair<size_t, size_t>> cache_sizes;
+    cache_sizes.reserve(1ULL << num_shard_bits_);
+    for (size_t s = 0; s != 1ULL << num_shard_bits_; ++s) {
+      cache_sizes.emplace_back(shards_[s].TEST_GetIndividualUsages());
+    }
+    return cache_sizes;
+  }
+
+ private:
+  static uint32_t HashSlice(const Slice& s) {
+    return Hash(s.data(), s.size(), 0);
+  }
+
+  uint32_t Shard(uint32_t hash) const {
+    return num_shard_bits_ > 0 ? hash >> (32 - num_shard_bits_) : 0;
+  }
+
+  ClockCacheShard* shards_;
+  const int num_shard_bits_;
+  std::mutex capacity_mutex_;
+  std::atomic<uint64_t> last_id_{0};
+  size_t capacity_;
+  const bool strict_capacity_limit_;
+  std::shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+} // namespace
+
+std::shared_ptr<Cache> NewClockCache(
+    size_t capacity, size_t estimated_entry_charge, int num_shard_bits,
+    bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(
+      capacity, estimated_entry_charge, num_shard_bits, strict_capacity_limit);
+}
+
+}  // namespace rocksdb
@@ -60,6 +60,7 @@
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/thread_local.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/slice.h"
 #include "yb/util/stats/iostats_context_imp.h"
@@ -77,6 +78,8 @@
 
 #include "yb/util/file_system_posix.h"
 
+DECLARE_int32(o_direct_block_alignment_bytes);
+
 using std::unique_ptr;
 using std::shared_ptr;
 
@@ -134,6 +137,26 @@ void SetFD_CLOEXEC(int fd, const EnvOptions* options) {
   }
 }
 
+// Opens file with O_DIRECT in addition to specified flags. Returns -1 with errno set to EINVAL
+// if file system does not support direct I/O, so caller could fall back to buffered I/O.
+int OpenDirect(const std::string& fname, int flags, mode_t mode) {
+#if defined(__linux__)
+  int fd;
+  do {
+    IOSTATS_TIMER_GUARD(open_nanos);
+    fd = open(fname.c_str(), flags | O_DIRECT, mode);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0 && errno == EINVAL) {
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Direct I/O is not supported for " << fname << ", falling back to buffered I/O";
+  }
+  return fd;
+#else
+  errno = EINVAL;
+  return -1;
+#endif
+}
+
 class PosixFileLock : public FileLock {
  public:
   int fd_;
@@ -601,6 +624,18 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd;
+    if (options.use_direct_reads && !options.use_mmap_reads) {
+      fd = OpenDirect(fname, O_RDONLY, 0);
+      if (fd >= 0) {
+        SetFD_CLOEXEC(fd, &options);
+        *result = std::make_unique<PosixDirectRandomAccessFile>(
+            fname, fd, FLAGS_o_direct_block_alignment_bytes);
+        return s;
+      }
+      if (errno != EINVAL) {
+        return STATUS_IO_ERROR(fname, errno);
+      }
+    }
     {
       IOSTATS_TIMER_GUARD(open_nanos);
       fd = open(fname.c_str(), O_RDONLY);
@@ -635,6 +670,18 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd = -1;
+    if (options.use_direct_writes && !options.use_mmap_writes) {
+      fd = OpenDirect(fname, O_CREAT | O_RDWR | O_TRUNC, 0644);
+      if (fd >= 0) {
+        SetFD_CLOEXEC(fd, &options);
+        *result = std::make_unique<PosixDirectWritableFile>(
+            fname, fd, FLAGS_o_direct_block_alignment_bytes, options);
+        return s;
+      }
+      if (errno != EINVAL) {
+        return STATUS_IO_ERROR(fname, errno);
+      }
+    }
     do {
       IOSTATS_TIMER_GUARD(open_nanos);
       fd = open(fname.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
@@ -44,11 +44,13 @@
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/log_buffer.h"
 #include "yb/rocksdb/util/mutexlock.h"
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 
+#include "yb/util/random_util.h"
 #include "yb/util/string_util.h"
 #include "yb/util/test_util.h"
 
@@ -969,6 +971,60 @@ TEST_F(EnvPosixTest, Preallocation) {
   ASSERT_EQ(last_allocated_block, 7UL);
 }
 
+// Test that file written and read with direct I/O has the same contents as written data.
+TEST_F(EnvPosixTest, DirectIO) {
+  const std::string fname = test::TmpDir() + "/direct_io_testfile";
+  EnvOptions soptions;
+  soptions.use_mmap_writes = false;
+  soptions.use_direct_writes = true;
+  soptions.use_direct_reads = true;
+
+  std::string expected;
+  {
+    unique_ptr<WritableFile> file;
+    ASSERT_OK(env_->NewWritableFile(fname, &file, soptions));
+    if (!file->UseDirectIO()) {
+      file.reset();
+      ASSERT_OK(env_->DeleteFile(fname));
+      GTEST_SKIP() << "Direct I/O is not supported by file system of " << test::TmpDir();
+    }
+    WritableFileWriter writer(std::move(file), soptions);
+    for (size_t size : {1, 4095, 4096, 10000, 65537, 3}) {
+      const auto data = yb::RandomString(size);
+      ASSERT_OK(writer.Append(data));
+      expected += data;
+      if (size == 4096) {
+        // Padded tail should be overwritten by subsequent writes.
+        ASSERT_OK(writer.Flush());
+      }
+    }
+    ASSERT_OK(writer.Sync(false));
+    ASSERT_OK(writer.Close());
+  }
+
+  uint64_t size = 0;
+  ASSERT_OK(env_->GetFileSize(fname, &size));
+  ASSERT_EQ(expected.size(), size);
+
+  unique_ptr<RandomAccessFile> file;
+  ASSERT_OK(env_->NewRandomAccessFile(fname, &file, soptions));
+  std::string scratch(expected.size(), 0);
+  for (size_t offset : {0, 1, 4095, 4096, 12345}) {
+    for (size_t n : {1, 100, 4096, 20000}) {
+      Slice result;
+      ASSERT_OK(file->Read(offset, n, &result, scratch.data()));
+      ASSERT_EQ(expected.substr(offset, n), result.ToBuffer());
+    }
+  }
+
+  // Read past the end of file returns only available data.
+  Slice result;
+  ASSERT_OK(file->Read(expected.size() - 10, 100, &result, scratch.data()));
+  ASSERT_EQ(expected.substr(expected.size() - 10), result.ToBuffer());
+
+  ASSERT_OK(env_->DeleteFile(fname));
+}
+
 // Test that the two ways to get children file attributes (in bulk or
 // individually) behave consistently.
 TEST_F(EnvPosixTest, ConsistentChildrenAttributes) {
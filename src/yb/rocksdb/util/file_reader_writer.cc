@@ -90,6 +90,23 @@ Status RandomAccessFileReader::ReadAndValidate(
   return s;
 }
 
+void RandomAccessFileReader::MultiRead(
+    RandomAccessFile::ReadRequest* requests, size_t count) const {
+  uint64_t elapsed = 0;
+  {
+    StopWatch sw(env_, stats_, hist_type_,
+                 (stats_ != nullptr) ? &elapsed : nullptr);
+    IOSTATS_TIMER_GUARD(read_nanos);
+    file_->MultiRead(requests, count);
+    for (size_t i = 0; i != count; ++i) {
+      IOSTATS_ADD_IF_POSITIVE(bytes_read, requests[i].result.size());
+    }
+  }
+  if (stats_ != nullptr && file_read_hist_ != nullptr) {
+    file_read_hist_->Add(elapsed);
+  }
+}
+
 WritableFileWriter::~WritableFileWriter() {
   WARN_NOT_OK(Close(), "Failed to close file");
 }
@@ -258,7 +275,8 @@ Status WritableFileWriter::Sync(bool use_fsync) {
     return s;
   }
   TEST_KILL_RANDOM("WritableFileWriter::Sync:0", test_kill_odds);
-  if (!direct_io_ && pending_sync_) {
+  // Direct I/O bypasses page cache, but file metadata still has to be synced.
+  if (pending_sync_) {
     s = SyncInternal(use_fsync);
     if (!s.ok()) {
       return s;
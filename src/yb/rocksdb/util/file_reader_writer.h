@@ -117,6 +117,9 @@ class RandomAccessFileReader {
   Status ReadAndValidate(
       uint64_t offset, size_t n, Slice* result, char* scratch, const yb::ReadValidator& validator);
 
+  // Performs a batch of reads, see RandomAccessFile::MultiRead.
+  void MultiRead(RandomAccessFile::ReadRequest* requests, size_t count) const;
+
   RandomAccessFile* file() { return file_.get(); }
 };
 
@@ -38,11 +38,16 @@
 #include <sys/statfs.h>
 #include <sys/syscall.h>
 #endif
+
+#include <algorithm>
+
 #include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/util/aligned_buffer.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/posix_logger.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/cast.h"
 #include "yb/util/file_system_posix.h"
 #include "yb/util/malloc.h"
 #include "yb/util/result.h"
@@ -368,6 +373,242 @@ Status PosixMmapFile::Allocate(uint64_t offset, uint64_t len) {
 }
 #endif
 
+/*
+ * PosixDirectWritableFile
+ *
+ * O_DIRECT based writes, that don't pollute page cache.
+ */
+PosixDirectWritableFile::PosixDirectWritableFile(
+    const std::string& fname, int fd, size_t alignment, const EnvOptions& options)
+    : filename_(fname), fd_(fd), alignment_(alignment) {
+#ifdef ROCKSDB_FALLOCATE_PRESENT
+  allow_fallocate_ = options.allow_fallocate;
+  fallocate_with_keep_size_ = options.fallocate_with_keep_size;
+#endif
+  assert(!options.use_mmap_writes);
+}
+
+PosixDirectWritableFile::~PosixDirectWritableFile() {
+  if (fd_ >= 0) {
+    WARN_NOT_OK(PosixDirectWritableFile::Close(), "Failed to close direct writable file");
+  }
+}
+
+Status PosixDirectWritableFile::SyncSize() {
+  if (synced_size_ == filesize_) {
+    return Status::OK();
+  }
+  if (fdatasync(fd_) < 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  synced_size_ = filesize_;
+  return Status::OK();
+}
+
+Status PosixDirectWritableFile::Append(const Slice& data) {
+  return PositionedAppend(data, filesize_);
+}
+
+Status PosixDirectWritableFile::PositionedAppend(const Slice& data, uint64_t offset) {
+  assert(offset % alignment_ == 0);
+  assert(data.size() % alignment_ == 0);
+  assert(reinterpret_cast<uintptr_t>(data.data()) % alignment_ == 0);
+  const char* src = data.cdata();
+  size_t left = data.size();
+  while (left != 0) {
+    ssize_t done = pwrite(fd_, src, left, static_cast<off_t>(offset));
+    if (done < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    left -= done;
+    src += done;
+    offset += done;
+  }
+  filesize_ = std::max<uint64_t>(filesize_, offset);
+  return Status::OK();
+}
+
+Status PosixDirectWritableFile::Truncate(uint64_t size) {
+  // The last block was written padded with zeros, so cut the file to its actual size.
+  if (ftruncate(fd_, size) != 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  filesize_ = size;
+  return Status::OK();
+}
+
+Status PosixDirectWritableFile::Close() {
+  Status s;
+
+  size_t block_size;
+  size_t last_allocated_block;
+  GetPreallocationStatus(&block_size, &last_allocated_block);
+  if (last_allocated_block > 0) {
+    // Trim the extra space preallocated at the end of the file, see PosixWritableFile::Close.
+    int dummy __attribute__((unused));
+    dummy = ftruncate(fd_, filesize_);
+#ifdef ROCKSDB_FALLOCATE_PRESENT
+    IOSTATS_TIMER_GUARD(allocate_nanos);
+    if (allow_fallocate_) {
+      fallocate(fd_, FALLOC_FL_KEEP_SIZE | FALLOC_FL_PUNCH_HOLE, filesize_,
+                block_size * last_allocated_block - filesize_);
+    }
+#endif
+  }
+
+  // The last block is usually synced before Truncate trims padding, so make sure that synced
+  // file does not keep the padded size after crash.
+  if (synced_size_ != 0) {
+    s = SyncSize();
+  }
+
+  if (close(fd_) < 0 && s.ok()) {
+    s = STATUS_IO_ERROR(filename_, errno);
+  }
+  fd_ = -1;
+  return s;
+}
+
+Status PosixDirectWritableFile::Flush() { return Status::OK(); }
+
+Status PosixDirectWritableFile::Sync() {
+  // Data does not stay in page cache, but file metadata still has to be persisted.
+  if (fdatasync(fd_) < 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  synced_size_ = filesize_;
+  return Status::OK();
+}
+
+Status PosixDirectWritableFile::Fsync() {
+  if (FLAGS_never_fsync) {
+    return Status::OK();
+  }
+  if (fsync(fd_) < 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  synced_size_ = filesize_;
+  return Status::OK();
+}
+
+uint64_t PosixDirectWritableFile::GetFileSize() { return filesize_; }
+
+#ifdef ROCKSDB_FALLOCATE_PRESENT
+Status PosixDirectWritableFile::Allocate(uint64_t offset, uint64_t len) {
+  TEST_KILL_RANDOM("PosixDirectWritableFile::Allocate:0", test_kill_odds);
+  IOSTATS_TIMER_GUARD(allocate_nanos);
+  if (allow_fallocate_ &&
+      fallocate(fd_, fallocate_with_keep_size_ ? FALLOC_FL_KEEP_SIZE : 0,
+                static_cast<off_t>(offset), static_cast<off_t>(len)) != 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  return Status::OK();
+}
+
+size_t PosixDirectWritableFile::GetUniqueId(char* id) const {
+  return yb::GetUniqueIdFromFile(fd_, pointer_cast<uint8_t*>(id));
+}
+#endif
+
+/*
+ * PosixDirectRandomAccessFile
+ *
+ * O_DIRECT based random access reads.
+ */
+PosixDirectRandomAccessFile::PosixDirectRandomAccessFile(
+    const std::string& fname, int fd, size_t alignment)
+    : filename_(fname), fd_(fd), alignment_(alignment) {
+}
+
+PosixDirectRandomAccessFile::~PosixDirectRandomAccessFile() {
+  close(fd_);
+}
+
+namespace {
+
+// Returns aligned buffer of at least the specified size, owned by the current thread.
+// Direct reads are done by a few flush and compaction threads, so each of them keeps its buffer
+// between reads instead of allocating a new one for every block or readahead read.
+AlignedBuffer& ThreadLocalDirectReadBuffer(size_t alignment, size_t size) {
+  static thread_local AlignedBuffer buffer;
+  if (buffer.Alignment() != alignment || buffer.Capacity() < size) {
+    buffer.Alignment(alignment);
+    buffer.AllocateNewBuffer(size);
+  }
+  return buffer;
+}
+
+} // namespace
+
+Status PosixDirectRandomAccessFile::Read(
+    uint64_t offset, size_t n, Slice* result, uint8_t* scratch) const {
+  const uint64_t aligned_offset = TruncateToPageBoundary(alignment_, offset);
+  const size_t prefix = offset - aligned_offset;
+  const size_t aligned_size = Roundup(prefix + n, alignment_);
+
+  auto& buffer = ThreadLocalDirectReadBuffer(alignment_, aligned_size);
+
+  char* ptr = buffer.Destination();
+  size_t left = aligned_size;
+  uint64_t read_offset = aligned_offset;
+  while (left > 0) {
+    ssize_t r = pread(fd_, ptr, left, static_cast<off_t>(read_offset));
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      *result = Slice();
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    if (r == 0) {
+      // End of file.
+      break;
+    }
+    ptr += r;
+    read_offset += r;
+    left -= r;
+    if (r % alignment_ != 0) {
+      // Partial block could only be read at the end of file.
+      break;
+    }
+  }
+
+  const size_t read = aligned_size - left;
+  const size_t size = read > prefix ? std::min(read - prefix, n) : 0;
+  memcpy(scratch, buffer.BufferStart() + prefix, size);
+  *result = Slice(scratch, size);
+  return Status::OK();
+}
+
+yb::Result<uint64_t> PosixDirectRandomAccessFile::Size() const {
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  return st.st_size;
+}
+
+yb::Result<uint64_t> PosixDirectRandomAccessFile::INode() const {
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  return st.st_ino;
+}
+
+size_t PosixDirectRandomAccessFile::memory_footprint() const {
+  return malloc_usable_size(this) + filename_.capacity();
+}
+
+#ifdef __linux__
+size_t PosixDirectRandomAccessFile::GetUniqueId(char* id) const {
+  return yb::GetUniqueIdFromFile(fd_, pointer_cast<uint8_t*>(id));
+}
+#endif
+
 PosixDirectory::~PosixDirectory() { close(fd_); }
 
 Status PosixDirectory::Fsync() {
@@ -108,6 +108,71 @@ class PosixMmapFile : public WritableFile {
 #endif
 };
 
+// Writable file opened with O_DIRECT, so written data bypasses the page cache.
+// WritableFileWriter uses aligned buffer and positional writes for such file, since
+// UseOSBuffer() returns false. Tail of the file is written padded to alignment, so actual size
+// is restored by Truncate.
+class PosixDirectWritableFile : public WritableFile {
+ public:
+  PosixDirectWritableFile(const std::string& fname, int fd, size_t alignment,
+                          const EnvOptions& options);
+  ~PosixDirectWritableFile();
+
+  bool UseOSBuffer() const override { return false; }
+  size_t GetRequiredBufferAlignment() const override { return alignment_; }
+  bool UseDirectIO() const override { return true; }
+
+  Status Append(const Slice& data) override;
+  Status PositionedAppend(const Slice& data, uint64_t offset) override;
+  Status Truncate(uint64_t size) override;
+  Status Close() override;
+  Status Flush() override;
+  Status Sync() override;
+  Status Fsync() override;
+  bool IsSyncThreadSafe() const override { return true; }
+  uint64_t GetFileSize() override;
+#ifdef ROCKSDB_FALLOCATE_PRESENT
+  Status Allocate(uint64_t offset, uint64_t len) override;
+  size_t GetUniqueId(char* id) const override;
+#endif
+
+ private:
+  // Syncs file if its size was changed since the last sync.
+  Status SyncSize();
+
+  const std::string filename_;
+  int fd_;
+  const size_t alignment_;
+  uint64_t filesize_ = 0;
+  uint64_t synced_size_ = 0;
+#ifdef ROCKSDB_FALLOCATE_PRESENT
+  bool allow_fallocate_;
+  bool fallocate_with_keep_size_;
+#endif
+};
+
+// Random access file opened with O_DIRECT. Reads are performed into aligned buffer that covers
+// requested range, then copied to scratch.
+class PosixDirectRandomAccessFile : public RandomAccessFile {
+ public:
+  PosixDirectRandomAccessFile(const std::string& fname, int fd, size_t alignment);
+  ~PosixDirectRandomAccessFile();
+
+  Status Read(uint64_t offset, size_t n, Slice* result, uint8_t* scratch) const override;
+  yb::Result<uint64_t> Size() const override;
+  yb::Result<uint64_t> INode() const override;
+  size_t memory_footprint() const override;
+  const std::string& filename() const override { return filename_; }
+#ifdef __linux__
+  size_t GetUniqueId(char* id) const override;
+#endif
+
+ private:
+  const std::string filename_;
+  const int fd_;
+  const size_t alignment_;
+};
+
 class PosixDirectory : public Directory {
  public:
   explicit PosixDirectory(int fd) : fd_(fd) {}
@@ -96,6 +96,7 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       block_based_table_mem_tracker(options.block_based_table_mem_tracker),
       iterator_replacer(options.iterator_replacer),
       compaction_file_filter_factory(options.compaction_file_filter_factory.get()),
+      compaction_output_path_selector(options.compaction_output_path_selector.get()),
       priority_thread_pool_metrics(options.priority_thread_pool_metrics) {}
 
 ColumnFamilyOptions::ColumnFamilyOptions()
@@ -376,6 +377,8 @@ void DBOptions::Dump(Logger* log) const {
       "               Options.compaction_readahead_size: %" ROCKSDB_PRIszt
          "d",
          compaction_readahead_size);
+  RHEADER(log, "  Options.use_direct_io_for_flush_and_compaction: %d",
+      use_direct_io_for_flush_and_compaction);
   RHEADER(
       log,
       "               Options.random_access_max_buffer_size: %" ROCKSDB_PRIszt
@@ -221,6 +221,9 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
     {"compaction_readahead_size",
      {offsetof(struct DBOptions, compaction_readahead_size), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"use_direct_io_for_flush_and_compaction",
+     {offsetof(struct DBOptions, use_direct_io_for_flush_and_compaction),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
     {"random_access_max_buffer_size",
      {offsetof(struct DBOptions, random_access_max_buffer_size),
       OptionType::kSizeT, OptionVerificationType::kNormal}},
@@ -549,6 +552,12 @@ static std::unordered_map<std::string,
     {"index_block_size",
      {offsetof(struct BlockBasedTableOptions, index_block_size), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"data_block_hash_index",
+     {offsetof(struct BlockBasedTableOptions, data_block_hash_index),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"data_block_hash_table_util_ratio",
+     {offsetof(struct BlockBasedTableOptions, data_block_hash_table_util_ratio),
+      OptionType::kDouble, OptionVerificationType::kNormal}},
     {"min_keys_per_index_block",
      {offsetof(struct BlockBasedTableOptions, min_keys_per_index_block), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
@@ -599,6 +608,7 @@ static std::unordered_map<std::string, CompressionType>
         {"kBZip2Compression", kBZip2Compression},
         {"kLZ4Compression", kLZ4Compression},
         {"kLZ4HCCompression", kLZ4HCCompression},
+        {"kZSTD", kZSTD},
         {"kZSTDNotFinalCompression", kZSTDNotFinalCompression}};
 
 static std::unordered_map<std::string, IndexType>
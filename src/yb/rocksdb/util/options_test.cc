@@ -1602,7 +1602,8 @@ Status GetFromString(BlockBasedTableOptions* source, BlockBasedTableOptions* des
       "index_block_restart_interval=4;index_block_size=16384;min_keys_per_index_block=16;"
       "filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
       "skip_table_builder_flush=1;format_version=1;"
-      "hash_index_allow_collision=false;";
+      "hash_index_allow_collision=false;data_block_hash_index=1;"
+      "data_block_hash_table_util_ratio=0.5;";
 
   RETURN_NOT_OK(GetBlockBasedTableOptionsFromString(*source, kOptionsString, destination));
 
@@ -1636,6 +1637,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "use_adaptive_mutex=true;"
       "max_total_wal_size=4295005604;"
       "compaction_readahead_size=0;"
+      "use_direct_io_for_flush_and_compaction=false;"
       "new_table_reader_for_compaction_inputs=true;"
       "keep_log_file_num=4890;"
       "skip_stats_update_on_db_open=true;"
@@ -1873,6 +1875,7 @@ TEST_F(OptionsParserTest, BlockBasedTableOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache_compressed),
       BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_key_value_encoding_format),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_hash_index_key_transform),
       BLACKLIST_ENTRY(BlockBasedTableOptions, filter_policy),
       BLACKLIST_ENTRY(BlockBasedTableOptions, supported_filter_policies),
   };
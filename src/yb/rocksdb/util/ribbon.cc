@@ -0,0 +1,345 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "yb/rocksdb/filter_policy.h"
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/cast.h"
+#include "yb/util/hash_util.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Ribbon filter (https://arxiv.org/abs/2103.02515) represents set of keys as a solution of the
+// linear system over GF(2). Each key is mapped to the equation with 128 coefficients starting at
+// some slot, and r-bit result. Querying a key computes the left part of its equation using the
+// stored solution, so key that was not added matches with probability 2^-r.
+//
+// Compared to the Bloom filter with the same false positive rate, it requires r / load_factor
+// bits per key instead of r * 1.44 bits per key, i.e. ~25% less space for r = 7 (false positive
+// rate 0.8%) that is used for the default 1% target rate. Building filter is more expensive,
+// because all key hashes should be buffered and the system solved at the end.
+//
+// The solution is stored column-wise, each of r columns contains one bit for each slot:
+// +------------------------------------------------------------------------------------+
+// | column 0 : num_slots / 8 bytes                                                     |
+// | ...                                                                                |
+// | column r - 1 : num_slots / 8 bytes                                                 |
+// +------------------------------------------------------------------------------------+
+// | num_slots : 4 bytes | result_bits : 1 byte | seed : 1 byte | format_version : 1 byte |
+// +------------------------------------------------------------------------------------+
+// Empty filter has num_slots equal to 0, and does not match any key. Filter with result_bits
+// equal to 0 matches all keys, it is built when no seed allows to solve the system.
+using RibbonCoeffRow = unsigned __int128;
+
+constexpr size_t kRibbonCoeffBits = 128;
+// Fraction of slots that could be occupied by keys. Higher load factor increases probability
+// that the system could not be solved for the particular seed.
+constexpr double kRibbonLoadFactor = 0.95;
+constexpr size_t kRibbonMaxResultBits = 16;
+constexpr size_t kRibbonNumSeeds = 256;
+constexpr uint8_t kRibbonFormatVersion = 1;
+constexpr size_t kRibbonMetaDataSize = 7;
+
+inline uint64_t Mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+inline uint64_t RibbonKeyHash(const Slice& key) {
+  return yb::HashUtil::MurmurHash2_64(key.data(), key.size(), /* seed= */ 0);
+}
+
+inline bool Parity(RibbonCoeffRow value) {
+  return __builtin_parityll(static_cast<uint64_t>(value)) ^
+         __builtin_parityll(static_cast<uint64_t>(value >> 64));
+}
+
+inline size_t CountTrailingZeros(RibbonCoeffRow value) {
+  const auto low = static_cast<uint64_t>(value);
+  return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll(static_cast<uint64_t>(value >> 64));
+}
+
+// Loads 64 bits starting at specified bit position, in little endian order.
+inline uint64_t LoadBits(const uint8_t* data, size_t bit_pos) {
+  const uint8_t* ptr = data + bit_pos / 8;
+  const size_t shift = bit_pos % 8;
+  uint64_t result = DecodeFixed64(ptr) >> shift;
+  if (shift != 0) {
+    result |= static_cast<uint64_t>(ptr[8]) << (64 - shift);
+  }
+  return result;
+}
+
+struct RibbonEquation {
+  size_t start;
+  RibbonCoeffRow coeffs;
+  uint32_t result;
+};
+
+inline RibbonEquation MakeRibbonEquation(
+    uint64_t key_hash, uint32_t seed, size_t num_slots, size_t result_bits) {
+  const uint64_t hash = Mix64(key_hash + seed * 0x9e3779b97f4a7c15ULL);
+  const size_t num_starts = num_slots - kRibbonCoeffBits + 1;
+  RibbonEquation result;
+  result.start = static_cast<size_t>((static_cast<RibbonCoeffRow>(hash) * num_starts) >> 64);
+  // The first coefficient is always set, so the equation could be placed to its start slot.
+  result.coeffs = (static_cast<RibbonCoeffRow>(Mix64(hash ^ 0x6a09e667f3bcc908ULL)) << 64) |
+                  Mix64(hash ^ 0xbb67ae8584caa73bULL) | 1;
+  result.result = static_cast<uint32_t>(
+      Mix64(hash ^ 0x3c6ef372fe94f82bULL) & ((1ULL << result_bits) - 1));
+  return result;
+}
+
+// A fixed size ribbon bits builder buffers hashes of added keys, and solves the system in Finish.
+// The number of slots is chosen so that the filter fits into total_bits, and IsFull returns true
+// when the number of distinct keys reaches the load factor.
+class FixedSizeRibbonBitsBuilder : public FilterBitsBuilder {
+ public:
+  FixedSizeRibbonBitsBuilder(const FixedSizeRibbonBitsBuilder&) = delete;
+  void operator=(const FixedSizeRibbonBitsBuilder&) = delete;
+
+  FixedSizeRibbonBitsBuilder(size_t total_bits, double error_rate) {
+    DCHECK_GT(error_rate, 0);
+    DCHECK_GT(total_bits, 0);
+    result_bits_ = static_cast<size_t>(ceil(-log2(error_rate)));
+    result_bits_ = std::max<size_t>(result_bits_, 1);
+    result_bits_ = std::min<size_t>(result_bits_, kRibbonMaxResultBits);
+    num_slots_ = std::max<size_t>(total_bits / result_bits_ / kRibbonCoeffBits, 1) *
+                 kRibbonCoeffBits;
+    max_keys_ = static_cast<size_t>(num_slots_ * kRibbonLoadFactor);
+  }
+
+  void AddKey(const Slice& key) override {
+    const auto hash = RibbonKeyHash(key);
+    // Keys are sorted, so it is enough to check the last hash to skip duplicates, that are usual
+    // for DocDB key transformers.
+    if (hashes_.empty() || hashes_.back() != hash) {
+      hashes_.push_back(hash);
+    }
+  }
+
+  bool IsFull() const override { return hashes_.size() >= max_keys_; }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    const size_t num_slots = hashes_.empty() ? 0 : num_slots_;
+    size_t result_bits = result_bits_;
+    const size_t filter_size = num_slots * result_bits / 8 + kRibbonMetaDataSize;
+    std::unique_ptr<char[]> data(new char[filter_size]);
+    memset(data.get(), 0, filter_size);
+
+    uint32_t seed = 0;
+    if (num_slots != 0) {
+      std::vector<RibbonCoeffRow> coeffs;
+      std::vector<uint32_t> results;
+      while (seed != kRibbonNumSeeds && !Band(seed, &coeffs, &results)) {
+        ++seed;
+      }
+      if (seed != kRibbonNumSeeds) {
+        BackSubstitute(coeffs, results, pointer_cast<uint8_t*>(data.get()));
+      } else {
+        // Practically impossible, but keep the filter correct by matching all keys.
+        seed = 0;
+        result_bits = 0;
+      }
+    }
+
+    char* meta = data.get() + filter_size - kRibbonMetaDataSize;
+    EncodeFixed32(meta, static_cast<uint32_t>(num_slots));
+    meta[4] = static_cast<char>(result_bits);
+    meta[5] = static_cast<char>(seed);
+    meta[6] = static_cast<char>(kRibbonFormatVersion);
+
+    hashes_.clear();
+    buf->reset(data.release());
+    return Slice(buf->get(), filter_size);
+  }
+
+ private:
+  // Performs Gaussian elimination on the fly, storing at most one equation per slot, with the
+  // first coefficient in this slot. Returns false if the system is inconsistent.
+  bool Band(uint32_t seed, std::vector<RibbonCoeffRow>* coeffs, std::vector<uint32_t>* results) {
+    coeffs->assign(num_slots_, 0);
+    results->assign(num_slots_, 0);
+    for (const auto key_hash : hashes_) {
+      auto equation = MakeRibbonEquation(key_hash, seed, num_slots_, result_bits_);
+      auto slot = equation.start;
+      for (;;) {
+        auto& slot_coeffs = (*coeffs)[slot];
+        if (slot_coeffs == 0) {
+          slot_coeffs = equation.coeffs;
+          (*results)[slot] = equation.result;
+          break;
+        }
+        equation.coeffs ^= slot_coeffs;
+        equation.result ^= (*results)[slot];
+        if (equation.coeffs == 0) {
+          // Equation is linear combination of already added ones, i.e. the same hash was added.
+          if (equation.result != 0) {
+            return false;
+          }
+          break;
+        }
+        const auto shift = CountTrailingZeros(equation.coeffs);
+        slot += shift;
+        equation.coeffs >>= shift;
+      }
+    }
+    return true;
+  }
+
+  // Computes solution starting from the last slot. Slots without equation get zero solution.
+  void BackSubstitute(
+      const std::vector<RibbonCoeffRow>& coeffs, const std::vector<uint32_t>& results,
+      uint8_t* data) {
+    const size_t column_size = num_slots_ / 8;
+    // Bit k of state for column b contains solution for slot i + 1 + k.
+    std::vector<RibbonCoeffRow> state(result_bits_, 0);
+    for (size_t i = num_slots_; i-- > 0;) {
+      const auto tail_coeffs = coeffs[i] >> 1;
+      for (size_t b = 0; b != result_bits_; ++b) {
+        const bool bit = ((results[i] >> b) & 1) ^ Parity(state[b] & tail_coeffs);
+        state[b] = (state[b] << 1) | bit;
+        if (bit) {
+          data[b * column_size + i / 8] |= 1 << (i % 8);
+        }
+      }
+    }
+  }
+
+  size_t result_bits_;
+  size_t num_slots_;
+  size_t max_keys_;
+  std::vector<uint64_t> hashes_;
+};
+
+class FixedSizeRibbonBitsReader : public FilterBitsReader {
+ public:
+  FixedSizeRibbonBitsReader(const FixedSizeRibbonBitsReader&) = delete;
+  void operator=(const FixedSizeRibbonBitsReader&) = delete;
+
+  FixedSizeRibbonBitsReader(const Slice& contents, Logger* logger)
+      : data_(contents.data()) {
+    if (contents.size() < kRibbonMetaDataSize) {
+      Broken(logger, "Ribbon filter data is too short");
+      return;
+    }
+    const auto* meta = contents.data() + contents.size() - kRibbonMetaDataSize;
+    num_slots_ = DecodeFixed32(meta);
+    result_bits_ = meta[4];
+    seed_ = meta[5];
+    const auto format_version = meta[6];
+    if (format_version != kRibbonFormatVersion) {
+      Broken(logger, "Unknown ribbon filter format version");
+      return;
+    }
+    if ((num_slots_ != 0 && num_slots_ < kRibbonCoeffBits) || num_slots_ % kRibbonCoeffBits ||
+        result_bits_ > kRibbonMaxResultBits ||
+        contents.size() != num_slots_ * result_bits_ / 8 + kRibbonMetaDataSize) {
+      Broken(logger, "Ribbon filter data is broken");
+    }
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    if (num_slots_ == 0) {
+      // Empty filter.
+      return false;
+    }
+    const auto equation = MakeRibbonEquation(
+        RibbonKeyHash(entry), seed_, num_slots_, result_bits_);
+    const auto coeffs_low = static_cast<uint64_t>(equation.coeffs);
+    const auto coeffs_high = static_cast<uint64_t>(equation.coeffs >> 64);
+    const size_t column_size = num_slots_ / 8;
+    for (size_t b = 0; b != result_bits_; ++b) {
+      const auto* column = data_ + b * column_size;
+      const bool bit = __builtin_parityll(LoadBits(column, equation.start) & coeffs_low) ^
+                       __builtin_parityll(LoadBits(column, equation.start + 64) & coeffs_high);
+      if (bit != ((equation.result >> b) & 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  void Broken(Logger* logger, const char* message) {
+    RLOG(InfoLogLevel::ERROR_LEVEL, logger, "%s, won't be used.", message);
+    FAIL_IF_NOT_PRODUCTION();
+    // Filter with zero result bits matches all keys.
+    num_slots_ = kRibbonCoeffBits;
+    result_bits_ = 0;
+    seed_ = 0;
+  }
+
+  const uint8_t* data_;
+  size_t num_slots_ = 0;
+  size_t result_bits_ = 0;
+  uint32_t seed_ = 0;
+};
+
+class FixedSizeRibbonFilterPolicy : public FilterPolicy {
+ public:
+  FixedSizeRibbonFilterPolicy(size_t total_bits, double error_rate, Logger* logger)
+      : total_bits_(total_bits), error_rate_(error_rate), logger_(logger) {
+    DCHECK_GT(error_rate, 0);
+  }
+
+  FilterType GetFilterType() const override { return FilterType::kFixedSizeFilter; }
+
+  const char* Name() const override {
+    return "rocksdb.FixedSizeRibbonFilter";
+  }
+
+  // Not used in FixedSizeFilter. GetFilterBitsBuilder/Reader interface should be used.
+  void CreateFilter(const Slice* keys, int n, std::string* dst) const override {
+    assert(!"FixedSizeRibbonFilterPolicy::CreateFilter is not supported");
+  }
+
+  bool KeyMayMatch(const Slice& key, const Slice& filter) const override {
+    assert(!"FixedSizeRibbonFilterPolicy::KeyMayMatch is not supported");
+    return true;
+  }
+
+  FilterBitsBuilder* GetFilterBitsBuilder() const override {
+    return new FixedSizeRibbonBitsBuilder(total_bits_, error_rate_);
+  }
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
+    return new FixedSizeRibbonBitsReader(contents, logger_);
+  }
+
+ private:
+  size_t total_bits_;
+  double error_rate_;
+  Logger* logger_;
+};
+
+}  // namespace
+
+const FilterPolicy* NewFixedSizeRibbonFilterPolicy(
+    size_t total_bits, double error_rate, Logger* logger) {
+  return new FixedSizeRibbonFilterPolicy(total_bits, error_rate, logger);
+}
+
+}  // namespace rocksdb
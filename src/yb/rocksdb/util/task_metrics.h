@@ -113,6 +113,8 @@ struct RocksDBTaskStateMetrics {
       case CompactionReason::kAdminCompaction:
         FALLTHROUGH_INTENDED;
       case CompactionReason::kScheduledFullCompaction:
+        FALLTHROUGH_INTENDED;
+      case CompactionReason::kTombstoneDensityCompaction:
         return &full;
       // Post-split compactions.
       case CompactionReason::kPostSplitCompaction:
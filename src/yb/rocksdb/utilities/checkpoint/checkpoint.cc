@@ -51,6 +51,7 @@ namespace checkpoint {
 // accepts an output directory on the same disk, and under the directory
 // (1) hard-linked SST files pointing to existing live SST files
 // SST files will be copied if output directory is on a different filesystem
+// SST files from all db_paths are placed directly under the output directory
 // (2) a copied manifest files and other files
 // The directory should not already exist and will be created by this API.
 // The directory will be an absolute path
@@ -98,6 +99,8 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
   // create snapshot directory
   s = db->GetCheckpointEnv()->CreateDir(full_private_path);
 
+  const auto& db_paths = db->GetOptions().db_paths;
+
   // copy/hard link live_files
   for (size_t i = 0; s.ok() && i < live_files.size(); ++i) {
     uint64_t number;
@@ -118,19 +121,29 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     // * if it's kDescriptorFile, limit the size to manifest_file_size
     // * always copy if cross-device link
     bool is_table_file = type == kTableFile || type == kTableSBlockFile;
-    if (is_table_file && same_fs) {
-      RLOG(db->GetOptions().info_log, "Hard Linking %s", src_fname.c_str());
-      s = db->GetCheckpointEnv()->LinkFile(db->GetName() + src_fname,
-                                 full_private_path + src_fname);
+    std::string src_path = db->GetName() + src_fname;
+    // Table files from db paths other than the first one could reside on a different
+    // filesystem, so cross-device link for them does not affect other files.
+    bool same_fs_as_db = true;
+    if (is_table_file) {
+      auto base_path = FindTableFileName(db->GetCheckpointEnv(), db_paths, number, 0);
+      src_path = type == kTableFile ? base_path : TableBaseToDataFileName(base_path);
+      same_fs_as_db = base_path == MakeTableFileName(db_paths.front().path, number);
+    }
+    bool copy_file = !is_table_file || !same_fs;
+    if (!copy_file) {
+      RLOG(db->GetOptions().info_log, "Hard Linking %s", src_path.c_str());
+      s = db->GetCheckpointEnv()->LinkFile(src_path, full_private_path + src_fname);
       if (s.IsNotSupported()) {
-        same_fs = false;
+        same_fs = !same_fs_as_db;
+        copy_file = true;
         s = Status::OK();
       }
     }
-    if (!is_table_file || !same_fs) {
-      RLOG(db->GetOptions().info_log, "Copying %s", src_fname.c_str());
+    if (copy_file) {
+      RLOG(db->GetOptions().info_log, "Copying %s", src_path.c_str());
       std::string dest_name = full_private_path + src_fname;
-      s = CopyFile(db->GetCheckpointEnv(), db->GetName() + src_fname, dest_name,
+      s = CopyFile(db->GetCheckpointEnv(), src_path, dest_name,
                    type == kDescriptorFile ? manifest_file_size : 0);
     }
   }
@@ -133,7 +133,13 @@ class RocksDBEncryptedFileFactory : public rocksdb::RocksDBFileFactoryWrapper {
   Status NewWritableFile(const std::string& fname, std::unique_ptr<rocksdb::WritableFile>* result,
                          const rocksdb::EnvOptions& options) override {
     std::unique_ptr<rocksdb::WritableFile> underlying;
-    RETURN_NOT_OK(RocksDBFileFactoryWrapper::NewWritableFile(fname, &underlying, options));
+    // Encrypted file is written with unaligned appends, so it cannot use direct I/O.
+    auto underlying_options = options;
+    if (header_manager_->IsEncryptionEnabled()) {
+      underlying_options.use_direct_writes = false;
+    }
+    RETURN_NOT_OK(RocksDBFileFactoryWrapper::NewWritableFile(
+        fname, &underlying, underlying_options));
     return RocksDBEncryptedWritableFile::Create(
         result, header_manager_.get(), std::move(underlying));
   }
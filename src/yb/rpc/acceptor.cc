@@ -80,8 +80,11 @@ TAG_FLAG(rpc_acceptor_listen_backlog, advanced);
 namespace yb {
 namespace rpc {
 
-Acceptor::Acceptor(const scoped_refptr<MetricEntity>& metric_entity, NewSocketHandler handler)
+Acceptor::Acceptor(const scoped_refptr<MetricEntity>& metric_entity, NewSocketHandler handler,
+                   bool reuse_port, std::vector<int> cpus)
     : handler_(std::move(handler)),
+      reuse_port_(reuse_port),
+      cpus_(std::move(cpus)),
       rpc_connections_accepted_(METRIC_rpc_connections_accepted.Instantiate(metric_entity)),
       loop_(kDefaultLibEvFlags) {
 }
@@ -94,6 +97,9 @@ Status Acceptor::Listen(const Endpoint& endpoint, Endpoint* bound_endpoint) {
   Socket socket;
   RETURN_NOT_OK(socket.Init(endpoint.address().is_v6() ? Socket::FLAG_IPV6 : 0));
   RETURN_NOT_OK(socket.SetReuseAddr(true));
+  if (reuse_port_) {
+    RETURN_NOT_OK(socket.SetReusePort(true));
+  }
   RETURN_NOT_OK(socket.Bind(endpoint));
   if (bound_endpoint) {
     RETURN_NOT_OK(socket.GetSocketAddress(bound_endpoint));
@@ -220,6 +226,9 @@ void Acceptor::AsyncHandler(ev::async& async, int events) {
 }
 
 void Acceptor::RunThread() {
+  if (!cpus_.empty()) {
+    WARN_NOT_OK(SetCurrentThreadCpuAffinity(cpus_), "Failed to pin acceptor thread");
+  }
   loop_.run();
   VLOG(1) << "Acceptor shutting down.";
 }
@@ -61,7 +61,11 @@ typedef std::function<void(Socket *new_socket, const Endpoint& remote)> NewSocke
 class Acceptor {
  public:
   // Create a new acceptor pool.
-  Acceptor(const scoped_refptr<MetricEntity>& metric_entity, NewSocketHandler handler);
+  // When reuse_port is true, listening sockets are bound with SO_REUSEPORT, so several acceptors
+  // could listen on the same endpoint and the kernel distributes connections between them.
+  // When cpus is not empty, the acceptor thread is pinned to those CPUs.
+  Acceptor(const scoped_refptr<MetricEntity>& metric_entity, NewSocketHandler handler,
+           bool reuse_port = false, std::vector<int> cpus = {});
   ~Acceptor();
 
   // Setup acceptor to listen address.
@@ -83,6 +87,8 @@ class Acceptor {
   };
 
   NewSocketHandler handler_;
+  const bool reuse_port_;
+  const std::vector<int> cpus_;
   scoped_refptr<yb::Thread> thread_;
   std::mutex mutex_;
   std::unordered_map<ev::io*, AcceptingSocket> sockets_;
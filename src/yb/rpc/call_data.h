@@ -24,6 +24,8 @@ struct CallData {
   CallData() : buffer_(EmptyBuffer()) {}
 
   explicit CallData(size_t size) : buffer_(size) {}
+
+  explicit CallData(RefCntBuffer buffer) : buffer_(std::move(buffer)) {}
   class ShouldRejectTag {};
 
   CallData(size_t size, ShouldRejectTag) {}
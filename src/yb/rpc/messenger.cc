@@ -70,6 +70,7 @@
 #include "yb/util/status.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
+#include "yb/util/thread.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
 
@@ -96,9 +97,43 @@ DEFINE_NON_RUNTIME_int32(rpc_workers_limit, 1024, "Workers limit for rpc server"
 
 DEFINE_UNKNOWN_int32(socket_receive_buffer_size, 0, "Socket receive buffer size, 0 to use default");
 
+DEFINE_NON_RUNTIME_bool(rpc_acceptor_reuse_port, false,
+    "Listen on each RPC address with a separate SO_REUSEPORT socket and acceptor thread per "
+    "reactor. The kernel spreads incoming connections between those sockets, and every connection "
+    "is handled by the reactor whose socket received it.");
+TAG_FLAG(rpc_acceptor_reuse_port, advanced);
+
+DEFINE_NON_RUNTIME_bool(rpc_pin_reactor_threads, false,
+    "Pin each reactor thread of server messengers to its own subset of CPUs the process is allowed "
+    "to run on. When rpc_acceptor_reuse_port is set, the acceptor thread of the reactor is pinned "
+    "to the same CPUs.");
+TAG_FLAG(rpc_pin_reactor_threads, advanced);
+
 namespace yb {
 namespace rpc {
 
+namespace {
+
+// Splits CPUs the process is allowed to run on between reactors, so reactor with index i runs on
+// every num_reactors-th allowed CPU starting from the i-th one.
+Result<std::vector<std::vector<int>>> ReactorCpus(size_t num_reactors) {
+  auto allowed_cpus = VERIFY_RESULT(GetProcessCpuAffinity());
+  SCHECK(!allowed_cpus.empty(), IllegalState, "Process is not allowed to run on any CPU");
+  std::vector<std::vector<int>> result(num_reactors);
+  if (num_reactors >= allowed_cpus.size()) {
+    for (size_t i = 0; i != num_reactors; ++i) {
+      result[i].push_back(allowed_cpus[i % allowed_cpus.size()]);
+    }
+    return result;
+  }
+  for (size_t i = 0; i != allowed_cpus.size(); ++i) {
+    result[i % num_reactors].push_back(allowed_cpus[i]);
+  }
+  return result;
+}
+
+} // namespace
+
 class Messenger;
 class ServerBuilder;
 
@@ -182,7 +217,7 @@ void Messenger::Shutdown() {
   ThreadRestrictions::ScopedAllowWait allow_wait;
 
   std::vector<Reactor*> reactors;
-  std::unique_ptr<Acceptor> acceptor;
+  std::vector<std::unique_ptr<Acceptor>> acceptors;
   {
     std::lock_guard<percpu_rwlock> guard(lock_);
     if (closing_) {
@@ -194,14 +229,14 @@ void Messenger::Shutdown() {
     DCHECK(rpc_services_.empty()) << "Unregister RPC services before shutting down Messenger";
     rpc_services_.clear();
 
-    acceptor.swap(acceptor_);
+    acceptors.swap(acceptors_);
 
     for (const auto& reactor : reactors_) {
       reactors.push_back(reactor.get());
     }
   }
 
-  if (acceptor) {
+  for (const auto& acceptor : acceptors) {
     acceptor->Shutdown();
   }
 
@@ -229,12 +264,37 @@ void Messenger::Shutdown() {
 Status Messenger::ListenAddress(
     ConnectionContextFactoryPtr factory, const Endpoint& accept_endpoint,
     Endpoint* bound_endpoint) {
-  Acceptor* acceptor;
+  std::vector<Acceptor*> acceptors;
+  std::vector<std::vector<int>> reactor_cpus;
   {
     std::lock_guard<percpu_rwlock> guard(lock_);
-    if (!acceptor_) {
-      acceptor_.reset(new Acceptor(
-          metric_entity_, std::bind(&Messenger::RegisterInboundSocket, this, factory, _1, _2)));
+    if (acceptors_.empty()) {
+      // Only server messengers listen, so reactors of client messengers are never pinned.
+      if (FLAGS_rpc_pin_reactor_threads) {
+        auto cpus = ReactorCpus(reactors_.size());
+        if (cpus.ok()) {
+          reactor_cpus = std::move(*cpus);
+        } else {
+          LOG(WARNING) << "Failed to split CPUs between reactors of " << name_ << ": "
+                       << cpus.status();
+        }
+      }
+      if (FLAGS_rpc_acceptor_reuse_port) {
+        for (size_t i = 0; i != reactors_.size(); ++i) {
+          acceptors_.push_back(std::make_unique<Acceptor>(
+              metric_entity_,
+              std::bind(
+                  &Messenger::RegisterInboundSocket, this, factory, reactors_[i].get(), _1, _2),
+              /* reuse_port= */ true,
+              reactor_cpus.empty() ? std::vector<int>() : reactor_cpus[i]));
+        }
+      } else {
+        acceptors_.push_back(std::make_unique<Acceptor>(
+            metric_entity_,
+            std::bind(
+                &Messenger::RegisterInboundSocket, this, factory, static_cast<Reactor*>(nullptr),
+                _1, _2)));
+      }
     }
     auto accept_host = accept_endpoint.address();
     auto& outbound_address = accept_host.is_v6() ? outbound_address_v6_
@@ -242,9 +302,25 @@ Status Messenger::ListenAddress(
     if (outbound_address.is_unspecified() && !accept_host.is_unspecified()) {
       outbound_address = accept_host;
     }
-    acceptor = acceptor_.get();
+    for (const auto& acceptor : acceptors_) {
+      acceptors.push_back(acceptor.get());
+    }
+  }
+  for (size_t i = 0; i != reactor_cpus.size(); ++i) {
+    WARN_NOT_OK(reactors_[i]->PinToCpus(reactor_cpus[i]),
+                Format("Failed to pin reactor $0 of $1", i, name_));
   }
-  return acceptor->Listen(accept_endpoint, bound_endpoint);
+  // When several acceptors share the address, the first one resolves the port, and the rest are
+  // bound to the same port.
+  Endpoint bound;
+  RETURN_NOT_OK(acceptors.front()->Listen(accept_endpoint, &bound));
+  for (size_t i = 1; i < acceptors.size(); ++i) {
+    RETURN_NOT_OK(acceptors[i]->Listen(bound));
+  }
+  if (bound_endpoint) {
+    *bound_endpoint = bound;
+  }
+  return Status::OK();
 }
 
 Status Messenger::StartAcceptor() {
@@ -253,11 +329,13 @@ Status Messenger::StartAcceptor() {
   }
 
   std::lock_guard<percpu_rwlock> guard(lock_);
-  if (acceptor_) {
-    return acceptor_->Start();
-  } else {
+  if (acceptors_.empty()) {
     return STATUS(IllegalState, "Trying to start acceptor w/o active addresses");
   }
+  for (const auto& acceptor : acceptors_) {
+    RETURN_NOT_OK(acceptor->Start());
+  }
+  return Status::OK();
 }
 
 void Messenger::BreakConnectivityWith(const IpAddress& address) {
@@ -368,13 +446,18 @@ Status Messenger::TEST_GetReactorMetrics(size_t reactor_idx, ReactorMetrics* met
   return reactors_[reactor_idx]->GetMetrics(metrics);
 }
 
+Result<std::vector<int>> Messenger::TEST_GetReactorCpuAffinity(size_t reactor_idx) {
+  SCHECK_LT(reactor_idx, reactors_.size(), InvalidArgument, "Invalid reactor index");
+  return reactors_[reactor_idx]->GetCpuAffinity();
+}
+
 void Messenger::ShutdownAcceptor() {
-  std::unique_ptr<Acceptor> acceptor;
+  std::vector<std::unique_ptr<Acceptor>> acceptors;
   {
     std::lock_guard<percpu_rwlock> guard(lock_);
-    acceptor.swap(acceptor_);
+    acceptors.swap(acceptors_);
   }
-  if (acceptor) {
+  for (const auto& acceptor : acceptors) {
     acceptor->Shutdown();
   }
 }
@@ -520,7 +603,8 @@ const std::shared_ptr<MemTracker>& Messenger::parent_mem_tracker() {
 }
 
 void Messenger::RegisterInboundSocket(
-    const ConnectionContextFactoryPtr& factory, Socket *new_socket, const Endpoint& remote) {
+    const ConnectionContextFactoryPtr& factory, Reactor* reactor, Socket *new_socket,
+    const Endpoint& remote) {
   if (TEST_ShouldArtificiallyRejectIncomingCallsFrom(remote.address())) {
     auto status = new_socket->Close();
     VLOG(1) << "TEST: Rejected connection from " << remote
@@ -539,8 +623,10 @@ void Messenger::RegisterInboundSocket(
     return;
   }
 
-  int idx = num_connections_accepted_.fetch_add(1) % num_connections_to_server_;
-  Reactor *reactor = RemoteToReactor(remote, idx);
+  if (!reactor) {
+    int idx = num_connections_accepted_.fetch_add(1) % num_connections_to_server_;
+    reactor = RemoteToReactor(remote, idx);
+  }
   reactor->RegisterInboundSocket(new_socket, *receive_buffer_size, remote, factory);
 }
 
@@ -301,6 +301,8 @@ class Messenger : public ProxyContext {
 
   Status TEST_GetReactorMetrics(size_t reactor_idx, ReactorMetrics* metrics);
 
+  Result<std::vector<int>> TEST_GetReactorCpuAffinity(size_t reactor_idx);
+
  private:
   friend class DelayedTask;
 
@@ -312,9 +314,11 @@ class Messenger : public ProxyContext {
   void BreakConnectivity(const IpAddress& address, bool incoming, bool outgoing);
   void RestoreConnectivity(const IpAddress& address, bool incoming, bool outgoing);
 
-  // Take ownership of the socket via Socket::Release
+  // Take ownership of the socket via Socket::Release.
+  // When reactor is null, it is picked based on the remote endpoint.
   void RegisterInboundSocket(
-      const ConnectionContextFactoryPtr& factory, Socket *new_socket, const Endpoint& remote);
+      const ConnectionContextFactoryPtr& factory, Reactor* reactor, Socket *new_socket,
+      const Endpoint& remote);
 
   bool TEST_ShouldArtificiallyRejectOutgoingCallsTo(const IpAddress &remote);
 
@@ -341,8 +345,9 @@ class Messenger : public ProxyContext {
   const scoped_refptr<MetricEntity> metric_entity_;
   const scoped_refptr<Histogram> outgoing_queue_time_;
 
-  // Acceptor which is listening on behalf of this messenger.
-  std::unique_ptr<Acceptor> acceptor_;
+  // Acceptors which are listening on behalf of this messenger. There is a single acceptor, unless
+  // rpc_acceptor_reuse_port is set, in which case there is an acceptor per reactor.
+  std::vector<std::unique_ptr<Acceptor>> acceptors_;
   IpAddress outbound_address_v4_;
   IpAddress outbound_address_v6_;
 
@@ -278,6 +278,21 @@ Status Reactor::GetMetrics(ReactorMetrics *metrics) {
   }, SOURCE_LOCATION());
 }
 
+Status Reactor::PinToCpus(const std::vector<int>& cpus) {
+  return RunOnReactorThread([&cpus](Reactor* reactor) {
+    return SetCurrentThreadCpuAffinity(cpus);
+  }, SOURCE_LOCATION());
+}
+
+Result<std::vector<int>> Reactor::GetCpuAffinity() {
+  std::vector<int> result;
+  RETURN_NOT_OK(RunOnReactorThread([&result](Reactor* reactor) -> Status {
+    result = VERIFY_RESULT(GetCurrentThreadCpuAffinity());
+    return Status::OK();
+  }, SOURCE_LOCATION()));
+  return result;
+}
+
 void Reactor::Join() {
   auto join_result = ThreadJoiner(thread_.get()).give_up_after(30s).Join();
   if (join_result.ok()) {
@@ -44,6 +44,7 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <boost/intrusive/list.hpp>
 #include <boost/utility.hpp>
@@ -364,6 +365,14 @@ class Reactor {
   // Must be called from the reactor thread.
   Status GetMetrics(ReactorMetrics *metrics);
 
+  // Restricts the reactor thread to run only on the specified CPUs.
+  // This may be called from another thread.
+  Status PinToCpus(const std::vector<int>& cpus);
+
+  // Returns CPUs that the reactor thread is allowed to run on.
+  // This may be called from another thread.
+  Result<std::vector<int>> GetCpuAffinity();
+
   void Join();
 
   // Queues a server event on all the connections, such that every client receives it.
@@ -41,12 +41,18 @@
 #include "yb/rpc/rtest.proxy.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/flags.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
 using namespace std::literals; // NOLINT
+using namespace yb::size_literals;
+
+DEFINE_NON_RUNTIME_uint64(rpc_bench_payload_size, 1_MB,
+    "Size of the sidecar returned by each call in the large payload benchmark.");
 
 using std::string;
 using std::shared_ptr;
@@ -67,8 +73,10 @@ class RpcBench : public RpcTestBase {
 
 class ClientThread {
  public:
-  explicit ClientThread(RpcBench *bench)
+  // When payload_size is not zero, each call asks the server to return a sidecar of this size.
+  explicit ClientThread(RpcBench *bench, size_t payload_size = 0)
     : bench_(bench),
+      payload_size_(payload_size),
       request_count_(0) {
   }
 
@@ -83,6 +91,11 @@ class ClientThread {
   void Run() {
     CDSAttacher attacher;
     auto client_messenger = CreateAutoShutdownMessengerHolder(bench_->CreateMessenger("Client"));
+    if (payload_size_) {
+      RunLargePayload(client_messenger.get());
+      return;
+    }
+
     ProxyCache proxy_cache(client_messenger.get());
 
     rpc_test::CalculatorServiceProxy p(&proxy_cache, HostPort(bench_->server_hostport_));
@@ -100,8 +113,27 @@ class ClientThread {
     }
   }
 
+  void RunLargePayload(Messenger* messenger) {
+    Proxy p(messenger, bench_->server_hostport_);
+    rpc_test::SendStringsRequestPB req;
+    req.add_sizes(payload_size_);
+    rpc_test::SendStringsResponsePB resp;
+    while (bench_->should_run_.load(std::memory_order_acquire)) {
+      req.set_random_seed(request_count_);
+      RpcController controller;
+      controller.set_timeout(MonoDelta::FromSeconds(10));
+      CHECK_OK(p.SyncRequest(
+          CalculatorServiceMethods::SendStringsMethod(), /* method_metrics= */ nullptr, req,
+          &resp, &controller));
+      auto sidecar = CHECK_RESULT(controller.ExtractSidecar(resp.sidecars(0)));
+      CHECK_EQ(sidecar.size(), payload_size_);
+      request_count_++;
+    }
+  }
+
   std::unique_ptr<std::thread> thread_;
   RpcBench *bench_;
+  const size_t payload_size_;
   int request_count_;
 };
 
@@ -155,5 +187,46 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+// Calls that return large sidecars, to measure the cost of sending large responses.
+// Run with --rpc_zero_copy_send_threshold to compare with zero copy send. The server generates
+// random payload, so the user CPU includes this generation, while the difference in the sys
+// CPU shows the cost of copying data into the kernel.
+TEST_F(RpcBench, BenchmarkLargePayload) {
+  StartTestServer(&server_hostport_);
+
+  Stopwatch sw(Stopwatch::ALL_THREADS);
+  sw.start();
+
+  std::vector<std::unique_ptr<ClientThread>> threads;
+  constexpr int kNumThreads = 4;
+  for (int i = 0; i < kNumThreads; i++) {
+    auto thr = std::make_unique<ClientThread>(this, FLAGS_rpc_bench_payload_size);
+    thr->Start();
+    threads.push_back(std::move(thr));
+  }
+
+  std::this_thread::sleep_for(10s);
+  should_run_.store(false, std::memory_order_release);
+
+  int total_reqs = 0;
+
+  for (const auto& thr : threads) {
+    thr->Join();
+    total_reqs += thr->request_count_;
+  }
+  sw.stop();
+
+  auto wall_seconds = sw.elapsed().wall_seconds();
+  auto total_bytes = static_cast<double>(total_reqs) * FLAGS_rpc_bench_payload_size;
+  float reqs_per_second = static_cast<float>(total_reqs / wall_seconds);
+  float mb_per_second = static_cast<float>(total_bytes / 1_MB / wall_seconds);
+  float sys_cpu_micros_per_req = static_cast<float>(sw.elapsed().system / 1000.0 / total_reqs);
+
+  LOG(INFO) << "Payload size:     " << FLAGS_rpc_bench_payload_size;
+  LOG(INFO) << "Reqs/sec:         " << reqs_per_second;
+  LOG(INFO) << "MB/sec:           " << mb_per_second;
+  LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
+}
+
 } // namespace rpc
 } // namespace yb
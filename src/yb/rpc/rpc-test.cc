@@ -83,12 +83,15 @@ DEFINE_UNKNOWN_int32(rpc_test_connection_keepalive_num_iterations, 1,
 DECLARE_bool(TEST_pause_calculator_echo_request);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
 DECLARE_bool(enable_rpc_keepalive);
+DECLARE_bool(rpc_acceptor_reuse_port);
+DECLARE_bool(rpc_pin_reactor_threads);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int64(rpc_throttle_threshold_bytes);
 DECLARE_int32(stream_compression_algo);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_string(vmodule);
 DECLARE_uint64(rpc_connection_timeout_ms);
+DECLARE_uint64(rpc_zero_copy_send_threshold);
 DECLARE_uint64(rpc_read_buffer_size);
 
 using namespace std::chrono_literals;
@@ -232,6 +235,70 @@ TEST_F(TestRpc, TestCall) {
   }
 }
 
+TEST_F(TestRpc, ReusePortAcceptors) {
+  FLAGS_rpc_acceptor_reuse_port = true;
+  FLAGS_rpc_pin_reactor_threads = true;
+
+  constexpr int kNumClients = 20;
+
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+  const auto num_reactors = server_messenger()->num_reactors();
+
+  // Use several client messengers, so connections are spread between server acceptors.
+  std::vector<AutoShutdownMessengerHolder> client_messengers;
+  size_t num_connections = 0;
+  for (int i = 0; i < kNumClients; i++) {
+    client_messengers.push_back(CreateAutoShutdownMessengerHolder(Format("Client$0", i)));
+    auto* client_messenger = client_messengers.back().get();
+    Proxy p(client_messenger, server_addr);
+    for (int j = 0; j < 5; j++) {
+      ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+    }
+    ReactorMetrics metrics;
+    ASSERT_OK(client_messenger->TEST_GetReactorMetrics(0, &metrics));
+    num_connections += metrics.num_client_connections;
+  }
+
+  // Every connection is handled by the reactor whose acceptor received it, so with this number of
+  // clients all server reactors are expected to get connections.
+  std::vector<size_t> reactor_connections(num_reactors);
+  ASSERT_OK(WaitFor([this, &reactor_connections, num_connections]() -> Result<bool> {
+    size_t total = 0;
+    for (size_t i = 0; i != reactor_connections.size(); ++i) {
+      ReactorMetrics metrics;
+      RETURN_NOT_OK(server_messenger()->TEST_GetReactorMetrics(i, &metrics));
+      reactor_connections[i] = metrics.num_server_connections;
+      total += metrics.num_server_connections;
+    }
+    return total == num_connections;
+  }, 10s * kTimeMultiplier, "All connections registered"));
+  LOG(INFO) << "Server connections per reactor: " << AsString(reactor_connections);
+  for (size_t i = 0; i != num_reactors; ++i) {
+    ASSERT_GT(reactor_connections[i], 0) << "Reactor " << i << " did not get any connections";
+  }
+
+  // Allowed CPUs of the process are split between server reactors round robin.
+  auto allowed_cpus = ASSERT_RESULT(GetProcessCpuAffinity());
+  ASSERT_FALSE(allowed_cpus.empty());
+  for (size_t i = 0; i != num_reactors; ++i) {
+    std::vector<int> expected_cpus;
+    if (num_reactors >= allowed_cpus.size()) {
+      expected_cpus.push_back(allowed_cpus[i % allowed_cpus.size()]);
+    } else {
+      for (size_t j = i; j < allowed_cpus.size(); j += num_reactors) {
+        expected_cpus.push_back(allowed_cpus[j]);
+      }
+    }
+    ASSERT_EQ(ASSERT_RESULT(server_messenger()->TEST_GetReactorCpuAffinity(i)), expected_cpus)
+        << "Reactor " << i;
+  }
+
+  // Client messengers don't listen, so their reactors are not pinned.
+  ASSERT_EQ(ASSERT_RESULT(client_messengers.front()->TEST_GetReactorCpuAffinity(0)),
+            allowed_cpus);
+}
+
 TEST_F(TestRpc, BigTimeout) {
   // Set up server.
   TestServerOptions options;
@@ -481,6 +548,22 @@ TEST_F(TestRpc, TestRpcSidecar) {
   DoTestSidecar(&p, sizes);
 }
 
+// Test that sidecars are transferred correctly when zero copy send is enabled.
+TEST_F(TestRpc, TestRpcSidecarZeroCopy) {
+  FLAGS_rpc_zero_copy_send_threshold = 64_KB;
+
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  DoTestSidecar(&p, {123, 456});
+  for (int i = 0; i != 10; ++i) {
+    DoTestSidecar(&p, {3_MB, 2_MB, 24_MB});
+  }
+}
+
 // Test that timeouts are properly handled.
 TEST_F(TestRpc, TestCallTimeout) {
   HostPort server_addr;
@@ -13,6 +13,8 @@
 
 #include "yb/rpc/tcp_stream.h"
 
+#include <sys/socket.h>
+
 #include "yb/rpc/outbound_data.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/rpc_util.h"
@@ -32,12 +34,22 @@ DECLARE_uint64(rpc_connection_timeout_ms);
 DEFINE_test_flag(int32, delay_connect_ms, 0,
                  "Delay connect in tests for specified amount of milliseconds.");
 
+DEFINE_NON_RUNTIME_uint64(rpc_zero_copy_send_threshold, 0,
+    "Writes of at least this number of bytes to TCP connections are sent with MSG_ZEROCOPY, so "
+    "the kernel does not copy the data. 0 disables zero copy send. Zero copy is disabled for "
+    "connections where the kernel has to copy the data anyway, e.g. loopback ones.");
+TAG_FLAG(rpc_zero_copy_send_threshold, advanced);
+
 METRIC_DEFINE_simple_counter(
   server, tcp_bytes_sent, "Bytes sent over TCP connections", yb::MetricUnit::kBytes);
 
 METRIC_DEFINE_simple_counter(
   server, tcp_bytes_received, "Bytes received via TCP connections", yb::MetricUnit::kBytes);
 
+METRIC_DEFINE_simple_counter(
+  server, tcp_zero_copy_bytes_sent, "Bytes sent over TCP connections using zero copy",
+  yb::MetricUnit::kBytes);
+
 namespace yb {
 namespace rpc {
 
@@ -45,8 +57,66 @@ namespace {
 
 const size_t kMaxIov = 16;
 
+#if defined(MSG_ZEROCOPY)
+constexpr int kZeroCopyFlag = MSG_ZEROCOPY;
+#else
+constexpr int kZeroCopyFlag = 0;
+#endif
+
+constexpr auto kZeroCopyDrainPollInterval = 50ms;
+constexpr auto kZeroCopyDrainTimeout = 30s;
+
 }
 
+// Keeps buffers of zero copy sends alive after the stream is shut down, until the kernel reports
+// that it does not use them anymore. The socket stays open meanwhile, since completions are
+// reported via its error queue. If completions are not reported in time, the connection is reset,
+// so the kernel drops unsent data, and only after that the buffers are released.
+// The drainer runs on the reactor loop of the stream. If the loop is stopped first, the buffers
+// are intentionally never released.
+class TcpStream::ZeroCopyDrainer {
+ public:
+  static void Start(
+      ev::loop_ref loop, Socket socket, std::deque<ZeroCopySend> sends, std::string log_prefix) {
+    // Deletes itself when done.
+    auto* drainer = new ZeroCopyDrainer(
+        loop, std::move(socket), std::move(sends), std::move(log_prefix));
+    drainer->timer_.start(0, MonoDelta(kZeroCopyDrainPollInterval).ToSeconds());
+  }
+
+ private:
+  ZeroCopyDrainer(
+      ev::loop_ref loop, Socket socket, std::deque<ZeroCopySend> sends, std::string log_prefix)
+      : socket_(std::move(socket)), sends_(std::move(sends)), log_prefix_(std::move(log_prefix)),
+        deadline_(CoarseMonoClock::now() + kZeroCopyDrainTimeout) {
+    timer_.set(loop);
+    timer_.set<ZeroCopyDrainer, &ZeroCopyDrainer::Handler>(this);
+  }
+
+  void Handler(ev::timer& watcher, int revents) { // NOLINT
+    auto result = ReleaseCompletedZeroCopySends(&socket_, &sends_);
+    if (result.ok() && !sends_.empty() && CoarseMonoClock::now() < deadline_) {
+      return;
+    }
+    if (!sends_.empty()) {
+      LOG(WARNING) << log_prefix_ << "Resetting connection with " << sends_.size()
+                   << " incomplete zero copy sends: "
+                   << (result.ok() ? STATUS(TimedOut, "Completions not reported")
+                                   : result.status());
+      WARN_NOT_OK(socket_.SetLinger(true, 0), log_prefix_ + "Failed to set linger");
+    }
+    timer_.stop();
+    WARN_NOT_OK(socket_.Close(), log_prefix_ + "Error closing socket");
+    delete this;
+  }
+
+  Socket socket_;
+  std::deque<ZeroCopySend> sends_;
+  const std::string log_prefix_;
+  const CoarseTimePoint deadline_;
+  ev::timer timer_;
+};
+
 TcpStream::TcpStream(const StreamCreateData& data)
     : socket_(std::move(*data.socket)),
       remote_(data.remote) {
@@ -56,6 +126,8 @@ TcpStream::TcpStream(const StreamCreateData& data)
   if (data.metric_entity) {
     bytes_received_counter_ = METRIC_tcp_bytes_received.Instantiate(data.metric_entity);
     bytes_sent_counter_ = METRIC_tcp_bytes_sent.Instantiate(data.metric_entity);
+    zero_copy_bytes_sent_counter_ =
+        METRIC_tcp_zero_copy_bytes_sent.Instantiate(data.metric_entity);
   }
 }
 
@@ -78,6 +150,14 @@ Status TcpStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context
   // These timeouts don't affect non-blocking sockets:
   RETURN_NOT_OK(socket_.SetSendTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
   RETURN_NOT_OK(socket_.SetRecvTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
+  if (FLAGS_rpc_zero_copy_send_threshold && kZeroCopyFlag) {
+    auto status = socket_.SetZeroCopy(true);
+    if (status.ok()) {
+      zero_copy_threshold_ = FLAGS_rpc_zero_copy_send_threshold;
+    } else {
+      YB_LOG_EVERY_N_SECS(WARNING, 60) << "Zero copy send is not available: " << status;
+    }
+  }
 
   if (connect && FLAGS_TEST_delay_connect_ms) {
     connect_delayer_.set(*loop);
@@ -150,6 +230,21 @@ void TcpStream::Shutdown(const Status& status) {
 
   ReadBuffer().Reset();
 
+  if (!zero_copy_sends_.empty()) {
+    WARN_NOT_OK(ProcessZeroCopyCompletions(), LogPrefix() + "Failed to process completions");
+  }
+  if (!zero_copy_sends_.empty()) {
+    // The kernel could still transmit data from buffers of zero copy sends, so the socket is
+    // closed only after their completions are reported.
+    auto shutdown_status = socket_.Shutdown(true, true);
+    VLOG_IF_WITH_PREFIX(1, !shutdown_status.ok())
+        << "Failed to shutdown socket: " << shutdown_status;
+    ZeroCopyDrainer::Start(
+        io_.loop, std::move(socket_), std::move(zero_copy_sends_), LogPrefix());
+    zero_copy_sends_.clear();
+    return;
+  }
+
   WARN_NOT_OK(socket_.Close(), "Error closing socket");
 }
 
@@ -161,9 +256,11 @@ Status TcpStream::TryWrite() {
   return result;
 }
 
-TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
+TcpStream::FillIovResult TcpStream::FillIov(
+    iovec* out, TcpStreamSendingData::SendingBytes* holders) {
   int index = 0;
   size_t offset = send_position_;
+  size_t size = 0;
   bool only_heartbeats = true;
   for (auto& data : sending_) {
     const auto wrapped_data = data.data;
@@ -184,14 +281,18 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
 
       out[index].iov_base = const_cast<char*>(bytes.data()) + offset;
       out[index].iov_len = bytes.size() - offset;
+      size += out[index].iov_len;
       offset = 0;
+      if (holders) {
+        holders->push_back(bytes);
+      }
       if (++index == kMaxIov) {
-        return FillIovResult{index, only_heartbeats};
+        return FillIovResult{index, only_heartbeats, size};
       }
     }
   }
 
-  return FillIovResult{index, only_heartbeats};
+  return FillIovResult{index, only_heartbeats, size};
 }
 
 Status TcpStream::DoWrite() {
@@ -205,21 +306,31 @@ Status TcpStream::DoWrite() {
   }
 
   // If we weren't waiting write to be ready, we could try to write data to socket.
+  bool allow_zero_copy = true;
   while (!sending_.empty()) {
     iovec iov[kMaxIov];
-    auto fill_result = FillIov(iov);
+    TcpStreamSendingData::SendingBytes holders;
+    bool try_zero_copy = allow_zero_copy && zero_copy_threshold_;
+    auto fill_result = FillIov(iov, try_zero_copy ? &holders : nullptr);
+    try_zero_copy = try_zero_copy && fill_result.size >= zero_copy_threshold_;
 
     if (!fill_result.only_heartbeats) {
       context_->UpdateLastActivity();
     }
 
     auto result = fill_result.len != 0
-        ? socket_.Writev(iov, fill_result.len)
+        ? socket_.Writev(iov, fill_result.len, try_zero_copy ? kZeroCopyFlag : 0)
         : 0;
     DVLOG_WITH_PREFIX(4) << "Queued writes " << queued_bytes_to_send_ << " bytes. Result "
                          << result << ", sending_.size(): " << sending_.size();
 
     if (PREDICT_FALSE(!result.ok())) {
+      if (try_zero_copy && Errno(result.status()) == ENOBUFS) {
+        // The kernel could not allocate zero copy notification, send without zero copy.
+        VLOG_WITH_PREFIX(3) << "Zero copy send failed: " << result.status();
+        allow_zero_copy = false;
+        continue;
+      }
       if (!result.status().IsTryAgain()) {
         YB_LOG_WITH_PREFIX_EVERY_N(WARNING, 50) << "Send failed: " << result.status();
         return result.status();
@@ -232,6 +343,13 @@ Status TcpStream::DoWrite() {
     context_->UpdateLastWrite();
 
     IncrementCounterBy(bytes_sent_counter_, *result);
+    if (try_zero_copy) {
+      IncrementCounterBy(zero_copy_bytes_sent_counter_, *result);
+      zero_copy_sends_.push_back(ZeroCopySend {
+        .id = next_zero_copy_id_++,
+        .bytes = std::move(holders),
+      });
+    }
 
     send_position_ += *result;
     while (!sending_.empty()) {
@@ -256,6 +374,35 @@ Status TcpStream::DoWrite() {
   return Status::OK();
 }
 
+Status TcpStream::ProcessZeroCopyCompletions() {
+  auto copied = VERIFY_RESULT(ReleaseCompletedZeroCopySends(&socket_, &zero_copy_sends_));
+  if (copied && zero_copy_threshold_) {
+    // Zero copy only adds overhead when the kernel copies the data anyway.
+    VLOG_WITH_PREFIX(1) << "Kernel copied zero copy send, disabling zero copy";
+    zero_copy_threshold_ = 0;
+  }
+  return Status::OK();
+}
+
+Result<bool> TcpStream::ReleaseCompletedZeroCopySends(
+    Socket* socket, std::deque<ZeroCopySend>* sends) {
+  bool copied = false;
+  for (;;) {
+    auto completion = VERIFY_RESULT(socket->ReadZeroCopyCompletion());
+    if (!completion) {
+      return copied;
+    }
+    copied = copied || completion->copied;
+    // Completions are usually reported in order, but it is not guaranteed.
+    auto first = completion->first;
+    auto range_size = completion->last - first;
+    auto it = std::remove_if(sends->begin(), sends->end(), [first, range_size](const auto& send) {
+      return send.id - first <= range_size;
+    });
+    sends->erase(it, sends->end());
+  }
+}
+
 void TcpStream::PopSending() {
   queued_bytes_to_send_ -= sending_.front().bytes_size();
   sending_.pop_front();
@@ -270,6 +417,14 @@ void TcpStream::Handler(ev::io& watcher, int revents) {  // NOLINT
     VLOG_WITH_PREFIX(3) << status;
   }
 
+  // Zero copy completions are reported via the socket error queue, that wakes up the reader.
+  if (status.ok() && !zero_copy_sends_.empty()) {
+    status = ProcessZeroCopyCompletions();
+    if (!status.ok()) {
+      VLOG_WITH_PREFIX(3) << "ProcessZeroCopyCompletions() returned error: " << status;
+    }
+  }
+
   if (status.ok() && (revents & ev::READ)) {
     status = ReadHandler();
     if (!status.ok()) {
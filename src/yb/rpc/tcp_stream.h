@@ -69,8 +69,18 @@ class TcpStream : public Stream {
   struct FillIovResult {
     int len;
     bool only_heartbeats;
+    size_t size;
   };
 
+  // Buffers passed to the kernel by the zero copy send. They should be kept alive until the
+  // kernel reports the completion of this send.
+  struct ZeroCopySend {
+    uint32_t id;
+    TcpStreamSendingData::SendingBytes bytes;
+  };
+
+  class ZeroCopyDrainer;
+
   Status Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
   void Close() override;
   void Shutdown(const Status& status) override;
@@ -106,7 +116,17 @@ class TcpStream : public Stream {
   // Updates listening events.
   void UpdateEvents();
 
-  FillIovResult FillIov(iovec* out);
+  // Fills iov with data to send. When holders is not null, references to the filled buffers are
+  // added to it.
+  FillIovResult FillIov(iovec* out, TcpStreamSendingData::SendingBytes* holders);
+
+  // Reads zero copy completions from the socket error queue and releases completed buffers.
+  Status ProcessZeroCopyCompletions();
+
+  // Reads zero copy completions from the error queue of socket and removes completed sends.
+  // Returns true if the kernel has copied data of any completed send.
+  static Result<bool> ReleaseCompletedZeroCopySends(
+      Socket* socket, std::deque<ZeroCopySend>* sends);
 
   void DelayConnectHandler(ev::timer& watcher, int revents); // NOLINT
 
@@ -152,6 +172,13 @@ class TcpStream : public Stream {
   MemTrackerPtr mem_tracker_;
   scoped_refptr<Counter> bytes_sent_counter_;
   scoped_refptr<Counter> bytes_received_counter_;
+  scoped_refptr<Counter> zero_copy_bytes_sent_counter_;
+
+  // Writes of at least this size are sent with MSG_ZEROCOPY, 0 when zero copy is disabled.
+  size_t zero_copy_threshold_ = 0;
+  // Id that the kernel will assign to the next zero copy send.
+  uint32_t next_zero_copy_id_ = 0;
+  std::deque<ZeroCopySend> zero_copy_sends_;
 };
 
 } // namespace rpc
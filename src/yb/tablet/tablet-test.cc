@@ -50,10 +50,13 @@
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/join.h"
 
+#include "yb/rocksdb/db/filename.h"
+
 #include "yb/tablet/local_tablet_writer.h"
 #include "yb/tablet/tablet-test-base.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
+#include "yb/tablet/tablet_metadata.h"
 
 #include "yb/util/enums.h"
 #include "yb/util/slice.h"
@@ -66,6 +69,9 @@ using std::unordered_set;
 using std::string;
 using std::vector;
 
+DECLARE_string(rocksdb_cold_tier_dir);
+DECLARE_uint64(rocksdb_cold_tier_min_age_sec);
+
 namespace yb {
 namespace tablet {
 
@@ -227,5 +233,68 @@ TYPED_TEST(TestTablet, TestFlushedOpId) {
   ASSERT_EQ(id.index, start_index + 2*kCount);
 }
 
+size_t CountTableFiles(Env* env, const std::string& dir) {
+  std::vector<std::string> files;
+  CHECK_OK(env->GetChildren(dir, &files));
+  size_t result = 0;
+  for (const auto& file : files) {
+    uint64_t number;
+    rocksdb::FileType type;
+    if (rocksdb::ParseFileName(file, &number, &type) && type == rocksdb::kTableFile) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+TYPED_TEST(TestTablet, ColdTierPlacement) {
+  // Keep total number of rows within the INT8 key range.
+  const int32_t kNumRows = 30;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_cold_tier_dir) = this->GetTestPath("cold_tier");
+  // All flushed data is considered old.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_cold_tier_min_age_sec) = 0;
+  this->TabletReOpen();
+
+  auto tablet = this->tablet();
+  const auto hot_dir = tablet->metadata()->rocksdb_dir();
+  const auto cold_dir = tablet->metadata()->cold_tier_rocksdb_dir();
+  ASSERT_TRUE(this->env_->DirExists(cold_dir));
+
+  // Flushes always place files on the hot path.
+  this->InsertTestRows(0, kNumRows, 0);
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  this->InsertTestRows(kNumRows, kNumRows, 0);
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  ASSERT_EQ(2, CountTableFiles(this->env_.get(), hot_dir));
+  ASSERT_EQ(0, CountTableFiles(this->env_.get(), cold_dir));
+
+  tablet->TEST_ForceRocksDBCompact();
+  ASSERT_EQ(0, CountTableFiles(this->env_.get(), hot_dir));
+  ASSERT_EQ(1, CountTableFiles(this->env_.get(), cold_dir));
+  this->VerifyTestRows(0, 2 * kNumRows);
+
+  // Reads merge files from both tiers.
+  this->InsertTestRows(2 * kNumRows, kNumRows, 0);
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  ASSERT_EQ(1, CountTableFiles(this->env_.get(), hot_dir));
+  ASSERT_EQ(1, CountTableFiles(this->env_.get(), cold_dir));
+  this->VerifyTestRows(0, 3 * kNumRows);
+
+  // Cold tier directory is stored in metadata, so files placed there are found after the flag is
+  // cleared.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_cold_tier_dir) = "";
+  this->TabletReOpen();
+  tablet = this->tablet();
+  ASSERT_EQ(cold_dir, tablet->metadata()->cold_tier_rocksdb_dir());
+  this->VerifyTestRows(0, 3 * kNumRows);
+
+  // Without cold tier configured, compaction moves data back to the regular directory.
+  tablet->TEST_ForceRocksDBCompact();
+  ASSERT_EQ(1, CountTableFiles(this->env_.get(), hot_dir));
+  ASSERT_EQ(0, CountTableFiles(this->env_.get(), cold_dir));
+  this->VerifyTestRows(0, 3 * kNumRows);
+}
+
 } // namespace tablet
 } // namespace yb
@@ -62,6 +62,7 @@
 #include "yb/docdb/cql_operation.h"
 #include "yb/docdb/doc_read_context.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/doc_tombstone_density_collector.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_compaction_filter_intents.h"
@@ -217,6 +218,17 @@ DEFINE_UNKNOWN_bool(tablet_enable_ttl_file_filter, false,
             "Enables compaction to directly delete files that have expired based on TTL, "
             "rather than removing them via the normal compaction process.");
 
+DEFINE_NON_RUNTIME_uint64(rocksdb_cold_tier_min_age_sec, 7 * 24 * 60 * 60,
+    "SST files that contain only data with hybrid time older than this number of seconds are "
+    "considered cold when placing compaction output in --rocksdb_cold_tier_dir.");
+TAG_FLAG(rocksdb_cold_tier_min_age_sec, advanced);
+
+DEFINE_NON_RUNTIME_double(rocksdb_cold_tier_min_cold_input_ratio, 0.8,
+    "Compaction output is placed in --rocksdb_cold_tier_dir when cold input files make up at "
+    "least this fraction of the total compaction input size. Files that are already in the cold "
+    "tier and files older than --rocksdb_cold_tier_min_age_sec are cold.");
+TAG_FLAG(rocksdb_cold_tier_min_cold_input_ratio, advanced);
+
 DEFINE_test_flag(int32, slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -259,6 +271,7 @@ DECLARE_bool(consistent_restore);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
+DECLARE_string(rocksdb_cold_tier_dir);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DECLARE_int64(cdc_intent_retention_ms);
@@ -728,6 +741,8 @@ Status Tablet::OpenKeyValueTablet() {
       retention_policy_, &key_bounds_,
       std::bind(&Tablet::DeleteMarkerRetentionTime, this, _1),
       metadata_.get());
+  rocksdb_options.subcompaction_boundary_prefix_size =
+      docdb::CreateSubcompactionBoundaryPrefixSize();
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
     if (mem_table_flush_filter_factory_) {
@@ -760,6 +775,31 @@ Status Tablet::OpenKeyValueTablet() {
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
 
+  // Cold tier directory is stored in metadata, so files placed there are still found after
+  // --rocksdb_cold_tier_dir is cleared or changed.
+  RETURN_NOT_OK(metadata()->InitColdTierRocksDBDir());
+  const auto cold_tier_dir = metadata()->cold_tier_rocksdb_dir();
+  if (!cold_tier_dir.empty()) {
+    // Only the regular DB is tiered, intents are short-lived.
+    LOG_WITH_PREFIX(INFO) << "Using cold tier for RocksDB at: " << cold_tier_dir;
+    RETURN_NOT_OK_PREPEND(
+        metadata()->fs_manager()->env()->CreateDirs(cold_tier_dir),
+        Format("Failed to create RocksDB cold tier directory $0", cold_tier_dir));
+    regular_rocksdb_options.db_paths = {
+        rocksdb::DbPath(db_dir, std::numeric_limits<uint64_t>::max()),
+        rocksdb::DbPath(cold_tier_dir, std::numeric_limits<uint64_t>::max()),
+    };
+    static_assert(kColdTierRocksDBPathId == 1);
+    // When cold tier is no longer configured, compactions move data back to the regular
+    // directory.
+    if (!FLAGS_rocksdb_cold_tier_dir.empty()) {
+      regular_rocksdb_options.compaction_output_path_selector =
+          std::make_shared<docdb::DocDBCompactionOutputPathSelector>(
+              clock(), MonoDelta::FromSeconds(FLAGS_rocksdb_cold_tier_min_age_sec),
+              FLAGS_rocksdb_cold_tier_min_cold_input_ratio, kColdTierRocksDBPathId);
+    }
+  }
+
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
   rocksdb::Status rocksdb_open_status = rocksdb::DB::Open(regular_rocksdb_options, db_dir, &db);
@@ -778,6 +818,9 @@ Status Tablet::OpenKeyValueTablet() {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
     rocksdb::Options intents_rocksdb_options(rocksdb_options);
     intents_rocksdb_options.compaction_context_factory = {};
+    intents_rocksdb_options.subcompaction_boundary_prefix_size = {};
+    // Intents are never scanned with range bounds, so data block boundaries are useless there.
+    intents_rocksdb_options.table_properties_collector_factories = {};
     docdb::SetLogPrefix(&intents_rocksdb_options, LogPrefix(docdb::StorageDbType::kIntents));
 
     intents_rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
@@ -1305,7 +1348,9 @@ Status Tablet::WriteTransactionalBatch(
 
   last_batch_data.hybrid_time = hybrid_time;
   last_batch_data.next_write_id = writer.intra_txn_write_id();
-  transaction_participant()->BatchReplicated(transaction_id, last_batch_data);
+  transaction_participant()->BatchReplicated(
+      transaction_id, last_batch_data, writer.min_strong_intent_key(),
+      writer.max_strong_intent_key());
 
   return Status::OK();
 }
@@ -1846,6 +1891,13 @@ Status Tablet::WaitForFlush() {
   return Status::OK();
 }
 
+docdb::DocDB Tablet::doc_db() const {
+  return {
+    regular_db_.get(), intents_db_.get(), &key_bounds_,
+    transaction_participant_ ? &transaction_participant_->intents_index() : nullptr
+  };
+}
+
 Status Tablet::ImportData(const std::string& source_dir) {
   // We import only regular records, so don't have to deal with intents here.
   return regular_db_->Import(source_dir);
@@ -3822,6 +3874,24 @@ bool Tablet::IsEligibleForFullCompaction() {
       && GetCurrentVersionNumSSTFiles() != 0;
 }
 
+Result<bool> Tablet::HasHighTombstoneDensity() {
+  if (!docdb::TombstoneDensityCompactionEnabled()) {
+    return false;
+  }
+  auto scoped_operation = CreateNonAbortableScopedRWOperation();
+  RETURN_NOT_OK(scoped_operation);
+  if (!regular_db_) {
+    return false;
+  }
+  const auto directive = retention_policy_->GetRetentionDirective();
+  if (directive.retain_delete_markers_in_major_compaction) {
+    return false;
+  }
+  rocksdb::TablePropertiesCollection props;
+  RETURN_NOT_OK(regular_db_->GetPropertiesOfAllTables(&props));
+  return docdb::HasHighTombstoneDensity(props, directive.history_cutoff);
+}
+
 Status Tablet::VerifyDataIntegrity() {
   LOG_WITH_PREFIX(INFO) << "Beginning data integrity checks on this tablet";
 
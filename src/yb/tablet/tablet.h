@@ -576,7 +576,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   Status ForceFullRocksDBCompact(rocksdb::CompactionReason compaction_reason,
       docdb::SkipFlush skip_flush = docdb::SkipFlush::kFalse);
 
-  docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
+  docdb::DocDB doc_db() const;
 
   // Returns approximate middle key for tablet split:
   // - for hash-based partitions: encoded hash code in order to split by hash code.
@@ -739,6 +739,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // full compaction.
   bool IsEligibleForFullCompaction();
 
+  // Returns true when a regular DB SST file contains enough delete markers and expired values,
+  // that a full compaction with the current history cutoff would remove, for such compaction to
+  // be triggered. See docdb_tombstone_density_compaction_threshold.
+  Result<bool> HasHighTombstoneDensity();
+
   // Verifies the data on this tablet for consistency. Returns status OK if checks pass.
   Status VerifyDataIntegrity();
 
@@ -78,6 +78,13 @@
 
 DEPRECATE_FLAG(bool, enable_tablet_orphaned_block_deletion, "10_2022");
 
+DEFINE_NON_RUNTIME_string(rocksdb_cold_tier_dir, "",
+    "Directory on slower storage used for SST files of the regular RocksDB that contain mostly "
+    "data older than --rocksdb_cold_tier_min_age_sec, see "
+    "--rocksdb_cold_tier_min_cold_input_ratio. Tablet files are placed under "
+    "<dir>/rocksdb/table-<id>/tablet-<id>. Empty value disables cold tier placement.");
+TAG_FLAG(rocksdb_cold_tier_dir, advanced);
+
 using std::shared_ptr;
 using std::string;
 
@@ -351,6 +358,7 @@ Status KvStoreInfo::LoadFromPB(const std::string& tablet_log_prefix,
   kv_store_id = KvStoreId(pb.kv_store_id());
   if (local_superblock) {
     rocksdb_dir = pb.rocksdb_dir();
+    cold_tier_rocksdb_dir = pb.cold_tier_rocksdb_dir();
   }
   lower_bound_key = pb.lower_bound_key();
   upper_bound_key = pb.upper_bound_key();
@@ -406,6 +414,11 @@ Status KvStoreInfo::MergeWithRestored(
 void KvStoreInfo::ToPB(const TableId& primary_table_id, KvStoreInfoPB* pb) const {
   pb->set_kv_store_id(kv_store_id.ToString());
   pb->set_rocksdb_dir(rocksdb_dir);
+  if (cold_tier_rocksdb_dir.empty()) {
+    pb->clear_cold_tier_rocksdb_dir();
+  } else {
+    pb->set_cold_tier_rocksdb_dir(cold_tier_rocksdb_dir);
+  }
   if (lower_bound_key.empty()) {
     pb->clear_lower_bound_key();
   } else {
@@ -449,6 +462,7 @@ bool KvStoreInfo::TEST_Equals(const KvStoreInfo& lhs, const KvStoreInfo& rhs) {
   };
   return YB_STRUCT_EQUALS(kv_store_id,
                           rocksdb_dir,
+                          cold_tier_rocksdb_dir,
                           lower_bound_key,
                           upper_bound_key,
                           has_been_fully_compacted,
@@ -463,6 +477,17 @@ std::string MakeTabletDirName(const TabletId& tablet_id) {
   return Format("tablet-$0", tablet_id);
 }
 
+// Returns the cold tier directory for the specified regular RocksDB directory according to
+// --rocksdb_cold_tier_dir, mirroring its table-<id>/tablet-<id> layout.
+std::string MakeColdTierRocksDBDir(const std::string& rocksdb_dir) {
+  if (FLAGS_rocksdb_cold_tier_dir.empty() || rocksdb_dir.empty()) {
+    return "";
+  }
+  return JoinPathSegments(
+      FLAGS_rocksdb_cold_tier_dir, FsManager::kRocksDBDirName, BaseName(DirName(rocksdb_dir)),
+      BaseName(rocksdb_dir));
+}
+
 } // namespace
 
 // ============================================================================
@@ -499,6 +524,7 @@ Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateNew(
       data_top_dir, FsManager::kRocksDBDirName, table_dir_name, tablet_dir_name);
 
   RaftGroupMetadataPtr ret(new RaftGroupMetadata(data, rocksdb_dir, wal_dir));
+  ret->kv_store_.cold_tier_rocksdb_dir = MakeColdTierRocksDBDir(rocksdb_dir);
   RETURN_NOT_OK(ret->Flush());
   return ret;
 }
@@ -628,6 +654,13 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
         << "Unable to delete rocksdb data directory " << rocksdb_dir;
   }
 
+  const auto cold_tier_dir = this->cold_tier_rocksdb_dir();
+  if (!cold_tier_dir.empty() && fs_manager_->env()->FileExists(cold_tier_dir)) {
+    auto s = fs_manager_->env()->DeleteRecursively(cold_tier_dir);
+    LOG_IF_WITH_PREFIX(WARNING, !s.ok())
+        << "Unable to delete rocksdb cold tier directory " << cold_tier_dir;
+  }
+
   const auto intents_dir = this->intents_rocksdb_dir();
   if (fs_manager_->env()->FileExists(intents_dir)) {
     status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
@@ -1104,6 +1137,30 @@ string RaftGroupMetadata::data_root_dir() const {
   }
 }
 
+string RaftGroupMetadata::cold_tier_rocksdb_dir() const {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  return kv_store_.cold_tier_rocksdb_dir;
+}
+
+Status RaftGroupMetadata::InitColdTierRocksDBDir() {
+  {
+    std::lock_guard<MutexType> lock(data_mutex_);
+    auto configured_dir = MakeColdTierRocksDBDir(kv_store_.rocksdb_dir);
+    if (!kv_store_.cold_tier_rocksdb_dir.empty()) {
+      LOG_IF_WITH_PREFIX(WARNING, configured_dir != kv_store_.cold_tier_rocksdb_dir)
+          << "Keeping RocksDB cold tier directory " << kv_store_.cold_tier_rocksdb_dir
+          << " that could contain files, configured directory: "
+          << (configured_dir.empty() ? "<none>" : configured_dir);
+      return Status::OK();
+    }
+    if (configured_dir.empty()) {
+      return Status::OK();
+    }
+    kv_store_.cold_tier_rocksdb_dir = std::move(configured_dir);
+  }
+  return Flush();
+}
+
 string RaftGroupMetadata::wal_root_dir() const {
   std::string wal_dir = this->wal_dir();
 
@@ -1401,6 +1458,10 @@ Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateSubtabletMetadata(
   metadata->kv_store_.lower_bound_key = lower_bound_key;
   metadata->kv_store_.upper_bound_key = upper_bound_key;
   metadata->kv_store_.rocksdb_dir = GetSubRaftGroupDataDir(raft_group_id);
+  if (!kv_store_.cold_tier_rocksdb_dir.empty()) {
+    metadata->kv_store_.cold_tier_rocksdb_dir = JoinPathSegments(
+        DirName(kv_store_.cold_tier_rocksdb_dir), MakeTabletDirName(raft_group_id));
+  }
   metadata->kv_store_.has_been_fully_compacted = false;
   metadata->kv_store_.last_full_compaction_time = kNoLastFullCompactionTime;
   *metadata->partition_ = partition;
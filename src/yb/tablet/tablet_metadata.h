@@ -73,6 +73,9 @@ extern const std::string kIntentsSubdir;
 extern const std::string kIntentsDBSuffix;
 extern const std::string kSnapshotsDirSuffix;
 
+// Index of the cold tier directory in db_paths of the regular RocksDB.
+constexpr uint32_t kColdTierRocksDBPathId = 1;
+
 const uint64_t kNoLastFullCompactionTime = HybridTime::kMin.ToUint64();
 
 YB_STRONGLY_TYPED_BOOL(Primary);
@@ -199,6 +202,11 @@ struct KvStoreInfo {
   // `rocksdb_dir + kIntentsDBSuffix` path.
   std::string rocksdb_dir;
 
+  // The directory where regular RocksDB SST files placed on the cold storage tier are stored.
+  // Empty when cold tier was never configured for this KV-store. It is kept after
+  // --rocksdb_cold_tier_dir is changed, since files placed there are still referenced by the DB.
+  std::string cold_tier_rocksdb_dir;
+
   // Optional inclusive lower bound and exclusive upper bound for keys served by this KV-store.
   // See docdb::KeyBounds.
   std::string lower_bound_key;
@@ -332,6 +340,14 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata>,
   std::string intents_rocksdb_dir() const { return kv_store_.rocksdb_dir + kIntentsDBSuffix; }
   std::string snapshots_dir() const { return kv_store_.rocksdb_dir + kSnapshotsDirSuffix; }
 
+  // Returns the directory for regular RocksDB SST files placed on the cold storage tier, or empty
+  // string when cold tier was never configured for this Raft group.
+  std::string cold_tier_rocksdb_dir() const;
+
+  // Assigns the cold tier directory according to --rocksdb_cold_tier_dir and flushes metadata,
+  // if the directory was not assigned before. Already assigned directory is kept.
+  Status InitColdTierRocksDBDir();
+
   const std::string& lower_bound_key() const { return kv_store_.lower_bound_key; }
   const std::string& upper_bound_key() const { return kv_store_.upper_bound_key; }
 
@@ -29,6 +29,7 @@
 #include "yb/consensus/consensus_util.h"
 
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/intents_index.h"
 #include "yb/docdb/transaction_dump.h"
 
 #include "yb/rpc/poller.h"
@@ -329,7 +330,9 @@ class TransactionParticipant::Impl
     return std::make_pair(transaction.metadata().isolation, transaction.last_batch_data());
   }
 
-  void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data) {
+  void BatchReplicated(
+      const TransactionId& id, const TransactionalBatchData& data,
+      const Slice& min_intent_key, const Slice& max_intent_key) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = transactions_.find(id);
     if (it == transactions_.end()) {
@@ -338,6 +341,9 @@ class TransactionParticipant::Impl
       return;
     }
     (**it).BatchReplicated(data);
+    if (!min_intent_key.empty()) {
+      intents_index_.Add(id, min_intent_key, max_intent_key);
+    }
   }
 
   void RequestStatusAt(const StatusRequest& request) {
@@ -838,6 +844,10 @@ class TransactionParticipant::Impl
     return &participant_context_;
   }
 
+  docdb::IntentsIndex& intents_index() {
+    return intents_index_;
+  }
+
   HybridTime MinRunningHybridTime() {
     auto result = min_running_ht_.load(std::memory_order_acquire);
     if (result == HybridTime::kMax || result == HybridTime::kInvalid) {
@@ -1133,6 +1143,7 @@ class TransactionParticipant::Impl
     MinRunningNotifier min_running_notifier(&applier_);
     std::lock_guard<std::mutex> lock(mutex_);
     functor();
+    intents_index_.SetLoaded();
     TransactionsModifiedUnlocked(&min_running_notifier);
   }
 
@@ -1413,6 +1424,8 @@ class TransactionParticipant::Impl
       txn->SetLocalCommitData(pending_apply->commit_ht, pending_apply->state.aborted);
       txn->SetApplyData(pending_apply->state);
     }
+    // Key range of intents written before restart is unknown.
+    intents_index_.AddUnbounded(txn->id());
     transactions_.insert(txn);
     TransactionsModifiedUnlocked(&min_running_notifier);
   }
@@ -1460,6 +1473,7 @@ class TransactionParticipant::Impl
     recently_removed_transactions_cleanup_queue_.push_back({transaction.id(), now + 15s});
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
+    intents_index_.Remove(transaction.id());
     transactions_.erase(it);
     TransactionsModifiedUnlocked(min_running_notifier);
   }
@@ -1698,6 +1712,8 @@ class TransactionParticipant::Impl
   RWOperationCounter* pending_op_counter_ = nullptr;
 
   Transactions transactions_;
+  // Key ranges of intents of transactions_, updated while holding mutex_.
+  docdb::IntentsIndex intents_index_;
   // Ids of running requests, stored in increasing order.
   std::deque<int64_t> running_requests_;
   // Ids of complete requests, minimal request is on top.
@@ -1803,8 +1819,13 @@ boost::optional<std::pair<IsolationLevel, TransactionalBatchData>>
 }
 
 void TransactionParticipant::BatchReplicated(
-    const TransactionId& id, const TransactionalBatchData& data) {
-  return impl_->BatchReplicated(id, data);
+    const TransactionId& id, const TransactionalBatchData& data,
+    const Slice& min_intent_key, const Slice& max_intent_key) {
+  return impl_->BatchReplicated(id, data, min_intent_key, max_intent_key);
+}
+
+const docdb::IntentsIndex& TransactionParticipant::intents_index() const {
+  return impl_->intents_index();
 }
 
 HybridTime TransactionParticipant::LocalCommitTime(const TransactionId& id) {
@@ -138,7 +138,12 @@ class TransactionParticipant : public TransactionStatusManager {
       const TransactionId& id, size_t batch_idx,
       boost::container::small_vector_base<uint8_t>* encoded_replicated_batches);
 
-  void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data);
+  // Updates transaction state after its batch was replicated and written to intents DB.
+  // min_intent_key and max_intent_key are bounds of strong intent keys written by this batch,
+  // empty when batch has no strong intents.
+  void BatchReplicated(
+      const TransactionId& id, const TransactionalBatchData& data,
+      const Slice& min_intent_key, const Slice& max_intent_key);
 
   HybridTime LocalCommitTime(const TransactionId& id) override;
 
@@ -187,6 +192,9 @@ class TransactionParticipant : public TransactionStatusManager {
 
   TransactionParticipantContext* context() const;
 
+  // Key ranges of intents of running transactions.
+  const docdb::IntentsIndex& intents_index() const;
+
   HybridTime MinRunningHybridTime() const override;
 
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override;
@@ -19,6 +19,8 @@
 
 #include "yb/common/hybrid_time.h"
 
+#include "yb/docdb/doc_tombstone_density_collector.h"
+
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
@@ -50,6 +52,11 @@ DEFINE_RUNTIME_int32(scheduled_full_compaction_jitter_factor_percentage,
               "computed when scheduling a compaction, between 0 and (frequency * jitter factor) "
               "hours.");
 
+DEFINE_RUNTIME_uint64(docdb_tombstone_density_compaction_min_interval_sec, 3600,
+              "Minimal interval between the last full compaction of a tablet and a full "
+              "compaction triggered by high density of delete markers and expired values, "
+              "in seconds. Limits write amplification caused by such compactions.");
+
 namespace yb {
 namespace tserver {
 
@@ -63,6 +70,47 @@ FullCompactionManager::FullCompactionManager(TSTabletManager* ts_tablet_manager)
 void FullCompactionManager::ScheduleFullCompactions() {
   SetFrequencyAndJitterFromFlags();
   DoScheduleFullCompactions();
+  ScheduleTombstoneDensityCompactions();
+}
+
+void FullCompactionManager::ScheduleTombstoneDensityCompactions() {
+  if (!docdb::TombstoneDensityCompactionEnabled()) {
+    num_tombstone_density_scheduled_last_execution_.store(0);
+    return;
+  }
+
+  const auto now = ts_tablet_manager_->server()->Clock()->Now();
+  const auto min_interval = MonoDelta::FromSeconds(
+      ANNOTATE_UNPROTECTED_READ(FLAGS_docdb_tombstone_density_compaction_min_interval_sec));
+  int num_scheduled = 0;
+  for (auto& peer : ts_tablet_manager_->GetTabletPeers()) {
+    const auto tablet = peer->shared_tablet();
+    if (!tablet || !tablet->IsEligibleForFullCompaction()) {
+      continue;
+    }
+    const HybridTime last_compact_time(peer->tablet_metadata()->last_full_compaction_time());
+    if (!last_compact_time.is_special() && last_compact_time.AddDelta(min_interval) > now) {
+      continue;
+    }
+    auto high_density = tablet->HasHighTombstoneDensity();
+    if (!high_density.ok()) {
+      LOG(WARNING) << "Unable to check tombstone density of tablet " << peer->tablet_id()
+          << ": " << high_density.status();
+      continue;
+    }
+    if (!*high_density) {
+      continue;
+    }
+    Status s = tablet->TriggerFullCompactionIfNeeded(
+        rocksdb::CompactionReason::kTombstoneDensityCompaction);
+    if (s.ok()) {
+      num_scheduled++;
+    } else {
+      LOG(WARNING) << "Unable to schedule tombstone density compaction on tablet "
+          << peer->tablet_id() << ": " << s.ToString();
+    }
+  }
+  num_tombstone_density_scheduled_last_execution_.store(num_scheduled);
 }
 
 void FullCompactionManager::DoScheduleFullCompactions() {
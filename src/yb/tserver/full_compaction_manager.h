@@ -38,9 +38,16 @@ class FullCompactionManager {
   explicit FullCompactionManager(TSTabletManager* ts_tablet_manager);
 
   // Checks if the gflag values for the compaction frequency and jitter factor have changed
-  // since the last runs, and resets to those values if so. Then, runs DoScheduleFullCompactions().
+  // since the last runs, and resets to those values if so. Then, runs DoScheduleFullCompactions()
+  // and ScheduleTombstoneDensityCompactions().
   void ScheduleFullCompactions();
 
+  // Schedules full compactions on tablets that have SST files with high density of delete
+  // markers and expired values, see docdb_tombstone_density_compaction_threshold. A tablet is
+  // not compacted for this reason more often than once per
+  // docdb_tombstone_density_compaction_min_interval_sec after its last full compaction.
+  void ScheduleTombstoneDensityCompactions();
+
   MonoDelta compaction_frequency() const { return compaction_frequency_; }
 
   MonoDelta max_jitter() const { return max_jitter_; }
@@ -49,6 +56,12 @@ class FullCompactionManager {
   // DoScheduleFullCompactions().
   int num_scheduled_last_execution() const { return num_scheduled_last_execution_.load(); }
 
+  // Indicates the number of full compactions that were scheduled during the last execution of
+  // ScheduleTombstoneDensityCompactions().
+  int num_tombstone_density_scheduled_last_execution() const {
+    return num_tombstone_density_scheduled_last_execution_.load();
+  }
+
   // Provides public access to DetermineNextCompactTime() for tests.
   // Clears all precomputed next compaction times.
   HybridTime TEST_DetermineNextCompactTime(tablet::TabletPeerPtr peer, HybridTime now) {
@@ -129,6 +142,10 @@ class FullCompactionManager {
   // Number of compactions that were scheduled during the previous execution.
   // -1 indicates that there is no information about the previous execution.
   std::atomic<int> num_scheduled_last_execution_ = -1;
+
+  // Number of tombstone density compactions that were scheduled during the previous execution.
+  // -1 indicates that there is no information about the previous execution.
+  std::atomic<int> num_tombstone_density_scheduled_last_execution_ = -1;
 };
 
 } // namespace tserver
@@ -13,8 +13,12 @@
 
 #include "yb/tserver/pg_client_service.h"
 
+#include <unistd.h>
+
+#include <future>
 #include <mutex>
 #include <queue>
+#include <unordered_map>
 
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
@@ -34,9 +38,14 @@
 
 #include "yb/master/master_admin.proxy.h"
 
+#include "yb/rpc/constants.h"
 #include "yb/rpc/rpc_context.h"
 #include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_header.pb.h"
+#include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/scheduler.h"
+#include "yb/rpc/serialization.h"
+#include "yb/rpc/yb_rpc.h"
 
 #include "yb/tserver/pg_client_session.h"
 #include "yb/tserver/pg_create_table.h"
@@ -44,20 +53,41 @@
 #include "yb/tserver/pg_table_cache.h"
 #include "yb/tserver/tablet_server_interface.h"
 #include "yb/tserver/tserver_service.pb.h"
+#include "yb/tserver/tserver_shared_mem.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/result.h"
 #include "yb/util/shared_lock.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/status.h"
 #include "yb/util/flags.h"
+#include "yb/util/threadpool.h"
 
 using namespace std::literals;
+using namespace yb::size_literals;
 
 DEFINE_UNKNOWN_uint64(pg_client_session_expiration_ms, 60000,
               "Pg client session expiration time in milliseconds.");
 
+DEFINE_NON_RUNTIME_uint64(pg_client_shared_exchange_buffer_size, 1_MB,
+    "Size of the buffer of the shared memory exchange used by a pg client session. Larger "
+    "requests are sent over RPC, larger responses are transferred in several chunks.");
+TAG_FLAG(pg_client_shared_exchange_buffer_size, advanced);
+
+DEFINE_NON_RUNTIME_int32(pg_client_shared_exchange_max_threads, 64,
+    "Max number of threads serving shared memory exchanges of pg client sessions. Sessions "
+    "whose exchanges are not served send requests over RPC.");
+TAG_FLAG(pg_client_shared_exchange_max_threads, advanced);
+
+DEFINE_RUNTIME_uint64(pg_client_shared_exchange_idle_timeout_ms, 5000,
+    "Time without requests after which the shared memory exchange of a pg client session is "
+    "parked and its thread is released. The session sends requests over RPC until the exchange "
+    "is served again.");
+TAG_FLAG(pg_client_shared_exchange_idle_timeout_ms, advanced);
+
 namespace yb {
 namespace tserver {
 
@@ -109,6 +139,183 @@ using LockablePgClientSession = Lockable<PgClientSession>;
 using PgClientSessionLocker = Locker<PgClientSession>;
 using LockablePgClientSessionPtr = std::shared_ptr<LockablePgClientSession>;
 
+const rpc::RemoteMethod kPerformRemoteMethod("yb.tserver.PgClientService", "Perform");
+
+// Inbound call for the Perform request received over the shared memory exchange.
+// The request data is the RPC message without the length prefix, and the response is serialized
+// in the same format, so the client could parse it as a regular RPC response.
+class SharedExchangeInboundCall : public rpc::YBInboundCall {
+ public:
+  SharedExchangeInboundCall(rpc::RpcMetrics* rpc_metrics, Slice data)
+      : YBInboundCall(rpc_metrics, kPerformRemoteMethod), data_(data) {
+  }
+
+  const Endpoint& remote_address() const override {
+    static const Endpoint endpoint;
+    return endpoint;
+  }
+
+  const Endpoint& local_address() const override {
+    return remote_address();
+  }
+
+  CoarseTimePoint GetClientDeadline() const override {
+    return deadline_;
+  }
+
+  Status ParseParam(rpc::RpcCallParams* params) override {
+    rpc::RequestHeader header;
+    Slice body;
+    RETURN_NOT_OK(rpc::ParseYBMessage(data_, &header, &body));
+    if (header.timeout_millis()) {
+      deadline_ = ToCoarse(ReceiveTime()) + header.timeout_millis() * 1ms;
+    }
+    // Request data is located in the shared memory, that is reused for the response, so it
+    // should not be referenced after parsing.
+    data_ = Slice();
+    return ResultToStatus(params->ParseRequest(body, RefCntBuffer()));
+  }
+
+  std::future<Status> ResponseFuture() {
+    return response_promise_.get_future();
+  }
+
+  // Returns parts of the serialized response. Valid only after the response future is ready.
+  std::vector<Slice> ResponseParts() const {
+    std::vector<Slice> result;
+    result.reserve(response_blocks_.size());
+    for (const auto& block : response_blocks_) {
+      result.push_back(block.AsSlice());
+    }
+    if (!result.empty()) {
+      result.front().remove_prefix(rpc::kMsgLengthPrefixLength);
+    }
+    return result;
+  }
+
+ protected:
+  void Respond(AnyMessageConstPtr response, bool is_success) override {
+    auto body_size = response.SerializedSize();
+    rpc::ResponseHeader header;
+    header.set_call_id(call_id());
+    header.set_is_error(!is_success);
+    sidecars_.MoveOffsetsTo(body_size, header.mutable_sidecar_offsets());
+    auto buffer = rpc::SerializeRequest(body_size, sidecars_.size(), header, response);
+    if (!buffer.ok()) {
+      if (is_success) {
+        RespondFailure(rpc::ErrorStatusPB::ERROR_APPLICATION, buffer.status());
+      } else {
+        LOG(DFATAL) << "Failed to serialize failure: " << buffer.status();
+        response_promise_.set_value(buffer.status());
+      }
+      return;
+    }
+    response_blocks_.emplace_back(std::move(*buffer));
+    sidecars_.Flush(&response_blocks_);
+    response_promise_.set_value(Status::OK());
+  }
+
+ private:
+  Slice data_;
+  CoarseTimePoint deadline_ = CoarseTimePoint::max();
+  boost::container::small_vector<RefCntSlice, 4> response_blocks_;
+  std::promise<Status> response_promise_;
+};
+
+using PerformFunctor = std::function<void(
+    PgPerformRequestPB*, PgPerformResponsePB*, rpc::RpcContext*)>;
+
+// Serves Perform requests of a single session received over the shared memory exchange.
+// The exchange is served by a thread from the shared pool only while the session keeps sending
+// requests. After pg_client_shared_exchange_idle_timeout_ms without requests the exchange is
+// parked and the thread is released. The parked session sends requests over RPC, and the first
+// such request activates the runner again.
+class SharedExchangeRunner : public std::enable_shared_from_this<SharedExchangeRunner> {
+ public:
+  SharedExchangeRunner(
+      std::unique_ptr<SharedExchange> exchange, std::string name, rpc::RpcMetrics* rpc_metrics,
+      PerformFunctor perform)
+      : exchange_(std::move(exchange)), name_(std::move(name)), rpc_metrics_(rpc_metrics),
+        perform_(std::move(perform)) {
+  }
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  // Starts serving the exchange in the specified pool, unless it is already served.
+  // Does nothing when the pool has no free threads, the exchange stays parked in this case.
+  void Activate(ThreadPool* pool) {
+    if (running_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    auto status = pool->SubmitFunc([runner = shared_from_this()] {
+      runner->Execute();
+    });
+    if (!status.ok()) {
+      VLOG(2) << name_ << ": not activated: " << status;
+      running_.store(false, std::memory_order_release);
+    }
+  }
+
+  // Makes the serving thread exit after the request in progress is completed.
+  void SignalStop() {
+    exchange_->SignalStop();
+  }
+
+ private:
+  void Execute() {
+    exchange_->Unpark();
+    for (;;) {
+      auto data = exchange_->Poll(
+          CoarseMonoClock::now() +
+          GetAtomicFlag(&FLAGS_pg_client_shared_exchange_idle_timeout_ms) * 1ms);
+      if (!data.ok()) {
+        // TimedOut means that the exchange was parked because of inactivity.
+        if (!data.status().IsTimedOut() && !data.status().IsShutdownInProgress()) {
+          LOG(WARNING) << name_ << ": poll failed: " << data.status();
+          exchange_->SignalStop();
+        }
+        break;
+      }
+      auto status = Serve(*data);
+      if (!status.ok()) {
+        LOG_IF(WARNING, !status.IsShutdownInProgress()) << name_ << ": serve failed: " << status;
+        // The exchange is in the middle of the response, so it could not be used anymore.
+        exchange_->SignalStop();
+        break;
+      }
+    }
+    running_.store(false, std::memory_order_release);
+  }
+
+  Status Serve(Slice data) {
+    auto call = rpc::InboundCall::Create<SharedExchangeInboundCall>(rpc_metrics_, data);
+    auto response_future = call->ResponseFuture();
+    {
+      auto params = std::make_shared<
+          rpc::RpcCallPBParamsImpl<PgPerformRequestPB, PgPerformResponsePB>>();
+      auto* req = &params->request();
+      auto* resp = &params->response();
+      rpc::RpcContext context(call, std::move(params));
+      if (!context.responded()) {
+        perform_(req, resp, &context);
+      }
+    }
+    RETURN_NOT_OK(response_future.get());
+    return exchange_->Respond(call->ResponseParts(), call->GetClientDeadline());
+  }
+
+  const std::unique_ptr<SharedExchange> exchange_;
+  const std::string name_;
+  rpc::RpcMetrics* const rpc_metrics_;
+  const PerformFunctor perform_;
+  // Whether a task serving the exchange is submitted to the pool.
+  std::atomic<bool> running_{false};
+};
+
+using SharedExchangeRunnerPtr = std::shared_ptr<SharedExchangeRunner>;
+
 } // namespace
 
 template <class T>
@@ -181,11 +388,35 @@ class PgClientServiceImpl::Impl {
         check_expired_sessions_(scheduler),
         xcluster_safe_time_map_(xcluster_safe_time_map),
         response_cache_(metric_entity) {
+    if (metric_entity) {
+      shared_exchange_rpc_metrics_ = std::make_unique<rpc::RpcMetrics>(
+          scoped_refptr<MetricEntity>(metric_entity));
+    }
+    // Without queue, so a runner is not activated when all threads are busy.
+    WARN_NOT_OK(ThreadPoolBuilder("pg_exchange")
+                    .set_max_threads(FLAGS_pg_client_shared_exchange_max_threads)
+                    .set_max_queue_size(0)
+                    .Build(&shared_exchange_pool_),
+                "Failed to create shared exchange pool");
     ScheduleCheckExpiredSessions(CoarseMonoClock::now());
   }
 
   ~Impl() {
     check_expired_sessions_.Shutdown();
+    std::vector<SharedExchangeRunnerPtr> runners;
+    {
+      std::lock_guard<rw_spinlock> lock(mutex_);
+      for (auto& [session_id, runner] : shared_exchange_runners_) {
+        runners.push_back(std::move(runner));
+      }
+      shared_exchange_runners_.clear();
+    }
+    for (const auto& runner : runners) {
+      runner->SignalStop();
+    }
+    if (shared_exchange_pool_) {
+      shared_exchange_pool_->Shutdown();
+    }
   }
 
   Status Heartbeat(
@@ -200,10 +431,26 @@ class PgClientServiceImpl::Impl {
         xcluster_safe_time_map_, &response_cache_);
     resp->set_session_id(session_id);
 
+    SharedExchangeRunnerPtr runner;
+    if (req.use_shared_memory()) {
+      auto runner_result = StartSharedExchange(session_id);
+      if (runner_result.ok()) {
+        runner = std::move(*runner_result);
+        runner->Activate(shared_exchange_pool_.get());
+        resp->set_shared_exchange_name(runner->name());
+      } else {
+        LOG(WARNING) << "Failed to start shared exchange for session " << session_id << ": "
+                     << runner_result.status();
+      }
+    }
+
     std::lock_guard<rw_spinlock> lock(mutex_);
     auto it = sessions_.emplace(
         FLAGS_pg_client_session_expiration_ms * 1ms, std::move(session)).first;
     session_expiration_queue_.push({it->expiration(), session_id});
+    if (runner) {
+      shared_exchange_runners_.emplace(session_id, std::move(runner));
+    }
     return Status::OK();
   }
 
@@ -393,10 +640,10 @@ class PgClientServiceImpl::Impl {
   }
 
   void Perform(PgPerformRequestPB* req, PgPerformResponsePB* resp, rpc::RpcContext* context) {
-    auto status = DoPerform(req, resp, context);
-    if (!status.ok()) {
-      Respond(status, resp, context);
-    }
+    // The session sends requests over RPC while its shared exchange is parked, so start serving
+    // the exchange again.
+    ActivateSharedExchange(req->session_id());
+    ExecutePerform(req, resp, context);
   }
 
   void InvalidateTableCache() {
@@ -465,12 +712,60 @@ class PgClientServiceImpl::Impl {
           session_expiration_queue_.push({current_expiration, id});
         } else {
           sessions_.erase(it);
+          StopSharedExchange(id);
         }
       }
     }
     ScheduleCheckExpiredSessions(now);
   }
 
+  Result<SharedExchangeRunnerPtr> StartSharedExchange(uint64_t session_id) {
+    SCHECK(shared_exchange_rpc_metrics_, IllegalState, "Shared exchange metrics are not available");
+    SCHECK(shared_exchange_pool_, IllegalState, "Shared exchange pool is not available");
+    static std::atomic<uint64_t> exchange_serial_no{0};
+    auto name = Format("yb_pg_exchange_$0_$1", getpid(), ++exchange_serial_no);
+    auto exchange = VERIFY_RESULT(SharedExchange::Create(
+        name, FLAGS_pg_client_shared_exchange_buffer_size));
+    auto runner = std::make_shared<SharedExchangeRunner>(
+        std::move(exchange), std::move(name), shared_exchange_rpc_metrics_.get(),
+        [this](PgPerformRequestPB* req, PgPerformResponsePB* resp, rpc::RpcContext* context) {
+      ExecutePerform(req, resp, context);
+    });
+    VLOG(1) << "Created shared exchange " << runner->name() << " for session " << session_id;
+    return runner;
+  }
+
+  void ActivateSharedExchange(uint64_t session_id) {
+    SharedExchangeRunnerPtr runner;
+    {
+      SharedLock<rw_spinlock> lock(mutex_);
+      auto it = shared_exchange_runners_.find(session_id);
+      if (it == shared_exchange_runners_.end()) {
+        return;
+      }
+      runner = it->second;
+    }
+    runner->Activate(shared_exchange_pool_.get());
+  }
+
+  // The runner keeps serving the request in progress, it is destroyed when the request completes.
+  void StopSharedExchange(uint64_t session_id) REQUIRES(mutex_) {
+    auto it = shared_exchange_runners_.find(session_id);
+    if (it == shared_exchange_runners_.end()) {
+      return;
+    }
+    it->second->SignalStop();
+    shared_exchange_runners_.erase(it);
+  }
+
+  void ExecutePerform(
+      PgPerformRequestPB* req, PgPerformResponsePB* resp, rpc::RpcContext* context) {
+    auto status = DoPerform(req, resp, context);
+    if (!status.ok()) {
+      Respond(status, resp, context);
+    }
+  }
+
   Status DoPerform(PgPerformRequestPB* req, PgPerformResponsePB* resp, rpc::RpcContext* context) {
     return VERIFY_RESULT(GetSession(*req))->Perform(req, resp, context);
   }
@@ -510,6 +805,11 @@ class PgClientServiceImpl::Impl {
 
   std::atomic<int64_t> session_serial_no_{0};
 
+  std::unique_ptr<rpc::RpcMetrics> shared_exchange_rpc_metrics_;
+  std::unordered_map<uint64_t, SharedExchangeRunnerPtr> shared_exchange_runners_
+      GUARDED_BY(mutex_);
+  std::unique_ptr<ThreadPool> shared_exchange_pool_;
+
   rpc::ScheduledTaskTracker check_expired_sessions_;
 
   const XClusterSafeTimeMap* xcluster_safe_time_map_;
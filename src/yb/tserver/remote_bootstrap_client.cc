@@ -667,11 +667,23 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   RETURN_NOT_OK(CreateTabletDirectories(rocksdb_dir, meta_->fs_manager()));
 
+  // Files from the cold tier of the source are placed to the cold tier here when it is configured.
+  // Otherwise they are placed to the regular RocksDB directory, and found there by table cache.
+  const auto cold_tier_dir = meta_->cold_tier_rocksdb_dir();
+  if (!cold_tier_dir.empty()) {
+    RETURN_NOT_OK_PREPEND(env().CreateDirs(cold_tier_dir),
+                          Substitute("Failed to create RocksDB cold tier directory $0",
+                                     cold_tier_dir));
+  }
+
   DataIdPB data_id;
   data_id.set_type(DataIdPB::ROCKSDB_FILE);
   for (auto const& file_pb : new_superblock_.kv_store().rocksdb_files()) {
     auto start = MonoTime::Now();
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
+    const auto& dir =
+        file_pb.db_path_id() == tablet::kColdTierRocksDBPathId && !cold_tier_dir.empty()
+            ? cold_tier_dir : rocksdb_dir;
+    RETURN_NOT_OK(downloader_.DownloadFile(file_pb, dir, &data_id));
     auto elapsed = MonoTime::Now().GetDeltaSince(start);
     LOG_WITH_PREFIX(INFO)
         << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
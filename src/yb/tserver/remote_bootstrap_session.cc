@@ -43,6 +43,8 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/type_traits.h"
 
+#include "yb/rocksdb/db/filename.h"
+
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
@@ -169,6 +171,28 @@ Result<google::protobuf::RepeatedPtrField<tablet::FilePB>> ListFiles(const std::
   return result;
 }
 
+// Sets db_path_id for regular DB table files that reside in the cold tier directory of the tablet,
+// so remote bootstrap client could preserve their placement.
+void SetColdTierPathIds(
+    const std::string& cold_tier_dir, google::protobuf::RepeatedPtrField<tablet::FilePB>* files) {
+  auto env = Env::Default();
+  for (auto& file : *files) {
+    // Intents DB files are placed in subdirectory, and are never stored in the cold tier.
+    if (file.name().find('/') != std::string::npos) {
+      continue;
+    }
+    uint64_t number;
+    rocksdb::FileType type;
+    if (!rocksdb::ParseFileName(file.name(), &number, &type) ||
+        (type != rocksdb::kTableFile && type != rocksdb::kTableSBlockFile)) {
+      continue;
+    }
+    if (env->FileExists(rocksdb::MakeTableFileName(cold_tier_dir, number))) {
+      file.set_db_path_id(tablet::kColdTierRocksDBPathId);
+    }
+  }
+}
+
 const std::string RemoteBootstrapSession::kCheckpointsDir = "checkpoints";
 
 Status RemoteBootstrapSession::Init() {
@@ -213,6 +237,10 @@ Status RemoteBootstrapSession::Init() {
   auto status = tablet->snapshots().CreateCheckpoint(checkpoint_dir_);
   if (status.ok()) {
     *kv_store->mutable_rocksdb_files() = VERIFY_RESULT(ListFiles(checkpoint_dir_));
+    const auto cold_tier_dir = metadata->cold_tier_rocksdb_dir();
+    if (!cold_tier_dir.empty()) {
+      SetColdTierPathIds(cold_tier_dir, kv_store->mutable_rocksdb_files());
+    }
   } else if (!status.IsNotSupported()) {
     RETURN_NOT_OK(status);
   }
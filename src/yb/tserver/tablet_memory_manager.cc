@@ -21,6 +21,7 @@
 
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/table/compressed_secondary_cache.h"
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_options.h"
@@ -76,9 +77,43 @@ DEFINE_UNKNOWN_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_NON_RUNTIME_string(db_block_cache_type, "lru",
+    "Type of RocksDB block cache: lru or clock. Clock cache does not take locks on lookup, so it "
+    "scales better when many threads read hot blocks.");
+TAG_FLAG(db_block_cache_type, advanced);
+
+static bool ValidateBlockCacheType(const char* flag_name, const std::string& value) {
+  if (value != "lru" && value != "clock") {
+    LOG(ERROR) << "Invalid value for '" << flag_name << "': " << value
+               << ", must be 'lru' or 'clock'";
+    return false;
+  }
+  return true;
+}
+
+DEFINE_validator(db_block_cache_type, &ValidateBlockCacheType);
+
+DEFINE_NON_RUNTIME_int32(db_block_cache_compressed_percentage, 0,
+    "Percentage of the block cache memory used for the compressed secondary tier. Blocks evicted "
+    "from the block cache are kept there compressed, and are moved back on access. 0 to disable.");
+TAG_FLAG(db_block_cache_compressed_percentage, advanced);
+
+static bool ValidateCompressedPercentage(const char* flag_name, int32_t value) {
+  if (value < 0 || value >= 100) {
+    LOG(ERROR) << "Invalid value for '" << flag_name << "': " << value
+               << ", must be in [0, 100)";
+    return false;
+  }
+  return true;
+}
+
+DEFINE_validator(db_block_cache_compressed_percentage, &ValidateCompressedPercentage);
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
+DECLARE_int64(db_block_size_bytes);
+
 namespace yb {
 namespace tserver {
 
@@ -196,8 +231,21 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+    const int64_t compressed_size_bytes =
+        block_cache_size_bytes * FLAGS_db_block_cache_compressed_percentage / 100;
+    const int64_t primary_size_bytes = block_cache_size_bytes - compressed_size_bytes;
+    if (FLAGS_db_block_cache_type == "clock") {
+      options->block_cache = rocksdb::NewClockCache(
+          primary_size_bytes, FLAGS_db_block_size_bytes, FLAGS_db_block_cache_num_shard_bits);
+    } else {
+      options->block_cache = rocksdb::NewLRUCache(primary_size_bytes,
+                                                  FLAGS_db_block_cache_num_shard_bits);
+    }
+    if (compressed_size_bytes > 0) {
+      options->block_cache = rocksdb::NewCompressedSecondaryCache(
+          options->block_cache, compressed_size_bytes, FLAGS_db_block_cache_num_shard_bits,
+          block_based_table_mem_tracker_);
+    }
     options->block_cache->SetMetrics(metrics);
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
@@ -236,8 +236,8 @@ DEFINE_NON_RUNTIME_int32(full_compaction_pool_max_queue_size, 200,
 
 DEFINE_NON_RUNTIME_int32(scheduled_full_compaction_check_interval_min, 15,
              "The interval at which the scheduled full compaction task checks for tablets "
-             "eligible for compaction, in minutes. 0 indicates that the background task "
-             "is fully disabled.");
+             "eligible for compaction, including tablets with high density of delete markers, "
+             "in minutes. 0 indicates that the background task is fully disabled.");
 
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
@@ -0,0 +1,150 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/tserver/tserver_shared_mem.h"
+
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tserver {
+
+class SharedExchangeTest : public YBTest {
+ protected:
+  std::string ExchangeName() {
+    return Format("yb_test_exchange_$0_$1", getpid(), ++exchange_serial_no_);
+  }
+
+ private:
+  int exchange_serial_no_ = 0;
+};
+
+TEST_F(SharedExchangeTest, RequestResponse) {
+  constexpr size_t kBufferSize = 16;
+  auto name = ExchangeName();
+  auto server = ASSERT_RESULT(SharedExchange::Create(name, kBufferSize));
+  auto client = ASSERT_RESULT(SharedExchange::Open(name));
+  ASSERT_EQ(client->buffer_size(), kBufferSize);
+  // Exchange is parked until the server is ready to serve it.
+  ASSERT_FALSE(client->ReadyToSend());
+  ASSERT_TRUE(server->Unpark());
+
+  std::thread server_thread([&server] {
+    for (;;) {
+      auto request = server->Poll(CoarseTimePoint::max());
+      if (!request.ok()) {
+        ASSERT_TRUE(request.status().IsShutdownInProgress()) << request.status();
+        break;
+      }
+      // Response is larger than the buffer, so it is sent in several chunks.
+      auto text = request->ToBuffer();
+      std::string prefix = "response to ";
+      ASSERT_OK(server->Respond(
+          {Slice(prefix), Slice(text), Slice(text)}, CoarseMonoClock::now() + 10s));
+    }
+  });
+
+  for (int i = 0; i != 10; ++i) {
+    ASSERT_TRUE(client->ReadyToSend());
+    auto text = Format("request $0", i);
+    ASSERT_EQ(client->Obtain(kBufferSize + 1), nullptr);
+    auto* buffer = client->Obtain(text.size());
+    ASSERT_NE(buffer, nullptr);
+    memcpy(buffer, text.data(), text.size());
+    ASSERT_TRUE(client->SendRequest(text.size()));
+    ASSERT_FALSE(client->ReadyToSend());
+    auto response = ASSERT_RESULT(client->FetchResponse(CoarseMonoClock::now() + 10s));
+    ASSERT_EQ(response.AsSlice().ToBuffer(), "response to " + text + text);
+  }
+
+  server->SignalStop();
+  server_thread.join();
+  ASSERT_FALSE(client->ReadyToSend());
+}
+
+TEST_F(SharedExchangeTest, Timeout) {
+  auto name = ExchangeName();
+  auto server = ASSERT_RESULT(SharedExchange::Create(name, 1024));
+  auto client = ASSERT_RESULT(SharedExchange::Open(name));
+  ASSERT_TRUE(server->Unpark());
+
+  auto* buffer = client->Obtain(1);
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_TRUE(client->SendRequest(1));
+  auto response = client->FetchResponse(CoarseMonoClock::now() + 100ms);
+  ASSERT_NOK(response);
+  ASSERT_TRUE(response.status().IsTimedOut()) << response.status();
+  // Exchange could not be used after failure.
+  ASSERT_FALSE(client->ReadyToSend());
+}
+
+TEST_F(SharedExchangeTest, Park) {
+  auto name = ExchangeName();
+  auto server = ASSERT_RESULT(SharedExchange::Create(name, 1024));
+  auto client = ASSERT_RESULT(SharedExchange::Open(name));
+  ASSERT_TRUE(server->Unpark());
+  ASSERT_FALSE(server->Unpark());
+
+  // Server parks the exchange when there are no requests.
+  auto request = server->Poll(CoarseMonoClock::now() + 100ms);
+  ASSERT_NOK(request);
+  ASSERT_TRUE(request.status().IsTimedOut()) << request.status();
+  ASSERT_FALSE(client->ReadyToSend());
+  ASSERT_EQ(client->Obtain(1), nullptr);
+
+  // Request that was not sent because of parking does not break the exchange.
+  ASSERT_TRUE(server->Unpark());
+  auto* buffer = client->Obtain(1);
+  ASSERT_NE(buffer, nullptr);
+  request = server->Poll(CoarseMonoClock::now() + 100ms);
+  ASSERT_NOK(request);
+  ASSERT_FALSE(client->SendRequest(1));
+
+  ASSERT_TRUE(server->Unpark());
+  ASSERT_TRUE(client->ReadyToSend());
+  buffer = client->Obtain(1);
+  ASSERT_NE(buffer, nullptr);
+  *buffer = std::byte{42};
+  ASSERT_TRUE(client->SendRequest(1));
+  request = server->Poll(CoarseMonoClock::now() + 100ms);
+  ASSERT_OK(request);
+  ASSERT_EQ(request->size(), 1U);
+  ASSERT_OK(server->Respond({Slice("response")}, CoarseMonoClock::now() + 10s));
+  auto response = ASSERT_RESULT(client->FetchResponse(CoarseMonoClock::now() + 10s));
+  ASSERT_EQ(response.AsSlice().ToBuffer(), "response");
+}
+
+TEST_F(SharedExchangeTest, RespondTimeout) {
+  constexpr size_t kBufferSize = 16;
+  auto name = ExchangeName();
+  auto server = ASSERT_RESULT(SharedExchange::Create(name, kBufferSize));
+  auto client = ASSERT_RESULT(SharedExchange::Open(name));
+  ASSERT_TRUE(server->Unpark());
+
+  ASSERT_NE(client->Obtain(1), nullptr);
+  ASSERT_TRUE(client->SendRequest(1));
+  ASSERT_OK(server->Poll(CoarseMonoClock::now() + 10s));
+  // The client does not read the response, so the server does not wait for it forever.
+  std::string response(kBufferSize * 2, 'x');
+  auto status = server->Respond({Slice(response)}, CoarseMonoClock::now() + 100ms);
+  ASSERT_NOK(status);
+  ASSERT_TRUE(status.IsTimedOut()) << status;
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,367 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/tserver_shared_mem.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <climits>
+#include <thread>
+
+#include "yb/gutil/casts.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/errno.h"
+#include "yb/util/scope_exit.h"
+#include "yb/util/status_format.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+// kParked - the server does not wait for requests, so the client should not send them.
+YB_DEFINE_ENUM(SharedExchangeState,
+               (kParked)(kIdle)(kRequestSent)(kResponseChunk)(kChunkRequested)(kResponseSent)
+               (kShutdown));
+
+uint32_t StateValue(SharedExchangeState state) {
+  return static_cast<uint32_t>(to_underlying(state));
+}
+
+// Max time to wait in a single system call, so a process that missed the wake up because of
+// some bug would not hang forever.
+constexpr auto kMaxSingleWait = 1s;
+
+#if defined(__linux__)
+
+void FutexWait(std::atomic<uint32_t>* address, uint32_t expected, CoarseDuration timeout) {
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+  timespec ts = {
+    .tv_sec = static_cast<time_t>(ns / 1000000000),
+    .tv_nsec = static_cast<long>(ns % 1000000000), // NOLINT
+  };
+  // The futex is shared between processes, so FUTEX_PRIVATE_FLAG should not be used.
+  syscall(SYS_futex, address, FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t>* address) {
+  syscall(SYS_futex, address, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+void FutexWait(std::atomic<uint32_t>* address, uint32_t expected, CoarseDuration timeout) {
+  std::this_thread::sleep_for(std::min<CoarseDuration>(timeout, 100us));
+}
+
+void FutexWake(std::atomic<uint32_t>* address) {
+}
+
+#endif
+
+Result<std::string> SharedExchangePath(const std::string& name) {
+  SCHECK(name.find('/') == std::string::npos, InvalidArgument,
+         Format("Invalid shared exchange name: $0", name));
+  return GetSharedMemoryDirectory() + "/" + name;
+}
+
+} // namespace
+
+struct SharedExchangeHeader {
+  std::atomic<uint32_t> state{StateValue(SharedExchangeState::kParked)};
+  // Process id of the client, used by the server to detect that the client has exited.
+  std::atomic<int32_t> client_pid{0};
+  uint64_t buffer_size;
+  // Size of the request or the response chunk stored in the buffer.
+  uint64_t data_size = 0;
+  // Full size of the response, that could be sent in several chunks.
+  uint64_t response_size = 0;
+
+  explicit SharedExchangeHeader(uint64_t buffer_size_) : buffer_size(buffer_size_) {
+    static_assert(sizeof(state) == sizeof(uint32_t), "Futex should be 32 bit");
+    LOG_IF(FATAL, !IsAcceptableAtomicImpl(state)) << "Shared memory atomics must be lock-free";
+  }
+
+  SharedExchangeState State() const {
+    return static_cast<SharedExchangeState>(state.load(std::memory_order_acquire));
+  }
+
+  // Changes the state from the expected one, returns false if the state was different, i.e. the
+  // exchange was stopped.
+  bool Transition(SharedExchangeState from, SharedExchangeState to) {
+    auto expected = StateValue(from);
+    if (!state.compare_exchange_strong(expected, StateValue(to), std::memory_order_acq_rel)) {
+      return false;
+    }
+    FutexWake(&state);
+    return true;
+  }
+
+  template <class Predicate>
+  Result<SharedExchangeState> Wait(const Predicate& predicate, CoarseTimePoint deadline) {
+    for (;;) {
+      auto current = state.load(std::memory_order_acquire);
+      auto current_state = static_cast<SharedExchangeState>(current);
+      if (predicate(current_state)) {
+        return current_state;
+      }
+      if (current_state == SharedExchangeState::kShutdown) {
+        return STATUS(ShutdownInProgress, "Shared exchange stopped");
+      }
+      auto now = CoarseMonoClock::now();
+      if (now >= deadline) {
+        return STATUS_FORMAT(TimedOut, "Timed out waiting shared exchange, state: $0",
+                             current_state);
+      }
+      FutexWait(&state, current, std::min<CoarseDuration>(deadline - now, kMaxSingleWait));
+    }
+  }
+};
+
+SharedExchange::SharedExchange(SharedMemorySegment segment, std::string path)
+    : segment_(std::move(segment)), path_(std::move(path)),
+      header_(static_cast<SharedExchangeHeader*>(segment_.GetAddress())),
+      data_(pointer_cast<std::byte*>(header_ + 1)),
+      buffer_size_(header_->buffer_size) {
+}
+
+SharedExchange::~SharedExchange() {
+  if (!path_.empty() && unlink(path_.c_str()) == -1) {
+    LOG(WARNING) << "Failed to remove shared exchange file " << path_ << ": "
+                 << ErrnoToString(errno);
+  }
+}
+
+Result<std::unique_ptr<SharedExchange>> SharedExchange::Create(
+    const std::string& name, size_t buffer_size) {
+  auto path = VERIFY_RESULT(SharedExchangePath(name));
+  int fd = open(path.c_str(), O_CREAT | O_RDWR | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd == -1) {
+    return STATUS_FORMAT(IOError, "Failed to create shared exchange file $0: $1",
+                         path, ErrnoToString(errno));
+  }
+  bool created = false;
+  auto se = ScopeExit([fd, &path, &created] {
+    if (!created) {
+      close(fd);
+      unlink(path.c_str());
+    }
+  });
+
+  const size_t segment_size = sizeof(SharedExchangeHeader) + buffer_size;
+  if (ftruncate(fd, segment_size) == -1) {
+    return STATUS_FORMAT(IOError, "Failed to truncate shared exchange file $0: $1",
+                         path, ErrnoToString(errno));
+  }
+  auto segment = VERIFY_RESULT(SharedMemorySegment::Open(
+      fd, SharedMemorySegment::AccessMode::kReadWrite, segment_size));
+  created = true;
+  new (segment.GetAddress()) SharedExchangeHeader(buffer_size);
+  return std::unique_ptr<SharedExchange>(new SharedExchange(std::move(segment), std::move(path)));
+}
+
+Result<std::unique_ptr<SharedExchange>> SharedExchange::Open(const std::string& name) {
+  auto path = VERIFY_RESULT(SharedExchangePath(name));
+  int fd = open(path.c_str(), O_RDWR);
+  if (fd == -1) {
+    return STATUS_FORMAT(IOError, "Failed to open shared exchange file $0: $1",
+                         path, ErrnoToString(errno));
+  }
+  bool opened = false;
+  auto se = ScopeExit([fd, &opened] {
+    if (!opened) {
+      close(fd);
+    }
+  });
+
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    return STATUS_FORMAT(IOError, "Failed to stat shared exchange file $0: $1",
+                         path, ErrnoToString(errno));
+  }
+  SCHECK_GT(implicit_cast<size_t>(st.st_size), sizeof(SharedExchangeHeader), Corruption,
+            Format("Shared exchange file $0 is too small", path));
+  auto segment = VERIFY_RESULT(SharedMemorySegment::Open(
+      fd, SharedMemorySegment::AccessMode::kReadWrite, st.st_size));
+  opened = true;
+  auto result = std::unique_ptr<SharedExchange>(
+      new SharedExchange(std::move(segment), std::string()));
+  SCHECK_EQ(result->buffer_size() + sizeof(SharedExchangeHeader),
+            implicit_cast<size_t>(st.st_size), Corruption,
+            Format("Wrong size of shared exchange file $0", path));
+  result->header_->client_pid.store(getpid(), std::memory_order_release);
+  return result;
+}
+
+bool SharedExchange::ReadyToSend() const {
+  return !failed_ && header_->State() == SharedExchangeState::kIdle;
+}
+
+std::byte* SharedExchange::Obtain(size_t required_size) {
+  if (required_size > buffer_size_ || !ReadyToSend()) {
+    return nullptr;
+  }
+  return data_;
+}
+
+bool SharedExchange::SendRequest(size_t size) {
+  DCHECK_LE(size, buffer_size_);
+  header_->data_size = size;
+  if (header_->Transition(SharedExchangeState::kIdle, SharedExchangeState::kRequestSent)) {
+    return true;
+  }
+  if (header_->State() != SharedExchangeState::kParked) {
+    failed_ = true;
+  }
+  return false;
+}
+
+Result<RefCntBuffer> SharedExchange::FetchResponse(CoarseTimePoint deadline) {
+  bool done = false;
+  auto se = ScopeExit([this, &done] {
+    if (!done) {
+      failed_ = true;
+    }
+  });
+  RefCntBuffer result;
+  size_t received = 0;
+  for (;;) {
+    auto state = VERIFY_RESULT(header_->Wait([](SharedExchangeState state) {
+      return state == SharedExchangeState::kResponseChunk ||
+             state == SharedExchangeState::kResponseSent;
+    }, deadline));
+    if (received == 0) {
+      result = RefCntBuffer(header_->response_size);
+    }
+    auto size = header_->data_size;
+    SCHECK_LE(size, buffer_size_, Corruption,
+              Format("Shared exchange chunk is larger than buffer: $0", size));
+    SCHECK_LE(received + size, result.size(), Corruption,
+              Format("Shared exchange response overflow: $0 + $1 vs $2",
+                     received, size, result.size()));
+    memcpy(result.data() + received, data_, size);
+    received += size;
+    if (state == SharedExchangeState::kResponseSent) {
+      SCHECK_EQ(received, result.size(), Corruption, "Incomplete shared exchange response");
+      SCHECK(header_->Transition(SharedExchangeState::kResponseSent, SharedExchangeState::kIdle),
+             ShutdownInProgress, "Shared exchange stopped");
+      done = true;
+      return result;
+    }
+    SCHECK(header_->Transition(
+               SharedExchangeState::kResponseChunk, SharedExchangeState::kChunkRequested),
+           ShutdownInProgress, "Shared exchange stopped");
+  }
+}
+
+Result<Slice> SharedExchange::Poll(CoarseTimePoint deadline) {
+  for (;;) {
+    auto state = header_->Wait([](SharedExchangeState state) {
+      return state == SharedExchangeState::kRequestSent;
+    }, deadline);
+    if (state.ok()) {
+      break;
+    }
+    if (!state.status().IsTimedOut()) {
+      return state.status();
+    }
+    // The request could arrive right before parking, it should be served in this case.
+    if (header_->Transition(SharedExchangeState::kIdle, SharedExchangeState::kParked)) {
+      return state.status();
+    }
+  }
+  // The size is written by the client, so it should not be trusted.
+  auto size = header_->data_size;
+  SCHECK_LE(size, buffer_size_, Corruption,
+            Format("Shared exchange request is larger than buffer: $0", size));
+  return Slice(data_, size);
+}
+
+bool SharedExchange::Unpark() {
+  return header_->Transition(SharedExchangeState::kParked, SharedExchangeState::kIdle);
+}
+
+Status SharedExchange::CheckClientAlive() const {
+  auto pid = header_->client_pid.load(std::memory_order_acquire);
+  if (pid != 0 && kill(pid, 0) == -1 && errno == ESRCH) {
+    return STATUS_FORMAT(Aborted, "Shared exchange client $0 has exited", pid);
+  }
+  return Status::OK();
+}
+
+Status SharedExchange::WaitChunkRequested(CoarseTimePoint deadline) {
+  for (;;) {
+    // Wait in short intervals, so the exit of the client process is noticed.
+    auto state = header_->Wait([](SharedExchangeState state) {
+      return state == SharedExchangeState::kChunkRequested;
+    }, std::min(deadline, CoarseMonoClock::now() + kMaxSingleWait));
+    if (state.ok() || !state.status().IsTimedOut() || CoarseMonoClock::now() >= deadline) {
+      return ResultToStatus(state);
+    }
+    RETURN_NOT_OK(CheckClientAlive());
+  }
+}
+
+Status SharedExchange::Respond(const std::vector<Slice>& parts, CoarseTimePoint deadline) {
+  size_t total_size = 0;
+  for (const auto& part : parts) {
+    total_size += part.size();
+  }
+  header_->response_size = total_size;
+
+  auto state = SharedExchangeState::kRequestSent;
+  auto part = parts.begin();
+  size_t part_offset = 0;
+  for (;;) {
+    size_t size = 0;
+    while (part != parts.end() && size < buffer_size_) {
+      auto len = std::min(part->size() - part_offset, buffer_size_ - size);
+      memcpy(data_ + size, part->data() + part_offset, len);
+      size += len;
+      part_offset += len;
+      if (part_offset == part->size()) {
+        ++part;
+        part_offset = 0;
+      }
+    }
+    header_->data_size = size;
+    auto last = part == parts.end();
+    auto new_state = last ? SharedExchangeState::kResponseSent
+                          : SharedExchangeState::kResponseChunk;
+    SCHECK(header_->Transition(state, new_state), ShutdownInProgress, "Shared exchange stopped");
+    if (last) {
+      return Status::OK();
+    }
+    RETURN_NOT_OK(WaitChunkRequested(deadline));
+    state = SharedExchangeState::kChunkRequested;
+  }
+}
+
+void SharedExchange::SignalStop() {
+  header_->state.store(StateValue(SharedExchangeState::kShutdown), std::memory_order_release);
+  FutexWake(&header_->state);
+}
+
+} // namespace tserver
+} // namespace yb
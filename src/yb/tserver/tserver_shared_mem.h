@@ -14,13 +14,19 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <boost/asio/ip/tcp.hpp>
 
 #include "yb/tserver/tserver_util_fwd.h"
 
 #include "yb/util/atomic.h"
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_fwd.h"
+#include "yb/util/ref_cnt_buffer.h"
+#include "yb/util/shared_mem.h"
 #include "yb/util/slice.h"
 
 #include "yb/yql/pggate/ybc_pg_typedefs.h"
@@ -96,5 +102,85 @@ class TServerSharedData {
   std::atomic<uint64_t> db_catalog_versions_[kMaxNumDbCatalogVersions] = {0};
 };
 
+struct SharedExchangeHeader;
+
+// Exchange of requests and responses between a postgres backend and the local tserver over
+// a shared memory segment, that is used instead of loopback RPC.
+//
+// The backend writes the serialized request to the buffer and wakes the tserver. The tserver
+// writes the response to the same buffer, splitting it into chunks when the response does not
+// fit. Only one request could be in progress at a time. Waiting is implemented with futexes on
+// Linux and with polling on other platforms.
+//
+// The exchange is created parked, i.e. the tserver does not wait for requests and the backend
+// should not send them. The tserver unparks it when it is ready to serve requests, and parks it
+// again after some time without requests.
+class SharedExchange {
+ public:
+  // Creates a new exchange backed by the file with the specified name in the shared memory
+  // directory. The file is removed when the exchange is destroyed.
+  static Result<std::unique_ptr<SharedExchange>> Create(
+      const std::string& name, size_t buffer_size);
+
+  // Opens the exchange created by another process.
+  static Result<std::unique_ptr<SharedExchange>> Open(const std::string& name);
+
+  ~SharedExchange();
+
+  size_t buffer_size() const {
+    return buffer_size_;
+  }
+
+  // Client side interface.
+
+  // Returns true if there is no request in progress, and a new one could be sent.
+  bool ReadyToSend() const;
+
+  // Returns the buffer to serialize the request to, or nullptr if the request of the specified
+  // size could not be sent using this exchange.
+  std::byte* Obtain(size_t required_size);
+
+  // Sends the request of the specified size, that was serialized to the buffer returned by
+  // Obtain(). Returns false if the request was not sent, because the exchange was parked or
+  // stopped meanwhile.
+  bool SendRequest(size_t size);
+
+  // Waits for the response to the sent request and returns it.
+  // The exchange should not be used anymore if this function has failed.
+  Result<RefCntBuffer> FetchResponse(CoarseTimePoint deadline);
+
+  // Server side interface.
+
+  // Waits for the next request. If no request arrives before deadline, parks the exchange and
+  // returns TimedOut. Returns ShutdownInProgress after SignalStop(), and Corruption if the
+  // request size written by the client is invalid.
+  Result<Slice> Poll(CoarseTimePoint deadline);
+
+  // Makes the parked exchange ready to receive requests. Returns false if it was not parked.
+  bool Unpark();
+
+  // Sends the response that consists of the specified parts. Blocks until the client reads all
+  // chunks but the last one. Fails if the client does not read them before deadline, or the
+  // client process exits.
+  Status Respond(const std::vector<Slice>& parts, CoarseTimePoint deadline);
+
+  // Makes all current and future waits of both sides fail.
+  void SignalStop();
+
+ private:
+  SharedExchange(SharedMemorySegment segment, std::string path);
+
+  Status CheckClientAlive() const;
+  Status WaitChunkRequested(CoarseTimePoint deadline);
+
+  SharedMemorySegment segment_;
+  // Path of the backing file, set only in the process that created the exchange.
+  const std::string path_;
+  SharedExchangeHeader* header_;
+  std::byte* data_;
+  size_t buffer_size_;
+  bool failed_ = false;
+};
+
 }  // namespace tserver
 }  // namespace yb
@@ -71,6 +71,20 @@ METRIC_DEFINE_gauge_uint64(server, block_cache_multi_touch_usage,
                            "Multi Cache Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
                            "Memory consumed by the multi cache block cache");
+
+METRIC_DEFINE_counter(server, compressed_block_cache_inserts,
+                      "Compressed Block Cache Inserts", yb::MetricUnit::kBlocks,
+                      "Number of blocks evicted from the block cache and kept in compressed form");
+METRIC_DEFINE_counter(server, compressed_block_cache_hits,
+                      "Compressed Block Cache Hits", yb::MetricUnit::kBlocks,
+                      "Number of block cache misses that were served from the compressed cache");
+METRIC_DEFINE_counter(server, compressed_block_cache_misses,
+                      "Compressed Block Cache Misses", yb::MetricUnit::kBlocks,
+                      "Number of block cache misses that were not found in the compressed cache");
+METRIC_DEFINE_gauge_uint64(server, compressed_block_cache_usage,
+                           "Compressed Block Cache Memory Usage",
+                           yb::MetricUnit::kBytes,
+                           "Memory consumed by the compressed block cache");
 namespace yb {
 
 #define MINIT(member, x) member(METRIC_##x.Instantiate(entity))
@@ -87,6 +101,13 @@ CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity)
     GINIT(single_touch_cache_usage, block_cache_single_touch_usage),
     GINIT(multi_touch_cache_usage, block_cache_multi_touch_usage) {
 }
+
+CompressedCacheMetrics::CompressedCacheMetrics(const scoped_refptr<MetricEntity>& entity)
+  : MINIT(inserts, compressed_block_cache_inserts),
+    MINIT(cache_hits, compressed_block_cache_hits),
+    MINIT(cache_misses, compressed_block_cache_misses),
+    GINIT(cache_usage, compressed_block_cache_usage) {
+}
 #undef MINIT
 #undef GINIT
 
@@ -59,4 +59,15 @@ struct CacheMetrics {
   scoped_refptr<AtomicGauge<uint64_t> > multi_touch_cache_usage;
 };
 
+// Metrics of the compressed secondary tier of the block cache.
+struct CompressedCacheMetrics {
+  explicit CompressedCacheMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+
+  scoped_refptr<Counter> inserts;
+  scoped_refptr<Counter> cache_hits;
+  scoped_refptr<Counter> cache_misses;
+
+  scoped_refptr<AtomicGauge<uint64_t> > cache_usage;
+};
+
 } // namespace yb
@@ -60,6 +60,8 @@
 
 DECLARE_int32(o_direct_block_size_bytes);
 DECLARE_bool(TEST_simulate_fs_without_fallocate);
+DECLARE_bool(use_io_uring);
+DECLARE_bool(TEST_io_uring_fail_after_submit);
 
 #if !defined(__APPLE__)
 #include <linux/falloc.h>
@@ -181,6 +183,28 @@ class TestEnv : public YBTest, public ::testing::WithParamInterface<bool> {
     ASSERT_NO_FATALS(VerifyTestData(s, offset));
   }
 
+  void CheckMultiRead(const RandomAccessFile& raf, size_t file_size) {
+    // More reads than the size of the io_uring submission queue, the last one crosses end of file.
+    constexpr size_t kNumReads = 100;
+    constexpr size_t kReadLength = 4096;
+    std::vector<uint8_t> scratch(kNumReads * kReadLength);
+    std::vector<RandomAccessFile::ReadRequest> requests(kNumReads);
+    for (size_t i = 0; i != kNumReads; ++i) {
+      auto& request = requests[i];
+      request.offset = i + 1 == kNumReads ? file_size - 100 : RandomUniformInt<size_t>(
+          0, file_size - kReadLength);
+      request.n = kReadLength;
+      request.scratch = scratch.data() + i * kReadLength;
+    }
+    raf.MultiRead(requests.data(), requests.size());
+    for (const auto& request : requests) {
+      ASSERT_OK(request.status);
+      ASSERT_EQ(request.result.data(), request.scratch);
+      ASSERT_EQ(request.result.size(), std::min<size_t>(kReadLength, file_size - request.offset));
+      ASSERT_NO_FATALS(VerifyTestData(request.result, request.offset));
+    }
+  }
+
   void TestAppendVector(size_t num_slices, size_t slice_size, size_t iterations,
                         bool fast, bool pre_allocate, const WritableFileOptions& opts) {
     const string kTestPath = GetTestPath("test_env_appendvec_read_append");
@@ -531,6 +555,41 @@ TEST_F(TestEnv, TestReadFully) {
   ASSERT_STR_CONTAINS(status.ToString(), "EOF");
 }
 
+TEST_F(TestEnv, TestMultiRead) {
+  const string kTestPath = GetTestPath("test");
+  const size_t kFileSize = 1024 * 1024;
+  WriteTestFile(env_.get(), kTestPath, kFileSize);
+  ASSERT_NO_FATALS();
+
+  shared_ptr<RandomAccessFile> raf;
+  ASSERT_OK(env_util::OpenFileForRandom(env_.get(), kTestPath, &raf));
+
+  for (bool use_io_uring : {false, true}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_use_io_uring) = use_io_uring;
+    ASSERT_NO_FATALS(CheckMultiRead(*raf, kFileSize));
+  }
+}
+
+// Checks that reads submitted before io_uring failure do not affect the fallback reads and the
+// following batches.
+TEST_F(TestEnv, TestMultiReadRingFailure) {
+  const string kTestPath = GetTestPath("test");
+  const size_t kFileSize = 1024 * 1024;
+  WriteTestFile(env_.get(), kTestPath, kFileSize);
+  ASSERT_NO_FATALS();
+
+  shared_ptr<RandomAccessFile> raf;
+  ASSERT_OK(env_util::OpenFileForRandom(env_.get(), kTestPath, &raf));
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_use_io_uring) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_io_uring_fail_after_submit) = true;
+  ASSERT_NO_FATALS(CheckMultiRead(*raf, kFileSize));
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_io_uring_fail_after_submit) = false;
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_NO_FATALS(CheckMultiRead(*raf, kFileSize));
+  }
+}
+
 TEST_P(TestEnv, TestAppendVector) {
   WritableFileOptions opts;
   opts.o_direct = GetParam();
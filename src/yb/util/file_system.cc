@@ -33,6 +33,12 @@ Status RandomAccessFile::Read(uint64_t offset, size_t n, Slice* result, char* sc
   return Read(offset, n, result, reinterpret_cast<uint8_t*>(scratch));
 }
 
+void RandomAccessFile::MultiRead(ReadRequest* requests, size_t count) const {
+  for (auto* end = requests + count; requests != end; ++requests) {
+    requests->status = Read(requests->offset, requests->n, &requests->result, requests->scratch);
+  }
+}
+
 Status RandomAccessFile::InvalidateCache(size_t offset, size_t length) {
   return STATUS(NotSupported, "InvalidateCache not supported.");
 }
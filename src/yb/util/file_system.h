@@ -142,6 +142,23 @@ class RandomAccessFile : public FileWithUniqueId {
 
   Status Read(uint64_t offset, size_t n, Slice* result, char* scratch);
 
+  struct ReadRequest {
+    uint64_t offset;
+    size_t n;
+    uint8_t* scratch;
+
+    // Filled by MultiRead.
+    Slice result;
+    Status status;
+  };
+
+  // Performs a batch of independent reads. Result and status of each read are stored in its
+  // request, i.e. the same values that Read would return.
+  // Default implementation executes reads one by one.
+  //
+  // Safe for concurrent use by multiple threads.
+  virtual void MultiRead(ReadRequest* requests, size_t count) const;
+
   // Returns the size of the file
   virtual Result<uint64_t> Size() const = 0;
 
@@ -28,6 +28,9 @@
 #include "yb/util/coding.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/errno.h"
+#include "yb/util/flags.h"
+#include "yb/util/io_uring.h"
+#include "yb/util/logging.h"
 #include "yb/util/malloc.h"
 #include "yb/util/result.h"
 #include "yb/util/stats/iostats_context_imp.h"
@@ -62,6 +65,10 @@
 
 DECLARE_bool(never_fsync);
 
+DEFINE_NON_RUNTIME_bool(use_io_uring, false,
+    "Use io_uring to submit batches of random access file reads, e.g. SST data blocks fetched by "
+    "multi get, with a single system call. Falls back to pread when io_uring is not available.");
+
 namespace {
 
 // A wrapper for fadvise, if the platform doesn't support fadvise, it will simply return
@@ -204,6 +211,46 @@ Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
   return s;
 }
 
+void PosixRandomAccessFile::MultiRead(ReadRequest* requests, size_t count) const {
+  auto* ring = count > 1 && FLAGS_use_io_uring ? IoUring::ThreadLocal() : nullptr;
+  if (!ring) {
+    RandomAccessFile::MultiRead(requests, count);
+    return;
+  }
+
+  ThreadRestrictions::AssertIOAllowed();
+  std::vector<IoUring::ReadRequest> ring_requests(count);
+  for (size_t i = 0; i != count; ++i) {
+    auto& ring_request = ring_requests[i];
+    ring_request.fd = fd_;
+    ring_request.offset = requests[i].offset;
+    ring_request.size = requests[i].n;
+    ring_request.buffer = requests[i].scratch;
+  }
+  auto status = ring->Read(ring_requests.data(), count);
+  if (!status.ok()) {
+    LOG(WARNING) << "io_uring read of " << filename_ << " failed, falling back to pread: "
+                 << status;
+    RandomAccessFile::MultiRead(requests, count);
+    return;
+  }
+
+  for (size_t i = 0; i != count; ++i) {
+    const auto& ring_request = ring_requests[i];
+    auto& request = requests[i];
+    if (ring_request.error) {
+      request.result = Slice(request.scratch, static_cast<size_t>(0));
+      request.status = STATUS_IO_ERROR(filename_, ring_request.error);
+    } else {
+      request.result = Slice(request.scratch, ring_request.bytes_read);
+      request.status = Status::OK();
+    }
+  }
+  if (!use_os_buffer_) {
+    Fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);
+  }
+}
+
 Result<uint64_t> PosixRandomAccessFile::Size() const {
   TRACE_EVENT1("io", __PRETTY_FUNCTION__, "path", filename_);
   ThreadRestrictions::AssertIOAllowed();
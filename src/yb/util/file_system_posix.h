@@ -49,6 +49,9 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual Status Read(uint64_t offset, size_t n, Slice* result,
                       uint8_t* scratch) const override;
 
+  // Submits all reads with a single io_uring call when use_io_uring is set.
+  void MultiRead(ReadRequest* requests, size_t count) const override;
+
   Result<uint64_t> Size() const override;
 
   Result<uint64_t> INode() const override;
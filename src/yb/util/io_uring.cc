@@ -0,0 +1,329 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/io_uring.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define YB_HAS_IO_URING 1
+#endif
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "yb/util/errno.h"
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status_format.h"
+
+DEFINE_test_flag(bool, io_uring_fail_after_submit, false,
+                 "Simulate io_uring failure after reads were submitted to the kernel.");
+
+namespace yb {
+
+namespace {
+
+// Size of submission queue of thread local rings.
+constexpr uint32_t kThreadLocalEntries = 32;
+
+} // namespace
+
+#ifdef YB_HAS_IO_URING
+
+namespace {
+
+template <class T>
+T LoadAcquire(const T* ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+template <class T>
+void StoreRelease(T* ptr, T value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+} // namespace
+
+class IoUring::Impl {
+ public:
+  ~Impl() {
+    if (sqes_) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ptr_ && cq_ptr_ != sq_ptr_) {
+      munmap(cq_ptr_, cq_size_);
+    }
+    if (sq_ptr_) {
+      munmap(sq_ptr_, sq_size_);
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  Status Init(uint32_t entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd_ < 0) {
+      return STATUS_FORMAT(NotSupported, "io_uring_setup failed: $0", ErrnoToString(errno));
+    }
+
+    sq_entries_ = params.sq_entries;
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap) {
+      sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    }
+
+    sq_ptr_ = VERIFY_RESULT(Map(sq_size_, IORING_OFF_SQ_RING));
+    cq_ptr_ = single_mmap ? sq_ptr_ : VERIFY_RESULT(Map(cq_size_, IORING_OFF_CQ_RING));
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(VERIFY_RESULT(Map(sqes_size_, IORING_OFF_SQES)));
+
+    auto* sq = static_cast<char*>(sq_ptr_);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+
+    auto* cq = static_cast<char*>(cq_ptr_);
+    cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return Status::OK();
+  }
+
+  Status Read(ReadRequest* requests, size_t count) {
+    iovecs_.resize(count);
+    pending_.clear();
+    for (size_t i = 0; i != count; ++i) {
+      requests[i].bytes_read = 0;
+      requests[i].error = 0;
+      if (requests[i].size) {
+        pending_.push_back(i);
+      }
+    }
+
+    size_t next_pending = 0;
+    // Number of prepared entries, that were not yet consumed by the kernel.
+    uint32_t unsubmitted = 0;
+    uint32_t in_flight = 0;
+    while (next_pending < pending_.size() || unsubmitted || in_flight) {
+      // Completion queue is twice as large as submission queue, so it cannot overflow.
+      while (next_pending < pending_.size() && in_flight + unsubmitted < sq_entries_) {
+        Prepare(requests, pending_[next_pending++]);
+        ++unsubmitted;
+      }
+
+      auto submitted = static_cast<int>(syscall(
+          __NR_io_uring_enter, fd_, unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+      if (submitted < 0) {
+        if (IsRetryable(errno)) {
+          continue;
+        }
+        auto status = STATUS_IO_ERROR("io_uring_enter", errno);
+        Abort(unsubmitted, in_flight);
+        return status;
+      }
+      unsubmitted -= submitted;
+      in_flight += submitted;
+      if (FLAGS_TEST_io_uring_fail_after_submit && in_flight) {
+        Abort(unsubmitted, in_flight);
+        return STATUS(IOError, "Simulated io_uring failure");
+      }
+
+      in_flight -= ReapCompletions([this, requests](const io_uring_cqe& cqe) {
+        const auto index = static_cast<size_t>(cqe.user_data);
+        auto& request = requests[index];
+        if (cqe.res < 0) {
+          if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+            pending_.push_back(index);
+          } else {
+            request.error = -cqe.res;
+          }
+        } else if (cqe.res > 0) {
+          request.bytes_read += cqe.res;
+          if (request.bytes_read < request.size) {
+            pending_.push_back(index);
+          }
+        }
+        // Zero result means end of file.
+      });
+    }
+    return Status::OK();
+  }
+
+ private:
+  static bool IsRetryable(int error) {
+    return error == EINTR || error == EAGAIN || error == EBUSY;
+  }
+
+  // Invokes handler for each available completion and returns number of reaped completions.
+  template <class Handler>
+  uint32_t ReapCompletions(const Handler& handler) {
+    auto head = *cq_head_;
+    const auto tail = LoadAcquire(cq_tail_);
+    uint32_t result = 0;
+    for (; head != tail; ++head, ++result) {
+      handler(cqes_[head & cq_mask_]);
+    }
+    StoreRelease(cq_head_, head);
+    return result;
+  }
+
+  // Called when the ring failed in the middle of a batch. Requests that were submitted still
+  // reference caller buffers and iovecs_, so we should not return until the kernel completes
+  // them. Otherwise the kernel could write into freed memory, and stale completions would be
+  // attributed to requests of the next batch.
+  void Abort(uint32_t unsubmitted, uint32_t in_flight) {
+    // Entries that were not consumed by the kernel yet are dropped by moving the tail back.
+    // It is safe since the kernel consumes submission queue only during io_uring_enter.
+    StoreRelease(sq_tail_, *sq_tail_ - unsubmitted);
+
+    bool can_wait = true;
+    while (in_flight) {
+      in_flight -= ReapCompletions([](const io_uring_cqe&) {});
+      if (!in_flight) {
+        break;
+      }
+      if (can_wait) {
+        auto result = syscall(
+            __NR_io_uring_enter, fd_, 0, in_flight, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (result >= 0 || IsRetryable(errno)) {
+          continue;
+        }
+        // Completions are posted to the ring even when we cannot wait for them, so poll it.
+        LOG(WARNING) << "Failed to wait for " << in_flight << " io_uring completions: "
+                     << ErrnoToString(errno) << ", polling";
+        can_wait = false;
+      }
+      SleepFor(MonoDelta::FromMilliseconds(1));
+    }
+  }
+
+  Result<void*> Map(size_t size, uint64_t offset) {
+    auto* result = mmap(
+        nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+        static_cast<off_t>(offset));
+    if (result == MAP_FAILED) {
+      return STATUS_IO_ERROR("mmap io_uring", errno);
+    }
+    return result;
+  }
+
+  void Prepare(ReadRequest* requests, size_t index) {
+    auto& request = requests[index];
+    auto& iov = iovecs_[index];
+    iov.iov_base = request.buffer + request.bytes_read;
+    iov.iov_len = request.size - request.bytes_read;
+
+    const auto tail = *sq_tail_;
+    const auto sqe_index = tail & sq_mask_;
+    auto& sqe = sqes_[sqe_index];
+    memset(&sqe, 0, sizeof(sqe));
+    // READV is used instead of READ to support kernels older than 5.6.
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = request.fd;
+    sqe.off = request.offset + request.bytes_read;
+    sqe.addr = reinterpret_cast<uint64_t>(&iov);
+    sqe.len = 1;
+    sqe.user_data = index;
+    sq_array_[sqe_index] = sqe_index;
+    StoreRelease(sq_tail_, tail + 1);
+  }
+
+  int fd_ = -1;
+  uint32_t sq_entries_ = 0;
+
+  void* sq_ptr_ = nullptr;
+  size_t sq_size_ = 0;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t* sq_array_ = nullptr;
+
+  void* cq_ptr_ = nullptr;
+  size_t cq_size_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  // Per request iovec, should stay alive until request is completed.
+  std::vector<iovec> iovecs_;
+  // Indexes of requests that should be submitted, including resubmitted short reads.
+  std::vector<size_t> pending_;
+};
+
+#else
+
+class IoUring::Impl {
+ public:
+  Status Init(uint32_t entries) {
+    return STATUS(NotSupported, "io_uring is not supported on this platform");
+  }
+
+  Status Read(ReadRequest* requests, size_t count) {
+    return STATUS(NotSupported, "io_uring is not supported on this platform");
+  }
+};
+
+#endif
+
+IoUring::IoUring(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {
+}
+
+IoUring::~IoUring() = default;
+
+Result<std::unique_ptr<IoUring>> IoUring::Create(uint32_t entries) {
+  auto impl = std::make_unique<Impl>();
+  RETURN_NOT_OK(impl->Init(entries));
+  return std::unique_ptr<IoUring>(new IoUring(std::move(impl)));
+}
+
+IoUring* IoUring::ThreadLocal() {
+  static std::atomic<bool> unavailable{false};
+  thread_local std::unique_ptr<IoUring> ring;
+  if (!ring && !unavailable.load(std::memory_order_acquire)) {
+    auto result = Create(kThreadLocalEntries);
+    if (result.ok()) {
+      ring = std::move(*result);
+    } else if (!unavailable.exchange(true, std::memory_order_acq_rel)) {
+      LOG(WARNING) << "io_uring is not available, falling back to POSIX IO: " << result.status();
+    }
+  }
+  return ring.get();
+}
+
+Status IoUring::Read(ReadRequest* requests, size_t count) {
+  return impl_->Read(requests, count);
+}
+
+} // namespace yb
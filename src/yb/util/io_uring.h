@@ -0,0 +1,64 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "yb/util/result.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+// Minimal io_uring wrapper, that uses system calls directly, so does not depend on liburing.
+// Used to submit a batch of reads with a single system call and wait for all of them.
+// Instance is not thread safe, use ThreadLocal to obtain ring of the current thread.
+class IoUring {
+ public:
+  struct ReadRequest {
+    int fd;
+    uint64_t offset;
+    size_t size;
+    uint8_t* buffer;
+
+    // Filled by Read. Bytes read could be less than size only when end of file was reached.
+    size_t bytes_read = 0;
+    // errno of the failed read, 0 on success.
+    int error = 0;
+  };
+
+  ~IoUring();
+
+  // Returns NotSupported when io_uring is not available, e.g. old kernel or seccomp policy.
+  static Result<std::unique_ptr<IoUring>> Create(uint32_t entries);
+
+  // Returns ring of the current thread, or nullptr when io_uring is not available.
+  static IoUring* ThreadLocal();
+
+  // Performs all reads, resuming short reads. Returned status reflects failure of the ring itself,
+  // status of individual reads is stored in requests. Even on failure it returns only after the
+  // kernel completed all submitted reads, so buffers could be released and the ring reused.
+  Status Read(ReadRequest* requests, size_t count);
+
+ private:
+  class Impl;
+
+  explicit IoUring(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace yb
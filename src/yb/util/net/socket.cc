@@ -35,6 +35,10 @@
 #include <netinet/in.h>
 #include <sys/types.h>
 
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
+
 #include <limits>
 #include <string>
 
@@ -212,6 +216,17 @@ Status Socket::SetNoDelay(bool enabled) {
   return Status::OK();
 }
 
+Status Socket::SetLinger(bool enabled, int timeout_sec) {
+  struct linger value = {
+    .l_onoff = enabled ? 1 : 0,
+    .l_linger = timeout_sec,
+  };
+  if (setsockopt(fd_, SOL_SOCKET, SO_LINGER, &value, sizeof(value)) == -1) {
+    return STATUS(NetworkError, "Failed to set SO_LINGER", Errno(errno));
+  }
+  return Status::OK();
+}
+
 Status Socket::SetNonBlocking(bool enabled) {
   int curflags = ::fcntl(fd_, F_GETFL, 0);
   if (curflags == -1) {
@@ -271,6 +286,14 @@ Status Socket::SetReuseAddr(bool flag) {
   return Status::OK();
 }
 
+Status Socket::SetReusePort(bool flag) {
+  int int_flag = flag ? 1 : 0;
+  if (setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &int_flag, sizeof(int_flag)) == -1) {
+    return STATUS(NetworkError, "Failed to set SO_REUSEPORT", Errno(errno));
+  }
+  return Status::OK();
+}
+
 Status Socket::BindAndListen(const Endpoint& sockaddr,
                              int listenQueueSize) {
   RETURN_NOT_OK(SetReuseAddr(true));
@@ -426,7 +449,7 @@ Result<size_t> Socket::Write(const uint8_t *buf, ssize_t amt) {
   return res;
 }
 
-Result<size_t> Socket::Writev(const struct ::iovec *iov, int iov_len) {
+Result<size_t> Socket::Writev(const struct ::iovec *iov, int iov_len, int flags) {
   if (PREDICT_FALSE(iov_len <= 0)) {
     return STATUS(NetworkError,
                   StringPrintf("Writev: invalid io vector length of %d", iov_len),
@@ -438,7 +461,7 @@ Result<size_t> Socket::Writev(const struct ::iovec *iov, int iov_len) {
   memset(&msg, 0, sizeof(struct msghdr));
   msg.msg_iov = const_cast<iovec *>(iov);
   msg.msg_iovlen = iov_len;
-  auto res = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+  auto res = ::sendmsg(fd_, &msg, MSG_NOSIGNAL | flags);
   if (PREDICT_FALSE(res < 0)) {
     if (IsTemporarySocketError(errno)) {
       static const Status try_write_again = STATUS(TryAgain, "Write not yet ready");
@@ -450,6 +473,59 @@ Result<size_t> Socket::Writev(const struct ::iovec *iov, int iov_len) {
   return res;
 }
 
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+
+Status Socket::SetZeroCopy(bool enabled) {
+  int flag = enabled ? 1 : 0;
+  if (setsockopt(fd_, SOL_SOCKET, SO_ZEROCOPY, &flag, sizeof(flag)) == -1) {
+    return STATUS(NetworkError, "Failed to set SO_ZEROCOPY", Errno(errno));
+  }
+  return Status::OK();
+}
+
+Result<std::optional<Socket::ZeroCopyCompletion>> Socket::ReadZeroCopyCompletion() {
+  for (;;) {
+    char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (::recvmsg(fd_, &msg, MSG_ERRQUEUE) == -1) {
+      if (IsTemporarySocketError(errno)) {
+        return std::nullopt;
+      }
+      return STATUS(NetworkError, "Failed to read socket error queue", Errno(errno));
+    }
+    for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      const auto* err = pointer_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+      if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      return ZeroCopyCompletion {
+        .first = err->ee_info,
+        .last = err->ee_data,
+        .copied = (err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0,
+      };
+    }
+  }
+}
+
+#else
+
+Status Socket::SetZeroCopy(bool enabled) {
+  return STATUS(NotSupported, "Zero copy send is not supported on this platform");
+}
+
+Result<std::optional<Socket::ZeroCopyCompletion>> Socket::ReadZeroCopyCompletion() {
+  return std::nullopt;
+}
+
+#endif
+
 // Mostly follows writen() from Stevens (2004) or Kerrisk (2010).
 Status Socket::BlockingWrite(const uint8_t *buf, size_t buflen, const MonoTime& deadline) {
   DCHECK_LE(buflen, std::numeric_limits<int32_t>::max()) << "Writes > INT32_MAX not supported";
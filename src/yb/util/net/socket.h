@@ -32,6 +32,7 @@
 #pragma once
 
 #include <sys/uio.h>
+#include <optional>
 #include <string>
 
 #include <boost/container/small_vector.hpp>
@@ -98,6 +99,10 @@ class Socket {
   // Set or clear TCP_NODELAY
   Status SetNoDelay(bool enabled);
 
+  // Implements the SOL_SOCKET/SO_LINGER socket option. Enabled linger with zero timeout makes
+  // Close() reset the connection and drop unsent data.
+  Status SetLinger(bool enabled, int timeout_sec);
+
   // Set or clear O_NONBLOCK
   Status SetNonBlocking(bool enabled);
   Status IsNonBlocking(bool* is_nonblock) const;
@@ -111,6 +116,9 @@ class Socket {
   // Sets SO_REUSEADDR to 'flag'. Should be used prior to Bind().
   Status SetReuseAddr(bool flag);
 
+  // Sets SO_REUSEPORT to 'flag'. Should be used prior to Bind().
+  Status SetReusePort(bool flag);
+
   // Convenience method to invoke the common sequence:
   // 1) SetReuseAddr(true)
   // 2) Bind()
@@ -144,7 +152,8 @@ class Socket {
 
   Result<size_t> Write(const uint8_t *buf, ssize_t amt);
 
-  Result<size_t> Writev(const struct ::iovec *iov, int iov_len);
+  // Extra flags are passed to sendmsg, e.g. MSG_ZEROCOPY.
+  Result<size_t> Writev(const struct ::iovec *iov, int iov_len, int flags = 0);
 
   // Blocking Write call, returns IOError unless full buffer is sent.
   // Underlying Socket expected to be in blocking mode. Fails if any Write() sends 0 bytes.
@@ -169,6 +178,23 @@ class Socket {
   Result<int32_t> GetReceiveBufferSize();
   Status SetReceiveBufferSize(int32_t size);
 
+  // Sets SO_ZEROCOPY, so MSG_ZEROCOPY could be passed to Writev.
+  // Returns NotSupported if zero copy send is not available on this platform.
+  Status SetZeroCopy(bool enabled);
+
+  struct ZeroCopyCompletion {
+    // Range of completed zero copy sends, both ends inclusive. Each successful Writev with
+    // MSG_ZEROCOPY gets the next number, starting from 0.
+    uint32_t first;
+    uint32_t last;
+    // The kernel has copied data instead of sending it from user pages, e.g. for loopback.
+    bool copied;
+  };
+
+  // Reads the next zero copy completion from the socket error queue, returns std::nullopt when
+  // there are no more completions.
+  Result<std::optional<ZeroCopyCompletion>> ReadZeroCopyCompletion();
+
  private:
   // Called internally from SetSend/RecvTimeout().
   Status SetTimeout(int opt, std::string optname, const MonoDelta& timeout);
@@ -67,7 +67,8 @@ Result<void*> MMap(int fd, SharedMemorySegment::AccessMode access_mode, size_t s
   return segment_address;
 }
 
-// Returns the directory in which all shared memory files should be created.
+}  // namespace
+
 std::string GetSharedMemoryDirectory() {
   std::string directory = "/tmp";
 
@@ -101,6 +102,8 @@ std::string GetSharedMemoryDirectory() {
   return directory;
 }
 
+namespace {
+
 #if defined(__linux__)
 int memfd_create() {
   // This name doesn't really matter, it is only useful for debugging purposes.
@@ -15,12 +15,17 @@
 
 #include <sys/mman.h>
 
+#include <string>
+
 #include <glog/logging.h>
 
 #include "yb/util/result.h"
 
 namespace yb {
 
+// Returns the directory in which all shared memory files should be created.
+std::string GetSharedMemoryDirectory();
+
 class SharedMemorySegment {
  public:
   // Represents a mode of access to shared memory.
@@ -38,6 +38,7 @@
 #include <sys/types.h>
 
 #if defined(__linux__)
+#include <sched.h>
 #include <sys/prctl.h>
 #endif // defined(__linux__)
 
@@ -600,6 +601,68 @@ void SetThreadName(const std::string& name) {
   }
 }
 
+Status SetCurrentThreadCpuAffinity(const std::vector<int>& cpus) {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    return STATUS(RuntimeError, Format("Failed to set affinity to CPUs $0", cpus), Errno(err));
+  }
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "Thread affinity is not supported on this platform");
+#endif // defined(__linux__)
+}
+
+#if defined(__linux__)
+namespace {
+
+std::vector<int> CpuSetToVector(const cpu_set_t& cpu_set) {
+  std::vector<int> result;
+  for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+} // namespace
+#endif // defined(__linux__)
+
+Result<std::vector<int>> GetCurrentThreadCpuAffinity() {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  int err = pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    return STATUS(RuntimeError, "Failed to get thread affinity", Errno(err));
+  }
+  return CpuSetToVector(cpu_set);
+#else
+  return STATUS(NotSupported, "Thread affinity is not supported on this platform");
+#endif // defined(__linux__)
+}
+
+Result<std::vector<int>> GetProcessCpuAffinity() {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  // Affinity of the main thread, whose id is equal to the process id. The calling thread could be
+  // already pinned to a subset of the process CPUs.
+  if (sched_getaffinity(getpid(), sizeof(cpu_set), &cpu_set) != 0) {
+    return STATUS(RuntimeError, "Failed to get process affinity", Errno(errno));
+  }
+  return CpuSetToVector(cpu_set);
+#else
+  return STATUS(NotSupported, "Process affinity is not supported on this platform");
+#endif // defined(__linux__)
+}
+
 void InitThreading() {
   std::call_once(init_threading_internal_once_flag, InitThreadingInternal);
 }
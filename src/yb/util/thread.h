@@ -405,6 +405,16 @@ void InitThreading();
 
 void SetThreadName(const std::string& name);
 
+// Restricts the current thread to run only on the specified CPUs.
+// Returns NotSupported on platforms without thread affinity.
+Status SetCurrentThreadCpuAffinity(const std::vector<int>& cpus);
+
+// Returns CPUs that the current thread is allowed to run on.
+Result<std::vector<int>> GetCurrentThreadCpuAffinity();
+
+// Returns CPUs that the process is allowed to run on, as restricted by taskset or cpuset cgroup.
+Result<std::vector<int>> GetProcessCpuAffinity();
+
 class CDSAttacher {
  public:
   CDSAttacher();
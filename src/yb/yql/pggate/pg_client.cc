@@ -13,6 +13,9 @@
 
 #include "yb/yql/pggate/pg_client.h"
 
+#include <condition_variable>
+#include <mutex>
+
 #include "yb/client/client-internal.h"
 #include "yb/client/table.h"
 #include "yb/client/table_info.h"
@@ -21,8 +24,11 @@
 
 #include "yb/gutil/casts.h"
 
+#include "yb/rpc/call_data.h"
+#include "yb/rpc/outbound_call.h"
 #include "yb/rpc/poller.h"
 #include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_header.pb.h"
 
 #include "yb/tserver/pg_client.pb.h"
 #include "yb/tserver/pg_client.proxy.h"
@@ -35,6 +41,7 @@
 #include "yb/util/scope_exit.h"
 #include "yb/util/shared_mem.h"
 #include "yb/util/status.h"
+#include "yb/util/thread.h"
 
 #include "yb/yql/pggate/pg_op.h"
 #include "yb/yql/pggate/pg_tabledesc.h"
@@ -43,6 +50,7 @@
 DECLARE_bool(use_node_hostname_for_local_tserver);
 DECLARE_int32(backfill_index_client_rpc_timeout_ms);
 DECLARE_int32(yb_client_admin_operation_timeout_sec);
+DECLARE_bool(pg_client_use_shared_memory);
 
 DEFINE_UNKNOWN_uint64(pg_client_heartbeat_interval_ms, 10000,
     "Pg client heartbeat interval in ms.");
@@ -65,11 +73,27 @@ struct PerformData {
   PgsqlOps operations;
   tserver::LWPgPerformResponsePB resp;
   rpc::RpcController controller;
-  PerformCallback callback;
+  std::promise<PerformResult> promise;
 
   explicit PerformData(ThreadSafeArena* arena) : resp(arena) {
   }
 
+  PerformResult MakeResult(const Status& status, rpc::CallResponsePtr response) {
+    PerformResult result;
+    result.status = status;
+    result.response = std::move(response);
+    if (result.status.ok()) {
+      result.status = ResponseStatus(resp);
+    }
+    if (result.status.ok()) {
+      result.status = Process();
+    }
+    if (result.status.ok() && resp.has_catalog_read_time()) {
+      result.catalog_read_time = ReadHybridTime::FromPB(resp.catalog_read_time());
+    }
+    return result;
+  }
+
   Status Process() {
     auto& responses = *resp.mutable_responses();
     SCHECK_EQ(implicit_cast<size_t>(responses.size()), operations.size(), RuntimeError,
@@ -139,6 +163,15 @@ class PgClient::Impl {
 
   void Shutdown() {
     heartbeat_poller_.Shutdown();
+    if (exchange_waiter_) {
+      {
+        std::lock_guard<std::mutex> lock(exchange_mutex_);
+        exchange_stopped_ = true;
+      }
+      exchange_cond_.notify_all();
+      exchange_->SignalStop();
+      exchange_waiter_->Join();
+    }
     proxy_ = nullptr;
   }
 
@@ -153,6 +186,8 @@ class PgClient::Impl {
     tserver::PgHeartbeatRequestPB req;
     if (!create) {
       req.set_session_id(session_id_);
+    } else if (FLAGS_pg_client_use_shared_memory) {
+      req.set_use_shared_memory(true);
     }
     proxy_->HeartbeatAsync(
         req, &heartbeat_resp_, PrepareHeartbeatController(),
@@ -162,6 +197,7 @@ class PgClient::Impl {
         if (!status.ok()) {
           create_session_promise_.set_value(status);
         } else {
+          OpenSharedExchange(heartbeat_resp_.shared_exchange_name());
           create_session_promise_.set_value(heartbeat_resp_.session_id());
         }
       }
@@ -172,6 +208,56 @@ class PgClient::Impl {
     });
   }
 
+  void OpenSharedExchange(const std::string& name) {
+    if (name.empty()) {
+      return;
+    }
+    auto exchange = tserver::SharedExchange::Open(name);
+    if (!exchange.ok()) {
+      LOG_WITH_PREFIX(WARNING) << "Failed to open shared exchange, using RPC: "
+                               << exchange.status();
+      return;
+    }
+    exchange_ = std::move(*exchange);
+    auto waiter = Thread::Make("pggate", "shared_exchange", [this] { WaitSharedExchange(); });
+    if (!waiter.ok()) {
+      LOG_WITH_PREFIX(WARNING) << "Failed to start shared exchange waiter, using RPC: "
+                               << waiter.status();
+      exchange_ = nullptr;
+      return;
+    }
+    exchange_waiter_ = std::move(*waiter);
+  }
+
+  // Fetches responses to requests sent over the shared exchange. It is done by a dedicated thread,
+  // so the result becomes ready as soon as the response arrives, and the exchange is released for
+  // the next request without waiting for somebody to request the result.
+  void WaitSharedExchange() {
+    for (;;) {
+      std::shared_ptr<PerformData> data;
+      CoarseTimePoint deadline;
+      {
+        std::unique_lock<std::mutex> lock(exchange_mutex_);
+        exchange_cond_.wait(lock, [this] {
+          return exchange_stopped_ || exchange_data_ != nullptr;
+        });
+        if (!exchange_data_) {
+          return;
+        }
+        data = exchange_data_;
+        deadline = exchange_deadline_;
+      }
+      auto response = FetchFromSharedExchange(&data->resp, deadline);
+      {
+        std::lock_guard<std::mutex> lock(exchange_mutex_);
+        exchange_data_ = nullptr;
+      }
+      data->promise.set_value(response.ok()
+          ? data->MakeResult(Status::OK(), std::move(*response))
+          : data->MakeResult(response.status(), nullptr));
+    }
+  }
+
   void SetTimeout(MonoDelta timeout) {
     timeout_ = timeout + kExtraTimeout;
   }
@@ -366,10 +452,9 @@ class PgClient::Impl {
     return ResponseStatus(resp);
   }
 
-  void PerformAsync(
+  std::future<PerformResult> PerformAsync(
       tserver::PgPerformOptionsPB* options,
-      PgsqlOps* operations,
-      const PerformCallback& callback) {
+      PgsqlOps* operations) {
     auto& arena = operations->front()->arena();
     tserver::LWPgPerformRequestPB req(&arena);
     req.set_session_id(session_id_);
@@ -378,24 +463,68 @@ class PgClient::Impl {
 
     auto data = std::make_shared<PerformData>(&arena);
     data->operations = std::move(*operations);
-    data->callback = callback;
-    data->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kReactorThread);
 
-    proxy_->PerformAsync(req, &data->resp, SetupController(&data->controller), [data] {
-      PerformResult result;
-      result.status = data->controller.status();
-      result.response = data->controller.response();
-      if (result.status.ok()) {
-        result.status = ResponseStatus(data->resp);
-      }
-      if (result.status.ok()) {
-        result.status = data->Process();
-      }
-      if (result.status.ok() && data->resp.has_catalog_read_time()) {
-        result.catalog_read_time = ReadHybridTime::FromPB(data->resp.catalog_read_time());
+    auto future = data->promise.get_future();
+    if (exchange_) {
+      std::lock_guard<std::mutex> lock(exchange_mutex_);
+      // The exchange holds a single request, so a request that overlaps with the one in
+      // progress is sent over RPC.
+      if (!exchange_data_ && SendToSharedExchange(req)) {
+        exchange_data_ = data;
+        exchange_deadline_ = CoarseMonoClock::now() + timeout_;
+        exchange_cond_.notify_one();
+        return future;
       }
-      data->callback(result);
+      VLOG_WITH_PREFIX(2) << "Shared exchange is not available, using RPC";
+    }
+
+    data->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kReactorThread);
+    proxy_->PerformAsync(req, &data->resp, SetupController(&data->controller), [data] {
+      data->promise.set_value(
+          data->MakeResult(data->controller.status(), data->controller.response()));
     });
+    return future;
+  }
+
+  // Serializes the request to the shared exchange in the same format as the RPC request, but
+  // without the length prefix. Returns false if the exchange is busy or parked, or the request
+  // does not fit to it, so the request should be sent over RPC.
+  bool SendToSharedExchange(const tserver::LWPgPerformRequestPB& req) {
+    using google::protobuf::io::CodedOutputStream;
+
+    rpc::RequestHeader header;
+    header.set_timeout_millis(narrow_cast<uint32_t>(timeout_.ToMilliseconds()));
+    auto header_size = narrow_cast<uint32_t>(header.ByteSizeLong());
+    auto body_size = narrow_cast<uint32_t>(req.SerializedSize());
+    auto size = CodedOutputStream::VarintSize32(header_size) + header_size +
+                CodedOutputStream::VarintSize32(body_size) + body_size;
+    auto* start = pointer_cast<uint8_t*>(exchange_->Obtain(size));
+    if (!start) {
+      return false;
+    }
+    auto* out = CodedOutputStream::WriteVarint32ToArray(header_size, start);
+    out = header.SerializeWithCachedSizesToArray(out);
+    out = CodedOutputStream::WriteVarint32ToArray(body_size, out);
+    out = req.SerializeToArray(out);
+    DCHECK_EQ(out - start, size);
+    return exchange_->SendRequest(size);
+  }
+
+  Result<rpc::CallResponsePtr> FetchFromSharedExchange(
+      tserver::LWPgPerformResponsePB* resp, CoarseTimePoint deadline) {
+    rpc::CallData call_data(VERIFY_RESULT(exchange_->FetchResponse(deadline)));
+    auto response = std::make_shared<rpc::CallResponse>();
+    RETURN_NOT_OK(response->ParseFrom(&call_data));
+    const auto& body = response->serialized_response();
+    if (!response->is_success()) {
+      rpc::ErrorStatusPB error;
+      if (!error.ParseFromArray(body.data(), narrow_cast<int>(body.size()))) {
+        return STATUS(Corruption, "Failed to parse shared exchange error response");
+      }
+      return STATUS(RemoteError, error.message());
+    }
+    RETURN_NOT_OK(resp->ParseFromSlice(body));
+    return response;
   }
 
   void PrepareOperations(tserver::LWPgPerformRequestPB* req, PgsqlOps* operations) {
@@ -603,6 +732,16 @@ class PgClient::Impl {
   std::unique_ptr<tserver::PgClientServiceProxy> proxy_;
   rpc::RpcController controller_;
   uint64_t session_id_ = 0;
+  // Used instead of RPC for Perform requests when available.
+  std::unique_ptr<tserver::SharedExchange> exchange_;
+  // Thread that runs WaitSharedExchange.
+  ThreadPtr exchange_waiter_;
+  std::mutex exchange_mutex_;
+  std::condition_variable exchange_cond_;
+  // Request sent over the exchange, whose response was not fetched yet.
+  std::shared_ptr<PerformData> exchange_data_ GUARDED_BY(exchange_mutex_);
+  CoarseTimePoint exchange_deadline_ GUARDED_BY(exchange_mutex_);
+  bool exchange_stopped_ GUARDED_BY(exchange_mutex_) = false;
 
   rpc::Poller heartbeat_poller_;
   std::atomic<bool> heartbeat_running_{false};
@@ -739,11 +878,10 @@ Status PgClient::DeleteDBSequences(int64_t db_oid) {
   return impl_->DeleteDBSequences(db_oid);
 }
 
-void PgClient::PerformAsync(
+std::future<PerformResult> PgClient::PerformAsync(
     tserver::PgPerformOptionsPB* options,
-    PgsqlOps* operations,
-    const PerformCallback& callback) {
-  impl_->PerformAsync(options, operations, callback);
+    PgsqlOps* operations) {
+  return impl_->PerformAsync(options, operations);
 }
 
 Result<bool> PgClient::CheckIfPitrActive() {
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
@@ -57,8 +58,6 @@ struct PerformResult {
   }
 };
 
-using PerformCallback = std::function<void(const PerformResult&)>;
-
 class PgClient {
  public:
   PgClient();
@@ -128,10 +127,9 @@ class PgClient {
 
   Status DeleteDBSequences(int64_t db_oid);
 
-  void PerformAsync(
+  std::future<PerformResult> PerformAsync(
       tserver::PgPerformOptionsPB* options,
-      PgsqlOps* operations,
-      const PerformCallback& callback);
+      PgsqlOps* operations);
 
   Result<bool> CheckIfPitrActive();
 
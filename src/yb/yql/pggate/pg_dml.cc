@@ -470,7 +470,9 @@ bool PgDml::has_aggregate_targets() {
     }
   }
 
-  CHECK(num_aggregate_targets == 0 || num_aggregate_targets == targets_.size())
+  // Grouped aggregates also return values of the grouping columns.
+  CHECK(num_aggregate_targets == 0 || num_aggregate_targets == targets_.size() ||
+        has_grouping_columns())
     << "Some, but not all, targets are aggregate expressions.";
 
   return num_aggregate_targets > 0;
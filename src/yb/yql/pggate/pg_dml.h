@@ -93,6 +93,11 @@ class PgDml : public PgStatement {
 
   bool has_aggregate_targets();
 
+  // Whether aggregate targets are computed per group of rows, see PgDmlRead::AppendGroupingColumn.
+  virtual bool has_grouping_columns() const {
+    return false;
+  }
+
   bool has_doc_op() const {
     return doc_op_ != nullptr;
   }
@@ -151,6 +151,16 @@ LWPgsqlExpressionPB *PgDmlRead::AllocQualPB() {
   return read_req_->add_where_clauses();
 }
 
+Status PgDmlRead::AppendGroupingColumn(PgExpr *colref) {
+  SCHECK(colref->is_colref(), InvalidArgument, "Grouping column must be a column reference");
+  SCHECK(!secondary_index_query_, NotSupported, "Aggregate pushdown should not happen with index");
+  const auto attr_num = static_cast<PgColumnRef *>(colref)->attr_num();
+  const PgColumn& col = VERIFY_RESULT(PrepareColumnForRead(attr_num, nullptr));
+  SCHECK(!col.is_virtual_column(), InvalidArgument, "Can not group by virtual column");
+  read_req_->mutable_grouping_column_ids()->push_back(col.id());
+  return Status::OK();
+}
+
 LWPgsqlColRefPB *PgDmlRead::AllocColRefPB() {
   return read_req_->add_col_refs();
 }
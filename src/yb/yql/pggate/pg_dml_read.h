@@ -94,6 +94,15 @@ class PgDmlRead : public PgDml {
   Status AddRowUpperBound(YBCPgStatement handle, int n_col_values,
                                     PgExpr **col_values, bool is_inclusive);
 
+  // Add a GROUP BY column of the pushed down aggregate. Aggregate targets are computed by DocDB
+  // separately for every group, and the other targets must be references to grouping columns.
+  // Results are partial aggregates that should be merged by the caller.
+  Status AppendGroupingColumn(PgExpr *colref);
+
+  bool has_grouping_columns() const override {
+    return !read_req_->grouping_column_ids().empty();
+  }
+
   // Execute.
   virtual Status Exec(const PgExecParameters *exec_params);
 
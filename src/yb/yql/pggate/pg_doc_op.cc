@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "yb/common/partition.h"
 #include "yb/common/row_mark.h"
 
 #include "yb/gutil/casts.h"
@@ -677,6 +678,19 @@ Result<bool> PgDocReadOp::PopulateParallelSelectOps() {
   SCHECK(read_op_->read_request().partition_column_values().empty(),
          IllegalState,
          "Request with non empty partition_column_values can't be parallelized");
+  // Hash range of the tablets of a hash partitioned table could be split further, to scan single
+  // tablet by multiple concurrent requests. Hash partitioned table scan returns rows in no
+  // particular order anyway, so it is not affected by the split. Range partitioned tables are
+  // scanned one request per tablet, since rows of range partitioned table may be expected in
+  // order, and there is no cheap way to find split points inside of a tablet's range.
+  const size_t num_splits =
+      table_->IsHashPartitioned() ? std::max<uint32_t>(FLAGS_ysql_select_intra_tablet_splits, 1)
+                                  : 1;
+  if (num_splits > 1) {
+    return PopulateParallelSelectOps(
+        PartitionSchema::SplitHashPartitionRanges(table_->GetPartitions(), num_splits));
+  }
+
   // Create batch operators, one per partition, to execute in parallel.
   // TODO(tsplit): what if table partition is changed during PgDocReadOp lifecycle before or after
   // the following line?
@@ -719,6 +733,39 @@ Result<bool> PgDocReadOp::PopulateParallelSelectOps() {
   return true;
 }
 
+Result<bool> PgDocReadOp::PopulateParallelSelectOps(const std::vector<ScanRange>& ranges) {
+  // Create batch operators, one per scan range, to execute in parallel.
+  ClonePgsqlOps(ranges.size());
+  SCHECK_EQ(ranges.size(), pgsql_ops_.size(), IllegalState,
+            "Number of scan ranges and number of operators are not the same");
+
+  // Same as one operator per partition, but each tablet is now scanned by multiple operators.
+  auto parallelism_level = FLAGS_ysql_select_parallelism;
+  if (parallelism_level < 0) {
+    int tserver_count = VERIFY_RESULT(pg_session_->TabletServerCount(true /* primary_only */));
+    const int num_splits = narrow_cast<int>(ranges.size() / table_->GetPartitionCount());
+    int kMinParSelParallelism = 1;
+    int kMaxParSelParallelism = 16 * num_splits;
+    parallelism_level_ = std::min(
+        std::max(tserver_count * 2 * num_splits, kMinParSelParallelism), kMaxParSelParallelism);
+  } else {
+    parallelism_level_ = parallelism_level;
+  }
+
+  for (size_t op_index = 0; op_index != ranges.size(); ++op_index) {
+    pgsql_ops_[op_index]->set_active(true);
+    RETURN_NOT_OK(table_->SetScanBoundary(&GetReadReq(op_index),
+                                          ranges[op_index].first,
+                                          /* lower_bound_is_inclusive */ true,
+                                          ranges[op_index].second,
+                                          /* upper_bound_is_inclusive */ false));
+  }
+  active_op_count_ = ranges.size();
+  VLOG(1) << "Number of parallel scan ranges: " << active_op_count_;
+
+  return true;
+}
+
 Result<bool> PgDocReadOp::PopulateSamplingOps() {
   // Create one PgsqlOp per partition
   ClonePgsqlOps(table_->GetPartitionCount());
@@ -17,6 +17,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -513,6 +514,11 @@ class PgDocReadOp : public PgDocOp {
   // - Optimization for aggregating or filtering requests.
   Result<bool> PopulateParallelSelectOps();
 
+  // Create operators by scan ranges, given as pairs of lower (inclusive) and upper (exclusive)
+  // partition keys. Used to scan a single tablet with multiple operators.
+  Result<bool> PopulateParallelSelectOps(
+      const std::vector<std::pair<std::string, std::string>>& ranges);
+
   // Create one sampling operator per partition and arrange their execution in random order
   Result<bool> PopulateSamplingOps();
 
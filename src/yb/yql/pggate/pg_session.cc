@@ -552,8 +552,6 @@ Result<PerformFuture> PgSession::Perform(BufferableOperations&& ops, PerformOpti
       yb_xcluster_consistency_level == XCLUSTER_CONSISTENCY_DATABASE &&
       !(ops_options.use_catalog_session || pg_txn_manager_->IsDdlMode()));
 
-  auto promise = std::make_shared<std::promise<PerformResult>>();
-
   // If all operations belong to the same database then set the namespace.
   // System database template1 is ignored as we may read global system catalog like tablespaces
   // in the same batch.
@@ -585,10 +583,8 @@ Result<PerformFuture> PgSession::Perform(BufferableOperations&& ops, PerformOpti
     options.mutable_caching_info()->set_key(std::move(ops_options.cache_key));
   }
 
-  pg_client_.PerformAsync(&options, &ops.operations, [promise](const PerformResult& result) {
-    promise->set_value(result);
-  });
-  return PerformFuture(promise->get_future(), this, std::move(ops.relations));
+  return PerformFuture(
+      pg_client_.PerformAsync(&options, &ops.operations), this, std::move(ops.relations));
 }
 
 void PgSession::ProcessPerformOnTxnSerialNo(
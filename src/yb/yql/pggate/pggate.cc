@@ -1094,6 +1094,14 @@ Status PgApiImpl::DmlAppendColumnRef(PgStatement *handle, PgExpr *colref, bool i
   return down_cast<PgDml*>(handle)->AppendColumnRef(colref, is_primary);
 }
 
+Status PgApiImpl::DmlAppendGroupingColumn(PgStatement *handle, PgExpr *colref) {
+  if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_SELECT)) {
+    // Invalid handle.
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+  return down_cast<PgDmlRead*>(handle)->AppendGroupingColumn(colref);
+}
+
 Status PgApiImpl::DmlBindColumn(PgStatement *handle, int attr_num, PgExpr *attr_value) {
   return down_cast<PgDml*>(handle)->BindColumn(attr_num, attr_value);
 }
@@ -371,6 +371,8 @@ class PgApiImpl {
 
   Status DmlAppendColumnRef(PgStatement *handle, PgExpr *colref, bool is_primary);
 
+  Status DmlAppendGroupingColumn(PgStatement *handle, PgExpr *colref);
+
   // Binding Columns: Bind column with a value (expression) in a statement.
   // + This API is used to identify the rows you want to operate on. If binding columns are not
   //   there, that means you want to operate on all rows (full scan). You can view this as a
@@ -39,6 +39,10 @@ DEFINE_UNKNOWN_int32(pggate_tserver_shm_fd, -1,
 DEFINE_test_flag(bool, pggate_ignore_tserver_shm, false,
               "Ignore the shared memory of the local tablet server.");
 
+DEFINE_NON_RUNTIME_bool(pg_client_use_shared_memory, false,
+    "Send Perform requests to the local tablet server over shared memory instead of RPC.");
+TAG_FLAG(pg_client_use_shared_memory, advanced);
+
 DEFINE_UNKNOWN_int32(ysql_request_limit, 1024,
              "Maximum number of requests to be sent at once");
 
@@ -111,6 +115,13 @@ DEFINE_UNKNOWN_int32(ysql_select_parallelism, -1,
             "Number of read requests to issue in parallel to tablets of a table "
             "for SELECT.");
 
+DEFINE_RUNTIME_uint32(ysql_select_intra_tablet_splits, 1,
+            "Number of sub-ranges the hash range of a tablet is split into by parallel SELECT on a "
+            "hash partitioned table. Sub-ranges are scanned by concurrent requests, so a scan of "
+            "few large tablets could use more than one core per tablet server. When automatic "
+            "parallelism is used (ysql_select_parallelism < 0), number of requests issued in "
+            "parallel is multiplied by this value. 1 disables splitting.");
+
 DEFINE_UNKNOWN_int32(ysql_max_write_restart_attempts, 20,
              "Max number of restart attempts made for writes on transaction conflicts.");
 
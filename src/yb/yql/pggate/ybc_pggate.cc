@@ -797,6 +797,10 @@ YBCStatus YbPgDmlAppendColumnRef(YBCPgStatement handle, YBCPgExpr colref, bool i
   return ToYBCStatus(pgapi->DmlAppendColumnRef(handle, colref, is_primary));
 }
 
+YBCStatus YbPgDmlAppendGroupingColumn(YBCPgStatement handle, YBCPgExpr colref) {
+  return ToYBCStatus(pgapi->DmlAppendGroupingColumn(handle, colref));
+}
+
 YBCStatus YBCPgDmlBindColumn(YBCPgStatement handle, int attr_num, YBCPgExpr attr_value) {
   return ToYBCStatus(pgapi->DmlBindColumn(handle, attr_num, attr_value));
 }
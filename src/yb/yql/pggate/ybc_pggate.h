@@ -349,6 +349,13 @@ YBCStatus YbPgDmlAppendQual(YBCPgStatement handle, YBCPgExpr qual, bool is_prima
 // how to convert values from the DocDB formats to use them to evaluate Postgres expressions.
 YBCStatus YbPgDmlAppendColumnRef(YBCPgStatement handle, YBCPgExpr colref, bool is_primary);
 
+// Add GROUP BY column to the SELECT statement with aggregate targets.
+// DocDB computes aggregates separately for every group of rows having the same grouping column
+// values and returns one row per group. Other than aggregates, targets may only be references to
+// grouping columns. Returned aggregates are partial, rows of the same group returned by
+// different tablets or pages must be merged by the caller.
+YBCStatus YbPgDmlAppendGroupingColumn(YBCPgStatement handle, YBCPgExpr colref);
+
 // Binding Columns: Bind column with a value (expression) in a statement.
 // + This API is used to identify the rows you want to operate on. If binding columns are not
 //   there, that means you want to operate on all rows (full scan). You can view this as a
@@ -11,6 +11,7 @@
 // under the License.
 //
 
+#include <array>
 #include <atomic>
 #include <optional>
 #include <thread>
@@ -1528,6 +1529,62 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ConcurrentSingleRowUpdate)) {
   ASSERT_EQ(thread_count * increment_per_thread, counter);
 }
 
+// Concurrent transactions write intents for the same keys. Checks that reads still see provisional
+// writes of their own transaction, and committed writes that were not applied to regular DB yet,
+// i.e. that intents DB is not skipped while there are live transactions for the read keys.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ConcurrentIntentsOnSameKeys)) {
+  constexpr int kKeys = 5;
+  constexpr int kWriters = 8;
+  constexpr auto kTestTime = 15s;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT s, 0 FROM generate_series(0, $0) AS s", kKeys - 1));
+
+  std::array<std::atomic<int>, kKeys> num_commits;
+  for (auto& value : num_commits) {
+    value = 0;
+  }
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kWriters; ++i) {
+    thread_holder.AddThreadFunctor([this, &num_commits, &stop = thread_holder.stop_flag()] {
+      auto write_conn = ASSERT_RESULT(Connect());
+      while (!stop.load(std::memory_order_acquire)) {
+        const auto key = RandomUniformInt(0, kKeys - 1);
+        const auto select = Format("SELECT v FROM t WHERE k = $0", key);
+        ASSERT_OK(write_conn.Execute("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ"));
+        auto old_value = ASSERT_RESULT(write_conn.FetchValue<int32_t>(select));
+        auto status = write_conn.ExecuteFormat("UPDATE t SET v = v + 1 WHERE k = $0", key);
+        if (status.ok()) {
+          // Own provisional write is present only in intents DB.
+          auto new_value = ASSERT_RESULT(write_conn.FetchValue<int32_t>(select));
+          ASSERT_EQ(new_value, old_value + 1);
+          status = write_conn.Execute("COMMIT");
+        }
+        if (!status.ok()) {
+          ASSERT_EQ(PgsqlError(status), YBPgErrorCode::YB_PG_T_R_SERIALIZATION_FAILURE)
+              << status;
+          ASSERT_OK(write_conn.Execute("ROLLBACK"));
+          continue;
+        }
+        ++num_commits[key];
+        // Committed write could be not applied to regular DB yet.
+        auto committed_value = ASSERT_RESULT(write_conn.FetchValue<int32_t>(select));
+        ASSERT_GE(committed_value, old_value + 1);
+      }
+    });
+  }
+  thread_holder.WaitAndStop(kTestTime);
+
+  for (int key = 0; key != kKeys; ++key) {
+    auto value = ASSERT_RESULT(conn.FetchValue<int32_t>(
+        Format("SELECT v FROM t WHERE k = $0", key)));
+    LOG(INFO) << "Key: " << key << ", commits: " << num_commits[key].load();
+    ASSERT_EQ(value, num_commits[key].load());
+  }
+}
+
 // ------------------------------------------------------------------------------------------------
 // A test performing manual transaction control on system tables.
 // ------------------------------------------------------------------------------------------------
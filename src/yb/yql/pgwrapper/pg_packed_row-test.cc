@@ -31,11 +31,13 @@
 
 using namespace std::literals;
 
+DECLARE_bool(ysql_enable_columnar_aggregate_scan);
 DECLARE_bool(ysql_enable_packed_row);
 DECLARE_int32(history_cutoff_propagation_interval_ms);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
 DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_uint64(rocksdb_universal_compaction_always_include_size_threshold);
+DECLARE_uint64(ysql_columnar_scan_batch_size);
 DECLARE_uint64(ysql_packed_row_size_limit);
 DECLARE_bool(ysql_enable_packed_row_for_colocated_table);
 DECLARE_bool(TEST_skip_aborting_active_transactions_during_schema_change);
@@ -711,5 +713,43 @@ TEST_F(PgPackedRowTest, YB_DISABLE_TEST_IN_TSAN(AppliedSchemaVersion)) {
   ASSERT_OK(cluster_->CompactTablets());
 }
 
+// Check that aggregates evaluated over columnar batches match row by row evaluation, for both
+// rows decoded directly from packed rows and rows that have column level updates.
+TEST_F(PgPackedRowTest, YB_DISABLE_TEST_IN_TSAN(ColumnarAggregate)) {
+  constexpr int kNumRows = 100;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_columnar_scan_batch_size) = 7;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT PRIMARY KEY, v1 INT, v2 BIGINT, v3 DOUBLE PRECISION, v4 TEXT) "
+      "SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, NULLIF(i % 5, 0), i * 1000, NULLIF(i % 3, 1) * 0.5, i::TEXT "
+      "FROM generate_series(1, $0) AS i", kNumRows));
+
+  // Updates with packed row disabled produce column level records, so such rows could not be
+  // decoded directly from the packed row.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_enable_packed_row) = false;
+  ASSERT_OK(conn.Execute("UPDATE t SET v1 = NULL, v2 = -v2 WHERE key % 11 = 0"));
+  ASSERT_OK(conn.Execute("UPDATE t SET v3 = 100 WHERE key % 13 = 0"));
+  ASSERT_OK(conn.Execute("DELETE FROM t WHERE key % 17 = 0"));
+
+  const std::vector<std::string> kQueries = {
+    "SELECT COUNT(*), COUNT(v1), SUM(v1), MIN(v1), MAX(v1) FROM t",
+    "SELECT COUNT(v2), SUM(v2), MIN(v2), MAX(v2), COUNT(v3), SUM(v3), MIN(v3), MAX(v3) FROM t",
+    "SELECT COUNT(*), SUM(v1), MIN(v2), MAX(v3) FROM t WHERE key > 1000",
+    "SELECT COUNT(v4), SUM(v1) FROM t",
+  };
+
+  for (const auto& query : kQueries) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_enable_columnar_aggregate_scan) = false;
+    auto expected = ASSERT_RESULT(conn.FetchRowAsString(query));
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_enable_columnar_aggregate_scan) = true;
+    auto actual = ASSERT_RESULT(conn.FetchRowAsString(query));
+    ASSERT_EQ(expected, actual) << "Query: " << query;
+  }
+}
+
 } // namespace pgwrapper
 } // namespace yb
@@ -49,6 +49,7 @@ DECLARE_bool(enable_automatic_tablet_splitting);
 DECLARE_bool(TEST_skip_partitioning_version_validation);
 DECLARE_int32(cleanup_split_tablets_interval_sec);
 DECLARE_int32(TEST_partitioning_version);
+DECLARE_uint32(ysql_select_intra_tablet_splits);
 
 using namespace std::literals;
 
@@ -165,6 +166,49 @@ TEST_F(PgTabletSplitTest, YB_DISABLE_TEST_IN_TSAN(SplitKeyMatchesPartitionBound)
   ASSERT_NE(result.status().ToString().find("with partition bounds"), std::string::npos);
 }
 
+class PgIntraTabletSplitScanTest : public PgTabletSplitTest {
+ protected:
+  void SetUp() override {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_select_intra_tablet_splits) = kIntraTabletSplits;
+    PgTabletSplitTest::SetUp();
+  }
+
+  static constexpr uint32_t kIntraTabletSplits = 3;
+};
+
+// Check that parallel scan over the hash sub-ranges of uneven tablets, produced by tablet
+// splitting, reads every row exactly once.
+TEST_F(PgIntraTabletSplitScanTest, YB_DISABLE_TEST_IN_TSAN(ScanAfterSplit)) {
+  constexpr int kNumRows = 10000;
+  constexpr size_t kNumSplits = 3;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t(k INT PRIMARY KEY, v INT) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i FROM generate_series(1, $0) AS i", kNumRows));
+  ASSERT_OK(cluster_->FlushTablets());
+
+  const auto expected_aggregates = Format("$0, $1", kNumRows, kNumRows * (kNumRows + 1) / 2);
+  const auto expected_filtered = std::to_string(kNumRows / 7);
+  auto check = [&conn, &expected_aggregates, &expected_filtered]() -> Status {
+    // Aggregates and filtered scans are executed by parallel requests.
+    auto aggregates = VERIFY_RESULT(conn.FetchRowAsString("SELECT COUNT(*), SUM(v) FROM t"));
+    SCHECK_EQ(aggregates, expected_aggregates, IllegalState, "Wrong aggregates");
+    auto filtered = VERIFY_RESULT(conn.FetchRowAsString(
+        "SELECT COUNT(*) FROM t WHERE v % 7 = 0"));
+    SCHECK_EQ(filtered, expected_filtered, IllegalState, "Wrong filtered count");
+    return Status::OK();
+  };
+
+  ASSERT_OK(check());
+  // Split the last tablet several times, so tablets have different hash range widths.
+  ASSERT_OK(DoLastTabletSplitForTableWithSingleTablet("t", kNumSplits));
+  // Executing several times to check the result after possible cache update.
+  for ([[maybe_unused]] auto _ : Range(3)) {
+    ASSERT_OK(check());
+  }
+}
+
 class PgPartitioningVersionTest :
     public PgTabletSplitTest,
     public testing::WithParamInterface<uint32_t> {